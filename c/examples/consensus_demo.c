@@ -167,6 +167,7 @@ static void run_voting_round(int round, uint32_t proposal_data, ekk_fixed_t thre
     for (int i = 1; i < NUM_MODULES; i++) {
         ekk_consensus_on_proposal(&g_modules[i].consensus,
                                   g_modules[0].id,
+                                  g_modules[0].consensus.incarnation,
                                   ballot_id,
                                   EKK_PROPOSAL_MODE_CHANGE,
                                   proposal_data,
@@ -182,6 +183,7 @@ static void run_voting_round(int round, uint32_t proposal_data, ekk_fixed_t thre
         /* Send vote to proposer (module 0) */
         ekk_consensus_on_vote(&g_modules[0].consensus,
                               g_modules[i].id,
+                              g_modules[0].id,
                               ballot_id,
                               vote);
     }
@@ -252,11 +254,11 @@ static void demo_inhibition(void)
 
     /* Simulate some votes for Ballot 1 */
     printf("Voting on Ballot 1 (MODE_A):\n");
-    ekk_consensus_on_vote(&g_modules[0].consensus, g_modules[0].id, ballot1, EKK_VOTE_YES);
-    ekk_consensus_on_vote(&g_modules[0].consensus, g_modules[1].id, ballot1, EKK_VOTE_NO);
-    ekk_consensus_on_vote(&g_modules[0].consensus, g_modules[2].id, ballot1, EKK_VOTE_YES);
-    ekk_consensus_on_vote(&g_modules[0].consensus, g_modules[3].id, ballot1, EKK_VOTE_YES);
-    ekk_consensus_on_vote(&g_modules[0].consensus, g_modules[4].id, ballot1, EKK_VOTE_YES);
+    ekk_consensus_on_vote(&g_modules[0].consensus, g_modules[0].id, g_modules[0].id, ballot1, EKK_VOTE_YES);
+    ekk_consensus_on_vote(&g_modules[0].consensus, g_modules[1].id, g_modules[0].id, ballot1, EKK_VOTE_NO);
+    ekk_consensus_on_vote(&g_modules[0].consensus, g_modules[2].id, g_modules[0].id, ballot1, EKK_VOTE_YES);
+    ekk_consensus_on_vote(&g_modules[0].consensus, g_modules[3].id, g_modules[0].id, ballot1, EKK_VOTE_YES);
+    ekk_consensus_on_vote(&g_modules[0].consensus, g_modules[4].id, g_modules[0].id, ballot1, EKK_VOTE_YES);
     printf("  4 YES, 1 NO\n");
 
     /* Finalize */
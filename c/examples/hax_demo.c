@@ -420,6 +420,7 @@ static void start_consensus(void)
         if (g_module_alive[i]) {
             ekk_consensus_on_proposal(&g_modules[i].consensus,
                                       g_modules[0].id,
+                                      g_modules[0].consensus.incarnation,
                                       g_ballot_id,
                                       EKK_PROPOSAL_MODE_CHANGE,
                                       100,
@@ -433,6 +434,7 @@ static void start_consensus(void)
         if (g_module_alive[i]) {
             ekk_consensus_on_vote(&g_modules[0].consensus,
                                   g_modules[i].id,
+                                  g_modules[0].id,
                                   g_ballot_id,
                                   EKK_VOTE_YES);
         }
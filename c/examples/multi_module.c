@@ -30,6 +30,7 @@
 
 /* Module states */
 static ekk_module_t g_modules[NUM_MODULES];
+static ekk_hal_endpoint_t g_endpoints[NUM_MODULES];    /* Each module's own bus attachment */
 static bool g_module_alive[NUM_MODULES];
 static char g_module_names[NUM_MODULES][16];
 
@@ -162,6 +163,7 @@ static void kill_module(int idx)
 {
     printf("\n!!! Module %u FAILED !!!\n", g_modules[idx].id);
     g_module_alive[idx] = false;
+    ekk_module_attach_endpoint(&g_modules[idx], NULL);     /* Off the bus */
 
     /* Notify other modules of the loss */
     for (int i = 0; i < NUM_MODULES; i++) {
@@ -214,6 +216,12 @@ int main(void)
             return 1;
         }
 
+        /* Own sender ID and rx ring: modules do not consume each other's frames */
+        err = ekk_module_attach_endpoint(&g_modules[i], &g_endpoints[i]);
+        if (err != EKK_OK) {
+            fprintf(stderr, "ERROR: ekk_module_attach_endpoint(%d) failed: %d\n", i + 1, err);
+            return 1;
+        }
         g_module_alive[i] = true;
         printf("    Module %u initialized at (%d, %d)\n",
                g_modules[i].id, pos.x, pos.y);
@@ -60,8 +60,8 @@
  *     ekk_module_start(&my_module);
  *
  *     while (1) {
- *         ekk_time_us_t now = ekk_hal_time_us();
- *         ekk_module_tick(&my_module, now);
+ *         ekk_module_wait(&my_module);    // Sleep until something is due
+ *         ekk_module_tick(&my_module, ekk_hal_time_us());
  *     }
  * }
  * @endcode
@@ -95,6 +95,9 @@
 /* Core types and configuration */
 #include "ekk_types.h"
 
+/* Module ID to slot map (per-module tables with 16-bit IDs) */
+#include "ekk_idmap.h"
+
 /* Hardware abstraction */
 #include "ekk_hal.h"
 
@@ -110,6 +113,12 @@
 /* Heartbeat and liveness */
 #include "ekk_heartbeat.h"
 
+/* Task run queue (bitmap priorities, EDF, release timers) */
+#include "ekk_runqueue.h"
+
+/* Tick phase and task latency histograms */
+#include "ekk_histogram.h"
+
 /* Module - first class citizen */
 #include "ekk_module.h"
 
@@ -27,6 +27,7 @@
 #define EKK_AUTH_H
 
 #include "ekk_types.h"
+#include "ekk_idmap.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -214,7 +215,8 @@ bool ekk_auth_is_required(uint8_t msg_type);
 /**
  * @brief Compute MAC for EK-KOR message
  *
- * Authenticates: sender_id | msg_type | data
+ * Authenticates: sender_id | msg_type | data (sender_id little-endian,
+ * one byte with 8-bit module IDs)
  *
  * @param key Sender's key
  * @param sender_id Sender module ID
@@ -224,7 +226,7 @@ bool ekk_auth_is_required(uint8_t msg_type);
  * @param[out] tag Output MAC tag
  */
 void ekk_auth_message(const ekk_auth_key_t *key,
-                       uint8_t sender_id, uint8_t msg_type,
+                       ekk_module_id_t sender_id, uint8_t msg_type,
                        const void *data, uint32_t len,
                        ekk_auth_tag_t *tag);
 
@@ -240,7 +242,7 @@ void ekk_auth_message(const ekk_auth_key_t *key,
  * @return true if authentic, false if forged/corrupted
  */
 bool ekk_auth_verify_message(const ekk_auth_key_t *key,
-                              uint8_t sender_id, uint8_t msg_type,
+                              ekk_module_id_t sender_id, uint8_t msg_type,
                               const void *data, uint32_t len,
                               const ekk_auth_tag_t *tag);
 
@@ -252,11 +254,16 @@ bool ekk_auth_verify_message(const ekk_auth_key_t *key,
  * @brief Key slot for per-module keys
  *
  * In a cluster, each module has a shared secret with each neighbor.
- * This structure holds keys indexed by module ID.
+ * This structure holds keys indexed by module ID (by slot with 16-bit
+ * module IDs; a module has a key exactly when it has a slot).
  */
 typedef struct {
     ekk_auth_key_t keys[EKK_MAX_MODULES];   /**< Key per module */
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_t slots;                      /**< Module ID -> key slot */
+#else
     uint8_t valid[(EKK_MAX_MODULES + 7) / 8]; /**< Bitmap: 1 = key present */
+#endif
 } ekk_auth_keyring_t;
 
 /**
@@ -24,6 +24,8 @@
 #define EKK_CONSENSUS_H
 
 #include "ekk_types.h"
+#include "ekk_idmap.h"
+#include "ekk_heartbeat.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,6 +65,7 @@ typedef struct {
     ekk_time_us_t inhibit_duration;     /**< How long inhibition lasts */
     bool allow_self_vote;               /**< Can proposer vote for own proposal */
     bool require_all_neighbors;         /**< Require votes from all neighbors */
+    bool broadcast_decision;            /**< Proposer broadcasts the outcome as soon as it is known */
 } ekk_consensus_config_t;
 
 #define EKK_CONSENSUS_CONFIG_DEFAULT { \
@@ -70,8 +73,16 @@ typedef struct {
     .inhibit_duration = 100000, /* 100ms */ \
     .allow_self_vote = true, \
     .require_all_neighbors = false, \
+    .broadcast_decision = true, \
 }
 
+/**
+ * @brief Maximum votes packed into one EKK_MSG_VOTE_BATCH frame
+ */
+#ifndef EKK_VOTE_BATCH_MAX
+#define EKK_VOTE_BATCH_MAX          8
+#endif
+
 /* ============================================================================
  * BALLOT STRUCTURE
  * ============================================================================ */
@@ -83,6 +94,7 @@ typedef struct {
     ekk_ballot_id_t id;                     /**< Unique ballot ID */
     ekk_proposal_type_t type;               /**< What we're voting on */
     ekk_module_id_t proposer;               /**< Who proposed it */
+    uint8_t incarnation;                    /**< Proposer's incarnation */
 
     uint32_t proposal_data;                 /**< Proposal-specific data */
 
@@ -95,30 +107,78 @@ typedef struct {
     uint8_t yes_count;                      /**< Approvals */
     uint8_t no_count;                       /**< Rejections */
 
+    uint8_t my_vote;                        /**< Our vote on a remote ballot (ekk_vote_value_t) */
+    bool vote_queued;                       /**< my_vote not yet sent to the proposer */
+
     ekk_vote_result_t result;               /**< Final result */
     bool completed;                         /**< Voting finished */
 } ekk_ballot_t;
 
+/**
+ * @brief Outcome of a completed ballot (history ring entry)
+ */
+typedef struct {
+    ekk_ballot_id_t id;                     /**< Ballot ID (0 = unused entry) */
+    ekk_module_id_t proposer;               /**< Who proposed it */
+    uint8_t incarnation;                    /**< Proposer's incarnation */
+    uint8_t result;                         /**< Final result (ekk_vote_result_t) */
+    uint8_t yes_count;                      /**< Certified approvals */
+    uint8_t vote_count;                     /**< Certified votes */
+    bool verified;                          /**< Checked against the ballot threshold */
+} ekk_ballot_outcome_t;
+
 /* ============================================================================
  * CONSENSUS STATE
  * ============================================================================ */
 
+/** Hash buckets per ballot index (twice the table size, load <= 50%) */
+#define EKK_BALLOT_BUCKETS          (2 * EKK_MAX_BALLOTS)
+
 /**
  * @brief Consensus engine state
+ *
+ * Ballots and inhibitions live in dense arrays (removal swaps the last
+ * entry in) and are found through open-addressed indexes keyed by ballot
+ * ID: one 32-bit word per bucket, (id << 16) | (slot + 1), 0 = empty.
+ * Each proposer allocates IDs from its own range (EKK_BALLOT_SEQ_BITS),
+ * so any number of proposals up to EKK_MAX_BALLOTS can be in flight.
+ * Completed ballots leave the table on the next tick, or as soon as a
+ * new ballot needs the slot; their outcome stays in the history ring.
+ *
+ * A ballot is identified by (proposer, ID): with 16-bit module IDs the
+ * ranges repeat every 2^(16 - EKK_BALLOT_SEQ_BITS) modules, so every
+ * lookup that knows the proposer matches on it. A proposer that restarts
+ * numbers its ballots from the start of its range again; proposals and
+ * certificates carry its incarnation, and the first one from a new
+ * incarnation drops the ballots, outcomes and inhibitions held for the
+ * old one.
  */
-typedef struct {
+typedef struct ekk_consensus {
     ekk_module_id_t my_id;                      /**< This module's ID */
 
-    ekk_ballot_t ballots[EKK_MAX_BALLOTS];      /**< Active ballots */
+    ekk_ballot_t ballots[EKK_MAX_BALLOTS];      /**< Active ballots (dense) */
     uint32_t active_ballot_count;
+    uint32_t ballot_index[EKK_BALLOT_BUCKETS];  /**< Ballot ID -> slot */
 
-    ekk_ballot_id_t inhibited[EKK_MAX_BALLOTS]; /**< Inhibited ballot IDs */
+    ekk_ballot_id_t inhibited[EKK_MAX_BALLOTS]; /**< Inhibited ballot IDs (dense) */
+    ekk_module_id_t inhibited_proposer[EKK_MAX_BALLOTS]; /**< Their proposers */
     ekk_time_us_t inhibit_until[EKK_MAX_BALLOTS];
     uint32_t inhibit_count;
+    uint32_t inhibit_index[EKK_BALLOT_BUCKETS]; /**< Ballot ID -> inhibit slot */
+
+    ekk_ballot_outcome_t history[EKK_BALLOT_HISTORY]; /**< Recently completed ballots */
+    uint32_t history_head;                      /**< Next history entry to overwrite */
 
-    ekk_ballot_id_t next_ballot_id;             /**< Next ballot ID to use */
+    ekk_ballot_id_t next_ballot_id;             /**< Next ballot ID to use (own range) */
+    uint8_t incarnation;                        /**< Sent with proposals (never 0) */
 
     ekk_consensus_config_t config;              /**< Configuration */
+    ekk_heartbeat_t *liveness;                  /**< Sends go through it: trailer, endpoint (NULL = plain HAL) */
+
+    /* Callbacks (per instance, cleared by init) */
+    ekk_vote_value_t (*on_decide)(struct ekk_consensus *cons, const ekk_ballot_t *ballot);
+    void (*on_complete)(struct ekk_consensus *cons, const ekk_ballot_t *ballot,
+                        ekk_vote_result_t result);
 } ekk_consensus_t;
 
 /* ============================================================================
@@ -137,6 +197,19 @@ ekk_error_t ekk_consensus_init(ekk_consensus_t *cons,
                                 ekk_module_id_t my_id,
                                 const ekk_consensus_config_t *config);
 
+/**
+ * @brief Set this module's incarnation
+ *
+ * Init derives one from the clock, which tells restarts apart only where
+ * the clock outlives the process (POSIX). Targets whose clock restarts
+ * at reset should set it from a boot counter kept in backup RAM or
+ * flash, or from a hardware RNG, before the first proposal.
+ *
+ * @param cons Consensus state
+ * @param incarnation Incarnation (0 is mapped to 1)
+ */
+void ekk_consensus_set_incarnation(ekk_consensus_t *cons, uint8_t incarnation);
+
 /**
  * @brief Propose a vote to k-neighbors
  *
@@ -147,8 +220,8 @@ ekk_error_t ekk_consensus_init(ekk_consensus_t *cons,
  * @param type Proposal type
  * @param data Proposal-specific data
  * @param threshold Required approval ratio (Q16.16, e.g., 0.67 for 2/3)
- * @param[out] ballot_id Assigned ballot ID
- * @return EKK_OK on success, EKK_ERR_BUSY if too many active ballots
+ * @param[out] ballot_id Assigned ballot ID (from this module's ID range)
+ * @return EKK_OK on success, EKK_ERR_BUSY if EKK_MAX_BALLOTS are still voting
  *
  * EXAMPLE:
  * @code
@@ -172,6 +245,9 @@ ekk_error_t ekk_consensus_propose(ekk_consensus_t *cons,
 /**
  * @brief Cast vote in response to neighbor's proposal
  *
+ * If two proposers sharing an ID range both have the ballot open, the
+ * vote goes to the first one found.
+ *
  * @param cons Consensus state
  * @param ballot_id Ballot to vote on
  * @param vote Vote value
@@ -186,6 +262,8 @@ ekk_error_t ekk_consensus_vote(ekk_consensus_t *cons,
  *
  * Blocks a proposal from reaching quorum. Used for mutual exclusion
  * between competing proposals (e.g., can't enter two modes at once).
+ * The inhibition applies to the proposer of the open ballot with this
+ * ID, or to the owner of the ID range if no such ballot is open.
  *
  * @param cons Consensus state
  * @param ballot_id Ballot to inhibit
@@ -197,26 +275,37 @@ ekk_error_t ekk_consensus_inhibit(ekk_consensus_t *cons,
 /**
  * @brief Process incoming vote message
  *
- * Called when receiving a vote from a neighbor.
+ * Called when receiving a vote from a neighbor. EKK_VOTE_INHIBIT
+ * inhibits the proposer's ballot; any other vote counts only on a
+ * ballot of ours.
  *
  * @param cons Consensus state
  * @param voter_id Voter's module ID
+ * @param proposer_id Proposer of the ballot
  * @param ballot_id Ballot being voted on
  * @param vote Vote value
  * @return EKK_OK on success
  */
 ekk_error_t ekk_consensus_on_vote(ekk_consensus_t *cons,
                                    ekk_module_id_t voter_id,
+                                   ekk_module_id_t proposer_id,
                                    ekk_ballot_id_t ballot_id,
                                    ekk_vote_value_t vote);
 
 /**
  * @brief Process incoming proposal message
  *
- * Called when receiving a proposal from a neighbor.
+ * Called when receiving a proposal from a neighbor. The local vote is
+ * queued and sent by the next ekk_consensus_tick(), packed with any other
+ * votes owed to the same proposer.
+ *
+ * A proposal from a new incarnation of the proposer first drops what is
+ * held for its previous one, so a restarted proposer reusing IDs is not
+ * mistaken for a duplicate.
  *
  * @param cons Consensus state
  * @param proposer_id Proposer's module ID
+ * @param incarnation Proposer's incarnation
  * @param ballot_id Ballot ID
  * @param type Proposal type
  * @param data Proposal data
@@ -225,17 +314,56 @@ ekk_error_t ekk_consensus_on_vote(ekk_consensus_t *cons,
  */
 ekk_error_t ekk_consensus_on_proposal(ekk_consensus_t *cons,
                                        ekk_module_id_t proposer_id,
+                                       uint8_t incarnation,
                                        ekk_ballot_id_t ballot_id,
                                        ekk_proposal_type_t type,
                                        uint32_t data,
                                        ekk_fixed_t threshold);
 
+/**
+ * @brief Process incoming decision certificate
+ *
+ * The proposer broadcasts the outcome as soon as its tally crosses (or
+ * can no longer reach) the threshold, so voters finish the ballot one
+ * round trip after the proposal instead of at their vote timeout.
+ *
+ * The certificate is checked before it decides anything: the ballot must
+ * belong to proposer_id (its ID in the proposer's range, and the open
+ * ballot's owner), the counts must be consistent (yes <= votes <=
+ * EKK_K_NEIGHBORS), and they must support the result at the ballot's
+ * threshold (APPROVED needs yes/votes at or above it, REJECTED and
+ * TIMEOUT below it). Certificates for unknown ballots are kept in the
+ * history ring unverified and only count once the proposal arrives and
+ * they pass the same check.
+ *
+ * @param cons Consensus state
+ * @param proposer_id Proposer's module ID (must match the ballot's)
+ * @param incarnation Proposer's incarnation
+ * @param ballot_id Decided ballot
+ * @param result APPROVED, REJECTED or TIMEOUT
+ * @param yes_count Approvals behind the result
+ * @param vote_count Votes behind the result
+ * @return EKK_OK on success, EKK_ERR_INVALID_ARG if the certificate is
+ *         malformed or does not support the result
+ */
+ekk_error_t ekk_consensus_on_decision(ekk_consensus_t *cons,
+                                       ekk_module_id_t proposer_id,
+                                       uint8_t incarnation,
+                                       ekk_ballot_id_t ballot_id,
+                                       ekk_vote_result_t result,
+                                       uint8_t yes_count,
+                                       uint8_t vote_count);
+
 /**
  * @brief Get result of a ballot
  *
+ * Ballots that already left the table are answered from the history
+ * ring (the last EKK_BALLOT_HISTORY outcomes). Our own ballots take
+ * precedence over remote ones sharing the ID.
+ *
  * @param cons Consensus state
  * @param ballot_id Ballot to check
- * @return Vote result (PENDING if still voting)
+ * @return Vote result (PENDING if still voting or unknown)
  */
 ekk_vote_result_t ekk_consensus_get_result(const ekk_consensus_t *cons,
                                             ekk_ballot_id_t ballot_id);
@@ -243,7 +371,9 @@ ekk_vote_result_t ekk_consensus_get_result(const ekk_consensus_t *cons,
 /**
  * @brief Periodic tick (call from main loop)
  *
- * Checks for timeouts and finalizes ballots.
+ * Checks for timeouts, finalizes ballots and sends queued votes. A
+ * remote ballot that reaches its deadline without a decision certificate
+ * ends as TIMEOUT.
  *
  * @param cons Consensus state
  * @param now Current timestamp
@@ -251,17 +381,29 @@ ekk_vote_result_t ekk_consensus_get_result(const ekk_consensus_t *cons,
  */
 uint32_t ekk_consensus_tick(ekk_consensus_t *cons, ekk_time_us_t now);
 
+/**
+ * @brief Earliest time at which ekk_consensus_tick() has work to do
+ *
+ * The soonest of: an open ballot's deadline and an inhibition's expiry.
+ * Queued votes and inhibited open ballots make it due at once (0).
+ *
+ * @param cons Consensus state
+ * @return Absolute time in microseconds, UINT64_MAX if nothing is pending
+ */
+ekk_time_us_t ekk_consensus_next_deadline(const ekk_consensus_t *cons);
+
 /* ============================================================================
  * VOTE MESSAGE FORMAT
  * ============================================================================ */
 
 /**
- * @brief Vote message (sent to proposer)
+ * @brief Vote message (sent to proposer, inhibits broadcast)
  */
 EKK_PACK_BEGIN
 typedef struct {
     uint8_t msg_type;               /**< EKK_MSG_VOTE */
     ekk_module_id_t voter_id;       /**< Voter's ID */
+    ekk_module_id_t proposer_id;    /**< Proposer of the ballot */
     ekk_ballot_id_t ballot_id;      /**< Which ballot */
     uint8_t vote;                   /**< The vote (ekk_vote_value_t) */
     uint32_t timestamp;             /**< Voting timestamp (truncated) */
@@ -277,6 +419,7 @@ EKK_PACK_BEGIN
 typedef struct {
     uint8_t msg_type;               /**< EKK_MSG_PROPOSAL */
     ekk_module_id_t proposer_id;    /**< Proposer's ID */
+    uint8_t incarnation;            /**< Proposer's incarnation */
     ekk_ballot_id_t ballot_id;      /**< Ballot ID */
     uint8_t type;                   /**< Proposal type (ekk_proposal_type_t) */
     uint32_t data;                  /**< Proposal data */
@@ -286,6 +429,54 @@ EKK_PACK_END
 
 EKK_STATIC_ASSERT(sizeof(ekk_proposal_msg_t) <= 16, "Proposal message too large");
 
+/**
+ * @brief Decision certificate (broadcast by the proposer)
+ */
+EKK_PACK_BEGIN
+typedef struct {
+    uint8_t msg_type;               /**< EKK_MSG_DECISION */
+    ekk_module_id_t proposer_id;    /**< Proposer's ID */
+    uint8_t incarnation;            /**< Proposer's incarnation */
+    ekk_ballot_id_t ballot_id;      /**< Decided ballot */
+    uint8_t result;                 /**< Outcome (ekk_vote_result_t) */
+    uint8_t yes_count;              /**< Approvals behind the outcome */
+    uint8_t vote_count;             /**< Votes behind the outcome */
+} EKK_PACKED ekk_decision_msg_t;
+EKK_PACK_END
+
+EKK_STATIC_ASSERT(sizeof(ekk_decision_msg_t) <= 12, "Decision message too large");
+
+/**
+ * @brief One entry of a vote batch
+ */
+EKK_PACK_BEGIN
+typedef struct {
+    ekk_ballot_id_t ballot_id;      /**< Which ballot */
+    uint8_t vote;                   /**< The vote (ekk_vote_value_t) */
+} EKK_PACKED ekk_vote_entry_t;
+EKK_PACK_END
+
+/**
+ * @brief Votes for several ballots of one proposer (sent to proposer)
+ *
+ * Only the first count entries are sent; see EKK_VOTE_BATCH_LEN().
+ */
+EKK_PACK_BEGIN
+typedef struct {
+    uint8_t msg_type;               /**< EKK_MSG_VOTE_BATCH */
+    ekk_module_id_t voter_id;       /**< Voter's ID */
+    ekk_module_id_t proposer_id;    /**< Proposer of every entry */
+    uint8_t count;                  /**< Entries that follow */
+    ekk_vote_entry_t entries[EKK_VOTE_BATCH_MAX];
+} EKK_PACKED ekk_vote_batch_msg_t;
+EKK_PACK_END
+
+/** Wire length of a vote batch with n entries */
+#define EKK_VOTE_BATCH_LEN(n) \
+    (offsetof(ekk_vote_batch_msg_t, entries) + (n) * sizeof(ekk_vote_entry_t))
+
+EKK_STATIC_ASSERT(sizeof(ekk_vote_batch_msg_t) <= 64, "Vote batch must fit a CAN-FD frame");
+
 /* ============================================================================
  * CALLBACKS
  * ============================================================================ */
@@ -357,9 +548,13 @@ typedef struct {
  * @brief Quarantine state tracking
  */
 typedef struct {
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_t quarantined;                    /**< Quarantined module -> slot */
+#else
     bool quarantined[EKK_MAX_MODULES];          /**< Quarantine status per module */
-    ekk_time_us_t quarantine_time[EKK_MAX_MODULES]; /**< When quarantine started */
-    uint8_t quarantine_count;                   /**< Number of quarantined modules */
+#endif
+    ekk_time_us_t quarantine_time[EKK_MAX_MODULES]; /**< When quarantine started (per slot) */
+    uint16_t quarantine_count;                  /**< Number of quarantined modules */
 } ekk_quarantine_state_t;
 
 /**
@@ -426,11 +621,14 @@ ekk_error_t ekk_consensus_execute_quarantine(ekk_consensus_t *cons,
  */
 static inline bool ekk_consensus_is_quarantined(const ekk_quarantine_state_t *state,
                                                   ekk_module_id_t module_id) {
-    if (state == NULL || module_id == EKK_INVALID_MODULE_ID ||
-        module_id >= EKK_MAX_MODULES) {
+    if (state == NULL || !EKK_MODULE_ID_VALID(module_id)) {
         return false;
     }
+#if EKK_MODULE_ID_BITS > 8
+    return ekk_idmap_find(&state->quarantined, module_id) >= 0;
+#else
     return state->quarantined[module_id];
+#endif
 }
 
 /**
@@ -453,7 +651,9 @@ ekk_error_t ekk_quarantine_lift(ekk_quarantine_state_t *state,
 /**
  * @brief Quarantine proposal message
  *
- * Includes suspect ID and evidence hash for verification.
+ * Includes suspect ID and evidence hash for verification. With 16-bit
+ * module IDs, evidence type and witness count share one byte
+ * (EKK_QUARANTINE_EVIDENCE) so the message stays at 12 bytes.
  */
 EKK_PACK_BEGIN
 typedef struct {
@@ -461,15 +661,24 @@ typedef struct {
     ekk_module_id_t proposer_id;        /**< Who is proposing */
     ekk_ballot_id_t ballot_id;          /**< Ballot ID */
     ekk_module_id_t suspect_id;         /**< Module to quarantine */
+#if EKK_MODULE_ID_BITS > 8
+    uint8_t evidence;                   /**< EKK_QUARANTINE_EVIDENCE(type, witnesses) */
+    uint8_t evidence_hash[4];           /**< Hash of full evidence for verification */
+#else
     uint8_t evidence_type;              /**< ekk_evidence_type_t */
     uint8_t evidence_hash[4];           /**< Hash of full evidence for verification */
     uint8_t witness_count;              /**< Number of corroborating witnesses */
     uint8_t reserved;
+#endif
 } EKK_PACKED ekk_quarantine_proposal_msg_t;
 EKK_PACK_END
 
 EKK_STATIC_ASSERT(sizeof(ekk_quarantine_proposal_msg_t) <= 12, "Quarantine proposal too large");
 
+/** Pack evidence type (low nibble) and witness count (high nibble) */
+#define EKK_QUARANTINE_EVIDENCE(type, witnesses) \
+    ((uint8_t)(((type) & 0x0F) | ((witnesses) << 4)))
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,6 +25,7 @@
 #define EKK_FIELD_H
 
 #include "ekk_types.h"
+#include "ekk_idmap.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -47,13 +48,24 @@ typedef enum {
  * @brief Field configuration per component
  */
 typedef struct {
-    ekk_fixed_t decay_tau;          /**< Decay time constant (Q16.16 seconds) */
+    ekk_fixed_t decay_tau;          /**< Decay time constant (Q16.16 seconds, 0 = EKK_FIELD_DECAY_TAU_US) */
     ekk_decay_model_t decay_model;  /**< Decay function */
     ekk_fixed_t min_value;          /**< Floor (clamp) */
     ekk_fixed_t max_value;          /**< Ceiling (clamp) */
     ekk_fixed_t default_value;      /**< Value when no data */
 } ekk_field_config_t;
 
+/**
+ * @brief Default component configuration (exponential, default tau, no clamp)
+ */
+#define EKK_FIELD_CONFIG_DEFAULT { \
+    .decay_tau = 0, \
+    .decay_model = EKK_DECAY_EXPONENTIAL, \
+    .min_value = INT32_MIN, \
+    .max_value = INT32_MAX, \
+    .default_value = 0, \
+}
+
 /* ============================================================================
  * COORDINATION FIELD WITH SEQUENCE COUNTER (LOCK-FREE CONSISTENCY)
  * ============================================================================ */
@@ -67,16 +79,94 @@ typedef struct {
  * - Reader checks sequence before/after read; retries if mismatched or odd
  *
  * This allows lock-free, wait-free reads with consistency guarantees.
+ *
+ * With EKK_CACHE_PAD_SLOTS each slot starts on a cache line and rounds
+ * up to whole lines, so a publish by one core does not invalidate the
+ * neighboring slot another core is reading.
  */
+#if EKK_CACHE_PAD_SLOTS
+typedef struct EKK_CACHE_ALIGNED {
+#else
 typedef struct {
+#endif
     ekk_field_t field;              /**< The actual field data */
     volatile uint32_t sequence;     /**< Sequence counter (odd = write in progress) */
 } ekk_coord_field_t;
 
+#if EKK_CACHE_PAD_SLOTS
+EKK_STATIC_ASSERT(sizeof(ekk_coord_field_t) % EKK_CACHE_LINE_SIZE == 0,
+                  "padded field slots must not share cache lines");
+#endif
+
 /* ============================================================================
  * FIELD ENGINE STATE
  * ============================================================================ */
 
+/*
+ * Slots: with 8-bit IDs slot n belongs to module n. With 16-bit IDs a
+ * module gets a slot from the region's ekk_idmap_t on its first publish
+ * and loses it when gc expires the field. Bitmaps (occupancy, expiry
+ * wheel) and change epochs are always per slot.
+ *
+ * Change tracking: every publish or expiry stamps the slot with the next
+ * change_epoch, and its 32-slot group's word_epoch with the same value.
+ * The slot's bit is also set in the journal bucket of that epoch span.
+ * A consumer remembers the last epoch it saw and ORs the journal buckets
+ * since; if those have been reused it collects the slots stamped later
+ * instead, skipping groups whose word_epoch is not newer.
+ */
+
+/** Words in a one-bit-per-slot bitmask */
+#define EKK_FIELD_FLAG_WORDS    ((EKK_MAX_MODULES + 31) / 32)
+
+#if EKK_FIELD_LAYOUT_SOA
+
+/**
+ * @brief Seqlock padded to a full cache line
+ *
+ * Writers to different slots never share a line, so a publish on one
+ * core does not invalidate the sequence another core is polling.
+ */
+typedef struct {
+    volatile uint32_t sequence;     /**< Sequence counter (odd = write in progress) */
+    uint8_t _pad[EKK_CACHE_LINE_SIZE - sizeof(uint32_t)];
+} ekk_field_seqlock_t;
+
+EKK_STATIC_ASSERT(sizeof(ekk_field_seqlock_t) == EKK_CACHE_LINE_SIZE,
+                  "seqlock must occupy exactly one cache line");
+
+/**
+ * @brief Shared field region, structure-of-arrays layout
+ *
+ * Each component is a contiguous array indexed by slot, so a scan
+ * over one component (e.g. EKK_FIELD_SLACK across the cluster) touches
+ * only that component's cache lines. Selected with EKK_FIELD_LAYOUT_SOA.
+ *
+ * Not the default: the library reads whole fields (sample, snapshot,
+ * sample_neighbors), which SoA spreads over the component arrays, and the
+ * padded seqlocks grow the region by about 40%. bench_field_{aos,soa}
+ * measure both layouts on the target.
+ */
+typedef struct {
+    ekk_fixed_t components[EKK_FIELD_COUNT][EKK_MAX_MODULES]; /**< Per-component values */
+    ekk_time_us_t timestamps[EKK_MAX_MODULES];  /**< Publish timestamps */
+    ekk_module_id_t sources[EKK_MAX_MODULES];   /**< Source ID (invalid = empty slot) */
+    ekk_field_seqlock_t seqlocks[EKK_MAX_MODULES]; /**< Per-slot seqlocks */
+    volatile uint32_t occupied[EKK_FIELD_FLAG_WORDS];     /**< Slots holding a published field */
+    uint32_t expiry_wheel[EKK_FIELD_WHEEL_SLOTS][EKK_FIELD_FLAG_WORDS]; /**< Slots by publish-time bucket */
+    uint32_t wheel_cursor;                     /**< First wheel tick gc has not finished */
+    volatile uint32_t change_epoch;            /**< Last change epoch handed out */
+    volatile uint32_t slot_epoch[EKK_MAX_MODULES]; /**< Epoch of each slot's last change */
+    volatile uint32_t word_epoch[EKK_FIELD_FLAG_WORDS]; /**< Newest slot_epoch per 32 slots */
+    volatile uint32_t change_journal[EKK_FIELD_CHANGE_BUCKETS][EKK_FIELD_FLAG_WORDS]; /**< Slots changed per epoch span */
+    ekk_time_us_t last_gc;                     /**< Last garbage collection */
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_t slots;                         /**< Module ID -> slot */
+#endif
+} ekk_field_region_t;
+
+#else
+
 /**
  * @brief Shared field region (one per cluster)
  *
@@ -84,13 +174,226 @@ typedef struct {
  * Placed in shared memory accessible by all modules.
  *
  * Uses ekk_coord_field_t for lock-free consistency via sequence counters.
+ * Array-of-structures layout (default): a slot's components, timestamp
+ * and seqlock share its cache lines.
  */
 typedef struct {
     ekk_coord_field_t fields[EKK_MAX_MODULES]; /**< Published fields with seqlock */
-    volatile uint32_t update_flags[(EKK_MAX_MODULES + 31) / 32]; /**< Bitmask of updated modules */
+    volatile uint32_t occupied[EKK_FIELD_FLAG_WORDS];     /**< Slots holding a published field */
+    uint32_t expiry_wheel[EKK_FIELD_WHEEL_SLOTS][EKK_FIELD_FLAG_WORDS]; /**< Slots by publish-time bucket */
+    uint32_t wheel_cursor;                     /**< First wheel tick gc has not finished */
+    volatile uint32_t change_epoch;            /**< Last change epoch handed out */
+    volatile uint32_t slot_epoch[EKK_MAX_MODULES]; /**< Epoch of each slot's last change */
+    volatile uint32_t word_epoch[EKK_FIELD_FLAG_WORDS]; /**< Newest slot_epoch per 32 slots */
+    volatile uint32_t change_journal[EKK_FIELD_CHANGE_BUCKETS][EKK_FIELD_FLAG_WORDS]; /**< Slots changed per epoch span */
     ekk_time_us_t last_gc;                     /**< Last garbage collection */
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_t slots;                         /**< Module ID -> slot */
+#endif
 } ekk_field_region_t;
 
+#endif /* EKK_FIELD_LAYOUT_SOA */
+
+/**
+ * @brief Slot holding a module's field
+ *
+ * @return Slot index, or -1 if the module has none
+ */
+static inline int32_t ekk_field_region_slot(const ekk_field_region_t *region,
+                                            ekk_module_id_t id)
+{
+#if EKK_MODULE_ID_BITS > 8
+    return ekk_idmap_find(&region->slots, id);
+#else
+    EKK_UNUSED(region);
+    return EKK_MODULE_ID_VALID(id) ? (int32_t)id : -1;
+#endif
+}
+
+/**
+ * @brief Raw slot sequence counter (layout independent)
+ */
+static inline uint32_t ekk_field_region_sequence(const ekk_field_region_t *region,
+                                                 uint32_t slot)
+{
+#if EKK_FIELD_LAYOUT_SOA
+    return region->seqlocks[slot].sequence;
+#else
+    return region->fields[slot].sequence;
+#endif
+}
+
+/**
+ * @brief Raw (undecayed) slot component value (layout independent)
+ */
+static inline ekk_fixed_t ekk_field_region_component(const ekk_field_region_t *region,
+                                                     uint32_t slot,
+                                                     ekk_field_component_t component)
+{
+#if EKK_FIELD_LAYOUT_SOA
+    return region->components[component][slot];
+#else
+    return region->fields[slot].field.components[component];
+#endif
+}
+
+/* ============================================================================
+ * CHANGE TRACKING
+ * ============================================================================ */
+
+/**
+ * @brief Per-consumer position in the region's change epochs
+ *
+ * Zero-initialize; the first ekk_field_changes_since() reports every
+ * module as changed.
+ */
+typedef struct {
+    uint32_t epoch;                 /**< Region change_epoch at last call */
+    bool synced;                    /**< False until the first call */
+} ekk_field_cursor_t;
+
+/**
+ * @brief Incremental aggregator entry (one per neighbor position)
+ */
+typedef struct {
+    ekk_module_id_t id;             /**< Neighbor ID (invalid = unused) */
+    bool present;                   /**< Currently contributes to the sums */
+    ekk_fixed_t weight;             /**< Health/distance weight in the sums */
+    ekk_time_us_t timestamp;        /**< Publish time of the cached snapshot */
+    ekk_time_us_t next_eval;        /**< Re-decay no later than this */
+    ekk_fixed_t raw[EKK_FIELD_COUNT];     /**< Published values */
+    ekk_fixed_t decayed[EKK_FIELD_COUNT]; /**< Values currently in the sums */
+} ekk_field_agg_entry_t;
+
+/**
+ * @brief Default drift tolerance before an unchanged neighbor is re-decayed
+ */
+#ifndef EKK_FIELD_AGG_TOLERANCE
+#define EKK_FIELD_AGG_TOLERANCE     (EKK_FIXED_ONE >> 6)    /* ~0.016 */
+#endif
+
+/**
+ * @brief Incremental neighbor aggregate
+ *
+ * Keeps running weighted sums and only touches neighbors that
+ * republished (per the region change history), changed weight, or whose
+ * decay has moved their value by more than the tolerance.
+ */
+typedef struct {
+    ekk_field_agg_entry_t entries[EKK_K_NEIGHBORS];
+    uint32_t count;                 /**< Neighbor positions in use */
+    int64_t sums[EKK_FIELD_COUNT];  /**< sum(decayed * weight), Q32.32 */
+    int64_t total_weight;           /**< sum(weight), Q16.16 */
+    ekk_field_cursor_t cursor;      /**< Last change epoch seen */
+    ekk_fixed_t tolerance;          /**< Max drift before re-decay (Q16.16) */
+    uint32_t evaluated;             /**< Stats: neighbor re-evaluations */
+    uint32_t skipped;               /**< Stats: neighbors left untouched */
+} ekk_field_aggregator_t;
+
+/* ============================================================================
+ * BULK SNAPSHOT
+ * ============================================================================ */
+
+/**
+ * @brief Seqlock attempts per slot before ekk_field_snapshot() skips it
+ */
+#ifndef EKK_FIELD_SNAPSHOT_RETRIES
+#define EKK_FIELD_SNAPSHOT_RETRIES  4
+#endif
+
+/**
+ * @brief One slot of a region snapshot
+ */
+typedef struct {
+    ekk_module_id_t id;             /**< Publishing module */
+    ekk_time_us_t age_us;           /**< Age at snapshot time */
+    ekk_field_t field;              /**< Published (undecayed) values */
+} ekk_field_snapshot_entry_t;
+
+/* ============================================================================
+ * SEGMENT HIERARCHY
+ * ============================================================================ */
+
+/**
+ * @brief Weight of the site-wide aggregate in a module's neighbor aggregate
+ *
+ * Modules in a segment see their k neighbors plus this share of the
+ * mean over all segment aggregates, so imbalance between racks reaches
+ * every module in two hops (gateway up, parent region down). Each level
+ * above blends in the level over it with the same weight.
+ */
+#ifndef EKK_FIELD_SEGMENT_WEIGHT
+#define EKK_FIELD_SEGMENT_WEIGHT    (EKK_FIXED_ONE >> 2)    /* 0.25 */
+#endif
+
+/**
+ * @brief Period at which a gateway republishes its segment aggregate
+ */
+#ifndef EKK_FIELD_SEGMENT_PERIOD_US
+#define EKK_FIELD_SEGMENT_PERIOD_US 10000   /* 10ms */
+#endif
+
+/**
+ * @brief One level of a segment hierarchy
+ *
+ * region holds the aggregates of the level below, keyed by the ID each
+ * publishes under; slot is the one this chain publishes under. up links
+ * to the level above (rack row, hall, site, ...) and is NULL at the
+ * root, so a hierarchy can be any number of levels deep. Levels are
+ * owned by the caller and must not form a loop.
+ */
+typedef struct ekk_field_level {
+    ekk_field_region_t *region;             /**< Aggregates of the level below */
+    ekk_module_id_t slot;                   /**< Our aggregate's slot in region */
+    const struct ekk_field_level *up;       /**< Level above (NULL = root) */
+} ekk_field_level_t;
+
+/* ============================================================================
+ * DEADBAND PUBLISHING
+ * ============================================================================ */
+
+/**
+ * @brief Default per-component publish deadband
+ */
+#ifndef EKK_FIELD_DEADBAND_DEFAULT
+#define EKK_FIELD_DEADBAND_DEFAULT  (EKK_FIXED_ONE >> 7)    /* ~0.008 */
+#endif
+
+/**
+ * @brief Default max silence as a fraction of the shortest decay tau
+ *
+ * Refreshing at tau/N keeps a steady publisher well inside the expiry
+ * horizon of every decay model (step and linear expire at tau).
+ */
+#ifndef EKK_FIELD_SILENCE_DIVISOR
+#define EKK_FIELD_SILENCE_DIVISOR   2
+#endif
+
+/**
+ * @brief Publish policy
+ */
+typedef struct {
+    ekk_fixed_t deadband[EKK_FIELD_COUNT];  /**< Max error tolerated per component (Q16.16) */
+    ekk_time_us_t max_silence_us;           /**< Forced refresh (0 = shortest tau / EKK_FIELD_SILENCE_DIVISOR) */
+} ekk_field_publish_policy_t;
+
+/**
+ * @brief Deadband publisher state (one per publishing module)
+ *
+ * Readers already extrapolate a slot with the component decay models, so
+ * the publisher predicts exactly what they see and only publishes once
+ * the prediction is off by more than the deadband, or the slot has been
+ * silent for max_silence_us.
+ */
+typedef struct {
+    ekk_field_publish_policy_t policy;
+    ekk_field_t last;               /**< Last published values */
+    ekk_time_us_t last_time;        /**< Last publish time */
+    bool valid;                     /**< Something has been published */
+    uint32_t sent;                  /**< Stats: publishes written */
+    uint32_t suppressed;            /**< Stats: publishes within deadband */
+} ekk_field_publisher_t;
+
 /* ============================================================================
  * FIELD API
  * ============================================================================ */
@@ -98,11 +401,57 @@ typedef struct {
 /**
  * @brief Initialize field engine
  *
+ * The engine is process-wide: one region and one decay configuration
+ * serve every module in the process (see ekk_module_t).
+ *
  * @param region Pointer to shared field region (must be in shared memory)
  * @return EKK_OK on success
  */
 ekk_error_t ekk_field_init(ekk_field_region_t *region);
 
+/**
+ * @brief Use an already initialized region without clearing it
+ *
+ * For regions shared with other processes (see ekk_hal_field_shm_open()).
+ * A zero-filled region is a valid empty region. Decay configuration is
+ * per process and reset to EKK_FIELD_CONFIG_DEFAULT.
+ *
+ * @param region Pointer to shared field region
+ * @return EKK_OK on success
+ */
+ekk_error_t ekk_field_attach(ekk_field_region_t *region);
+
+/**
+ * @brief Configure decay model, tau and clamps for one component
+ *
+ * Builds the component's decay evaluator (precomputed reciprocal plus a
+ * shared exp table), so sampling costs one lookup and a multiply per
+ * component. ekk_field_init() resets all components to
+ * EKK_FIELD_CONFIG_DEFAULT. Fields expire once older than the longest
+ * configured decay span (5*tau exponential, tau linear/step). Applies to
+ * every module in the process.
+ *
+ * @param component Component to configure
+ * @param config Configuration (copied)
+ * @return EKK_OK on success, EKK_ERR_INVALID_ARG if min > max or bad model
+ */
+ekk_error_t ekk_field_configure(ekk_field_component_t component,
+                                 const ekk_field_config_t *config);
+
+/**
+ * @brief Get current configuration for one component
+ */
+ekk_error_t ekk_field_get_config(ekk_field_component_t component,
+                                  ekk_field_config_t *config);
+
+/**
+ * @brief Decay factor for a component after elapsed_us (Q16.16, [0, 1])
+ *
+ * Deterministic integer evaluation, identical in the Rust port.
+ */
+ekk_fixed_t ekk_field_decay_factor(ekk_field_component_t component,
+                                    ekk_time_us_t elapsed_us);
+
 /**
  * @brief Publish module's coordination field
  *
@@ -132,6 +481,22 @@ ekk_error_t ekk_field_publish(ekk_module_id_t module_id,
 ekk_error_t ekk_field_sample(ekk_module_id_t target_id,
                               ekk_field_t *field);
 
+/**
+ * @brief Sample a single component of a module's field with decay applied
+ *
+ * Cheaper than ekk_field_sample() when scanning one component across
+ * many modules, especially with EKK_FIELD_LAYOUT_SOA.
+ *
+ * @param target_id Module to sample
+ * @param component Component to read
+ * @param[out] value Decayed component value
+ * @return EKK_OK on success, EKK_ERR_FIELD_EXPIRED if too old,
+ *         EKK_ERR_BUSY on a torn read
+ */
+ekk_error_t ekk_field_sample_component(ekk_module_id_t target_id,
+                                        ekk_field_component_t component,
+                                        ekk_fixed_t *value);
+
 /**
  * @brief Sample all k-neighbors and compute aggregate
  *
@@ -140,6 +505,9 @@ ekk_error_t ekk_field_sample(ekk_module_id_t target_id,
  * - Health state (healthy neighbors weighted higher)
  * - Logical distance (closer neighbors weighted higher)
  *
+ * All neighbor slots are snapshotted in one pass against a single time
+ * read, then accumulated with a SIMD kernel (see EKK_FIELD_SIMD).
+ *
  * @param module_id Requesting module
  * @param neighbors Array of neighbor info (from topology layer)
  * @param neighbor_count Number of neighbors
@@ -151,6 +519,199 @@ ekk_error_t ekk_field_sample_neighbors(ekk_module_id_t module_id,
                                         uint32_t neighbor_count,
                                         ekk_field_t *aggregate);
 
+/**
+ * @brief Collect modules that published since the cursor's last call
+ *
+ * Reports the slots stamped with a change epoch newer than the cursor's.
+ * Consumers do not affect each other, and one that falls behind still
+ * gets the exact set (each slot's newest change), however long it was
+ * away. A slot changing during the call may be reported again by the
+ * next one. Lock-free: publishers are not held up by readers.
+ *
+ * @param cursor Consumer cursor (updated)
+ * @param[out] changed EKK_FIELD_FLAG_WORDS words, bit n = slot n changed
+ *                     (see ekk_field_region_slot())
+ * @return Number of modules reported changed
+ */
+uint32_t ekk_field_changes_since(ekk_field_cursor_t *cursor, uint32_t *changed);
+
+/**
+ * @brief Initialize an incremental aggregator
+ *
+ * @param agg Aggregator
+ * @param tolerance Max drift (Q16.16) tolerated on an unchanged neighbor
+ */
+void ekk_field_aggregator_init(ekk_field_aggregator_t *agg, ekk_fixed_t tolerance);
+
+/**
+ * @brief Incrementally update the neighbor aggregate
+ *
+ * Same result as ekk_field_sample_neighbors() (to within the tolerance),
+ * but only re-reads neighbors that republished or changed weight, and
+ * only re-decays unchanged neighbors once their value may have drifted
+ * by more than the tolerance.
+ *
+ * @param agg Aggregator state
+ * @param neighbors Current neighbor list (from topology layer)
+ * @param neighbor_count Number of neighbors
+ * @param[out] aggregate Aggregated field
+ * @param[out] changed Set if the aggregate differs from the last call (may be NULL)
+ * @return EKK_OK on success
+ */
+ekk_error_t ekk_field_aggregate_update(ekk_field_aggregator_t *agg,
+                                        const ekk_neighbor_t *neighbors,
+                                        uint32_t neighbor_count,
+                                        ekk_field_t *aggregate,
+                                        bool *changed);
+
+/**
+ * @brief Copy every valid slot of the region in one sweep
+ *
+ * Walks the occupancy bitmap, so empty slots cost nothing, and takes the
+ * time once for the whole sweep. Each slot is copied under its seqlock
+ * (two sequence reads per attempt) with up to EKK_FIELD_SNAPSHOT_RETRIES
+ * attempts; expired slots are left out. Values are not decayed - use
+ * ekk_field_apply_decay(&entry.field, entry.age_us) for readers' view.
+ * Never allocates.
+ *
+ * @param[out] entries Caller buffer, filled in module ID order
+ * @param max_entries Buffer capacity
+ * @param[out] count Entries written
+ * @return EKK_OK, EKK_ERR_NO_MEMORY if the buffer filled up before the
+ *         sweep finished, EKK_ERR_BUSY if a slot stayed torn and was skipped
+ */
+ekk_error_t ekk_field_snapshot(ekk_field_snapshot_entry_t *entries,
+                                uint32_t max_entries,
+                                uint32_t *count);
+
+/**
+ * @brief Initialize a parent (site-level) region of segment aggregates
+ *
+ * Same layout as the module region, indexed by segment ID instead of
+ * module ID. Unlike ekk_field_init() it does not become the region that
+ * ekk_field_publish()/sample() operate on.
+ *
+ * @param parent Region to clear
+ * @return EKK_OK on success
+ */
+ekk_error_t ekk_field_parent_init(ekk_field_region_t *parent);
+
+/**
+ * @brief Aggregate every valid field in this segment's region
+ *
+ * Unweighted mean of all current (decayed) module fields. Run by the
+ * segment gateway before ekk_field_segment_publish().
+ *
+ * @param[out] aggregate Segment mean
+ * @param[out] module_count Modules contributing (may be NULL)
+ * @return EKK_OK, EKK_ERR_NOT_FOUND if no module has a valid field
+ */
+ekk_error_t ekk_field_segment_aggregate(ekk_field_t *aggregate, uint32_t *module_count);
+
+/**
+ * @brief Publish a segment aggregate into the parent region
+ *
+ * @param parent Parent region
+ * @param segment_id Segment slot (1..EKK_MAX_MODULES-1)
+ * @param aggregate Segment aggregate
+ * @return EKK_OK on success
+ */
+ekk_error_t ekk_field_segment_publish(ekk_field_region_t *parent,
+                                       ekk_module_id_t segment_id,
+                                       const ekk_field_t *aggregate);
+
+/**
+ * @brief Sample the site-wide aggregate from the parent region
+ *
+ * Mean over all segments with a current aggregate, each decayed by its
+ * age like a module field.
+ *
+ * @param parent Parent region
+ * @param[out] site Site-wide mean
+ * @param[out] segment_count Segments contributing (may be NULL)
+ * @return EKK_OK, EKK_ERR_NOT_FOUND if no segment has a current aggregate
+ */
+ekk_error_t ekk_field_sample_site(const ekk_field_region_t *parent,
+                                   ekk_field_t *site,
+                                   uint32_t *segment_count);
+
+/**
+ * @brief Publish an aggregate at a level and carry it up to the root
+ *
+ * Writes aggregate into level's slot, then the mean of level's region
+ * into the slot of the level above, and so on up the chain.
+ *
+ * @param level Lowest level to publish at
+ * @param aggregate Aggregate of the level below (e.g. ekk_field_segment_aggregate())
+ * @return EKK_OK, or the first error from ekk_field_segment_publish()
+ */
+ekk_error_t ekk_field_level_publish(const ekk_field_level_t *level,
+                                     const ekk_field_t *aggregate);
+
+/**
+ * @brief Sample a level with every level above it blended in
+ *
+ * The mean of level's region, lerped towards the view of the level
+ * above by EKK_FIELD_SEGMENT_WEIGHT, recursively up to the root. A
+ * level with no current aggregate passes the view from above through.
+ *
+ * @param level Level to sample from
+ * @param[out] view Blended aggregate
+ * @param[out] count Aggregates contributing over all levels (may be NULL)
+ * @return EKK_OK, EKK_ERR_NOT_FOUND if no level has a current aggregate
+ */
+ekk_error_t ekk_field_sample_levels(const ekk_field_level_t *level,
+                                     ekk_field_t *view,
+                                     uint32_t *count);
+
+/**
+ * @brief Initialize a deadband publisher
+ *
+ * @param pub Publisher
+ * @param policy Policy (copied), NULL = EKK_FIELD_DEADBAND_DEFAULT on
+ *               every component and the default max silence
+ */
+void ekk_field_publisher_init(ekk_field_publisher_t *pub,
+                               const ekk_field_publish_policy_t *policy);
+
+/**
+ * @brief Publish only if readers' extrapolation would be off
+ *
+ * Decays the last published values by their age (the same evaluation
+ * readers apply) and publishes when any component differs from the
+ * current value by more than its deadband, or when max silence has
+ * elapsed. Suppressed calls touch neither the region nor the transport.
+ *
+ * @param pub Publisher state
+ * @param module_id Publishing module's ID
+ * @param field Current field values
+ * @param[out] sent Set if the field was published (may be NULL)
+ * @return EKK_OK on success (published or suppressed)
+ */
+ekk_error_t ekk_field_publish_delta(ekk_field_publisher_t *pub,
+                                     ekk_module_id_t module_id,
+                                     const ekk_field_t *field,
+                                     bool *sent);
+
+/**
+ * @brief Time by which ekk_field_publish_delta() must be called again
+ *
+ * When max silence after the last publish runs out (0 before the first
+ * publish). Decay can carry readers' extrapolation past a deadband
+ * sooner; callers that sleep until this time should cap the sleep.
+ *
+ * @param pub Publisher state
+ * @return Absolute time in microseconds, UINT64_MAX if pub is NULL
+ */
+ekk_time_us_t ekk_field_publisher_next_deadline(const ekk_field_publisher_t *pub);
+
+/**
+ * @brief Name of the aggregation kernel selected at compile time
+ *
+ * @return "avx2", "sse2", "neon" or "scalar"
+ */
+const char* ekk_field_kernel_name(void);
+
 /**
  * @brief Compute gradient for a specific field component
  *
@@ -190,6 +751,9 @@ void ekk_field_gradient_all(const ekk_field_t *my_field,
 /**
  * @brief Apply decay to a field based on elapsed time
  *
+ * Uses each component's configured model and tau, then clamps to its
+ * min/max (see ekk_field_configure()).
+ *
  * @param field Field to decay (modified in place)
  * @param elapsed_us Microseconds since field was published
  */
@@ -198,7 +762,10 @@ void ekk_field_apply_decay(ekk_field_t *field, ekk_time_us_t elapsed_us);
 /**
  * @brief Garbage collect expired fields
  *
- * Marks fields older than max_age as invalid.
+ * Marks fields older than max_age as invalid and removes them from the
+ * occupancy bitmap. Publish files each slot in an expiry wheel bucket by
+ * timestamp, so gc only visits buckets that have come due since the
+ * last call instead of sweeping the region.
  * Called periodically by kernel.
  *
  * @param max_age_us Maximum field age in microseconds
@@ -108,11 +108,15 @@ typedef enum {
  * EVENT V2 (Extended format with origin tracking)
  * ============================================================================ */
 
+/** Event v2 payload bytes */
+#define EKK_EVENT_V2_PAYLOAD        (20 - EKK_MODULE_ID_WIRE_EXTRA)
+
 /**
  * @brief Extended event format for gossip protocol
  *
  * 36 bytes total (vs 32 bytes for v1 events).
- * Adds origin tracking for causality and deduplication.
+ * Adds origin tracking for causality and deduplication. With 16-bit
+ * module IDs the payload gives up a byte to the origin ID.
  */
 EKK_PACK_BEGIN
 typedef struct EKK_PACKED {
@@ -120,10 +124,10 @@ typedef struct EKK_PACKED {
     uint32_t timestamp_us;          /**< Event timestamp */
     uint8_t  event_type;            /**< Event type code */
     uint8_t  flags;                 /**< Event flags */
-    uint8_t  origin_id;             /**< Original emitter module */
+    ekk_module_id_t origin_id;      /**< Original emitter module */
     uint8_t  hop_count;             /**< Hops from origin (TTL) */
     uint32_t origin_seq;            /**< Sequence at origin module */
-    uint8_t  payload[20];           /**< Event payload */
+    uint8_t  payload[EKK_EVENT_V2_PAYLOAD]; /**< Event payload */
 } ekk_event_v2_t;
 EKK_PACK_END
 
@@ -156,7 +160,7 @@ EKK_STATIC_ASSERT(sizeof(ekk_event_v2_t) == 36, "Event v2 must be 36 bytes");
  */
 typedef struct {
     uint32_t timestamp_us;          /**< Timestamp (higher wins) */
-    uint8_t  origin_id;             /**< Tiebreaker (higher wins) */
+    ekk_module_id_t origin_id;      /**< Tiebreaker (higher wins) */
 } ekk_lww_timestamp_t;
 
 /* ============================================================================
@@ -178,43 +182,154 @@ typedef struct {
  *
  * Carries up to 2 events plus version vector summary.
  * Total: 1 + 1 + 1 + 7 + 72 = 82 bytes (fits in CAN-FD 64-byte with fragmentation)
+ *
+ * With 16-bit module IDs the count byte goes to the source ID: the
+ * frame is sent truncated after the last event and the count follows
+ * from its length (see ekk_gossip_msg_events()).
  */
 EKK_PACK_BEGIN
 typedef struct EKK_PACKED {
     uint8_t msg_type;               /**< EKK_MSG_EVENT_GOSSIP */
-    uint8_t source_module;          /**< Sender module ID */
+    ekk_module_id_t source_module;  /**< Sender module ID */
+#if EKK_MODULE_ID_BITS == 8
     uint8_t event_count;            /**< Number of events (1-2) */
+#endif
     ekk_vv_summary_t vv_summary;    /**< Compressed version vector */
     ekk_event_v2_t events[EKK_GOSSIP_BATCH_SIZE];
 } ekk_gossip_msg_t;
 EKK_PACK_END
 
+/** @brief Gossip message bytes before the first event */
+#define EKK_GOSSIP_MSG_HEADER       (offsetof(ekk_gossip_msg_t, events))
+
+/** @brief Gossip message length carrying n events (16-bit ID wire format) */
+#define EKK_GOSSIP_MSG_LEN(n)       (EKK_GOSSIP_MSG_HEADER + (n) * sizeof(ekk_event_v2_t))
+
 /**
  * @brief Event acknowledgment message
+ *
+ * With 16-bit module IDs the count byte goes to the source ID and the
+ * count follows from the frame length (see ekk_gossip_ack_count()).
  */
 EKK_PACK_BEGIN
 typedef struct EKK_PACKED {
     uint8_t msg_type;               /**< EKK_MSG_EVENT_ACK */
-    uint8_t source_module;          /**< Acknowledging module */
+    ekk_module_id_t source_module;  /**< Acknowledging module */
+#if EKK_MODULE_ID_BITS == 8
     uint8_t ack_count;              /**< Number of sequences acked */
+#endif
     uint32_t acked_seqs[4];         /**< Acknowledged origin sequences */
 } ekk_gossip_ack_t;
 EKK_PACK_END
 
+EKK_STATIC_ASSERT(sizeof(ekk_gossip_msg_t) == 10 + 36 * EKK_GOSSIP_BATCH_SIZE,
+                  "Gossip message size must not depend on the module ID width");
+EKK_STATIC_ASSERT(sizeof(ekk_gossip_ack_t) == 19,
+                  "Ack size must not depend on the module ID width");
+
+/**
+ * @brief Number of events in a received gossip message
+ *
+ * @param msg Received message
+ * @param len Received length
+ * @return Event count (0 if the frame is too short or malformed)
+ */
+static inline uint8_t ekk_gossip_msg_events(const ekk_gossip_msg_t *msg, uint32_t len)
+{
+#if EKK_MODULE_ID_BITS == 8
+    if (len < sizeof(ekk_gossip_msg_t) || msg->event_count > EKK_GOSSIP_BATCH_SIZE) {
+        return 0;
+    }
+    return msg->event_count;
+#else
+    (void)msg;
+    if (len < EKK_GOSSIP_MSG_HEADER) {
+        return 0;
+    }
+    uint32_t n = (len - (uint32_t)EKK_GOSSIP_MSG_HEADER) / (uint32_t)sizeof(ekk_event_v2_t);
+    return (uint8_t)((n > EKK_GOSSIP_BATCH_SIZE) ? EKK_GOSSIP_BATCH_SIZE : n);
+#endif
+}
+
+/**
+ * @brief Number of sequences in a received ack
+ *
+ * @param ack Received ack
+ * @param len Received length
+ * @return Acked sequence count (0 if the frame is too short)
+ */
+static inline uint8_t ekk_gossip_ack_count(const ekk_gossip_ack_t *ack, uint32_t len)
+{
+#if EKK_MODULE_ID_BITS == 8
+    if (len < sizeof(ekk_gossip_ack_t)) {
+        return 0;
+    }
+    return (ack->ack_count > 4) ? 4 : ack->ack_count;
+#else
+    (void)ack;
+    uint32_t header = (uint32_t)offsetof(ekk_gossip_ack_t, acked_seqs);
+    if (len < header) {
+        return 0;
+    }
+    uint32_t n = (len - header) / sizeof(uint32_t);
+    return (uint8_t)((n > 4) ? 4 : n);
+#endif
+}
+
 /**
  * @brief Event request message (gap fill)
+ *
+ * With 16-bit module IDs the two wider IDs take the reserved byte and
+ * the end of the range travels as a 16-bit count; larger gaps are
+ * requested in pieces. Use ekk_gossip_request_set_range() and
+ * ekk_gossip_request_to_seq() rather than the range fields.
  */
 EKK_PACK_BEGIN
 typedef struct EKK_PACKED {
     uint8_t msg_type;               /**< EKK_MSG_EVENT_REQUEST */
-    uint8_t requester;              /**< Requesting module */
-    uint8_t target_origin;          /**< Origin module for events */
+    ekk_module_id_t requester;      /**< Requesting module */
+    ekk_module_id_t target_origin;  /**< Origin module for events */
+#if EKK_MODULE_ID_BITS == 8
     uint8_t _reserved;
     uint32_t from_seq;              /**< First missing sequence */
     uint32_t to_seq;                /**< Last missing sequence */
+#else
+    uint32_t from_seq;              /**< First missing sequence */
+    uint16_t seq_count;             /**< Missing sequences from from_seq */
+    uint8_t _reserved;
+#endif
 } ekk_gossip_request_t;
 EKK_PACK_END
 
+EKK_STATIC_ASSERT(sizeof(ekk_gossip_request_t) == 12, "Request must be 12 bytes");
+
+/**
+ * @brief Set the requested range (to_seq >= from_seq)
+ */
+static inline void ekk_gossip_request_set_range(ekk_gossip_request_t *req,
+                                                uint32_t from_seq, uint32_t to_seq)
+{
+    req->from_seq = from_seq;
+#if EKK_MODULE_ID_BITS == 8
+    req->to_seq = to_seq;
+#else
+    uint32_t count = to_seq - from_seq + 1;
+    req->seq_count = (uint16_t)((count > 0xFFFF) ? 0xFFFF : count);
+#endif
+}
+
+/**
+ * @brief Last sequence of the requested range
+ */
+static inline uint32_t ekk_gossip_request_to_seq(const ekk_gossip_request_t *req)
+{
+#if EKK_MODULE_ID_BITS == 8
+    return req->to_seq;
+#else
+    return req->from_seq + req->seq_count - 1;
+#endif
+}
+
 /* ============================================================================
  * GOSSIP CONTEXT
  * ============================================================================ */
@@ -42,6 +42,9 @@ typedef enum {
     EKK_MSG_INHIBIT     = 0x06,     /**< Proposal inhibition */
     EKK_MSG_REFORM      = 0x07,     /**< Mesh reformation */
     EKK_MSG_SHUTDOWN    = 0x08,     /**< Graceful shutdown */
+    EKK_MSG_ECHO        = 0x09,     /**< Heartbeat echo (RTT probe) */
+    EKK_MSG_DECISION    = 0x0A,     /**< Consensus decision certificate */
+    EKK_MSG_VOTE_BATCH  = 0x0B,     /**< Votes for several ballots */
     EKK_MSG_USER_BASE   = 0x80,     /**< Application messages start here */
 } ekk_msg_type_t;
 
@@ -73,6 +76,20 @@ static inline uint32_t ekk_hal_time_ms(void)
  */
 void ekk_hal_delay_us(uint32_t us);
 
+/**
+ * @brief Free-running cycle counter for latency measurement
+ *
+ * The finest clock the platform has: DWT CYCCNT on Cortex-M, CNTVCT_EL0
+ * on Cortex-A53, the TSC on x86, CLOCK_MONOTONIC nanoseconds on POSIX.
+ * Wraps at 32 bits; take differences only. Not affected by mock time.
+ */
+uint32_t ekk_hal_cycles(void);
+
+/**
+ * @brief Convert a cycle count difference to nanoseconds
+ */
+uint32_t ekk_hal_cycles_to_ns(uint32_t cycles);
+
 /**
  * @brief Set mock time for testing (POSIX HAL only)
  *
@@ -126,6 +143,129 @@ ekk_error_t ekk_hal_recv(ekk_module_id_t *sender_id,
                           void *data,
                           uint32_t *len);
 
+/**
+ * @brief Received frame, viewed in place in the HAL rx ring
+ */
+typedef struct {
+    ekk_module_id_t sender_id;      /**< Sender's module ID */
+    ekk_msg_type_t msg_type;        /**< Message type */
+    const void *data;               /**< Payload (valid until ekk_hal_recv_release) */
+    uint32_t len;                   /**< Payload length */
+} ekk_hal_rx_view_t;
+
+/**
+ * @brief Look at the oldest received frame without copying it
+ *
+ * The frame stays at the head of the rx ring until
+ * ekk_hal_recv_release(). Ports without an in-place ring fall back to a
+ * weak default that stages one frame through ekk_hal_recv().
+ *
+ * @param[out] view Frame header and payload pointer
+ * @return EKK_OK if a frame is waiting, EKK_ERR_NOT_FOUND if none
+ */
+ekk_error_t ekk_hal_recv_peek(ekk_hal_rx_view_t *view);
+
+/**
+ * @brief Drop the frame returned by ekk_hal_recv_peek()
+ */
+void ekk_hal_recv_release(void);
+
+/**
+ * @brief Frames waiting in the rx ring (0 if the port cannot tell)
+ */
+uint32_t ekk_hal_rx_depth(void);
+
+/**
+ * @brief Frames lost to a full rx ring since ekk_hal_init()
+ */
+uint32_t ekk_hal_rx_overruns(void);
+
+/* ============================================================================
+ * ENDPOINTS (several modules behind one HAL)
+ * ============================================================================ */
+
+#ifndef EKK_HAL_ENDPOINT_DEPTH
+#define EKK_HAL_ENDPOINT_DEPTH  64      /**< Frames buffered per endpoint */
+#endif
+
+#ifndef EKK_HAL_ENDPOINT_MTU
+#define EKK_HAL_ENDPOINT_MTU    64      /**< Largest frame payload (multiple of 4) */
+#endif
+
+/**
+ * @brief One module's own attachment to the bus
+ *
+ * ekk_hal_send() and ekk_hal_recv() belong to the process: every frame
+ * is stamped with the one HAL module ID and lands in one rx ring. A host
+ * running several modules gives each an endpoint instead. Frames sent
+ * through an endpoint carry its ID, and each endpoint receives into its
+ * own ring the frames other endpoints (and ekk_hal_send()) address to
+ * it or broadcast.
+ *
+ * The caller owns the storage (about DEPTH * (MTU + 12) bytes) and must
+ * close it before it goes away. HALs without endpoint support fall back
+ * to weak defaults that map an endpoint onto the HAL's own send and rx
+ * ring, which is right for one module per HAL; the frame being looked
+ * at is still staged in the endpoint's own storage.
+ */
+typedef struct ekk_hal_endpoint {
+    ekk_module_id_t id;                     /**< Sender ID and address */
+    struct ekk_hal_endpoint *next;          /**< HAL's list of open endpoints */
+    volatile uint32_t head;                 /**< Next slot a sender fills */
+    volatile uint32_t tail;                 /**< Oldest unreleased frame */
+    uint32_t overruns;                      /**< Frames lost to a full ring */
+    struct {
+        uint32_t data[EKK_HAL_ENDPOINT_MTU / 4];    /**< Word aligned for in-place casts */
+        ekk_module_id_t sender_id;
+        ekk_msg_type_t msg_type;
+        uint32_t len;
+    } ring[EKK_HAL_ENDPOINT_DEPTH];
+} ekk_hal_endpoint_t;
+
+/**
+ * @brief Attach an endpoint to the bus
+ *
+ * @param ep Endpoint storage (cleared here)
+ * @param id Module ID it sends as and receives for
+ * @return EKK_OK, or EKK_ERR_INVALID_ARG
+ */
+ekk_error_t ekk_hal_endpoint_open(ekk_hal_endpoint_t *ep, ekk_module_id_t id);
+
+/**
+ * @brief Detach an endpoint; frames still queued are dropped
+ */
+void ekk_hal_endpoint_close(ekk_hal_endpoint_t *ep);
+
+/**
+ * @brief Send a frame as the endpoint's module
+ *
+ * @param dest_id Destination module, or EKK_BROADCAST_ID
+ * @return EKK_OK once handed to the bus. A full receiver ring counts an
+ *         overrun on that endpoint rather than failing the send.
+ */
+ekk_error_t ekk_hal_endpoint_send(ekk_hal_endpoint_t *ep,
+                                   ekk_module_id_t dest_id,
+                                   ekk_msg_type_t msg_type,
+                                   const void *data,
+                                   uint32_t len);
+
+/**
+ * @brief Look at the endpoint's oldest frame without copying it
+ *
+ * Same contract as ekk_hal_recv_peek(), for this endpoint's ring.
+ */
+ekk_error_t ekk_hal_endpoint_peek(ekk_hal_endpoint_t *ep, ekk_hal_rx_view_t *view);
+
+/**
+ * @brief Drop the frame returned by ekk_hal_endpoint_peek()
+ */
+void ekk_hal_endpoint_release(ekk_hal_endpoint_t *ep);
+
+/**
+ * @brief Frames waiting in the endpoint's ring
+ */
+uint32_t ekk_hal_endpoint_depth(ekk_hal_endpoint_t *ep);
+
 /**
  * @brief Message receive callback type
  */
@@ -139,6 +279,21 @@ typedef void (*ekk_hal_recv_cb)(ekk_module_id_t sender_id,
  */
 void ekk_hal_set_recv_callback(ekk_hal_recv_cb callback);
 
+/**
+ * @brief Sleep until a deadline or until a message is waiting
+ *
+ * Used by tickless runtimes between module ticks (see
+ * ekk_module_wait()). Returns at once if ekk_hal_recv() or an open
+ * endpoint has a message.
+ * POSIX sleeps on an eventfd signalled by sends (clock_nanosleep where
+ * there is none); with mock time the clock jumps to the deadline.
+ * Bare-metal ports program a timer compare and wait for an event.
+ *
+ * @param deadline Absolute time on the ekk_hal_time_us() clock
+ * @return EKK_OK if a message is waiting, EKK_ERR_TIMEOUT at the deadline
+ */
+ekk_error_t ekk_hal_wait_event(ekk_time_us_t deadline);
+
 /* ============================================================================
  * CRITICAL SECTIONS
  * ============================================================================ */
@@ -212,6 +367,72 @@ void* ekk_hal_get_field_region(void);
  */
 void ekk_hal_sync_field_region(void);
 
+/**
+ * @brief Place the field region in a named shared memory segment (POSIX HAL only)
+ *
+ * Call before ekk_init(). The first process creates the segment (zeroed
+ * region behind a versioned header); later processes attach after
+ * checking magic, version, EKK_MAX_MODULES and layout. Once attached,
+ * ekk_hal_field_lock() uses a process-shared mutex in the header and
+ * ekk_hal_time_us() uses the creator's time base, so slot timestamps
+ * compare across processes. Other critical sections stay per process.
+ *
+ * @param name Segment name, e.g. "/ekk-field" (leading slash required)
+ * @return EKK_OK, EKK_ERR_INVALID_ARG on geometry/version mismatch,
+ *         EKK_ERR_HAL_FAILURE if shm_open/mmap fail,
+ *         EKK_ERR_NOT_SUPPORTED on Windows
+ */
+ekk_error_t ekk_hal_field_shm_open(const char *name);
+
+/**
+ * @brief Unmap the shared segment and fall back to the static region (POSIX HAL only)
+ *
+ * @param unlink Also remove the segment name
+ */
+void ekk_hal_field_shm_close(bool unlink);
+
+/**
+ * @brief Is the field region mapped from a shared segment? (POSIX HAL only)
+ */
+bool ekk_hal_field_region_shared(void);
+
+/**
+ * @brief Change notification counter, bumped by ekk_hal_sync_field_region() (POSIX HAL only)
+ */
+uint32_t ekk_hal_field_notify_seq(void);
+
+/**
+ * @brief Block until the field region changes (POSIX HAL only)
+ *
+ * Sleeps on a futex over the notification counter (shared across
+ * processes when a segment is mapped). Publishers only make a syscall
+ * when someone is waiting.
+ *
+ * @param seen Counter value the caller has already handled
+ * @param timeout_us Maximum wait
+ * @return Current counter (== seen on timeout)
+ */
+uint32_t ekk_hal_field_wait(uint32_t seen, uint32_t timeout_us);
+
+/**
+ * @brief Lock the field region's bookkeeping (POSIX HAL only)
+ *
+ * Taken by the field engine for slot allocation, change stamping and
+ * gc, never for reads (those use the slot seqlocks). With a shared
+ * segment it is the robust process-shared mutex in the header, otherwise
+ * the ordinary critical section.
+ *
+ * @return State for ekk_hal_field_unlock()
+ */
+uint32_t ekk_hal_field_lock(void);
+
+/**
+ * @brief Release ekk_hal_field_lock() (POSIX HAL only)
+ *
+ * @param state State from ekk_hal_field_lock()
+ */
+void ekk_hal_field_unlock(uint32_t state);
+
 /* ============================================================================
  * PLATFORM INITIALIZATION
  * ============================================================================ */
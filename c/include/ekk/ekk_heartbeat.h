@@ -25,6 +25,8 @@
 #define EKK_HEARTBEAT_H
 
 #include "ekk_types.h"
+#include "ekk_idmap.h"
+#include "ekk_hal.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,6 +36,62 @@ extern "C" {
  * HEARTBEAT CONFIGURATION
  * ============================================================================ */
 
+/**
+ * @brief Use the phi-accrual detector by default (0 = missed-period count)
+ */
+#ifndef EKK_HEARTBEAT_PHI_ACCRUAL
+#define EKK_HEARTBEAT_PHI_ACCRUAL       0
+#endif
+
+/**
+ * @brief Default phi thresholds (Q16.16)
+ *
+ * phi = -log10(P(heartbeat still on its way)): phi 3 means a 1 in 1000
+ * chance that a live neighbor would be this late, phi 8 one in 10^8.
+ */
+#ifndef EKK_HEARTBEAT_PHI_SUSPECT
+#define EKK_HEARTBEAT_PHI_SUSPECT       (3 * EKK_FIXED_ONE)
+#endif
+
+#ifndef EKK_HEARTBEAT_PHI_DEAD
+#define EKK_HEARTBEAT_PHI_DEAD          (8 * EKK_FIXED_ONE)
+#endif
+
+/**
+ * @brief Floor on the inter-arrival standard deviation
+ *
+ * Keeps a perfectly regular bus from turning a little scheduling jitter
+ * into a failure.
+ */
+#ifndef EKK_HEARTBEAT_PHI_MIN_STD_US
+#define EKK_HEARTBEAT_PHI_MIN_STD_US    (EKK_HEARTBEAT_PERIOD_US / 10)
+#endif
+
+/**
+ * @brief Piggyback the heartbeat on other frames (module wiring)
+ *
+ * When set, modules append a heartbeat trailer to their discovery,
+ * proposal and decision broadcasts and to the votes, vote batches and
+ * echo frames they unicast. A period needs no explicit heartbeat if a
+ * trailer went out by broadcast, or by unicast to every tracked
+ * neighbor. Receivers take any frame from a tracked peer as liveness,
+ * credited to the transport-level sender.
+ */
+#ifndef EKK_HEARTBEAT_PIGGYBACK
+#define EKK_HEARTBEAT_PIGGYBACK         1
+#endif
+
+/** @brief Trailer appended to piggybacking frames: the heartbeat sequence */
+#define EKK_HEARTBEAT_TRAILER_SIZE      1
+
+/**
+ * @brief Set in a frame's first byte (its in-band msg_type) when a trailer follows
+ *
+ * Core message types stay below 0x80, so the bit is free; the length
+ * alone cannot tell a trailer from CAN-FD DLC padding.
+ */
+#define EKK_HEARTBEAT_TRAILER_FLAG      0x80u
+
 /**
  * @brief Heartbeat configuration
  */
@@ -41,7 +99,13 @@ typedef struct {
     ekk_time_us_t period;           /**< Heartbeat send period */
     uint32_t timeout_count;         /**< Missed beats before failure */
     bool auto_broadcast;            /**< Automatically broadcast heartbeats */
-    bool track_latency;             /**< Track RTT to neighbors */
+    bool track_latency;             /**< Probe RTT to tracked modules */
+
+    /* Phi-accrual detector (replaces timeout_count when enabled) */
+    bool phi_accrual;               /**< Classify by phi instead of missed periods */
+    ekk_fixed_t phi_suspect;        /**< Phi at which a neighbor is SUSPECT */
+    ekk_fixed_t phi_dead;           /**< Phi at which a neighbor is DEAD */
+    ekk_time_us_t phi_min_std;      /**< Inter-arrival std floor (us) */
 } ekk_heartbeat_config_t;
 
 #define EKK_HEARTBEAT_CONFIG_DEFAULT { \
@@ -49,6 +113,10 @@ typedef struct {
     .timeout_count = EKK_HEARTBEAT_TIMEOUT_COUNT, \
     .auto_broadcast = true, \
     .track_latency = false, \
+    .phi_accrual = EKK_HEARTBEAT_PHI_ACCRUAL, \
+    .phi_suspect = EKK_HEARTBEAT_PHI_SUSPECT, \
+    .phi_dead = EKK_HEARTBEAT_PHI_DEAD, \
+    .phi_min_std = EKK_HEARTBEAT_PHI_MIN_STD_US, \
 }
 
 /* ============================================================================
@@ -64,27 +132,78 @@ typedef struct {
     ekk_time_us_t last_seen;        /**< Last heartbeat received */
     uint8_t missed_count;           /**< Consecutive missed heartbeats */
     uint8_t sequence;               /**< Last seen sequence number */
-    ekk_time_us_t avg_latency;      /**< Average RTT (if tracking) */
+    ekk_time_us_t last_beat;        /**< First arrival of that sequence (0 = none since contact) */
+    ekk_time_us_t avg_latency;      /**< Smoothed RTT (0 = not measured) */
+
+    /* Inter-arrival statistics (EWMA, 1/8 weight; seeded from the period).
+     * One sample per new heartbeat sequence; other frames only prove liveness */
+    uint32_t arrival_mean;          /**< Mean heartbeat interval (us) */
+    uint32_t arrival_std;           /**< Std deviation, floored at phi_min_std (us) */
+    uint64_t arrival_var;           /**< Variance (us^2) */
+
+    /* Timeout scheduling */
+    ekk_time_us_t deadline;         /**< Next possible health change (if scheduled) */
+    uint16_t heap_pos;              /**< Position in deadline_heap (0xFFFF = none) */
+
+    uint32_t tx_period;             /**< Send period in which we last unicast it a trailer */
 } ekk_heartbeat_neighbor_t;
 
 /**
  * @brief Heartbeat engine state
+ *
+ * Seen neighbors sit in a min-heap keyed by the time their health could
+ * next change (last_seen plus the next threshold), so a tick only visits
+ * neighbors whose deadline has passed and a heartbeat reschedules its
+ * sender in O(log n). Thresholds are taken from the config when a
+ * neighbor is (re)scheduled.
  */
-typedef struct {
+typedef struct ekk_heartbeat {
     ekk_module_id_t my_id;
 
     ekk_heartbeat_neighbor_t neighbors[EKK_MAX_MODULES];
     uint32_t neighbor_count;
 
-    ekk_time_us_t last_send;        /**< Last heartbeat sent */
+    /* ID -> neighbors[] index */
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_t index_slots;                    /**< ID -> slot */
+    uint16_t slot_index[EKK_MAX_MODULES];       /**< Slot -> index */
+#else
+    uint16_t index_of[256];                     /**< ID -> index + 1 (0 = not tracked) */
+#endif
+
+    uint16_t deadline_heap[EKK_MAX_MODULES];    /**< neighbors[] indices, min-heap */
+    uint32_t deadline_count;
+
+    ekk_time_us_t last_send;        /**< Start of the current send period */
+    uint32_t send_period;           /**< Send periods started so far */
     uint8_t send_sequence;          /**< Outgoing sequence number */
 
+    /* RTT probing (track_latency): one echo outstanding at a time */
+    uint32_t probe_cursor;          /**< Next neighbor index to probe */
+    ekk_module_id_t probe_target;   /**< Module awaiting reply (or INVALID) */
+    uint8_t probe_token;            /**< Token of the outstanding probe */
+    ekk_time_us_t probe_sent;       /**< When the outstanding probe left */
+    ekk_time_us_t last_probe;       /**< Last probe sent */
+
+    /* Phi thresholds as normalized delays (t - mean) / std, from init */
+    ekk_fixed_t phi_y_suspect;
+    ekk_fixed_t phi_y_dead;
+
     ekk_heartbeat_config_t config;
 
-    /* Callbacks */
+    /* Callbacks (ekk_heartbeat_set_callbacks; no instance argument) */
     void (*on_neighbor_alive)(ekk_module_id_t id);
     void (*on_neighbor_suspect)(ekk_module_id_t id);
     void (*on_neighbor_dead)(ekk_module_id_t id);
+    void (*on_latency)(ekk_module_id_t id, ekk_time_us_t avg_rtt);
+
+    /* Per-instance callbacks (ekk_heartbeat_set_instance_callbacks) */
+    void (*inst_alive)(struct ekk_heartbeat *hb, ekk_module_id_t id);
+    void (*inst_suspect)(struct ekk_heartbeat *hb, ekk_module_id_t id);
+    void (*inst_dead)(struct ekk_heartbeat *hb, ekk_module_id_t id);
+    void (*inst_latency)(struct ekk_heartbeat *hb, ekk_module_id_t id, ekk_time_us_t avg_rtt);
+
+    ekk_hal_endpoint_t *endpoint;   /**< Send through this endpoint (NULL = the HAL's own) */
 } ekk_heartbeat_t;
 
 /* ============================================================================
@@ -127,7 +246,9 @@ ekk_error_t ekk_heartbeat_remove_neighbor(ekk_heartbeat_t *hb,
  * @brief Process received heartbeat
  *
  * Called when heartbeat message received from neighbor.
- * Updates neighbor's health state.
+ * Updates neighbor's health state. The first arrival of each new
+ * sequence feeds the inter-arrival statistics; repeats (trailers on
+ * further frames in the same period) only refresh liveness.
  *
  * @param hb Heartbeat state
  * @param sender_id Sender's module ID
@@ -140,10 +261,98 @@ ekk_error_t ekk_heartbeat_received(ekk_heartbeat_t *hb,
                                     uint8_t sequence,
                                     ekk_time_us_t now);
 
+/**
+ * @brief Process any other frame from a tracked module
+ *
+ * Implicit liveness: a frame the receive path accepted from a peer is as
+ * good as a heartbeat. Frames that carry the heartbeat trailer should go
+ * through ekk_heartbeat_received() with the trailer's sequence instead.
+ *
+ * @param hb Heartbeat state
+ * @param sender_id Sender's module ID
+ * @param now Current timestamp
+ * @return EKK_OK on success
+ */
+ekk_error_t ekk_heartbeat_seen(ekk_heartbeat_t *hb,
+                                ekk_module_id_t sender_id,
+                                ekk_time_us_t now);
+
+/**
+ * @brief Broadcast a frame with the heartbeat trailer appended
+ *
+ * The frame's first byte (its in-band msg_type) gets
+ * EKK_HEARTBEAT_TRAILER_FLAG. On success the frame stands in for this
+ * period's explicit heartbeat. With hb NULL (no heartbeat engine wired)
+ * or EKK_HEARTBEAT_PIGGYBACK 0 the frame goes out as is. Either way it
+ * leaves through hb->endpoint when one is set.
+ *
+ * @param hb Heartbeat state (or NULL)
+ * @param msg_type Message type
+ * @param data Frame payload
+ * @param len Payload length in bytes
+ * @param now Current timestamp
+ * @return Result of the send
+ */
+ekk_error_t ekk_heartbeat_piggyback(ekk_heartbeat_t *hb,
+                                     ekk_msg_type_t msg_type,
+                                     const void *data,
+                                     uint32_t len,
+                                     ekk_time_us_t now);
+
+/**
+ * @brief Unicast a frame with the heartbeat trailer appended
+ *
+ * Covers the destination for this period; the explicit heartbeat is
+ * skipped once every tracked neighbor is covered. The trailer repeats
+ * the current sequence, which advances once per period. EKK_BROADCAST_ID
+ * goes through ekk_heartbeat_piggyback().
+ *
+ * @param hb Heartbeat state (or NULL to send the frame as is)
+ * @param dest_id Destination module
+ * @param msg_type Message type
+ * @param data Frame payload
+ * @param len Payload length in bytes
+ * @param now Current timestamp
+ * @return Result of the send
+ */
+ekk_error_t ekk_heartbeat_piggyback_to(ekk_heartbeat_t *hb,
+                                        ekk_module_id_t dest_id,
+                                        ekk_msg_type_t msg_type,
+                                        const void *data,
+                                        uint32_t len,
+                                        ekk_time_us_t now);
+
+/**
+ * @brief Find the heartbeat trailer in a received frame
+ *
+ * @param data Frame payload
+ * @param len Received length (may include padding)
+ * @param body_len Length of the message body the trailer follows
+ * @param[out] sequence Sender's heartbeat sequence
+ * @return true if the frame is flagged and long enough to hold a trailer
+ */
+static inline bool ekk_heartbeat_trailer(const void *data, uint32_t len,
+                                         uint32_t body_len, uint8_t *sequence)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    if (body_len == 0 || len < body_len + EKK_HEARTBEAT_TRAILER_SIZE ||
+        (bytes[0] & EKK_HEARTBEAT_TRAILER_FLAG) == 0) {
+        return false;
+    }
+    *sequence = bytes[body_len];
+    return true;
+}
+
 /**
  * @brief Periodic tick
  *
- * Checks for timeouts and sends heartbeats if auto_broadcast enabled.
+ * Checks for timeouts and sends heartbeats if auto_broadcast enabled,
+ * unless this period a trailer went out by broadcast or reached every
+ * tracked neighbor by unicast.
+ * With phi_accrual, a neighbor is SUSPECT/DEAD once its phi crosses the
+ * configured level; otherwise after 1/timeout_count whole missed periods.
+ * With track_latency, also sends one echo probe per period, to the
+ * tracked modules in turn.
  *
  * @param hb Heartbeat state
  * @param now Current timestamp
@@ -151,6 +360,18 @@ ekk_error_t ekk_heartbeat_received(ekk_heartbeat_t *hb,
  */
 uint32_t ekk_heartbeat_tick(ekk_heartbeat_t *hb, ekk_time_us_t now);
 
+/**
+ * @brief Earliest time at which ekk_heartbeat_tick() has work to do
+ *
+ * The soonest of: a neighbor health deadline, the next auto_broadcast
+ * heartbeat and the next latency probe. Ticking earlier is harmless
+ * but finds nothing to do.
+ *
+ * @param hb Heartbeat state
+ * @return Absolute time in microseconds, UINT64_MAX if nothing is pending
+ */
+ekk_time_us_t ekk_heartbeat_next_deadline(const ekk_heartbeat_t *hb);
+
 /**
  * @brief Send heartbeat now
  *
@@ -161,6 +382,14 @@ uint32_t ekk_heartbeat_tick(ekk_heartbeat_t *hb, ekk_time_us_t now);
  */
 ekk_error_t ekk_heartbeat_send(ekk_heartbeat_t *hb);
 
+/**
+ * @brief Get smoothed RTT to a tracked module
+ *
+ * @return Smoothed RTT in microseconds, 0 if not measured or not tracked
+ */
+ekk_time_us_t ekk_heartbeat_get_latency(const ekk_heartbeat_t *hb,
+                                         ekk_module_id_t neighbor_id);
+
 /**
  * @brief Get neighbor health state
  *
@@ -171,6 +400,22 @@ ekk_error_t ekk_heartbeat_send(ekk_heartbeat_t *hb);
 ekk_health_state_t ekk_heartbeat_get_health(const ekk_heartbeat_t *hb,
                                              ekk_module_id_t neighbor_id);
 
+/**
+ * @brief Get a neighbor's phi-accrual suspicion level
+ *
+ * phi = -log10 of the probability that a live neighbor's next heartbeat
+ * would arrive later than now, given its inter-arrival mean and std.
+ * Available whether or not phi_accrual drives the health state.
+ *
+ * @param hb Heartbeat state
+ * @param neighbor_id Neighbor to query
+ * @param now Current timestamp
+ * @return phi in Q16.16, 0 if not tracked or never seen
+ */
+ekk_fixed_t ekk_heartbeat_get_phi(const ekk_heartbeat_t *hb,
+                                   ekk_module_id_t neighbor_id,
+                                   ekk_time_us_t now);
+
 /**
  * @brief Get time since last heartbeat
  *
@@ -197,24 +442,93 @@ typedef struct {
     uint8_t neighbor_count;         /**< Sender's neighbor count */
     uint8_t load_percent;           /**< Load 0-100% */
     uint8_t thermal_percent;        /**< Thermal 0-100% */
-    uint8_t flags;                  /**< Reserved */
+#if EKK_MODULE_ID_BITS == 8
+    uint8_t flags;                  /**< Reserved (taken by sender_id with 16-bit IDs) */
+#endif
 } EKK_PACKED ekk_heartbeat_msg_t;
 EKK_PACK_END
 
 EKK_STATIC_ASSERT(sizeof(ekk_heartbeat_msg_t) == 8, "Heartbeat message wrong size");
 
+/**
+ * @brief Echo message (unicast RTT probe and its reply)
+ */
+EKK_PACK_BEGIN
+typedef struct {
+    uint8_t msg_type;               /**< EKK_MSG_ECHO */
+    ekk_module_id_t sender_id;      /**< Sender's module ID */
+    ekk_module_id_t target_id;      /**< Module asked to reply / original prober */
+    uint8_t token;                  /**< Probe token, copied into the reply */
+    uint8_t reply;                  /**< 0 = request, 1 = reply */
+} EKK_PACKED ekk_echo_msg_t;
+EKK_PACK_END
+
+EKK_STATIC_ASSERT(sizeof(ekk_echo_msg_t) <= 8, "Echo message too large");
+
+/**
+ * @brief Process a received echo message
+ *
+ * Requests are answered immediately with a reply carrying the same token.
+ * A reply matching the outstanding probe yields an RTT sample, folded into
+ * the module's smoothed RTT (EWMA, 1/8 weight) and reported through the
+ * latency callback.
+ *
+ * @param hb Heartbeat state
+ * @param msg Received echo message
+ * @param now Current timestamp
+ * @return EKK_OK on success, EKK_ERR_NOT_FOUND if a reply matched no probe
+ */
+ekk_error_t ekk_heartbeat_on_echo(ekk_heartbeat_t *hb,
+                                   const ekk_echo_msg_t *msg,
+                                   ekk_time_us_t now);
+
 /* ============================================================================
  * CALLBACKS
  * ============================================================================ */
 
+/**
+ * @brief Health state change callback (per instance)
+ */
+typedef void (*ekk_heartbeat_cb)(ekk_heartbeat_t *hb, ekk_module_id_t id);
+
+/**
+ * @brief Smoothed RTT update callback (per instance)
+ */
+typedef void (*ekk_heartbeat_latency_cb)(ekk_heartbeat_t *hb, ekk_module_id_t id,
+                                         ekk_time_us_t avg_rtt);
+
 /**
  * @brief Set callbacks for health state changes
+ *
+ * The callbacks are not told which engine fired, so they only suit a
+ * process with a single heartbeat engine. Hosts running several use
+ * ekk_heartbeat_set_instance_callbacks(). Both sets may be installed;
+ * each fires.
  */
 void ekk_heartbeat_set_callbacks(ekk_heartbeat_t *hb,
                                   void (*on_alive)(ekk_module_id_t),
                                   void (*on_suspect)(ekk_module_id_t),
                                   void (*on_dead)(ekk_module_id_t));
 
+/**
+ * @brief Set callback for smoothed RTT updates (track_latency)
+ */
+void ekk_heartbeat_set_latency_callback(ekk_heartbeat_t *hb,
+                                         void (*on_latency)(ekk_module_id_t,
+                                                            ekk_time_us_t));
+
+/**
+ * @brief Set callbacks that receive the engine that fired them
+ *
+ * For several engines in one process: the owner recovers itself from hb
+ * (e.g. with EKK_CONTAINER_OF). Any callback may be NULL.
+ */
+void ekk_heartbeat_set_instance_callbacks(ekk_heartbeat_t *hb,
+                                           ekk_heartbeat_cb on_alive,
+                                           ekk_heartbeat_cb on_suspect,
+                                           ekk_heartbeat_cb on_dead,
+                                           ekk_heartbeat_latency_cb on_latency);
+
 #ifdef __cplusplus
 }
 #endif
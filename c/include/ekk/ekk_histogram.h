@@ -0,0 +1,122 @@
+/**
+ * @file ekk_histogram.h
+ * @brief EK-KOR v2 - Fixed-Memory Latency Histograms
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ * @license MIT
+ *
+ * Log-bucketed histograms for tick phase and task latencies, recorded in
+ * HAL cycle counts (see ekk_hal_cycles()). Each power-of-two octave is
+ * split into 2^EKK_HIST_SUB_BITS linear sub-buckets, so a percentile is
+ * off by at most one sub-bucket width (25% with the default of 2 bits).
+ * Min and max are exact. Recording is a couple of shifts and an
+ * increment; no allocation, no floating point. Memory is fixed at
+ * EKK_HIST_SIZE bytes per histogram; each fewer EKK_HIST_MAX_BITS saves
+ * 2^EKK_HIST_SUB_BITS buckets (16 bytes at the default).
+ */
+
+#ifndef EKK_HISTOGRAM_H
+#define EKK_HISTOGRAM_H
+
+#include "ekk_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * CONFIGURATION
+ * ============================================================================ */
+
+/**
+ * @brief Record tick phase and task latency histograms in modules
+ *
+ * RAM: one histogram (EKK_HIST_SIZE, 380 bytes with the defaults) per
+ * tick phase and per task slot, i.e. (EKK_PHASE_COUNT +
+ * EKK_MAX_TASKS_PER_MODULE) * EKK_HIST_SIZE per module. That is about
+ * 6 KB at the default 8 tasks and 15 KB with the RPi3 build's 32.
+ * Off by default on the MCU targets (STM32G474, EFR32MG24, TriCore),
+ * where that is a large share of SRAM; define it to 1 there to profile.
+ * 0 also drops the cycle counter reads from ekk_module_tick().
+ */
+#ifndef EKK_LATENCY_STATS
+#if defined(EKK_PLATFORM_STM32G474) || defined(EKK_PLATFORM_EFR32MG24) || \
+    defined(EKK_PLATFORM_TRICORE)
+#define EKK_LATENCY_STATS           0
+#else
+#define EKK_LATENCY_STATS           1
+#endif
+#endif
+
+/** Linear sub-buckets per octave (log2) */
+#ifndef EKK_HIST_SUB_BITS
+#define EKK_HIST_SUB_BITS           2
+#endif
+
+/** Largest resolved value (log2); anything above lands in the last bucket */
+#ifndef EKK_HIST_MAX_BITS
+#define EKK_HIST_MAX_BITS           24
+#endif
+
+/** Bucket count */
+#define EKK_HIST_BUCKETS \
+    ((EKK_HIST_MAX_BITS - EKK_HIST_SUB_BITS + 1) << EKK_HIST_SUB_BITS)
+
+/** Bytes per histogram: count, min, max and the buckets (380 by default) */
+#define EKK_HIST_SIZE               (4 * (3 + EKK_HIST_BUCKETS))
+
+/* ============================================================================
+ * HISTOGRAM
+ * ============================================================================ */
+
+/**
+ * @brief Log-bucketed histogram
+ */
+typedef struct {
+    uint32_t count;                         /**< Samples recorded */
+    uint32_t min;                           /**< Smallest sample (valid if count > 0) */
+    uint32_t max;                           /**< Largest sample */
+    uint32_t buckets[EKK_HIST_BUCKETS];
+} ekk_histogram_t;
+
+/**
+ * @brief Latency summary
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t p999;                          /**< 99.9th percentile */
+} ekk_latency_summary_t;
+
+/**
+ * @brief Clear all samples
+ */
+void ekk_histogram_reset(ekk_histogram_t *hist);
+
+/**
+ * @brief Record one sample
+ */
+void ekk_histogram_record(ekk_histogram_t *hist, uint32_t value);
+
+/**
+ * @brief Value below which a fraction of the samples fall
+ *
+ * @param ppm Fraction in parts per million (990000 = p99)
+ * @return Upper bound of the bucket holding that sample, clamped to
+ *         [min, max]; 0 if empty
+ */
+uint32_t ekk_histogram_quantile(const ekk_histogram_t *hist, uint32_t ppm);
+
+/**
+ * @brief Count, min, max, p50, p99 and p99.9 (same units as recorded)
+ */
+void ekk_histogram_summary(const ekk_histogram_t *hist, ekk_latency_summary_t *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EKK_HISTOGRAM_H */
@@ -0,0 +1,88 @@
+/**
+ * @file ekk_idmap.h
+ * @brief EK-KOR v2 - Module ID to Slot Map
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ * @license MIT
+ *
+ * Open-addressed hash map from module ID to a dense slot index in
+ * [0, EKK_MAX_MODULES). Per-module tables (field region, keyring,
+ * quarantine, vote tracking) use it with 16-bit module IDs, so their
+ * size follows the number of live modules instead of the ID space.
+ * With 8-bit IDs those tables index by ID directly and do not use it.
+ *
+ * Design:
+ * - Linear probing over 2 * EKK_MAX_MODULES buckets (load <= 50%)
+ * - One 32-bit word per bucket: (id << 16) | (slot + 1), 0 = empty
+ * - Slots allocated lowest-first from a bitmap
+ * - ekk_idmap_find() is safe against a concurrent writer: every bucket
+ *   changes with a single 32-bit store, and removal only empties a
+ *   bucket when no probe chain runs through it. Writers must serialize.
+ */
+
+#ifndef EKK_IDMAP_H
+#define EKK_IDMAP_H
+
+#include "ekk_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * CONFIGURATION
+ * ============================================================================ */
+
+/** Hash buckets (twice the slot count) */
+#define EKK_IDMAP_BUCKETS           (2 * EKK_MAX_MODULES)
+
+/** Words in the slot allocation bitmap */
+#define EKK_IDMAP_WORDS             ((EKK_MAX_MODULES + 31) / 32)
+
+/** Bucket whose entry was removed (probe chains continue past it) */
+#define EKK_IDMAP_TOMBSTONE         0xFFFFFFFFu
+
+/* ============================================================================
+ * SLOT MAP
+ * ============================================================================ */
+
+/**
+ * @brief Module ID to slot map
+ */
+typedef struct {
+    volatile uint32_t buckets[EKK_IDMAP_BUCKETS]; /**< (id << 16) | (slot + 1) */
+    uint32_t used[EKK_IDMAP_WORDS];               /**< Allocated slots */
+    uint32_t count;                               /**< Mapped IDs */
+} ekk_idmap_t;
+
+/**
+ * @brief Empty the map
+ */
+void ekk_idmap_init(ekk_idmap_t *map);
+
+/**
+ * @brief Slot of a module
+ *
+ * @return Slot index, or -1 if the ID is not mapped
+ */
+int32_t ekk_idmap_find(const ekk_idmap_t *map, ekk_module_id_t id);
+
+/**
+ * @brief Slot of a module, allocating one if it has none
+ *
+ * @return Slot index, or -1 if the ID is invalid or every slot is taken
+ */
+int32_t ekk_idmap_insert(ekk_idmap_t *map, ekk_module_id_t id);
+
+/**
+ * @brief Unmap a module and free its slot
+ *
+ * @return Freed slot index, or -1 if the ID was not mapped
+ */
+int32_t ekk_idmap_remove(ekk_idmap_t *map, ekk_module_id_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EKK_IDMAP_H */
@@ -26,6 +26,10 @@
 #include "ekk_field.h"
 #include "ekk_topology.h"
 #include "ekk_consensus.h"
+#include "ekk_heartbeat.h"
+#include "ekk_runqueue.h"
+#include "ekk_histogram.h"
+#include "ekk_hal.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -69,8 +73,56 @@ typedef struct {
     bool has_deadline;              /**< True if task has a deadline */
     ekk_deadline_t deadline;        /**< Deadline info (valid if has_deadline) */
     ekk_capability_t required_caps; /**< Capabilities required to run this task */
+
+#if EKK_LATENCY_STATS
+    ekk_histogram_t latency;        /**< Run time per invocation (HAL cycles) */
+#endif
 } ekk_internal_task_t;
 
+/**
+ * @brief Phases of ekk_module_tick(), in execution order
+ */
+typedef enum {
+    EKK_PHASE_RX        = 0,    /**< Drain received messages */
+    EKK_PHASE_HEARTBEAT = 1,    /**< Liveness tick */
+    EKK_PHASE_TOPOLOGY  = 2,    /**< Neighbor reelection */
+    EKK_PHASE_FIELD     = 3,    /**< Neighbor aggregate and gradients */
+    EKK_PHASE_CONSENSUS = 4,    /**< Ballot timeouts and votes */
+    EKK_PHASE_TASK      = 5,    /**< Task selection and execution */
+    EKK_PHASE_PUBLISH   = 6,    /**< Field (and segment) publish */
+    EKK_PHASE_STATE     = 7,    /**< Module state update */
+    EKK_PHASE_COUNT     = 8,
+} ekk_tick_phase_t;
+
+/* ============================================================================
+ * MESSAGE DISPATCH
+ * ============================================================================ */
+
+struct ekk_module;
+
+/**
+ * @brief Received-frame handler
+ *
+ * @param mod Receiving module
+ * @param sender_id Transport-level sender (from the HAL, not the payload)
+ * @param data Frame payload, possibly in place in the HAL rx ring; only
+ *             valid for the duration of the call
+ * @param len Payload length
+ * @param now Current timestamp
+ * @return EKK_OK, or an error to count the frame as dropped
+ */
+typedef ekk_error_t (*ekk_msg_handler_t)(struct ekk_module *mod,
+                                         ekk_module_id_t sender_id,
+                                         const void *data,
+                                         uint32_t len,
+                                         ekk_time_us_t now);
+
+/** Core message types (below this) have a handler slot each */
+#define EKK_MSG_CORE_TYPES          16
+
+/** Handler table size */
+#define EKK_MSG_HANDLER_SLOTS       (EKK_MSG_CORE_TYPES + EKK_MSG_USER_HANDLERS)
+
 /* ============================================================================
  * MODULE STRUCTURE
  * ============================================================================ */
@@ -84,6 +136,17 @@ typedef struct {
  * - Maintains k-neighbor topology
  * - Participates in consensus voting
  * - Self-schedules based on gradient fields
+ *
+ * All per-module state lives here, so a process may host any number of
+ * modules (e.g. a site simulation ticking them from a thread pool); each
+ * instance must only be ticked by one thread at a time.
+ *
+ * Not per instance, by design: the field region (ekk_init()) and its
+ * decay configuration and expiry age (ekk_field_configure()) are
+ * process-wide. Modules hosted together publish into one region and
+ * sample each other's fields from it, exactly as modules on separate
+ * controllers share the cluster region. Modules without an endpoint
+ * also share the HAL's one rx ring.
  */
 typedef struct ekk_module {
     /* Identity */
@@ -95,6 +158,12 @@ typedef struct ekk_module {
     ekk_field_t my_field;                   /**< My current field values */
     ekk_field_t neighbor_aggregate;         /**< Aggregated neighbor fields */
     ekk_fixed_t gradients[EKK_FIELD_COUNT]; /**< Current gradients */
+    ekk_field_aggregator_t field_agg;       /**< Incremental neighbor aggregate */
+    ekk_field_publisher_t field_pub;        /**< Deadband publish policy/state */
+
+    /* Segment hierarchy (optional, see ekk_module_set_segment) */
+    ekk_field_level_t segment;              /**< Parent region, own segment's slot, levels above (region NULL = flat) */
+    ekk_time_us_t last_segment_publish;     /**< Gateway: last segment aggregate publish */
 
     /* Topology (who I coordinate with) */
     ekk_topology_t topology;                /**< Topological state */
@@ -102,20 +171,34 @@ typedef struct ekk_module {
     /* Consensus (voting participation) */
     ekk_consensus_t consensus;              /**< Consensus engine */
 
+    /* Liveness (neighbor health, echo RTT) */
+    ekk_heartbeat_t heartbeat;              /**< Heartbeat engine */
+    ekk_hal_endpoint_t *endpoint;           /**< Own bus endpoint (NULL = the HAL's; see ekk_module_attach_endpoint) */
+    bool poll_hal_rx;                       /**< Tick drains the rx ring (default true) */
+    bool tick_pending;                      /**< Work queued outside a tick (field update, message) */
+    ekk_msg_handler_t handlers[EKK_MSG_HANDLER_SLOTS]; /**< Per message type (see ekk_module_set_handler) */
+
     /* Internal tasks (what I execute) */
     ekk_internal_task_t tasks[EKK_MAX_TASKS_PER_MODULE];
     uint32_t task_count;
     ekk_task_id_t active_task;              /**< Currently running task */
+    ekk_runqueue_t runqueue;                /**< Runnable tasks, kept in step with task state */
 
     /* Timing */
     ekk_time_us_t last_tick;                /**< Last tick timestamp */
     ekk_time_us_t tick_period;              /**< Tick period */
+#if EKK_LATENCY_STATS
+    ekk_histogram_t phase_latency[EKK_PHASE_COUNT]; /**< Per tick phase (HAL cycles) */
+#endif
 
     /* Statistics */
     uint32_t ticks_total;
     uint32_t field_updates;
     uint32_t topology_changes;
     uint32_t consensus_rounds;
+    uint32_t rx_frames;                     /**< Frames dispatched from the HAL */
+    uint32_t rx_dropped;                    /**< Frames without a handler, or rejected by it */
+    uint32_t rx_deferred;                   /**< Frames left queued when a tick's budget ran out */
 
     /* MAPF-HET Integration: Capability-based coordination */
     ekk_capability_t capabilities;      /**< This module's current capabilities */
@@ -189,6 +272,94 @@ ekk_error_t ekk_module_stop(ekk_module_t *mod);
  */
 ekk_error_t ekk_module_tick(ekk_module_t *mod, ekk_time_us_t now);
 
+/**
+ * @brief Earliest time at which ekk_module_tick() has work to do
+ *
+ * The soonest of the heartbeat, topology, consensus, run queue and field
+ * publisher deadlines, plus the segment feed on gateways. 0 while work
+ * queued outside a tick is pending (field update, routed message).
+ *
+ * @param mod Module
+ * @return Absolute time in microseconds, UINT64_MAX if not running
+ */
+ekk_time_us_t ekk_module_next_deadline(const ekk_module_t *mod);
+
+/**
+ * @brief Sleep until the module has work (tickless main loop)
+ *
+ * Blocks in ekk_hal_wait_event() until ekk_module_next_deadline() or a
+ * received frame, but at most EKK_MODULE_MAX_SLEEP_US. Replaces ticking
+ * at a fixed period:
+ *
+ * @code
+ * for (;;) {
+ *     ekk_module_wait(&mod);
+ *     ekk_module_tick(&mod, ekk_hal_time_us());
+ * }
+ * @endcode
+ *
+ * @param mod Module
+ * @return EKK_OK if a frame is waiting, EKK_ERR_TIMEOUT when a deadline is due
+ */
+ekk_error_t ekk_module_wait(ekk_module_t *mod);
+
+/**
+ * @brief Give a module its own bus endpoint
+ *
+ * Opens ep under the module's ID. From then on the module's frames are
+ * sent as that ID and its tick drains ep's ring instead of the HAL's, so
+ * modules sharing a process neither share a sender ID nor consume each
+ * other's frames. ep NULL closes the current endpoint and goes back to
+ * the HAL's own path. Attach before the module starts, from the thread
+ * that ticks it.
+ *
+ * @param mod Module
+ * @param ep Endpoint storage, owned by the caller until detached (or NULL)
+ * @return EKK_OK, or the error from ekk_hal_endpoint_open()
+ */
+ekk_error_t ekk_module_attach_endpoint(ekk_module_t *mod, ekk_hal_endpoint_t *ep);
+
+/**
+ * @brief Deliver one received frame to a module
+ *
+ * Calls the handler registered for the frame's type. When poll_hal_rx is
+ * set, ekk_module_tick() feeds this straight from the HAL rx ring (no
+ * copy), EKK_RX_BUDGET frames per tick, or the whole backlog while no
+ * deadline task is short of slack; a backlog left over keeps the module
+ * due (ekk_module_next_deadline() returns 0). A host running several
+ * modules in one process gives each its own endpoint
+ * (ekk_module_attach_endpoint()), or clears poll_hal_rx and routes
+ * frames to each instance itself.
+ *
+ * @param mod Module
+ * @param sender_id Transport-level sender, as reported by the HAL
+ * @param msg_type Message type
+ * @param data Frame payload
+ * @param len Payload length in bytes
+ * @param now Current timestamp
+ * @return EKK_OK, EKK_ERR_INVALID_ARG if the frame is shorter than its type,
+ *         EKK_ERR_NOT_FOUND if no handler is registered for it
+ */
+ekk_error_t ekk_module_on_message(ekk_module_t *mod,
+                                  ekk_module_id_t sender_id,
+                                  ekk_msg_type_t msg_type,
+                                  const void *data,
+                                  uint32_t len,
+                                  ekk_time_us_t now);
+
+/**
+ * @brief Register the handler for a message type
+ *
+ * Core types start out with the built-in handlers (heartbeat, discovery,
+ * consensus, ...); passing NULL restores the built-in one. Application
+ * types from EKK_MSG_USER_BASE have EKK_MSG_USER_HANDLERS slots.
+ *
+ * @return EKK_OK, EKK_ERR_INVALID_ARG if the type has no slot
+ */
+ekk_error_t ekk_module_set_handler(ekk_module_t *mod,
+                                   ekk_msg_type_t msg_type,
+                                   ekk_msg_handler_t handler);
+
 /* ============================================================================
  * INTERNAL TASK MANAGEMENT
  * ============================================================================ */
@@ -257,6 +428,27 @@ ekk_error_t ekk_module_update_field(ekk_module_t *mod,
 ekk_fixed_t ekk_module_get_gradient(const ekk_module_t *mod,
                                      ekk_field_component_t component);
 
+/**
+ * @brief Place the module in a segment of a multi-segment site
+ *
+ * Each tick the module blends the aggregate from the parent region,
+ * with any levels above it folded in (ekk_field_sample_levels()), into
+ * its neighbor aggregate (EKK_FIELD_SEGMENT_WEIGHT). If the module also
+ * has EKK_CAP_GATEWAY, it publishes its segment's aggregate into the
+ * parent every EKK_FIELD_SEGMENT_PERIOD_US and carries the parent's
+ * mean on up to the root (ekk_field_level_publish()).
+ *
+ * @param mod Module
+ * @param parent Parent region (ekk_field_parent_init), NULL to leave
+ * @param segment_id Segment slot in the parent region
+ * @param up Level above the parent region (NULL if the parent is the root)
+ * @return EKK_OK on success
+ */
+ekk_error_t ekk_module_set_segment(ekk_module_t *mod,
+                                    ekk_field_region_t *parent,
+                                    ekk_module_id_t segment_id,
+                                    const ekk_field_level_t *up);
+
 /* ============================================================================
  * DEADLINE / SLACK OPERATIONS (MAPF-HET)
  * ============================================================================ */
@@ -375,6 +567,11 @@ ekk_error_t ekk_module_propose_power_limit(ekk_module_t *mod,
 /**
  * @brief Default task selection based on gradients
  *
+ * Releases due periodic tasks, then picks from the run queue: a deadline
+ * task whose slack is under EKK_SLACK_THRESHOLD_US first (earliest latest
+ * start time wins), otherwise the highest-priority ready task (lowest ID
+ * on ties). Tasks lacking required capabilities are never queued.
+ *
  * Override this for custom scheduling logic.
  *
  * @param mod Module
@@ -409,11 +606,30 @@ typedef struct {
     ekk_fixed_t thermal_gradient;
     uint32_t active_ballots;
     uint32_t ticks_total;
+    uint32_t field_publishes_sent;          /**< Field publishes written */
+    uint32_t field_publishes_suppressed;    /**< Publishes skipped within deadband */
+    uint32_t rx_frames;                     /**< Frames dispatched from the HAL */
+    uint32_t rx_dropped;                    /**< Frames without a handler, or rejected */
+    uint32_t rx_deferred;                   /**< Frames left for a later tick */
+    uint32_t rx_overruns;                   /**< Frames lost to a full HAL rx ring */
+
+    /* Latency in nanoseconds (all zero if EKK_LATENCY_STATS is 0) */
+    ekk_latency_summary_t phase_latency[EKK_PHASE_COUNT]; /**< Per tick phase */
+    uint32_t task_count;
+    ekk_latency_summary_t task_latency[EKK_MAX_TASKS_PER_MODULE]; /**< Per task run */
 } ekk_module_status_t;
 
 ekk_error_t ekk_module_get_status(const ekk_module_t *mod,
                                    ekk_module_status_t *status);
 
+/**
+ * @brief Clear the phase and task latency histograms
+ *
+ * Lets a test harness or operator start a fresh measurement window
+ * without reinitializing the module.
+ */
+void ekk_module_reset_latency(ekk_module_t *mod);
+
 /**
  * @brief Print module status (for debugging)
  */
@@ -28,6 +28,7 @@
 
 #include "ekk_types.h"
 #include "ekk_partition.h"
+#include "ekk_idmap.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -70,6 +71,18 @@ extern "C" {
 #define EKK_RAFT_ELECTION_MAX_US            400000
 #endif
 
+/**
+ * @brief Words in the vote bitmap
+ *
+ * One bit per possible voter: the whole ID space with 8-bit IDs (32
+ * bytes), one per ekk_idmap_t slot with 16-bit IDs.
+ */
+#if EKK_MODULE_ID_BITS > 8
+#define EKK_RAFT_VOTE_WORDS                 ((EKK_MAX_MODULES + 31) / 32)
+#else
+#define EKK_RAFT_VOTE_WORDS                 (256 / 32)
+#endif
+
 /* ============================================================================
  * RAFT STATE
  * ============================================================================ */
@@ -109,10 +122,13 @@ typedef struct {
     ekk_time_us_t election_start;       /**< When election started */
 
     /* Election tracking */
-    uint8_t votes_received;             /**< Votes received as candidate */
-    uint8_t votes_needed;               /**< Votes needed for majority */
-    uint8_t total_voters;               /**< Total eligible voters */
-    bool vote_granted[EKK_MAX_MODULES]; /**< Track who voted for us */
+    uint16_t votes_received;            /**< Votes received as candidate */
+    uint16_t votes_needed;              /**< Votes needed for majority */
+    uint16_t total_voters;              /**< Total eligible voters */
+    uint32_t vote_granted[EKK_RAFT_VOTE_WORDS]; /**< Bitmap: who voted for us */
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_t voters;                 /**< Voter ID -> vote_granted bit */
+#endif
 
     /* Callbacks */
     void (*on_become_leader)(void *user_data);
@@ -146,7 +162,7 @@ typedef struct {
  */
 ekk_error_t ekk_raft_init(ekk_raft_ctx_t *ctx,
                            ekk_module_id_t my_id,
-                           uint8_t total_modules,
+                           uint16_t total_modules,
                            ekk_partition_ctx_t *partition_ctx);
 
 /**
@@ -295,7 +311,7 @@ EKK_PACK_BEGIN
 typedef struct {
     uint32_t term;                      /**< Leader's term */
     ekk_module_id_t leader_id;          /**< Leader's ID */
-    uint8_t reserved[3];
+    uint8_t reserved[3 - EKK_MODULE_ID_WIRE_EXTRA];
 } EKK_PACKED ekk_raft_heartbeat_msg_t;
 EKK_PACK_END
 
@@ -310,7 +326,7 @@ EKK_PACK_BEGIN
 typedef struct {
     uint32_t term;                      /**< Candidate's term */
     ekk_module_id_t candidate_id;       /**< Candidate's ID */
-    uint8_t reserved[3];
+    uint8_t reserved[3 - EKK_MODULE_ID_WIRE_EXTRA];
 } EKK_PACKED ekk_raft_vote_request_msg_t;
 EKK_PACK_END
 
@@ -326,7 +342,7 @@ typedef struct {
     uint32_t term;                      /**< Responder's term */
     ekk_module_id_t voter_id;           /**< Voter's ID */
     uint8_t vote_granted;               /**< 1 if granted, 0 if rejected */
-    uint8_t reserved[2];
+    uint8_t reserved[2 - EKK_MODULE_ID_WIRE_EXTRA];
 } EKK_PACKED ekk_raft_vote_response_msg_t;
 EKK_PACK_END
 
@@ -0,0 +1,151 @@
+/**
+ * @file ekk_runqueue.h
+ * @brief EK-KOR v2 - Per-Module Task Run Queue
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ * @license MIT
+ *
+ * Task selection for ekk_module_select_task() whose cost does not depend
+ * on the number of tasks. Tasks are named by their module task ID; the
+ * module keeps the queue in step with task state, so selection never
+ * re-checks states, release times or capabilities.
+ *
+ * Design:
+ * - Fixed priority: a bitmap of non-empty priority levels plus a bitmap
+ *   of ready task IDs per level. The lowest set bit of each gives the
+ *   highest priority level and, within it, the lowest task ID.
+ * - Deadlines: ready tasks with a deadline also sit in a min-heap on
+ *   their latest start time (deadline - duration estimate), i.e. EDF on
+ *   the time by which they must start. Once the head's slack drops below
+ *   EKK_SLACK_THRESHOLD_US it runs ahead of every fixed-priority task.
+ * - Periodic releases: tasks waiting for their next period sit in a
+ *   min-heap on release time (timer queue); ekk_runqueue_release() moves
+ *   the due ones to ready.
+ */
+
+#ifndef EKK_RUNQUEUE_H
+#define EKK_RUNQUEUE_H
+
+#include "ekk_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * CONFIGURATION
+ * ============================================================================ */
+
+/**
+ * @brief Priority levels (task priority 0 = highest)
+ *
+ * Priorities at or above this share the lowest level.
+ */
+#ifndef EKK_RUNQUEUE_PRIORITIES
+#define EKK_RUNQUEUE_PRIORITIES     32
+#endif
+
+/** Words per ready-task bitmap */
+#define EKK_RUNQUEUE_WORDS          ((EKK_MAX_TASKS_PER_MODULE + 31) / 32)
+
+/** No task (idle) */
+#define EKK_RUNQUEUE_NONE           0xFF
+
+/* ============================================================================
+ * RUN QUEUE
+ * ============================================================================ */
+
+/**
+ * @brief Task run queue
+ */
+typedef struct {
+    /* Fixed-priority ready set */
+    uint32_t level_map;                         /**< Bit p: level p has a ready task */
+    uint32_t level[EKK_RUNQUEUE_PRIORITIES][EKK_RUNQUEUE_WORDS]; /**< Ready task IDs per level */
+    uint8_t priority[EKK_MAX_TASKS_PER_MODULE]; /**< Level of each task */
+
+    /* EDF heap over ready tasks with a deadline */
+    bool has_deadline[EKK_MAX_TASKS_PER_MODULE];
+    ekk_time_us_t start_by[EKK_MAX_TASKS_PER_MODULE]; /**< Deadline - duration estimate */
+    ekk_task_id_t edf_heap[EKK_MAX_TASKS_PER_MODULE];
+    uint8_t edf_pos[EKK_MAX_TASKS_PER_MODULE];  /**< Heap index, NONE if absent */
+    uint32_t edf_count;
+
+    /* Timer queue of pending periodic releases */
+    ekk_time_us_t release_at[EKK_MAX_TASKS_PER_MODULE];
+    ekk_task_id_t timer_heap[EKK_MAX_TASKS_PER_MODULE];
+    uint8_t timer_pos[EKK_MAX_TASKS_PER_MODULE]; /**< Heap index, NONE if absent */
+    uint32_t timer_count;
+} ekk_runqueue_t;
+
+/**
+ * @brief Empty the queue (every task neither ready nor armed)
+ */
+void ekk_runqueue_init(ekk_runqueue_t *rq);
+
+/**
+ * @brief Set a task's priority (requeues it if ready)
+ */
+void ekk_runqueue_set_priority(ekk_runqueue_t *rq, ekk_task_id_t id, uint8_t priority);
+
+/**
+ * @brief Set or clear a task's deadline (requeues it if ready)
+ *
+ * @param deadline Absolute deadline
+ * @param duration_est Estimated run time (the task must start by deadline - duration_est)
+ */
+void ekk_runqueue_set_deadline(ekk_runqueue_t *rq, ekk_task_id_t id, bool has_deadline,
+                               ekk_time_us_t deadline, ekk_time_us_t duration_est);
+
+/**
+ * @brief Make a task ready now (cancels a pending release)
+ */
+void ekk_runqueue_ready(ekk_runqueue_t *rq, ekk_task_id_t id);
+
+/**
+ * @brief Make a task ready at a future time (timer queue)
+ */
+void ekk_runqueue_release_at(ekk_runqueue_t *rq, ekk_task_id_t id, ekk_time_us_t when);
+
+/**
+ * @brief Take a task out of the queue (neither ready nor armed)
+ */
+void ekk_runqueue_remove(ekk_runqueue_t *rq, ekk_task_id_t id);
+
+/**
+ * @brief Move tasks whose release time has come to ready
+ *
+ * @return Number of tasks released
+ */
+uint32_t ekk_runqueue_release(ekk_runqueue_t *rq, ekk_time_us_t now);
+
+/**
+ * @brief Earliest pending release (UINT64_MAX if none)
+ */
+ekk_time_us_t ekk_runqueue_next_release(const ekk_runqueue_t *rq);
+
+/**
+ * @brief Earliest time a task can run (0 if one is ready now)
+ */
+ekk_time_us_t ekk_runqueue_next_deadline(const ekk_runqueue_t *rq);
+
+/**
+ * @brief Task to run next, without dequeuing it
+ *
+ * @return Task ID, or EKK_RUNQUEUE_NONE if nothing is ready
+ */
+ekk_task_id_t ekk_runqueue_pick(const ekk_runqueue_t *rq, ekk_time_us_t now);
+
+/**
+ * @brief Check if a task is in the ready set
+ */
+static inline bool ekk_runqueue_is_ready(const ekk_runqueue_t *rq, ekk_task_id_t id)
+{
+    return (rq->level[rq->priority[id]][id / 32] >> (id % 32)) & 1u;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EKK_RUNQUEUE_H */
@@ -11,7 +11,11 @@
  * - Lock-free: No mutexes or spinlocks
  * - Wait-free: Bounded operation time
  * - Zero-copy option: Can return pointer to slot for in-place access
- * - Cache-friendly: Head and tail on separate cache lines
+ * - Cache-friendly: Head and tail on separate cache lines; each side
+ *   caches the other's index and only re-reads it when the cached value
+ *   says full (producer) or empty (consumer)
+ * - Batching: push_n/pop_n and multi-slot acquire/peek move a burst
+ *   with one release store
  * - Target latency: < 100ns push/pop on Cortex-M4 @ 170MHz
  *
  * Use cases:
@@ -42,10 +46,22 @@ extern "C" {
 #endif
 
 /**
- * @brief Cache line size for padding (Cortex-M4 has 32-byte lines)
+ * @brief Index hand-off between producer and consumer
+ *
+ * Acquire loads and release stores where the compiler provides them
+ * (plain moves on x86, one dmb on ARM); a full HAL barrier otherwise.
  */
-#ifndef EKK_CACHE_LINE_SIZE
-#define EKK_CACHE_LINE_SIZE         32
+#if defined(__GNUC__) || defined(__clang__)
+#define EKK_SPSC_LOAD_ACQUIRE(ptr)          __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define EKK_SPSC_STORE_RELEASE(ptr, val)    __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#else
+static inline uint32_t ekk_spsc_load_acquire(volatile uint32_t *ptr) {
+    uint32_t val = *ptr;
+    ekk_hal_memory_barrier();
+    return val;
+}
+#define EKK_SPSC_LOAD_ACQUIRE(ptr)          ekk_spsc_load_acquire(ptr)
+#define EKK_SPSC_STORE_RELEASE(ptr, val)    do { ekk_hal_memory_barrier(); *(ptr) = (val); } while (0)
 #endif
 
 /* ============================================================================
@@ -56,16 +72,19 @@ extern "C" {
  * @brief SPSC ring buffer control structure
  *
  * Head and tail are on separate cache lines to avoid false sharing
- * between producer (writes head) and consumer (writes tail).
+ * between producer (writes head) and consumer (writes tail). Each side
+ * keeps its copy of the other's index on its own line.
  */
-typedef struct {
+typedef struct EKK_CACHE_ALIGNED {
     /* Producer side - only producer writes head */
     volatile uint32_t head;             /**< Next write index */
-    uint8_t _pad_head[EKK_CACHE_LINE_SIZE - sizeof(uint32_t)];
+    uint32_t cached_tail;               /**< Producer's last view of tail */
+    uint8_t _pad_head[EKK_CACHE_LINE_SIZE - 2 * sizeof(uint32_t)];
 
     /* Consumer side - only consumer writes tail */
     volatile uint32_t tail;             /**< Next read index */
-    uint8_t _pad_tail[EKK_CACHE_LINE_SIZE - sizeof(uint32_t)];
+    uint32_t cached_head;               /**< Consumer's last view of head */
+    uint8_t _pad_tail[EKK_CACHE_LINE_SIZE - 2 * sizeof(uint32_t)];
 
     /* Shared (read-only after init) */
     void *buffer;                       /**< Pre-allocated buffer */
@@ -74,6 +93,13 @@ typedef struct {
     uint32_t item_size;                 /**< Size of each item in bytes */
 } ekk_spsc_t;
 
+EKK_STATIC_ASSERT(offsetof(ekk_spsc_t, tail) - offsetof(ekk_spsc_t, head) >= EKK_CACHE_LINE_SIZE,
+                  "SPSC head and tail must not share a cache line");
+EKK_STATIC_ASSERT(offsetof(ekk_spsc_t, buffer) - offsetof(ekk_spsc_t, tail) >= EKK_CACHE_LINE_SIZE,
+                  "SPSC tail must not share a cache line with the read-only fields");
+EKK_STATIC_ASSERT(sizeof(ekk_spsc_t) % EKK_CACHE_LINE_SIZE == 0,
+                  "SPSC arrays must keep every ring on its own lines");
+
 /* ============================================================================
  * SPSC API
  * ============================================================================ */
@@ -148,6 +174,31 @@ void *ekk_spsc_push_acquire(ekk_spsc_t *q);
  */
 void ekk_spsc_push_commit(ekk_spsc_t *q);
 
+/**
+ * @brief Push up to n items (copy semantics, one release)
+ *
+ * @param items Array of n items, item_size bytes each
+ * @return Number of items pushed (fewer than n if the queue fills)
+ */
+uint32_t ekk_spsc_push_n(ekk_spsc_t *q, const void *items, uint32_t n);
+
+/**
+ * @brief Get contiguous write slots for up to n items (zero-copy batch)
+ *
+ * The run stops at the end of the buffer, so a wrapping batch takes two
+ * calls. Nothing is visible to the consumer until
+ * ekk_spsc_push_commit_n().
+ *
+ * @param[out] count Slots granted (0 if full)
+ * @return Pointer to the first slot, or NULL if full
+ */
+void *ekk_spsc_push_acquire_n(ekk_spsc_t *q, uint32_t n, uint32_t *count);
+
+/**
+ * @brief Publish n acquired slots with a single release
+ */
+void ekk_spsc_push_commit_n(ekk_spsc_t *q, uint32_t n);
+
 /* ============================================================================
  * CONSUMER API (Call from single consumer thread only)
  * ============================================================================ */
@@ -194,6 +245,29 @@ void *ekk_spsc_pop_peek(ekk_spsc_t *q);
  */
 void ekk_spsc_pop_release(ekk_spsc_t *q);
 
+/**
+ * @brief Pop up to n items (copy semantics, one release)
+ *
+ * @param[out] items Array with room for n items
+ * @return Number of items popped (0 if empty)
+ */
+uint32_t ekk_spsc_pop_n(ekk_spsc_t *q, void *items, uint32_t n);
+
+/**
+ * @brief Peek at up to n contiguous items (zero-copy batch read)
+ *
+ * Like ekk_spsc_push_acquire_n(), the run stops at the end of the buffer.
+ *
+ * @param[out] count Items available in the run (0 if empty)
+ * @return Pointer to the oldest item, or NULL if empty
+ */
+void *ekk_spsc_pop_peek_n(ekk_spsc_t *q, uint32_t n, uint32_t *count);
+
+/**
+ * @brief Release n peeked items with a single release
+ */
+void ekk_spsc_pop_release_n(ekk_spsc_t *q, uint32_t n);
+
 /* ============================================================================
  * QUERY API (Safe from any thread)
  * ============================================================================ */
@@ -25,6 +25,8 @@
 #define EKK_TOPOLOGY_H
 
 #include "ekk_types.h"
+#include "ekk_idmap.h"
+#include "ekk_heartbeat.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,7 +42,7 @@ extern "C" {
 typedef enum {
     EKK_DISTANCE_LOGICAL,       /**< Based on module ID proximity */
     EKK_DISTANCE_PHYSICAL,      /**< Based on position coordinates */
-    EKK_DISTANCE_LATENCY,       /**< Based on communication latency */
+    EKK_DISTANCE_LATENCY,       /**< Based on measured RTT (heartbeat echo) */
     EKK_DISTANCE_CUSTOM,        /**< Application-defined metric */
 } ekk_distance_metric_t;
 
@@ -53,6 +55,7 @@ typedef struct {
     ekk_time_us_t discovery_period;         /**< How often to broadcast discovery */
     ekk_time_us_t reelection_delay;         /**< Delay before reelecting neighbors */
     uint32_t min_neighbors;                 /**< Minimum before DEGRADED state */
+    bool incremental;                       /**< Update neighbors per discovery/loss */
 } ekk_topology_config_t;
 
 /**
@@ -64,8 +67,59 @@ typedef struct {
     .discovery_period = 1000000, /* 1 second */ \
     .reelection_delay = 100000,  /* 100ms */ \
     .min_neighbors = 3, \
+    .incremental = true, \
 }
 
+/**
+ * @brief Spatial grid cell edge (position units)
+ *
+ * Known modules are bucketed into cubic cells of this size so that
+ * EKK_DISTANCE_PHYSICAL reelection only visits cells near this module.
+ * Match it to the typical neighbor spacing (a few rack slots).
+ */
+#ifndef EKK_TOPOLOGY_GRID_CELL
+#define EKK_TOPOLOGY_GRID_CELL      4
+#endif
+
+/**
+ * @brief Spatial grid hash buckets (power of 2)
+ */
+#ifndef EKK_TOPOLOGY_GRID_BUCKETS
+#define EKK_TOPOLOGY_GRID_BUCKETS   64
+#endif
+
+/**
+ * @brief Runner-up candidates kept behind the k neighbors
+ *
+ * In incremental mode a lost neighbor is replaced from this list; a full
+ * reelection only runs once it is exhausted.
+ */
+#ifndef EKK_TOPOLOGY_RESERVE
+#define EKK_TOPOLOGY_RESERVE        EKK_K_NEIGHBORS
+#endif
+
+/**
+ * @brief Latency hysteresis (percent)
+ *
+ * With EKK_DISTANCE_LATENCY, a module's ranked RTT only follows the
+ * smoothed measurement once it moves more than this far from the value
+ * last used, so jitter between similar links does not flap neighbors.
+ */
+#ifndef EKK_TOPOLOGY_LATENCY_HYSTERESIS_PCT
+#define EKK_TOPOLOGY_LATENCY_HYSTERESIS_PCT 25
+#endif
+
+/**
+ * @brief Latency distance of a module with no RTT sample yet
+ *
+ * Unmeasured modules rank behind every measured one, ordered among
+ * themselves by logical distance.
+ */
+#define EKK_TOPOLOGY_LATENCY_UNMEASURED     (INT32_MAX / 2)
+
+/** Words in the known-module slot bitmap */
+#define EKK_TOPOLOGY_KNOWN_WORDS    ((EKK_MAX_MODULES + 31) / 32)
+
 /* ============================================================================
  * MODULE POSITION (for physical distance metric)
  * ============================================================================ */
@@ -89,22 +143,60 @@ typedef struct {
  * ============================================================================ */
 
 /**
- * @brief Topology state for a module
+ * @brief Candidate neighbor and its distance
  */
 typedef struct {
+    ekk_module_id_t id;
+    int32_t distance;
+} ekk_topology_candidate_t;
+
+/**
+ * @brief Topology state for a module
+ *
+ * Known modules live in slots: the module ID itself with 8-bit IDs, or a
+ * slot from known_slots with 16-bit IDs. known_bits marks occupied slots.
+ *
+ * In incremental mode neighbors[] and reserve[] together hold the nearest
+ * known modules in (distance, ID) order, so a discovery is compared
+ * against the current bound and a loss promotes reserve[0].
+ */
+typedef struct ekk_topology {
     ekk_module_id_t my_id;                          /**< This module's ID */
     ekk_position_t my_position;                     /**< This module's position */
 
     ekk_neighbor_t neighbors[EKK_K_NEIGHBORS];      /**< Current k-neighbors */
     uint32_t neighbor_count;                        /**< Actual neighbor count */
 
-    ekk_module_id_t all_known[EKK_MAX_MODULES];     /**< All discovered modules */
+    ekk_module_id_t all_known[EKK_MAX_MODULES];     /**< Known module per slot */
+    ekk_position_t known_positions[EKK_MAX_MODULES];/**< Position per slot */
+    uint32_t known_latency[EKK_MAX_MODULES];        /**< Ranked RTT per slot (us, 0 = none) */
+    uint32_t known_bits[EKK_TOPOLOGY_KNOWN_WORDS];  /**< Occupied slots */
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_t known_slots;                        /**< Module ID -> slot */
+#endif
     uint32_t known_count;                           /**< Count of known modules */
 
+    ekk_topology_candidate_t reserve[EKK_TOPOLOGY_RESERVE]; /**< Next nearest, sorted */
+    uint32_t reserve_count;                         /**< Valid reserve entries */
+
+    /* Spatial grid over known_positions: per-bucket chains of
+     * slots, stored as slot + 1 (0 = end of chain) */
+    uint16_t grid_head[EKK_TOPOLOGY_GRID_BUCKETS];  /**< First entry per bucket */
+    uint16_t grid_next[EKK_MAX_MODULES];            /**< Next entry in chain */
+    ekk_position_t grid_min;                        /**< Occupied cell bounds (low) */
+    ekk_position_t grid_max;                        /**< Occupied cell bounds (high) */
+
     ekk_time_us_t last_discovery;                   /**< Last discovery broadcast */
     ekk_time_us_t last_reelection;                  /**< Last neighbor reelection */
+    uint16_t discovery_sequence;                    /**< Next discovery sequence */
+    ekk_heartbeat_t *liveness;                      /**< Sends go through it: trailer, endpoint (NULL = plain HAL) */
 
     ekk_topology_config_t config;                   /**< Configuration */
+
+    /** Neighbor set change callback (see ekk_topology_set_callback()) */
+    void (*on_changed)(struct ekk_topology *topo,
+                       const ekk_neighbor_t *old_neighbors, uint32_t old_count,
+                       const ekk_neighbor_t *new_neighbors, uint32_t new_count);
 } ekk_topology_t;
 
 /* ============================================================================
@@ -131,6 +223,10 @@ ekk_error_t ekk_topology_init(ekk_topology_t *topo,
  * Called when receiving a discovery broadcast from another module.
  * Updates known modules list and triggers reelection if needed.
  *
+ * In incremental mode a repeat discovery at the same position is O(1),
+ * and a newcomer only enters the neighbor set if it beats the current
+ * k-th nearest. A module that moved triggers a full reelection.
+ *
  * @param topo Topology state
  * @param sender_id Sender's module ID
  * @param sender_position Sender's position
@@ -144,7 +240,8 @@ ekk_error_t ekk_topology_on_discovery(ekk_topology_t *topo,
  * @brief Mark a neighbor as lost
  *
  * Called by heartbeat layer when a neighbor times out.
- * Triggers neighbor reelection.
+ * Triggers neighbor reelection, or in incremental mode promotes the
+ * nearest reserve candidate.
  *
  * @param topo Topology state
  * @param lost_id Lost neighbor's ID
@@ -159,11 +256,32 @@ ekk_error_t ekk_topology_on_neighbor_lost(ekk_topology_t *topo,
  * Recomputes k-nearest neighbors from all known modules.
  * Called after discovery or neighbor loss.
  *
+ * Keeps the k best candidates in a bounded max-heap (O(n log k)).
+ * With EKK_DISTANCE_PHYSICAL the candidates come from the spatial grid,
+ * searched in rings of cells outward from this module until no closer
+ * module can remain. Ties break toward the lower module ID.
+ *
  * @param topo Topology state
  * @return Number of neighbors after reelection
  */
 uint32_t ekk_topology_reelect(ekk_topology_t *topo);
 
+/**
+ * @brief Report a module's smoothed RTT
+ *
+ * Called with the heartbeat layer's echo-probe EWMA. The ranked value is
+ * only updated outside the EKK_TOPOLOGY_LATENCY_HYSTERESIS_PCT band, and
+ * with EKK_DISTANCE_LATENCY an update reelects neighbors.
+ *
+ * @param topo Topology state
+ * @param module_id Measured module
+ * @param rtt_us Smoothed round-trip time
+ * @return EKK_OK on success, EKK_ERR_NOT_FOUND if the module is not known
+ */
+ekk_error_t ekk_topology_on_latency(ekk_topology_t *topo,
+                                     ekk_module_id_t module_id,
+                                     ekk_time_us_t rtt_us);
+
 /**
  * @brief Periodic tick (call from main loop)
  *
@@ -175,6 +293,17 @@ uint32_t ekk_topology_reelect(ekk_topology_t *topo);
  */
 bool ekk_topology_tick(ekk_topology_t *topo, ekk_time_us_t now);
 
+/**
+ * @brief Earliest time at which ekk_topology_tick() has work to do
+ *
+ * The next discovery broadcast, a quarter period apart while below
+ * min_neighbors.
+ *
+ * @param topo Topology state
+ * @return Absolute time in microseconds, UINT64_MAX if topo is NULL
+ */
+ekk_time_us_t ekk_topology_next_deadline(const ekk_topology_t *topo);
+
 /**
  * @brief Get current neighbors
  *
@@ -187,6 +316,12 @@ uint32_t ekk_topology_get_neighbors(const ekk_topology_t *topo,
                                      ekk_neighbor_t *neighbors,
                                      uint32_t max_count);
 
+/**
+ * @brief Check if a module is known (discovered, neighbor or not)
+ */
+bool ekk_topology_is_known(const ekk_topology_t *topo,
+                            ekk_module_id_t module_id);
+
 /**
  * @brief Check if a module is a neighbor
  */
@@ -212,7 +347,9 @@ const ekk_neighbor_t* ekk_topology_get_neighbor(const ekk_topology_t *topo,
  *
  * For DISTANCE_LOGICAL: |id_a - id_b|
  * For DISTANCE_PHYSICAL: Euclidean distance
- * For DISTANCE_LATENCY: measured RTT (requires HAL)
+ * For DISTANCE_LATENCY: ranked RTT of the other module (see
+ *   ekk_topology_on_latency()), or EKK_TOPOLOGY_LATENCY_UNMEASURED plus
+ *   the logical distance before the first sample
  *
  * @param topo Topology state (for metric selection)
  * @param id_a First module
@@ -247,11 +384,15 @@ typedef struct {
     ekk_position_t position;        /**< Sender's position */
     uint8_t neighbor_count;         /**< Sender's current neighbor count */
     uint8_t state;                  /**< Sender's state (ekk_module_state_t) */
+#if EKK_MODULE_ID_BITS > 8
+    uint8_t sequence;               /**< Monotonic sequence (low byte) */
+#else
     uint16_t sequence;              /**< Monotonic sequence */
+#endif
 } EKK_PACKED ekk_discovery_msg_t;
 EKK_PACK_END
 
-EKK_STATIC_ASSERT(sizeof(ekk_discovery_msg_t) <= 16, "Discovery message too large");
+EKK_STATIC_ASSERT(sizeof(ekk_discovery_msg_t) <= 12, "Discovery message too large");
 
 /* ============================================================================
  * CALLBACKS
@@ -267,7 +408,7 @@ typedef void (*ekk_topology_changed_cb)(ekk_topology_t *topo,
                                          uint32_t new_count);
 
 /**
- * @brief Register topology change callback
+ * @brief Register topology change callback (per instance, cleared by init)
  */
 void ekk_topology_set_callback(ekk_topology_t *topo,
                                 ekk_topology_changed_cb callback);
@@ -46,18 +46,75 @@ extern "C" {
 
 /**
  * @brief Maximum modules in a cluster
+ *
+ * With 16-bit module IDs this is the number of modules that can be live
+ * at once, not the size of the ID space.
  */
 #ifndef EKK_MAX_MODULES
 #define EKK_MAX_MODULES             256
 #endif
 
 /**
- * @brief Maximum tasks per module (internal to module)
+ * @brief Module ID width in bits (8 or 16)
+ *
+ * 8: IDs 1..254; per-module tables are indexed directly by ID.
+ * 16: IDs 1..65534; per-module tables go through an ekk_idmap_t slot
+ * map, so their size follows EKK_MAX_MODULES rather than the ID space.
+ * Wire messages keep their sizes: the second ID byte replaces a
+ * reserved byte or narrows a field (see EKK_MODULE_ID_WIRE_EXTRA).
+ */
+#ifndef EKK_MODULE_ID_BITS
+#define EKK_MODULE_ID_BITS          8
+#endif
+
+/**
+ * @brief Maximum tasks per module (internal to module, at most 254)
+ *
+ * Task selection cost does not grow with this (see ekk_runqueue.h).
  */
 #ifndef EKK_MAX_TASKS_PER_MODULE
 #define EKK_MAX_TASKS_PER_MODULE    8
 #endif
 
+/**
+ * @brief Longest tickless sleep in microseconds (see ekk_module_wait)
+ *
+ * Bounds the staleness of inputs that raise no event: neighbor fields
+ * in the shared region and decay drift against the publish deadband.
+ */
+#ifndef EKK_MODULE_MAX_SLEEP_US
+#define EKK_MODULE_MAX_SLEEP_US     50000   /* Half the decay tau */
+#endif
+
+/**
+ * @brief Received frames a module tick dispatches per tick
+ *
+ * When more are waiting, the tick drains the backlog (up to
+ * EKK_RX_BUDGET_MAX) unless a deadline task is within EKK_RX_SLACK_US of
+ * its latest start time.
+ */
+#ifndef EKK_RX_BUDGET
+#define EKK_RX_BUDGET               16
+#endif
+
+#ifndef EKK_RX_BUDGET_MAX
+#define EKK_RX_BUDGET_MAX           128
+#endif
+
+#ifndef EKK_RX_SLACK_US
+#define EKK_RX_SLACK_US             1000
+#endif
+
+/**
+ * @brief Application message types with a handler slot per module
+ *
+ * Handlers can be registered for EKK_MSG_USER_BASE up to
+ * EKK_MSG_USER_BASE + EKK_MSG_USER_HANDLERS - 1.
+ */
+#ifndef EKK_MSG_USER_HANDLERS
+#define EKK_MSG_USER_HANDLERS       8
+#endif
+
 /**
  * @brief Field decay time constant in microseconds
  *
@@ -90,18 +147,125 @@ extern "C" {
 #endif
 
 /**
- * @brief Maximum concurrent ballots
+ * @brief Maximum concurrent ballots (own and remote, per module)
  */
 #ifndef EKK_MAX_BALLOTS
-#define EKK_MAX_BALLOTS             4
+#define EKK_MAX_BALLOTS             16
+#endif
+
+/**
+ * @brief Low ballot-ID bits holding the proposer's sequence number
+ *
+ * The remaining high bits select the proposer's ID range, so modules
+ * allocate ballot IDs without coordination and can keep several
+ * proposals in flight at once.
+ */
+#ifndef EKK_BALLOT_SEQ_BITS
+#define EKK_BALLOT_SEQ_BITS         8
+#endif
+
+/**
+ * @brief Completed ballot results kept for late voters and queries
+ */
+#ifndef EKK_BALLOT_HISTORY
+#define EKK_BALLOT_HISTORY          16
+#endif
+
+/**
+ * @brief Use SIMD kernels for field aggregation (SSE2/AVX2/NEON)
+ *
+ * Set to 0 to force the portable scalar kernel. Results are bit-identical.
+ */
+#ifndef EKK_FIELD_SIMD
+#define EKK_FIELD_SIMD              1
+#endif
+
+/**
+ * @brief Field region memory layout
+ *
+ * 0 = array of structures (one ekk_coord_field_t per module).
+ * 1 = structure of arrays (per-component arrays, cache-line padded seqlocks).
+ * The publish/sample API is identical in both layouts.
+ */
+#ifndef EKK_FIELD_LAYOUT_SOA
+#define EKK_FIELD_LAYOUT_SOA        0
+#endif
+
+/**
+ * @brief Field change journal: buckets and change epochs per bucket
+ *
+ * Recent changes are also ORed into one bitmap per EKK_FIELD_CHANGE_SPAN
+ * epochs, so a consumer less than (buckets - 1) * span changes behind
+ * collects them a word at a time. One further behind scans the per-slot
+ * epochs instead: slower, still exact. Both powers of two.
+ */
+#ifndef EKK_FIELD_CHANGE_BUCKETS
+#define EKK_FIELD_CHANGE_BUCKETS    16
+#endif
+
+#ifndef EKK_FIELD_CHANGE_SPAN
+#define EKK_FIELD_CHANGE_SPAN       32
+#endif
+
+/**
+ * @brief Field expiry wheel: buckets (power of two) and bucket width
+ *
+ * Slots are hashed by publish time into EKK_FIELD_WHEEL_SLOTS buckets of
+ * EKK_FIELD_WHEEL_TICK_US each; ekk_field_gc() only visits buckets that
+ * have come due. A span (slots * tick) above the field max age means
+ * every slot is examined once, when it actually expires.
+ */
+#ifndef EKK_FIELD_WHEEL_SLOTS
+#define EKK_FIELD_WHEEL_SLOTS       64
+#endif
+
+#ifndef EKK_FIELD_WHEEL_TICK_US
+#define EKK_FIELD_WHEEL_TICK_US     10000   /* 64 x 10ms = 640ms > 5 * tau */
+#endif
+
+/**
+ * @brief Cache line size for padding shared data
+ *
+ * Supplied per platform by the build (the rpi3 and x86_64 HALs pass 64);
+ * otherwise taken from the target architecture: 64 bytes on Cortex-A53
+ * and x86, 32 on Cortex-M and TriCore. Anything that two cores write
+ * concurrently must sit on lines of its own, so a value that is too
+ * small silently brings back false sharing.
+ */
+#ifndef EKK_CACHE_LINE_SIZE
+#if defined(__aarch64__) || defined(__x86_64__) || defined(__i386__) || \
+    defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+#define EKK_CACHE_LINE_SIZE         64
+#else
+#define EKK_CACHE_LINE_SIZE         32
+#endif
+#endif
+
+/**
+ * @brief Pad per-slot shared structures to whole cache lines
+ *
+ * Applies to the array-of-structures field slots (ekk_coord_field_t).
+ * Pays off where several cores publish into one region; single-core
+ * MCUs keep the slots packed and save the RAM. Defaults on for 64-byte
+ * line (SMP) targets.
+ */
+#ifndef EKK_CACHE_PAD_SLOTS
+#define EKK_CACHE_PAD_SLOTS         (EKK_CACHE_LINE_SIZE >= 64)
 #endif
 
 /* ============================================================================
  * BASIC TYPES
  * ============================================================================ */
 
-/** @brief Module identifier (0 = invalid) */
+/** @brief Module identifier (0 = invalid, all ones = broadcast) */
+#if EKK_MODULE_ID_BITS > 8
+typedef uint16_t ekk_module_id_t;
+#else
 typedef uint8_t ekk_module_id_t;
+#endif
+
+/** @brief Bytes a module ID needs on the wire beyond the first (0 or 1) */
+#define EKK_MODULE_ID_WIRE_EXTRA    ((EKK_MODULE_ID_BITS > 8) ? 1 : 0)
 
 /** @brief Task identifier within a module */
 typedef uint8_t ekk_task_id_t;
@@ -474,12 +638,34 @@ typedef struct {
 
 #define EKK_INVALID_MODULE_ID       0
 #define EKK_INVALID_BALLOT_ID       0
+#if EKK_MODULE_ID_BITS > 8
+#define EKK_BROADCAST_ID            0xFFFF
+#else
 #define EKK_BROADCAST_ID            0xFF
+#endif
+
+/**
+ * @brief Module ID that can own an entry in a per-module table
+ *
+ * 8-bit IDs index tables directly, so they must be below EKK_MAX_MODULES.
+ * 16-bit IDs take a slot from an ekk_idmap_t; any unicast ID qualifies.
+ */
+#if EKK_MODULE_ID_BITS > 8
+#define EKK_MODULE_ID_VALID(id)     ((id) != EKK_INVALID_MODULE_ID && (id) != EKK_BROADCAST_ID)
+#elif EKK_MAX_MODULES >= 256
+#define EKK_MODULE_ID_VALID(id)     ((id) != EKK_INVALID_MODULE_ID)
+#else
+#define EKK_MODULE_ID_VALID(id)     ((id) != EKK_INVALID_MODULE_ID && (id) < EKK_MAX_MODULES)
+#endif
 
 #define EKK_MIN(a, b)               (((a) < (b)) ? (a) : (b))
 #define EKK_MAX(a, b)               (((a) > (b)) ? (a) : (b))
 #define EKK_CLAMP(x, lo, hi)        EKK_MIN(EKK_MAX(x, lo), hi)
 
+/** Enclosing struct of an embedded member (callbacks -> owning module) */
+#define EKK_CONTAINER_OF(ptr, type, member) \
+    ((type *)(void *)((char *)(ptr) - offsetof(type, member)))
+
 #define EKK_ARRAY_SIZE(arr)         (sizeof(arr) / sizeof((arr)[0]))
 
 #define EKK_UNUSED(x)               ((void)(x))
@@ -509,6 +695,9 @@ typedef struct {
 /** @brief Static assertion */
 #define EKK_STATIC_ASSERT(cond, msg) static_assert(cond, msg)
 
+/** @brief Align a struct to a cache line (place after the struct keyword) */
+#define EKK_CACHE_ALIGNED           __declspec(align(EKK_CACHE_LINE_SIZE))
+
 #else
 /* GCC / Clang (including ARM GCC for MCU) */
 
@@ -530,8 +719,15 @@ typedef struct {
 /** @brief Static assertion */
 #define EKK_STATIC_ASSERT(cond, msg) _Static_assert(cond, msg)
 
+/** @brief Align a struct to a cache line (place after the struct keyword) */
+#define EKK_CACHE_ALIGNED           __attribute__((aligned(EKK_CACHE_LINE_SIZE)))
+
 #endif /* _MSC_VER */
 
+EKK_STATIC_ASSERT((EKK_CACHE_LINE_SIZE & (EKK_CACHE_LINE_SIZE - 1)) == 0 &&
+                  EKK_CACHE_LINE_SIZE >= 16,
+                  "EKK_CACHE_LINE_SIZE must be a power of two, at least 16");
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,391 @@
+/**
+ * @file consensus_canfd_sim.c
+ * @brief EK-KOR2 threshold consensus CAN-FD simulator (host-side)
+ *
+ * Discrete-time simulator measuring time-to-decision of pipelined
+ * threshold ballots on one shared CAN-FD bus. Every round a few modules
+ * each propose several ballots at once; all modules vote yes. For every
+ * module the time from proposal to learning the outcome is recorded, and
+ * the distribution is reported with and without decision certificates.
+ *
+ * NOTE: Frames are serialized on the bus in send order (no arbitration
+ * by ID, no errors or retransmissions). Same timing model as
+ * raft_canfd_sim.c.
+ *
+ * Usage: consensus_canfd_sim [nodes] [proposers] [pipeline] [rounds]
+ */
+
+#include "ekk/ekk_hal.h"
+#include "ekk/ekk_consensus.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ========================================================================== */
+/* SIM CONFIG                                                                 */
+/* ========================================================================== */
+
+#define SIM_MAX_NODES           32
+#define SIM_MAX_FRAMES          4096
+#define SIM_MAX_PROPOSALS       1024
+#define SIM_MAX_SAMPLES         (SIM_MAX_PROPOSALS * SIM_MAX_NODES)
+
+#define SIM_DEFAULT_NODES       8       /* Proposer + EKK_K_NEIGHBORS voters */
+#define SIM_DEFAULT_PROPOSERS   3
+#define SIM_DEFAULT_PIPELINE    4       /* Ballots per proposer per round */
+#define SIM_DEFAULT_ROUNDS      50
+#define SIM_TICK_US             1000
+#define SIM_ROUND_US            (2 * EKK_VOTE_TIMEOUT_US)
+
+/* CAN-FD timing approximation (very rough). */
+#define SIM_ARB_RATE_BPS        1000000   /* 1 Mbps arbitration */
+#define SIM_DATA_RATE_BPS       5000000   /* 5 Mbps data phase */
+#define SIM_ARB_BITS            64
+#define SIM_DATA_OVERHEAD_BITS  48
+
+/* ========================================================================== */
+/* SIM BUS                                                                    */
+/* ========================================================================== */
+
+typedef struct {
+    ekk_time_us_t deliver_at;
+    ekk_module_id_t sender;
+    ekk_module_id_t dest; /* EKK_BROADCAST_ID for broadcast */
+    ekk_msg_type_t type;
+    uint8_t data[64];
+    uint32_t len;
+} sim_frame_t;
+
+static sim_frame_t g_frames[SIM_MAX_FRAMES];
+static size_t g_frame_head = 0;
+static size_t g_frame_count = 0;
+static ekk_time_us_t g_bus_free = 0;
+static ekk_time_us_t g_bus_busy_us = 0;
+static uint32_t g_frames_by_type[256];
+
+static ekk_time_us_t g_now = 0;
+static ekk_module_id_t g_sender_id = 1;
+
+static ekk_time_us_t sim_frame_time_us(uint32_t len) {
+    const uint64_t arb_us = (uint64_t)SIM_ARB_BITS * 1000000ULL / SIM_ARB_RATE_BPS;
+    const uint64_t data_bits = SIM_DATA_OVERHEAD_BITS + (uint64_t)len * 8ULL;
+    const uint64_t data_us = data_bits * 1000000ULL / SIM_DATA_RATE_BPS;
+    return (ekk_time_us_t)(arb_us + data_us);
+}
+
+static void sim_enqueue_frame(ekk_module_id_t sender,
+                              ekk_module_id_t dest,
+                              ekk_msg_type_t type,
+                              const void *data,
+                              uint32_t len) {
+    if (g_frame_count >= SIM_MAX_FRAMES || len > sizeof(g_frames[0].data)) {
+        return;
+    }
+
+    sim_frame_t *f = &g_frames[(g_frame_head + g_frame_count++) % SIM_MAX_FRAMES];
+    f->sender = sender;
+    f->dest = dest;
+    f->type = type;
+    f->len = len;
+    if (len > 0 && data != NULL) {
+        memcpy(f->data, data, len);
+    }
+
+    /* One bus: a frame starts once the previous one is off the wire */
+    ekk_time_us_t start = (g_bus_free > g_now) ? g_bus_free : g_now;
+    ekk_time_us_t duration = sim_frame_time_us(len);
+    f->deliver_at = start + duration;
+    g_bus_free = f->deliver_at;
+    g_bus_busy_us += duration;
+    g_frames_by_type[type & 0xFF]++;
+}
+
+/* ========================================================================== */
+/* SIM NODES                                                                  */
+/* ========================================================================== */
+
+typedef struct {
+    ekk_module_id_t id;
+    ekk_consensus_t cons;
+} sim_node_t;
+
+static sim_node_t g_nodes[SIM_MAX_NODES];
+static size_t g_node_count = 0;
+
+/* Proposal start times, indexed by proposal_data */
+static ekk_time_us_t g_proposed_at[SIM_MAX_PROPOSALS];
+static uint32_t g_proposal_count = 0;
+
+typedef struct {
+    ekk_time_us_t samples[SIM_MAX_SAMPLES];
+    uint32_t count;
+} sim_latency_t;
+
+static sim_latency_t g_proposer_latency;
+static sim_latency_t g_voter_latency;
+static uint32_t g_voter_timeouts = 0;
+
+/* Frames sent from here on come from this node */
+static void sim_set_sender(ekk_module_id_t id) {
+    g_sender_id = id;
+}
+
+static sim_node_t *sim_find_node(ekk_module_id_t id) {
+    for (size_t i = 0; i < g_node_count; i++) {
+        if (g_nodes[i].id == id) {
+            return &g_nodes[i];
+        }
+    }
+    return NULL;
+}
+
+static void sim_on_complete(ekk_consensus_t *cons,
+                            const ekk_ballot_t *ballot,
+                            ekk_vote_result_t result) {
+    if (ballot->proposal_data >= g_proposal_count) {
+        return;
+    }
+
+    bool own = (ballot->proposer == cons->my_id);
+    sim_latency_t *lat = own ? &g_proposer_latency : &g_voter_latency;
+    if (lat->count < SIM_MAX_SAMPLES) {
+        lat->samples[lat->count++] = g_now - g_proposed_at[ballot->proposal_data];
+    }
+    if (!own && result == EKK_VOTE_TIMEOUT) {
+        g_voter_timeouts++;
+    }
+}
+
+static void sim_init_nodes(size_t count, bool certificates) {
+    ekk_consensus_config_t config = EKK_CONSENSUS_CONFIG_DEFAULT;
+    config.broadcast_decision = certificates;
+
+    g_node_count = count;
+    for (size_t i = 0; i < count; i++) {
+        sim_node_t *node = &g_nodes[i];
+        memset(node, 0, sizeof(*node));
+        node->id = (ekk_module_id_t)(i + 1);
+        ekk_consensus_init(&node->cons, node->id, &config);
+        ekk_consensus_set_complete_callback(&node->cons, sim_on_complete);
+    }
+}
+
+static void sim_deliver_frame(sim_node_t *node, const sim_frame_t *frame) {
+    ekk_consensus_t *cons = &node->cons;
+    sim_set_sender(node->id);
+
+    switch (frame->type) {
+        case EKK_MSG_PROPOSAL: {
+            const ekk_proposal_msg_t *msg = (const ekk_proposal_msg_t *)frame->data;
+            ekk_consensus_on_proposal(cons, msg->proposer_id, msg->incarnation, msg->ballot_id,
+                                      (ekk_proposal_type_t)msg->type, msg->data,
+                                      msg->threshold);
+        } break;
+        case EKK_MSG_VOTE: {
+            const ekk_vote_msg_t *msg = (const ekk_vote_msg_t *)frame->data;
+            ekk_consensus_on_vote(cons, msg->voter_id, msg->proposer_id, msg->ballot_id,
+                                  (ekk_vote_value_t)msg->vote);
+        } break;
+        case EKK_MSG_VOTE_BATCH: {
+            const ekk_vote_batch_msg_t *msg = (const ekk_vote_batch_msg_t *)frame->data;
+            for (uint32_t i = 0; i < msg->count && i < EKK_VOTE_BATCH_MAX; i++) {
+                ekk_consensus_on_vote(cons, msg->voter_id, msg->proposer_id,
+                                      msg->entries[i].ballot_id,
+                                      (ekk_vote_value_t)msg->entries[i].vote);
+            }
+        } break;
+        case EKK_MSG_DECISION: {
+            const ekk_decision_msg_t *msg = (const ekk_decision_msg_t *)frame->data;
+            ekk_consensus_on_decision(cons, msg->proposer_id, msg->incarnation, msg->ballot_id,
+                                      (ekk_vote_result_t)msg->result,
+                                      msg->yes_count, msg->vote_count);
+        } break;
+        default:
+            break;
+    }
+}
+
+static void sim_bus_flush(ekk_time_us_t now) {
+    /* Frames leave the wire in order; delivery may queue more behind them */
+    while (g_frame_count > 0 && g_frames[g_frame_head].deliver_at <= now) {
+        sim_frame_t frame = g_frames[g_frame_head];
+        g_frame_head = (g_frame_head + 1) % SIM_MAX_FRAMES;
+        g_frame_count--;
+
+        if (frame.dest == EKK_BROADCAST_ID) {
+            for (size_t n = 0; n < g_node_count; n++) {
+                if (g_nodes[n].id != frame.sender) {
+                    sim_deliver_frame(&g_nodes[n], &frame);
+                }
+            }
+        } else {
+            sim_node_t *target = sim_find_node(frame.dest);
+            if (target != NULL) {
+                sim_deliver_frame(target, &frame);
+            }
+        }
+    }
+}
+
+static void sim_node_tick(sim_node_t *node, ekk_time_us_t now) {
+    sim_set_sender(node->id);
+    ekk_consensus_tick(&node->cons, now);
+}
+
+/* ========================================================================== */
+/* SIM HAL (minimal)                                                          */
+/* ========================================================================== */
+
+ekk_time_us_t ekk_hal_time_us(void) {
+    return g_now;
+}
+
+ekk_error_t ekk_hal_send(ekk_module_id_t dest_id,
+                          ekk_msg_type_t msg_type,
+                          const void *data,
+                          uint32_t len) {
+    sim_enqueue_frame(g_sender_id, dest_id, msg_type, data, len);
+    return EKK_OK;
+}
+
+ekk_error_t ekk_hal_broadcast(ekk_msg_type_t msg_type,
+                               const void *data,
+                               uint32_t len) {
+    sim_enqueue_frame(g_sender_id, EKK_BROADCAST_ID, msg_type, data, len);
+    return EKK_OK;
+}
+
+ekk_error_t ekk_hal_endpoint_send(ekk_hal_endpoint_t *ep,
+                                   ekk_module_id_t dest_id,
+                                   ekk_msg_type_t msg_type,
+                                   const void *data,
+                                   uint32_t len) {
+    sim_enqueue_frame(ep->id, dest_id, msg_type, data, len);
+    return EKK_OK;
+}
+
+
+/* ========================================================================== */
+/* REPORT                                                                     */
+/* ========================================================================== */
+
+static int sim_cmp_time(const void *a, const void *b) {
+    ekk_time_us_t x = *(const ekk_time_us_t *)a;
+    ekk_time_us_t y = *(const ekk_time_us_t *)b;
+    return (x > y) - (x < y);
+}
+
+static void sim_report_latency(const char *name, sim_latency_t *lat) {
+    if (lat->count == 0) {
+        printf("  %-10s no decisions\n", name);
+        return;
+    }
+
+    qsort(lat->samples, lat->count, sizeof(lat->samples[0]), sim_cmp_time);
+    const uint32_t n = lat->count;
+    printf("  %-10s p50 %6llu us  p90 %6llu us  p99 %6llu us  max %6llu us  (%u)\n",
+           name,
+           (unsigned long long)lat->samples[n / 2],
+           (unsigned long long)lat->samples[(n * 9) / 10],
+           (unsigned long long)lat->samples[(n * 99) / 100],
+           (unsigned long long)lat->samples[n - 1],
+           (unsigned)n);
+}
+
+/* ========================================================================== */
+/* MAIN                                                                       */
+/* ========================================================================== */
+
+static void sim_run(const char *label, bool certificates, size_t nodes,
+                    uint32_t proposers, uint32_t pipeline, uint32_t rounds) {
+    memset(g_frames_by_type, 0, sizeof(g_frames_by_type));
+    g_frame_head = 0;
+    g_frame_count = 0;
+    g_bus_free = 0;
+    g_bus_busy_us = 0;
+    g_proposal_count = 0;
+    g_proposer_latency.count = 0;
+    g_voter_latency.count = 0;
+    g_voter_timeouts = 0;
+
+    sim_init_nodes(nodes, certificates);
+
+    const ekk_time_us_t duration = (ekk_time_us_t)rounds * SIM_ROUND_US;
+    for (g_now = 0; g_now < duration + SIM_ROUND_US; g_now += SIM_TICK_US) {
+        /* Round start: proposers issue their ballots back to back */
+        if (g_now % SIM_ROUND_US == 0 && g_now < duration) {
+            for (uint32_t p = 0; p < proposers; p++) {
+                sim_node_t *node = &g_nodes[p];
+                sim_set_sender(node->id);
+                for (uint32_t b = 0; b < pipeline && g_proposal_count < SIM_MAX_PROPOSALS; b++) {
+                    ekk_ballot_id_t ballot;
+                    g_proposed_at[g_proposal_count] = g_now;
+                    if (ekk_consensus_propose(&node->cons, EKK_PROPOSAL_POWER_LIMIT,
+                                              g_proposal_count,
+                                              EKK_THRESHOLD_SUPERMAJORITY,
+                                              &ballot) == EKK_OK) {
+                        g_proposal_count++;
+                    }
+                }
+            }
+        }
+
+        sim_bus_flush(g_now);
+        for (size_t i = 0; i < g_node_count; i++) {
+            sim_node_tick(&g_nodes[i], g_now);
+        }
+    }
+
+    const uint32_t votes = g_frames_by_type[EKK_MSG_VOTE] + g_frames_by_type[EKK_MSG_VOTE_BATCH];
+    printf("%s\n", label);
+    sim_report_latency("proposer", &g_proposer_latency);
+    sim_report_latency("voters", &g_voter_latency);
+    printf("  %u ballots, %.2f vote frames/ballot, %u certificates, "
+           "%u voter timeouts, bus %.1f%% busy\n\n",
+           (unsigned)g_proposal_count,
+           g_proposal_count ? (double)votes / g_proposal_count : 0.0,
+           (unsigned)g_frames_by_type[EKK_MSG_DECISION],
+           (unsigned)g_voter_timeouts,
+           100.0 * (double)g_bus_busy_us / (double)duration);
+}
+
+int main(int argc, char **argv) {
+    size_t nodes = SIM_DEFAULT_NODES;
+    uint32_t proposers = SIM_DEFAULT_PROPOSERS;
+    uint32_t pipeline = SIM_DEFAULT_PIPELINE;
+    uint32_t rounds = SIM_DEFAULT_ROUNDS;
+
+    if (argc > 1) {
+        nodes = (size_t)atoi(argv[1]);
+    }
+    if (argc > 2) {
+        proposers = (uint32_t)atoi(argv[2]);
+    }
+    if (argc > 3) {
+        pipeline = (uint32_t)atoi(argv[3]);
+    }
+    if (argc > 4) {
+        rounds = (uint32_t)atoi(argv[4]);
+    }
+
+    if (nodes < 2) {
+        nodes = 2;
+    }
+    if (nodes > SIM_MAX_NODES) {
+        nodes = SIM_MAX_NODES;
+    }
+    if (proposers > nodes) {
+        proposers = (uint32_t)nodes;
+    }
+
+    printf("Threshold consensus: %u nodes, %u proposers x %u ballots, %u rounds\n\n",
+           (unsigned)nodes, (unsigned)proposers, (unsigned)pipeline, (unsigned)rounds);
+
+    sim_run("Decision certificates:", true, nodes, proposers, pipeline, rounds);
+    sim_run("Voter tally/timeout only:", false, nodes, proposers, pipeline, rounds);
+
+    return 0;
+}
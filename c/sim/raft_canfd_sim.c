@@ -136,7 +136,7 @@ static void sim_init_nodes(size_t count) {
         node->id = (ekk_module_id_t)(i + 1);
 
         ekk_partition_init(&node->partition, (uint32_t)count);
-        ekk_raft_init(&node->raft, node->id, (uint8_t)count, &node->partition);
+        ekk_raft_init(&node->raft, node->id, (uint16_t)count, &node->partition);
         ekk_raft_set_callbacks(&node->raft, sim_on_leader, NULL, NULL, node);
     }
 }
@@ -352,12 +352,15 @@ void ekk_auth_final(ekk_auth_ctx_t *ctx, ekk_auth_tag_t *tag) {
 bool ekk_auth_is_required(uint8_t msg_type) {
     switch (msg_type) {
         case 0x04: /* EKK_MSG_PROPOSAL */
+        case 0x0A: /* EKK_MSG_DECISION (finalizes ballots on receipt) */
             return EKK_AUTH_REQUIRED_PROPOSAL != 0;
         case 0x05: /* EKK_MSG_VOTE */
+        case 0x0B: /* EKK_MSG_VOTE_BATCH (same votes, batched) */
             return EKK_AUTH_REQUIRED_VOTE != 0;
         case 0x08: /* EKK_MSG_SHUTDOWN (emergency) */
             return EKK_AUTH_REQUIRED_EMERGENCY != 0;
         case 0x01: /* EKK_MSG_HEARTBEAT */
+        case 0x09: /* EKK_MSG_ECHO (RTT feeds neighbor selection) */
             return EKK_AUTH_REQUIRED_HEARTBEAT != 0;
         case 0x02: /* EKK_MSG_DISCOVERY */
             return EKK_AUTH_REQUIRED_DISCOVERY != 0;
@@ -367,15 +370,19 @@ bool ekk_auth_is_required(uint8_t msg_type) {
 }
 
 void ekk_auth_message(const ekk_auth_key_t *key,
-                       uint8_t sender_id, uint8_t msg_type,
+                       ekk_module_id_t sender_id, uint8_t msg_type,
                        const void *data, uint32_t len,
                        ekk_auth_tag_t *tag) {
     ekk_auth_ctx_t ctx;
     ekk_auth_init(&ctx, key);
 
     /* Authenticate: sender_id | msg_type | data */
-    uint8_t header[2] = { sender_id, msg_type };
-    ekk_auth_update(&ctx, header, 2);
+    uint8_t header[sizeof(ekk_module_id_t) + 1];
+    for (size_t i = 0; i < sizeof(ekk_module_id_t); i++) {
+        header[i] = (uint8_t)((uint32_t)sender_id >> (8 * i));
+    }
+    header[sizeof(ekk_module_id_t)] = msg_type;
+    ekk_auth_update(&ctx, header, sizeof(header));
     if (data && len > 0) {
         ekk_auth_update(&ctx, data, len);
     }
@@ -384,7 +391,7 @@ void ekk_auth_message(const ekk_auth_key_t *key,
 }
 
 bool ekk_auth_verify_message(const ekk_auth_key_t *key,
-                              uint8_t sender_id, uint8_t msg_type,
+                              ekk_module_id_t sender_id, uint8_t msg_type,
                               const void *data, uint32_t len,
                               const ekk_auth_tag_t *tag) {
     ekk_auth_tag_t computed;
@@ -400,31 +407,51 @@ void ekk_auth_keyring_init(ekk_auth_keyring_t *ring) {
     memset(ring, 0, sizeof(ekk_auth_keyring_t));
 }
 
+/**
+ * @brief Key slot of a module (-1 = no key)
+ */
+static int32_t keyring_slot(const ekk_auth_keyring_t *ring, ekk_module_id_t id) {
+    if (!EKK_MODULE_ID_VALID(id)) return -1;
+#if EKK_MODULE_ID_BITS > 8
+    return ekk_idmap_find(&ring->slots, id);
+#else
+    return (ring->valid[id / 8] & (1 << (id % 8))) ? (int32_t)id : -1;
+#endif
+}
+
 void ekk_auth_keyring_set(ekk_auth_keyring_t *ring,
                            ekk_module_id_t id,
                            const uint8_t raw_key[16]) {
-    if (id == 0 || id > EKK_MAX_MODULES) return;
+    if (!EKK_MODULE_ID_VALID(id)) return;
 
-    ekk_auth_key_init(&ring->keys[id], raw_key);
+#if EKK_MODULE_ID_BITS > 8
+    int32_t slot = ekk_idmap_insert(&ring->slots, id);
+    if (slot < 0) return;
+#else
+    int32_t slot = id;
     ring->valid[id / 8] |= (1 << (id % 8));
+#endif
+    ekk_auth_key_init(&ring->keys[slot], raw_key);
 }
 
 const ekk_auth_key_t *ekk_auth_keyring_get(const ekk_auth_keyring_t *ring,
                                             ekk_module_id_t id) {
-    if (!ekk_auth_keyring_has(ring, id)) {
-        return NULL;
-    }
-    return &ring->keys[id];
+    int32_t slot = keyring_slot(ring, id);
+    return (slot < 0) ? NULL : &ring->keys[slot];
 }
 
 bool ekk_auth_keyring_has(const ekk_auth_keyring_t *ring, ekk_module_id_t id) {
-    if (id == 0 || id > EKK_MAX_MODULES) return false;
-    return (ring->valid[id / 8] & (1 << (id % 8))) != 0;
+    return keyring_slot(ring, id) >= 0;
 }
 
 void ekk_auth_keyring_clear(ekk_auth_keyring_t *ring, ekk_module_id_t id) {
-    if (id == 0 || id > EKK_MAX_MODULES) return;
+    int32_t slot = keyring_slot(ring, id);
+    if (slot < 0) return;
 
-    ekk_auth_key_clear(&ring->keys[id]);
+    ekk_auth_key_clear(&ring->keys[slot]);
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_remove(&ring->slots, id);
+#else
     ring->valid[id / 8] &= ~(1 << (id % 8));
+#endif
 }
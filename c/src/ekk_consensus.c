@@ -14,30 +14,220 @@
 #include "ekk/ekk_hal.h"
 #include <string.h>
 
+EKK_STATIC_ASSERT(EKK_BALLOT_SEQ_BITS >= 1 && EKK_BALLOT_SEQ_BITS <= 16,
+                  "Ballot sequence must fit in a ballot ID");
+EKK_STATIC_ASSERT(EKK_MAX_BALLOTS < (1u << EKK_BALLOT_SEQ_BITS) - 1u,
+                  "Ballot ID range must outnumber the ballot table");
+EKK_STATIC_ASSERT(EKK_BALLOT_HISTORY >= 1, "Ballot history must not be empty");
+
 /* ============================================================================
- * PRIVATE STATE
+ * PRIVATE HELPERS
  * ============================================================================ */
 
-/** Decision callback (application decides how to vote) */
-static ekk_consensus_decide_cb g_decide_callback = NULL;
+#define BALLOT_SEQ_MASK     ((1u << EKK_BALLOT_SEQ_BITS) - 1u)
 
-/** Completion callback (application notified of results) */
-static ekk_consensus_complete_cb g_complete_callback = NULL;
+#define BUCKET(id, slot)    (((uint32_t)(id) << 16) | ((uint32_t)(slot) + 1u))
+#define BUCKET_ID(b)        ((ekk_ballot_id_t)((b) >> 16))
+#define BUCKET_SLOT(b)      (((b) & 0xFFFFu) - 1u)
 
-/* ============================================================================
- * PRIVATE HELPERS
- * ============================================================================ */
+/**
+ * @brief First ballot ID of a proposer's range
+ *
+ * Module N owns IDs ((N - 1) << EKK_BALLOT_SEQ_BITS) + 1 onward, so module 1
+ * numbers its ballots 1, 2, 3... With 16-bit module IDs the range wraps and
+ * two proposers may share one; lookups that know the proposer match on it.
+ */
+static ekk_ballot_id_t ballot_range(ekk_module_id_t proposer)
+{
+    return (ekk_ballot_id_t)((((uint32_t)proposer - 1u) << EKK_BALLOT_SEQ_BITS) & 0xFFFFu);
+}
+
+/**
+ * @brief Lowest module ID whose range holds a ballot ID
+ *
+ * The only possible owner with 8-bit module IDs; with 16-bit IDs the
+ * first of the modules sharing the range.
+ */
+static ekk_module_id_t range_owner(ekk_ballot_id_t id)
+{
+    return (ekk_module_id_t)(((uint32_t)id >> EKK_BALLOT_SEQ_BITS) + 1u);
+}
+
+/**
+ * @brief Does a ballot ID lie in a proposer's range?
+ *
+ * With 16-bit module IDs ranges are shared, so this rules out only
+ * IDs the proposer can never have allocated.
+ */
+static bool ballot_owned_by(ekk_module_id_t proposer, ekk_ballot_id_t id)
+{
+    return ((uint32_t)id & ~BALLOT_SEQ_MASK) == ballot_range(proposer) &&
+           ((uint32_t)id & BALLOT_SEQ_MASK) != 0;
+}
+
+/**
+ * @brief Do certified counts support a result at a threshold?
+ *
+ * Mirrors evaluate_ballot(): the proposer approves once yes/K reaches
+ * the threshold, or at its deadline on yes/votes, so any genuine
+ * approval has yes/votes at or above it. Rejection and timeout leave
+ * yes/votes below it.
+ */
+static bool certificate_valid(ekk_vote_result_t result, uint32_t yes_count,
+                              uint32_t vote_count, ekk_fixed_t threshold)
+{
+    if (yes_count > vote_count || vote_count > EKK_K_NEIGHBORS) {
+        return false;
+    }
+
+    ekk_fixed_t ratio = (vote_count > 0) ?
+        (ekk_fixed_t)(((int64_t)yes_count << 16) / vote_count) : 0;
+
+    switch (result) {
+        case EKK_VOTE_APPROVED:
+            return vote_count > 0 && ratio >= threshold;
+        case EKK_VOTE_REJECTED:
+        case EKK_VOTE_TIMEOUT:
+            return vote_count == 0 || ratio < threshold;
+        default:
+            return false;
+    }
+}
+
+static inline uint32_t bucket_home(ekk_ballot_id_t id)
+{
+    /* Fibonacci hashing: a proposer's consecutive IDs land far apart */
+    return ((uint32_t)id * 2654435769u >> 16) % EKK_BALLOT_BUCKETS;
+}
+
+static inline uint32_t bucket_next(uint32_t i)
+{
+    return (i + 1 == EKK_BALLOT_BUCKETS) ? 0 : i + 1;
+}
+
+/**
+ * @brief Map a ballot ID to a table slot
+ */
+static void index_insert(uint32_t *index, ekk_ballot_id_t id, uint32_t slot)
+{
+    uint32_t i = bucket_home(id);
+    while (index[i] != 0) {
+        i = bucket_next(i);
+    }
+    index[i] = BUCKET(id, slot);
+}
+
+/**
+ * @brief Bucket holding an exact (ID, slot) mapping
+ * @return Bucket index, or -1 if not mapped
+ */
+static int32_t index_locate(const uint32_t *index, ekk_ballot_id_t id, uint32_t slot)
+{
+    uint32_t i = bucket_home(id);
+    for (uint32_t n = 0; n < EKK_BALLOT_BUCKETS && index[i] != 0; n++) {
+        if (index[i] == BUCKET(id, slot)) {
+            return (int32_t)i;
+        }
+        i = bucket_next(i);
+    }
+    return -1;
+}
+
+/**
+ * @brief Unmap a slot
+ *
+ * Backward-shift deletion: later entries of the probe chain move up into
+ * the hole, so the index never accumulates tombstones under churn.
+ */
+static void index_remove(uint32_t *index, ekk_ballot_id_t id, uint32_t slot)
+{
+    int32_t pos = index_locate(index, id, slot);
+    if (pos < 0) {
+        return;
+    }
+
+    uint32_t hole = (uint32_t)pos;
+    uint32_t j = bucket_next(hole);
+    while (index[j] != 0) {
+        uint32_t home = bucket_home(BUCKET_ID(index[j]));
+        /* Entry may fill the hole unless its home lies in (hole, j] */
+        bool stays = (hole <= j) ? (hole < home && home <= j)
+                                 : (hole < home || home <= j);
+        if (!stays) {
+            index[hole] = index[j];
+            hole = j;
+        }
+        j = bucket_next(j);
+    }
+    index[hole] = 0;
+}
+
+/**
+ * @brief Repoint a mapping after its entry moved from one slot to another
+ */
+static void index_move(uint32_t *index, ekk_ballot_id_t id, uint32_t from, uint32_t to)
+{
+    int32_t pos = index_locate(index, id, from);
+    if (pos >= 0) {
+        index[pos] = BUCKET(id, to);
+    }
+}
 
 /**
  * @brief Find ballot by ID
+ * @param proposer Required proposer, or EKK_INVALID_MODULE_ID for any
  * @return Index if found, -1 otherwise
  */
-static int find_ballot_index(const ekk_consensus_t *cons, ekk_ballot_id_t id)
+static int find_ballot_index(const ekk_consensus_t *cons, ekk_module_id_t proposer,
+                             ekk_ballot_id_t id)
 {
-    for (uint32_t i = 0; i < cons->active_ballot_count; i++) {
-        if (cons->ballots[i].id == id) {
-            return (int)i;
+    uint32_t i = bucket_home(id);
+    for (uint32_t n = 0; n < EKK_BALLOT_BUCKETS; n++) {
+        uint32_t b = cons->ballot_index[i];
+        if (b == 0) {
+            break;
+        }
+        if (BUCKET_ID(b) == id) {
+            uint32_t slot = BUCKET_SLOT(b);
+            if (proposer == EKK_INVALID_MODULE_ID ||
+                cons->ballots[slot].proposer == proposer) {
+                return (int)slot;
+            }
+        }
+        i = bucket_next(i);
+    }
+    return -1;
+}
+
+/**
+ * @brief Find a ballot by ID alone, our own first
+ *
+ * For the ID-only API: with 16-bit module IDs a remote proposer may
+ * share our range, and the caller most likely means the ID we handed out.
+ */
+static int find_local_ballot(const ekk_consensus_t *cons, ekk_ballot_id_t id)
+{
+    int idx = find_ballot_index(cons, cons->my_id, id);
+    return (idx >= 0) ? idx : find_ballot_index(cons, EKK_INVALID_MODULE_ID, id);
+}
+
+/**
+ * @brief Find inhibition entry by proposer and ballot ID
+ * @return Index if found, -1 otherwise
+ */
+static int find_inhibit_index(const ekk_consensus_t *cons, ekk_module_id_t proposer,
+                              ekk_ballot_id_t id)
+{
+    uint32_t i = bucket_home(id);
+    for (uint32_t n = 0; n < EKK_BALLOT_BUCKETS; n++) {
+        uint32_t b = cons->inhibit_index[i];
+        if (b == 0) {
+            break;
+        }
+        if (BUCKET_ID(b) == id && cons->inhibited_proposer[BUCKET_SLOT(b)] == proposer) {
+            return (int)BUCKET_SLOT(b);
         }
+        i = bucket_next(i);
     }
     return -1;
 }
@@ -45,23 +235,128 @@ static int find_ballot_index(const ekk_consensus_t *cons, ekk_ballot_id_t id)
 /**
  * @brief Check if a ballot is inhibited
  */
-static bool is_inhibited(const ekk_consensus_t *cons, ekk_ballot_id_t ballot_id,
-                          ekk_time_us_t now)
+static bool is_inhibited(const ekk_consensus_t *cons, ekk_module_id_t proposer,
+                          ekk_ballot_id_t ballot_id, ekk_time_us_t now)
 {
-    for (uint32_t i = 0; i < cons->inhibit_count; i++) {
-        if (cons->inhibited[i] == ballot_id && cons->inhibit_until[i] > now) {
-            return true;
+    int idx = find_inhibit_index(cons, proposer, ballot_id);
+    return idx >= 0 && cons->inhibit_until[idx] > now;
+}
+
+/**
+ * @brief Drop an inhibition, moving the last entry into its slot
+ */
+static void remove_inhibit(ekk_consensus_t *cons, uint32_t idx)
+{
+    uint32_t last = cons->inhibit_count - 1;
+
+    index_remove(cons->inhibit_index, cons->inhibited[idx], idx);
+    if (idx != last) {
+        cons->inhibited[idx] = cons->inhibited[last];
+        cons->inhibited_proposer[idx] = cons->inhibited_proposer[last];
+        cons->inhibit_until[idx] = cons->inhibit_until[last];
+        index_move(cons->inhibit_index, cons->inhibited[idx], last, idx);
+    }
+    cons->inhibit_count--;
+}
+
+/**
+ * @brief Inhibit a proposer's ballot until the given time
+ *
+ * Refreshes an existing entry; when the table is full the entry closest
+ * to expiry is evicted.
+ */
+static void add_inhibit(ekk_consensus_t *cons, ekk_module_id_t proposer,
+                        ekk_ballot_id_t ballot_id, ekk_time_us_t until)
+{
+    int idx = find_inhibit_index(cons, proposer, ballot_id);
+    if (idx >= 0) {
+        cons->inhibit_until[idx] = until;
+        return;
+    }
+
+    if (cons->inhibit_count >= EKK_MAX_BALLOTS) {
+        uint32_t oldest = 0;
+        for (uint32_t i = 1; i < cons->inhibit_count; i++) {
+            if (cons->inhibit_until[i] < cons->inhibit_until[oldest]) {
+                oldest = i;
+            }
+        }
+        remove_inhibit(cons, oldest);
+    }
+
+    uint32_t slot = cons->inhibit_count++;
+    cons->inhibited[slot] = ballot_id;
+    cons->inhibited_proposer[slot] = proposer;
+    cons->inhibit_until[slot] = until;
+    index_insert(cons->inhibit_index, ballot_id, slot);
+}
+
+/**
+ * @brief Find a completed ballot in the history ring (newest first)
+ * @param proposer Required proposer, or EKK_INVALID_MODULE_ID for any
+ * @return Outcome, or NULL if not remembered
+ */
+static const ekk_ballot_outcome_t *find_outcome(const ekk_consensus_t *cons,
+                                                ekk_module_id_t proposer,
+                                                ekk_ballot_id_t id)
+{
+    uint32_t i = cons->history_head;
+    for (uint32_t n = 0; n < EKK_BALLOT_HISTORY; n++) {
+        i = (i == 0) ? EKK_BALLOT_HISTORY - 1 : i - 1;
+        const ekk_ballot_outcome_t *o = &cons->history[i];
+        if (o->id == id && (proposer == EKK_INVALID_MODULE_ID || o->proposer == proposer)) {
+            return o;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Remove the ballot in a slot, moving the last ballot into it
+ */
+static void remove_ballot(ekk_consensus_t *cons, uint32_t idx)
+{
+    uint32_t last = cons->active_ballot_count - 1;
+
+    index_remove(cons->ballot_index, cons->ballots[idx].id, idx);
+    if (idx != last) {
+        cons->ballots[idx] = cons->ballots[last];
+        index_move(cons->ballot_index, cons->ballots[idx].id, last, idx);
+    }
+    cons->active_ballot_count--;
+}
+
+/**
+ * @brief Remove completed ballots from active list
+ *
+ * Their outcomes were recorded in the history ring when they finalized.
+ */
+static void cleanup_completed_ballots(ekk_consensus_t *cons)
+{
+    uint32_t i = 0;
+
+    while (i < cons->active_ballot_count) {
+        if (cons->ballots[i].completed) {
+            remove_ballot(cons, i);
+        } else {
+            i++;
         }
     }
-    return false;
 }
 
 /**
  * @brief Allocate a free ballot slot
+ *
+ * Reclaims completed ballots first when the table is full, so a new
+ * proposal only fails while EKK_MAX_BALLOTS ballots are still voting.
+ *
  * @return Index of free slot, -1 if none available
  */
 static int allocate_ballot_slot(ekk_consensus_t *cons)
 {
+    if (cons->active_ballot_count >= EKK_MAX_BALLOTS) {
+        cleanup_completed_ballots(cons);
+    }
     if (cons->active_ballot_count >= EKK_MAX_BALLOTS) {
         return -1;
     }
@@ -69,6 +364,37 @@ static int allocate_ballot_slot(ekk_consensus_t *cons)
     return (int)cons->active_ballot_count;
 }
 
+/**
+ * @brief Publish a ballot written into the slot from allocate_ballot_slot()
+ */
+static void commit_ballot_slot(ekk_consensus_t *cons, int idx)
+{
+    index_insert(cons->ballot_index, cons->ballots[idx].id, (uint32_t)idx);
+    cons->active_ballot_count++;
+}
+
+/**
+ * @brief Next free ID from this module's range
+ *
+ * The sequence wraps within the range, skipping 0 and any ID still in
+ * the table (the range is larger than the table, so one is always free).
+ */
+static ekk_ballot_id_t allocate_ballot_id(ekk_consensus_t *cons)
+{
+    ekk_ballot_id_t id;
+
+    do {
+        id = cons->next_ballot_id;
+        uint32_t seq = ((uint32_t)id & BALLOT_SEQ_MASK) + 1u;
+        if (seq > BALLOT_SEQ_MASK) {
+            seq = 1;
+        }
+        cons->next_ballot_id = (ekk_ballot_id_t)(((uint32_t)id & ~BALLOT_SEQ_MASK) | seq);
+    } while (find_ballot_index(cons, cons->my_id, id) >= 0);
+
+    return id;
+}
+
 /**
  * @brief Evaluate ballot result based on votes and threshold
  */
@@ -126,74 +452,205 @@ static ekk_vote_result_t evaluate_ballot(const ekk_ballot_t *ballot,
 }
 
 /**
- * @brief Finalize a ballot with a result
+ * @brief Append an outcome to the history ring
  */
-static void finalize_ballot(ekk_consensus_t *cons, ekk_ballot_t *ballot,
-                             ekk_vote_result_t result)
+static void record_outcome(ekk_consensus_t *cons, ekk_module_id_t proposer,
+                           uint8_t incarnation, ekk_ballot_id_t id,
+                           ekk_vote_result_t result, uint8_t yes_count,
+                           uint8_t vote_count, bool verified)
 {
-    ballot->result = result;
-    ballot->completed = true;
+    ekk_ballot_outcome_t *outcome = &cons->history[cons->history_head];
+    outcome->id = id;
+    outcome->proposer = proposer;
+    outcome->incarnation = incarnation;
+    outcome->result = (uint8_t)result;
+    outcome->yes_count = yes_count;
+    outcome->vote_count = vote_count;
+    outcome->verified = verified;
+    cons->history_head = (cons->history_head + 1) % EKK_BALLOT_HISTORY;
+}
 
-    /* Invoke completion callback */
-    if (g_complete_callback != NULL) {
-        g_complete_callback(cons, ballot, result);
-    }
+/**
+ * @brief Broadcast the outcome of one of our ballots
+ */
+static ekk_error_t broadcast_decision(const ekk_consensus_t *cons,
+                                       const ekk_ballot_t *ballot,
+                                       ekk_time_us_t now)
+{
+    ekk_decision_msg_t msg = {
+        .msg_type = EKK_MSG_DECISION,
+        .proposer_id = cons->my_id,
+        .incarnation = cons->incarnation,
+        .ballot_id = ballot->id,
+        .result = (uint8_t)ballot->result,
+        .yes_count = ballot->yes_count,
+        .vote_count = ballot->vote_count,
+    };
+
+    return ekk_heartbeat_piggyback(cons->liveness, EKK_MSG_DECISION, &msg, sizeof(msg), now);
 }
 
 /**
- * @brief Remove completed ballots from active list
+ * @brief Finalize a ballot with a result
+ *
+ * Our own ballots certify the outcome to the voters (cancellation is
+ * already announced by the inhibit broadcast).
  */
-static void cleanup_completed_ballots(ekk_consensus_t *cons)
+static void finalize_ballot(ekk_consensus_t *cons, ekk_ballot_t *ballot,
+                             ekk_vote_result_t result, ekk_time_us_t now)
 {
-    uint32_t write_idx = 0;
+    ballot->result = result;
+    ballot->completed = true;
+    ballot->vote_queued = false;
 
-    for (uint32_t read_idx = 0; read_idx < cons->active_ballot_count; read_idx++) {
-        if (!cons->ballots[read_idx].completed) {
-            if (write_idx != read_idx) {
-                cons->ballots[write_idx] = cons->ballots[read_idx];
-            }
-            write_idx++;
-        }
+    /* Remember the outcome after the ballot leaves the table */
+    record_outcome(cons, ballot->proposer, ballot->incarnation, ballot->id, result,
+                   ballot->yes_count, ballot->vote_count, true);
+
+    if (ballot->proposer == cons->my_id && result != EKK_VOTE_CANCELLED &&
+        cons->config.broadcast_decision) {
+        broadcast_decision(cons, ballot, now);
     }
 
-    cons->active_ballot_count = write_idx;
+    /* Invoke completion callback */
+    if (cons->on_complete != NULL) {
+        cons->on_complete(cons, ballot, result);
+    }
 }
 
 /**
  * @brief Broadcast proposal to neighbors
  */
 static ekk_error_t broadcast_proposal(const ekk_consensus_t *cons,
-                                       const ekk_ballot_t *ballot)
+                                       const ekk_ballot_t *ballot,
+                                       ekk_time_us_t now)
 {
     ekk_proposal_msg_t msg = {
         .msg_type = EKK_MSG_PROPOSAL,
         .proposer_id = cons->my_id,
+        .incarnation = cons->incarnation,
         .ballot_id = ballot->id,
         .type = ballot->type,
         .data = ballot->proposal_data,
         .threshold = ballot->threshold,
     };
 
-    return ekk_hal_broadcast(EKK_MSG_PROPOSAL, &msg, sizeof(msg));
+    return ekk_heartbeat_piggyback(cons->liveness, EKK_MSG_PROPOSAL, &msg, sizeof(msg), now);
 }
 
 /**
- * @brief Send vote to proposer
+ * @brief Send vote to proposer (or broadcast an inhibit)
  */
 static ekk_error_t send_vote(const ekk_consensus_t *cons,
+                              ekk_module_id_t dest_id,
                               ekk_module_id_t proposer_id,
                               ekk_ballot_id_t ballot_id,
                               ekk_vote_value_t vote)
 {
+    ekk_time_us_t now = ekk_hal_time_us();
     ekk_vote_msg_t msg = {
         .msg_type = EKK_MSG_VOTE,
         .voter_id = cons->my_id,
+        .proposer_id = proposer_id,
         .ballot_id = ballot_id,
         .vote = vote,
-        .timestamp = (uint32_t)(ekk_hal_time_us() & 0xFFFFFFFF),
+        .timestamp = (uint32_t)(now & 0xFFFFFFFF),
     };
 
-    return ekk_hal_send(proposer_id, EKK_MSG_VOTE, &msg, sizeof(msg));
+    return ekk_heartbeat_piggyback_to(cons->liveness, dest_id, EKK_MSG_VOTE,
+                                      &msg, sizeof(msg), now);
+}
+
+/**
+ * @brief Drop what is held for an earlier incarnation of a proposer
+ *
+ * A restarted proposer numbers its ballots from the start of its range
+ * again, so its old ballots, outcomes and inhibitions would shadow the
+ * new ones. Open ballots of the old incarnation end as CANCELLED.
+ */
+static void forget_incarnation(ekk_consensus_t *cons, ekk_module_id_t proposer,
+                               uint8_t incarnation, ekk_time_us_t now)
+{
+    bool restarted = false;
+
+    uint32_t i = 0;
+    while (i < cons->active_ballot_count) {
+        ekk_ballot_t *ballot = &cons->ballots[i];
+        if (ballot->proposer == proposer && ballot->incarnation != incarnation) {
+            if (!ballot->completed) {
+                finalize_ballot(cons, ballot, EKK_VOTE_CANCELLED, now);
+            }
+            remove_ballot(cons, i);
+            restarted = true;
+        } else {
+            i++;
+        }
+    }
+
+    for (i = 0; i < EKK_BALLOT_HISTORY; i++) {
+        ekk_ballot_outcome_t *outcome = &cons->history[i];
+        if (outcome->id != EKK_INVALID_BALLOT_ID && outcome->proposer == proposer &&
+            outcome->incarnation != incarnation) {
+            outcome->id = EKK_INVALID_BALLOT_ID;
+            restarted = true;
+        }
+    }
+
+    if (!restarted) {
+        return;
+    }
+
+    i = 0;
+    while (i < cons->inhibit_count) {
+        if (cons->inhibited_proposer[i] == proposer) {
+            remove_inhibit(cons, i);
+        } else {
+            i++;
+        }
+    }
+}
+
+/**
+ * @brief Send queued votes, one frame per proposer
+ *
+ * Votes owed to the same proposer share an EKK_MSG_VOTE_BATCH frame; a
+ * lone vote goes out as a plain EKK_MSG_VOTE.
+ */
+static void flush_votes(ekk_consensus_t *cons)
+{
+    for (uint32_t i = 0; i < cons->active_ballot_count; i++) {
+        ekk_ballot_t *first = &cons->ballots[i];
+        if (!first->vote_queued) {
+            continue;
+        }
+
+        ekk_vote_batch_msg_t batch = {
+            .msg_type = EKK_MSG_VOTE_BATCH,
+            .voter_id = cons->my_id,
+            .proposer_id = first->proposer,
+            .count = 0,
+        };
+        for (uint32_t j = i; j < cons->active_ballot_count &&
+                             batch.count < EKK_VOTE_BATCH_MAX; j++) {
+            ekk_ballot_t *ballot = &cons->ballots[j];
+            if (ballot->vote_queued && ballot->proposer == first->proposer) {
+                batch.entries[batch.count].ballot_id = ballot->id;
+                batch.entries[batch.count].vote = ballot->my_vote;
+                batch.count++;
+                ballot->vote_queued = false;
+            }
+        }
+
+        if (batch.count == 1) {
+            send_vote(cons, first->proposer, first->proposer, first->id,
+                      (ekk_vote_value_t)first->my_vote);
+        } else {
+            ekk_heartbeat_piggyback_to(cons->liveness, first->proposer,
+                                       EKK_MSG_VOTE_BATCH, &batch,
+                                       (uint32_t)EKK_VOTE_BATCH_LEN(batch.count),
+                                       ekk_hal_time_us());
+        }
+    }
 }
 
 /* ============================================================================
@@ -210,7 +667,11 @@ ekk_error_t ekk_consensus_init(ekk_consensus_t *cons,
 
     memset(cons, 0, sizeof(ekk_consensus_t));
     cons->my_id = my_id;
-    cons->next_ballot_id = 1;  /* 0 is invalid */
+    cons->next_ballot_id = ballot_range(my_id) | 1u;  /* Sequence 0 is never used */
+
+    /* Tells a restart apart from a replay; see ekk_consensus_set_incarnation() */
+    uint32_t seed = (uint32_t)ekk_hal_time_us();
+    ekk_consensus_set_incarnation(cons, (uint8_t)(seed ^ (seed >> 8) ^ (seed >> 16) ^ (seed >> 24)));
 
     /* Apply configuration */
     if (config != NULL) {
@@ -223,6 +684,15 @@ ekk_error_t ekk_consensus_init(ekk_consensus_t *cons,
     return EKK_OK;
 }
 
+void ekk_consensus_set_incarnation(ekk_consensus_t *cons, uint8_t incarnation)
+{
+    if (cons == NULL) {
+        return;
+    }
+
+    cons->incarnation = (incarnation != 0) ? incarnation : 1;
+}
+
 /* ============================================================================
  * PROPOSAL CREATION
  * ============================================================================ */
@@ -249,9 +719,10 @@ ekk_error_t ekk_consensus_propose(ekk_consensus_t *cons,
     ekk_ballot_t *ballot = &cons->ballots[idx];
     memset(ballot, 0, sizeof(ekk_ballot_t));
 
-    ballot->id = cons->next_ballot_id++;
+    ballot->id = allocate_ballot_id(cons);
     ballot->type = type;
     ballot->proposer = cons->my_id;
+    ballot->incarnation = cons->incarnation;
     ballot->proposal_data = data;
     ballot->threshold = threshold;
     ballot->deadline = now + cons->config.vote_timeout;
@@ -269,10 +740,10 @@ ekk_error_t ekk_consensus_propose(ekk_consensus_t *cons,
         ballot->yes_count = 1;
     }
 
-    cons->active_ballot_count++;
+    commit_ballot_slot(cons, idx);
 
     /* Broadcast proposal */
-    broadcast_proposal(cons, ballot);
+    broadcast_proposal(cons, ballot, now);
 
     *ballot_id = ballot->id;
     return EKK_OK;
@@ -291,9 +762,11 @@ ekk_error_t ekk_consensus_vote(ekk_consensus_t *cons,
     }
 
     /* Find ballot */
-    int idx = find_ballot_index(cons, ballot_id);
+    int idx = find_local_ballot(cons, ballot_id);
     if (idx < 0) {
-        return EKK_ERR_NOT_FOUND;
+        /* Cannot vote on completed ballot */
+        return (find_outcome(cons, EKK_INVALID_MODULE_ID, ballot_id) != NULL) ?
+            EKK_ERR_BUSY : EKK_ERR_NOT_FOUND;
     }
 
     ekk_ballot_t *ballot = &cons->ballots[idx];
@@ -303,8 +776,9 @@ ekk_error_t ekk_consensus_vote(ekk_consensus_t *cons,
         return EKK_ERR_BUSY;
     }
 
-    /* Send vote to proposer */
-    return send_vote(cons, ballot->proposer, ballot_id, vote);
+    /* Send vote to proposer (supersedes a queued one) */
+    ballot->vote_queued = false;
+    return send_vote(cons, ballot->proposer, ballot->proposer, ballot_id, vote);
 }
 
 /* ============================================================================
@@ -318,39 +792,26 @@ ekk_error_t ekk_consensus_inhibit(ekk_consensus_t *cons,
         return EKK_ERR_INVALID_ARG;
     }
 
-    /* Check if already inhibited */
-    ekk_time_us_t now = ekk_hal_time_us();
-    for (uint32_t i = 0; i < cons->inhibit_count; i++) {
-        if (cons->inhibited[i] == ballot_id) {
-            /* Update expiry */
-            cons->inhibit_until[i] = now + cons->config.inhibit_duration;
-            return EKK_OK;
-        }
-    }
+    int idx = find_local_ballot(cons, ballot_id);
+    ekk_module_id_t proposer = (idx >= 0) ? cons->ballots[idx].proposer :
+                                            range_owner(ballot_id);
 
-    /* Add new inhibition */
-    if (cons->inhibit_count >= EKK_MAX_BALLOTS) {
-        /* Evict oldest */
-        for (uint32_t i = 0; i < cons->inhibit_count - 1; i++) {
-            cons->inhibited[i] = cons->inhibited[i + 1];
-            cons->inhibit_until[i] = cons->inhibit_until[i + 1];
-        }
-        cons->inhibit_count--;
+    /* Add new inhibition, or update expiry if already inhibited */
+    ekk_time_us_t now = ekk_hal_time_us();
+    bool already = find_inhibit_index(cons, proposer, ballot_id) >= 0;
+    add_inhibit(cons, proposer, ballot_id, now + cons->config.inhibit_duration);
+    if (already) {
+        return EKK_OK;
     }
 
-    cons->inhibited[cons->inhibit_count] = ballot_id;
-    cons->inhibit_until[cons->inhibit_count] = now + cons->config.inhibit_duration;
-    cons->inhibit_count++;
-
     /* Mark local ballot as cancelled if we have it */
-    int idx = find_ballot_index(cons, ballot_id);
-    if (idx >= 0) {
-        finalize_ballot(cons, &cons->ballots[idx], EKK_VOTE_CANCELLED);
+    if (idx >= 0 && !cons->ballots[idx].completed) {
+        finalize_ballot(cons, &cons->ballots[idx], EKK_VOTE_CANCELLED, now);
     }
 
     /* Broadcast inhibit message */
     /* Note: Using vote message with INHIBIT value */
-    send_vote(cons, EKK_BROADCAST_ID, ballot_id, EKK_VOTE_INHIBIT);
+    send_vote(cons, EKK_BROADCAST_ID, proposer, ballot_id, EKK_VOTE_INHIBIT);
 
     return EKK_OK;
 }
@@ -361,11 +822,12 @@ ekk_error_t ekk_consensus_inhibit(ekk_consensus_t *cons,
 
 ekk_error_t ekk_consensus_on_vote(ekk_consensus_t *cons,
                                    ekk_module_id_t voter_id,
+                                   ekk_module_id_t proposer_id,
                                    ekk_ballot_id_t ballot_id,
                                    ekk_vote_value_t vote)
 {
     if (cons == NULL || voter_id == EKK_INVALID_MODULE_ID ||
-        ballot_id == EKK_INVALID_BALLOT_ID) {
+        proposer_id == EKK_INVALID_MODULE_ID || ballot_id == EKK_INVALID_BALLOT_ID) {
         return EKK_ERR_INVALID_ARG;
     }
 
@@ -374,35 +836,39 @@ ekk_error_t ekk_consensus_on_vote(ekk_consensus_t *cons,
         ekk_time_us_t now = ekk_hal_time_us();
 
         /* Add to inhibit list */
-        if (cons->inhibit_count < EKK_MAX_BALLOTS) {
-            cons->inhibited[cons->inhibit_count] = ballot_id;
-            cons->inhibit_until[cons->inhibit_count] = now + cons->config.inhibit_duration;
-            cons->inhibit_count++;
-        }
+        add_inhibit(cons, proposer_id, ballot_id, now + cons->config.inhibit_duration);
 
         /* Cancel local ballot */
-        int idx = find_ballot_index(cons, ballot_id);
+        int idx = find_ballot_index(cons, proposer_id, ballot_id);
         if (idx >= 0 && !cons->ballots[idx].completed) {
-            finalize_ballot(cons, &cons->ballots[idx], EKK_VOTE_CANCELLED);
+            finalize_ballot(cons, &cons->ballots[idx], EKK_VOTE_CANCELLED, now);
         }
 
         return EKK_OK;
     }
 
-    /* Find ballot */
-    int idx = find_ballot_index(cons, ballot_id);
+    /* Votes count only on our own ballots */
+    if (proposer_id != cons->my_id) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    /* Find ballot (votes are addressed to its proposer) */
+    int idx = find_ballot_index(cons, cons->my_id, ballot_id);
     if (idx < 0) {
+        /* Only proposer can receive votes */
+        if (find_ballot_index(cons, EKK_INVALID_MODULE_ID, ballot_id) >= 0) {
+            return EKK_ERR_INVALID_ARG;
+        }
+        /* Late vote for a ballot that already left the table */
+        if (find_outcome(cons, cons->my_id, ballot_id) != NULL) {
+            return EKK_OK;
+        }
         /* Unknown ballot - might be from a proposal we haven't seen */
         return EKK_ERR_NOT_FOUND;
     }
 
     ekk_ballot_t *ballot = &cons->ballots[idx];
 
-    /* Only proposer can receive votes */
-    if (ballot->proposer != cons->my_id) {
-        return EKK_ERR_INVALID_ARG;
-    }
-
     /* Cannot vote on completed ballot */
     if (ballot->completed) {
         return EKK_OK;  /* Ignore late votes */
@@ -434,7 +900,7 @@ ekk_error_t ekk_consensus_on_vote(ekk_consensus_t *cons,
     /* Check if we can determine result early */
     ekk_vote_result_t result = evaluate_ballot(ballot, EKK_K_NEIGHBORS);
     if (result != EKK_VOTE_PENDING) {
-        finalize_ballot(cons, ballot, result);
+        finalize_ballot(cons, ballot, result, ekk_hal_time_us());
     }
 
     return EKK_OK;
@@ -442,6 +908,7 @@ ekk_error_t ekk_consensus_on_vote(ekk_consensus_t *cons,
 
 ekk_error_t ekk_consensus_on_proposal(ekk_consensus_t *cons,
                                        ekk_module_id_t proposer_id,
+                                       uint8_t incarnation,
                                        ekk_ballot_id_t ballot_id,
                                        ekk_proposal_type_t type,
                                        uint32_t data,
@@ -459,25 +926,43 @@ ekk_error_t ekk_consensus_on_proposal(ekk_consensus_t *cons,
 
     ekk_time_us_t now = ekk_hal_time_us();
 
+    /* A restarted proposer reuses its IDs: forget its previous life */
+    forget_incarnation(cons, proposer_id, incarnation, now);
+
     /* Check if inhibited */
-    if (is_inhibited(cons, ballot_id, now)) {
+    if (is_inhibited(cons, proposer_id, ballot_id, now)) {
         /* Send inhibit response */
-        send_vote(cons, proposer_id, ballot_id, EKK_VOTE_INHIBIT);
+        send_vote(cons, proposer_id, proposer_id, ballot_id, EKK_VOTE_INHIBIT);
         return EKK_ERR_INHIBITED;
     }
 
-    /* Check if we already have this ballot */
-    int idx = find_ballot_index(cons, ballot_id);
+    /* Check if we already have (or had) this ballot */
+    int idx = find_ballot_index(cons, proposer_id, ballot_id);
     if (idx >= 0) {
         /* Duplicate proposal */
         return EKK_OK;
     }
 
+    ekk_ballot_outcome_t *outcome =
+        (ekk_ballot_outcome_t *)find_outcome(cons, proposer_id, ballot_id);
+    if (outcome != NULL) {
+        if (outcome->verified) {
+            return EKK_OK;
+        }
+        /* Certificate came first: it decides the ballot only if it holds up */
+        if (certificate_valid((ekk_vote_result_t)outcome->result, outcome->yes_count,
+                              outcome->vote_count, threshold)) {
+            outcome->verified = true;
+            return EKK_OK;
+        }
+        outcome->id = EKK_INVALID_BALLOT_ID;
+    }
+
     /* Allocate slot for remote ballot tracking */
     idx = allocate_ballot_slot(cons);
     if (idx < 0) {
         /* No room - vote no */
-        send_vote(cons, proposer_id, ballot_id, EKK_VOTE_NO);
+        send_vote(cons, proposer_id, proposer_id, ballot_id, EKK_VOTE_NO);
         return EKK_ERR_BUSY;
     }
 
@@ -488,26 +973,83 @@ ekk_error_t ekk_consensus_on_proposal(ekk_consensus_t *cons,
     ballot->id = ballot_id;
     ballot->type = type;
     ballot->proposer = proposer_id;
+    ballot->incarnation = incarnation;
     ballot->proposal_data = data;
     ballot->threshold = threshold;
     ballot->deadline = now + cons->config.vote_timeout;
     ballot->result = EKK_VOTE_PENDING;
     ballot->completed = false;
 
-    cons->active_ballot_count++;
+    commit_ballot_slot(cons, idx);
 
     /* Decide how to vote */
     ekk_vote_value_t my_vote = EKK_VOTE_ABSTAIN;
 
-    if (g_decide_callback != NULL) {
-        my_vote = g_decide_callback(cons, ballot);
+    if (cons->on_decide != NULL) {
+        my_vote = cons->on_decide(cons, ballot);
     } else {
         /* Default: vote yes */
         my_vote = EKK_VOTE_YES;
     }
 
-    /* Send vote */
-    send_vote(cons, proposer_id, ballot_id, my_vote);
+    /* Queue vote (sent by the next tick, batched per proposer) */
+    ballot->my_vote = (uint8_t)my_vote;
+    ballot->vote_queued = true;
+
+    return EKK_OK;
+}
+
+ekk_error_t ekk_consensus_on_decision(ekk_consensus_t *cons,
+                                       ekk_module_id_t proposer_id,
+                                       uint8_t incarnation,
+                                       ekk_ballot_id_t ballot_id,
+                                       ekk_vote_result_t result,
+                                       uint8_t yes_count,
+                                       uint8_t vote_count)
+{
+    if (cons == NULL || proposer_id == EKK_INVALID_MODULE_ID ||
+        ballot_id == EKK_INVALID_BALLOT_ID) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (result != EKK_VOTE_APPROVED && result != EKK_VOTE_REJECTED &&
+        result != EKK_VOTE_TIMEOUT) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    /* Our own ballots are decided by our own tally */
+    if (proposer_id == cons->my_id) {
+        return EKK_OK;
+    }
+
+    /* Only the owner of a ballot can certify it */
+    if (!ballot_owned_by(proposer_id, ballot_id) ||
+        yes_count > vote_count || vote_count > EKK_K_NEIGHBORS) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    forget_incarnation(cons, proposer_id, incarnation, ekk_hal_time_us());
+
+    int idx = find_ballot_index(cons, proposer_id, ballot_id);
+    if (idx < 0) {
+        /* Missed the proposal: hold the certificate until the threshold is known */
+        if (find_outcome(cons, proposer_id, ballot_id) == NULL) {
+            record_outcome(cons, proposer_id, incarnation, ballot_id, result,
+                           yes_count, vote_count, false);
+        }
+        return EKK_OK;
+    }
+
+    ekk_ballot_t *ballot = &cons->ballots[idx];
+    if (!certificate_valid(result, yes_count, vote_count, ballot->threshold)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (!ballot->completed) {
+        ballot->yes_count = yes_count;
+        ballot->vote_count = vote_count;
+        finalize_ballot(cons, ballot, result, ekk_hal_time_us());
+    }
 
     return EKK_OK;
 }
@@ -523,12 +1065,20 @@ ekk_vote_result_t ekk_consensus_get_result(const ekk_consensus_t *cons,
         return EKK_VOTE_PENDING;
     }
 
-    int idx = find_ballot_index(cons, ballot_id);
-    if (idx < 0) {
-        return EKK_VOTE_PENDING;  /* Unknown */
+    int idx = find_local_ballot(cons, ballot_id);
+    if (idx >= 0) {
+        return cons->ballots[idx].result;
+    }
+
+    const ekk_ballot_outcome_t *outcome = find_outcome(cons, cons->my_id, ballot_id);
+    if (outcome == NULL) {
+        outcome = find_outcome(cons, EKK_INVALID_MODULE_ID, ballot_id);
+    }
+    if (outcome != NULL && outcome->verified) {
+        return (ekk_vote_result_t)outcome->result;
     }
 
-    return cons->ballots[idx].result;
+    return EKK_VOTE_PENDING;  /* Unknown or not yet verified */
 }
 
 /* ============================================================================
@@ -552,48 +1102,77 @@ uint32_t ekk_consensus_tick(ekk_consensus_t *cons, ekk_time_us_t now)
         }
 
         /* Check for inhibition */
-        if (is_inhibited(cons, ballot->id, now)) {
-            finalize_ballot(cons, ballot, EKK_VOTE_CANCELLED);
+        if (is_inhibited(cons, ballot->proposer, ballot->id, now)) {
+            finalize_ballot(cons, ballot, EKK_VOTE_CANCELLED, now);
             completed_count++;
             continue;
         }
 
         /* Check for timeout */
         if (now >= ballot->deadline) {
-            /* Evaluate with votes received */
-            ekk_vote_result_t result = evaluate_ballot(ballot, ballot->vote_count);
+            /* Evaluate with votes received; a remote ballot holds no tally,
+             * so without a certificate its outcome is unknown */
+            ekk_vote_result_t result = (ballot->proposer == cons->my_id) ?
+                evaluate_ballot(ballot, ballot->vote_count) : EKK_VOTE_PENDING;
 
             if (result == EKK_VOTE_PENDING) {
                 /* Not enough votes before timeout */
                 result = EKK_VOTE_TIMEOUT;
             }
 
-            finalize_ballot(cons, ballot, result);
+            finalize_ballot(cons, ballot, result, now);
             completed_count++;
         }
     }
 
+    /* Send votes queued by proposals since the last tick */
+    flush_votes(cons);
+
     /* Clean up expired inhibitions */
-    uint32_t write_idx = 0;
-    for (uint32_t read_idx = 0; read_idx < cons->inhibit_count; read_idx++) {
-        if (cons->inhibit_until[read_idx] > now) {
-            if (write_idx != read_idx) {
-                cons->inhibited[write_idx] = cons->inhibited[read_idx];
-                cons->inhibit_until[write_idx] = cons->inhibit_until[read_idx];
-            }
-            write_idx++;
+    uint32_t i = 0;
+    while (i < cons->inhibit_count) {
+        if (cons->inhibit_until[i] <= now) {
+            remove_inhibit(cons, i);
+        } else {
+            i++;
         }
     }
-    cons->inhibit_count = write_idx;
 
-    /* Clean up completed ballots periodically */
-    if (completed_count > 0) {
-        cleanup_completed_ballots(cons);
-    }
+    /* Clean up completed ballots (including those decided by votes) */
+    cleanup_completed_ballots(cons);
 
     return completed_count;
 }
 
+ekk_time_us_t ekk_consensus_next_deadline(const ekk_consensus_t *cons)
+{
+    if (cons == NULL) {
+        return UINT64_MAX;
+    }
+
+    ekk_time_us_t next = UINT64_MAX;
+
+    for (uint32_t i = 0; i < cons->active_ballot_count; i++) {
+        const ekk_ballot_t *ballot = &cons->ballots[i];
+        if (ballot->vote_queued) {
+            return 0;
+        }
+        if (ballot->completed) {
+            continue;
+        }
+        if (find_inhibit_index(cons, ballot->proposer, ballot->id) >= 0) {
+            return 0;
+        }
+        next = EKK_MIN(next, ballot->deadline);
+    }
+
+    for (uint32_t i = 0; i < cons->inhibit_count; i++) {
+        next = EKK_MIN(next, cons->inhibit_until[i]);
+    }
+
+    return next;
+}
+
 /* ============================================================================
  * CALLBACKS
  * ============================================================================ */
@@ -601,15 +1180,21 @@ uint32_t ekk_consensus_tick(ekk_consensus_t *cons, ekk_time_us_t now)
 void ekk_consensus_set_decide_callback(ekk_consensus_t *cons,
                                         ekk_consensus_decide_cb callback)
 {
-    EKK_UNUSED(cons);
-    g_decide_callback = callback;
+    if (cons == NULL) {
+        return;
+    }
+
+    cons->on_decide = callback;
 }
 
 void ekk_consensus_set_complete_callback(ekk_consensus_t *cons,
                                           ekk_consensus_complete_cb callback)
 {
-    EKK_UNUSED(cons);
-    g_complete_callback = callback;
+    if (cons == NULL) {
+        return;
+    }
+
+    cons->on_complete = callback;
 }
 
 /* ============================================================================
@@ -699,8 +1284,7 @@ bool ekk_consensus_verify_evidence(const ekk_byzantine_evidence_t *evidence)
     }
 
     /* Verify suspect ID is valid */
-    if (evidence->suspect_id == EKK_INVALID_MODULE_ID ||
-        evidence->suspect_id >= EKK_MAX_MODULES) {
+    if (!EKK_MODULE_ID_VALID(evidence->suspect_id)) {
         return false;
     }
 
@@ -712,7 +1296,7 @@ bool ekk_consensus_verify_evidence(const ekk_byzantine_evidence_t *evidence)
     /* Verify witness IDs are valid and not the suspect */
     for (uint8_t i = 0; i < evidence->witness_count && i < EKK_QUARANTINE_MAX_WITNESSES; i++) {
         ekk_module_id_t w = evidence->witness_ids[i];
-        if (w == EKK_INVALID_MODULE_ID || w >= EKK_MAX_MODULES || w == evidence->suspect_id) {
+        if (!EKK_MODULE_ID_VALID(w) || w == evidence->suspect_id) {
             return false;
         }
     }
@@ -781,8 +1365,7 @@ ekk_error_t ekk_consensus_execute_quarantine(ekk_consensus_t *cons,
                                                ekk_module_id_t module_id,
                                                ekk_time_us_t now)
 {
-    if (cons == NULL || state == NULL ||
-        module_id == EKK_INVALID_MODULE_ID || module_id >= EKK_MAX_MODULES) {
+    if (cons == NULL || state == NULL || !EKK_MODULE_ID_VALID(module_id)) {
         return EKK_ERR_INVALID_ARG;
     }
 
@@ -792,13 +1375,21 @@ ekk_error_t ekk_consensus_execute_quarantine(ekk_consensus_t *cons,
     }
 
     /* Already quarantined? */
-    if (state->quarantined[module_id]) {
+    if (ekk_consensus_is_quarantined(state, module_id)) {
         return EKK_OK;
     }
 
     /* Execute quarantine */
+#if EKK_MODULE_ID_BITS > 8
+    int32_t slot = ekk_idmap_insert(&state->quarantined, module_id);
+    if (slot < 0) {
+        return EKK_ERR_NO_MEMORY;
+    }
+#else
+    int32_t slot = module_id;
     state->quarantined[module_id] = true;
-    state->quarantine_time[module_id] = now;
+#endif
+    state->quarantine_time[slot] = now;
     state->quarantine_count++;
 
     return EKK_OK;
@@ -807,17 +1398,21 @@ ekk_error_t ekk_consensus_execute_quarantine(ekk_consensus_t *cons,
 ekk_error_t ekk_quarantine_lift(ekk_quarantine_state_t *state,
                                   ekk_module_id_t module_id)
 {
-    if (state == NULL || module_id == EKK_INVALID_MODULE_ID ||
-        module_id >= EKK_MAX_MODULES) {
+    if (state == NULL || !EKK_MODULE_ID_VALID(module_id)) {
         return EKK_ERR_INVALID_ARG;
     }
 
-    if (!state->quarantined[module_id]) {
+    if (!ekk_consensus_is_quarantined(state, module_id)) {
         return EKK_OK;  /* Not quarantined */
     }
 
+#if EKK_MODULE_ID_BITS > 8
+    int32_t slot = ekk_idmap_remove(&state->quarantined, module_id);
+#else
+    int32_t slot = module_id;
     state->quarantined[module_id] = false;
-    state->quarantine_time[module_id] = 0;
+#endif
+    state->quarantine_time[slot] = 0;
     state->quarantine_count--;
 
     return EKK_OK;
@@ -20,7 +20,6 @@
 
 extern ekk_fixed_t ekk_fixed_mul(ekk_fixed_t a, ekk_fixed_t b);
 extern ekk_fixed_t ekk_fixed_div(ekk_fixed_t a, ekk_fixed_t b);
-extern ekk_fixed_t ekk_fixed_exp_decay(ekk_time_us_t elapsed_us, ekk_time_us_t tau_us);
 
 /* ============================================================================
  * PRIVATE STATE
@@ -29,91 +28,1014 @@ extern ekk_fixed_t ekk_fixed_exp_decay(ekk_time_us_t elapsed_us, ekk_time_us_t t
 /** Global field region pointer (set by ekk_field_init) */
 static ekk_field_region_t *g_field_region = NULL;
 
-/** Default decay tau in microseconds */
-static ekk_time_us_t g_decay_tau_us = EKK_FIELD_DECAY_TAU_US;
+/** Per-component configuration (as passed to ekk_field_configure) */
+static ekk_field_config_t g_field_config[EKK_FIELD_COUNT];
 
-/** Maximum field age (5 * tau) */
-#define EKK_FIELD_MAX_AGE_US    (EKK_FIELD_DECAY_TAU_US * 5)
+/** Maximum field age: longest decay span over all components (5 * tau by default) */
+static ekk_time_us_t g_max_age_us = EKK_FIELD_DECAY_TAU_US * 5;
+
+/** Shortest decay tau over all components (default publish refresh base) */
+static ekk_time_us_t g_min_tau_us = EKK_FIELD_DECAY_TAU_US;
+
+/* ============================================================================
+ * DECAY TABLES
+ * ============================================================================ */
+
+/** Segments in the exponential decay table (covers 0..5 tau) */
+#define EKK_DECAY_SEGMENTS      64
+
+/**
+ * exp(-5i/64) in Q16.16, i = 0..64, rounded to nearest.
+ * Must match DECAY_EXP_TABLE in rust/src/field.rs bit for bit.
+ */
+static const ekk_fixed_t g_decay_exp_table[EKK_DECAY_SEGMENTS + 1] = {
+    65536, 60611, 56056, 51843, 47947, 44344, 41011, 37929,
+    35079, 32443, 30005, 27750, 25664, 23736, 21952, 20302,
+    18776, 17365, 16060, 14853, 13737, 12705, 11750, 10867,
+    10050,  9295,  8596,  7950,  7353,  6800,  6289,  5817,
+     5380,  4975,  4601,  4256,  3936,  3640,  3366,  3113,
+     2879,  2663,  2463,  2278,  2107,  1948,  1802,  1666,
+     1541,  1425,  1318,  1219,  1128,  1043,   964,   892,
+      825,   763,   706,   653,   604,   558,   516,   477,
+      442,
+};
+
+/**
+ * @brief Decay evaluator for one component, built by ekk_field_configure()
+ *
+ * All divisions happen at build time. Evaluation is a 64-bit multiply by
+ * the precomputed reciprocal, one table lookup and an interpolation.
+ */
+typedef struct {
+    ekk_decay_model_t model;
+    ekk_time_us_t span_us;      /**< Age at which the factor reaches 0 */
+    ekk_time_us_t tau_us;       /**< Time constant */
+    uint64_t recip;             /**< 2^32 * (Q16 table position per us) */
+    ekk_fixed_t min_value;      /**< Clamp floor after decay */
+    ekk_fixed_t max_value;      /**< Clamp ceiling after decay */
+} ekk_decay_eval_t;
+
+static ekk_decay_eval_t g_decay[EKK_FIELD_COUNT];
+
+/** First component with the same decay curve (factor computed once per curve) */
+static uint8_t g_decay_alias[EKK_FIELD_COUNT];
+
+/** All components share one curve and none clamps: one factor per field */
+static bool g_decay_uniform = true;
+
+/**
+ * @brief Convert a Q16.16 seconds tau to microseconds (0 = default tau)
+ */
+static ekk_time_us_t decay_tau_us(ekk_fixed_t decay_tau)
+{
+    if (decay_tau <= 0) {
+        return EKK_FIELD_DECAY_TAU_US;
+    }
+    return ((uint64_t)decay_tau * 1000000u) >> 16;
+}
+
+static void decay_build(ekk_decay_eval_t *ev, const ekk_field_config_t *config)
+{
+    ekk_time_us_t tau = decay_tau_us(config->decay_tau);
+    if (tau == 0) {
+        tau = 1;
+    }
+
+    ev->model = config->decay_model;
+    ev->tau_us = tau;
+    ev->min_value = config->min_value;
+    ev->max_value = config->max_value;
+
+    switch (config->decay_model) {
+        case EKK_DECAY_EXPONENTIAL:
+            ev->span_us = tau * 5;
+            ev->recip = ((uint64_t)EKK_DECAY_SEGMENTS << 48) / ev->span_us;
+            break;
+        case EKK_DECAY_LINEAR:
+            ev->span_us = tau;
+            ev->recip = ((uint64_t)1 << 48) / tau;
+            break;
+        case EKK_DECAY_STEP:
+        default:
+            ev->span_us = tau;
+            ev->recip = 0;
+            break;
+    }
+}
+
+static ekk_fixed_t decay_factor(const ekk_decay_eval_t *ev, ekk_time_us_t age)
+{
+    if (age >= ev->span_us) {
+        return 0;
+    }
+
+    switch (ev->model) {
+        case EKK_DECAY_EXPONENTIAL: {
+            /* age < span keeps the product below 2^54 */
+            uint32_t pos = (uint32_t)((age * ev->recip) >> 32);
+            uint32_t idx = pos >> 16;
+            int64_t frac = pos & 0xFFFF;
+            ekk_fixed_t a = g_decay_exp_table[idx];
+            ekk_fixed_t b = g_decay_exp_table[idx + 1];
+            return a + (ekk_fixed_t)(((int64_t)(b - a) * frac) >> 16);
+        }
+        case EKK_DECAY_LINEAR:
+            return EKK_FIXED_ONE - (ekk_fixed_t)((age * ev->recip) >> 32);
+        case EKK_DECAY_STEP:
+        default:
+            return EKK_FIXED_ONE;
+    }
+}
+
+static ekk_fixed_t decay_clamp(const ekk_decay_eval_t *ev, ekk_fixed_t value)
+{
+    if (value < ev->min_value) value = ev->min_value;
+    if (value > ev->max_value) value = ev->max_value;
+    return value;
+}
+
+static ekk_fixed_t decay_value(const ekk_decay_eval_t *ev, ekk_fixed_t value,
+                               ekk_time_us_t age)
+{
+    return decay_clamp(ev, ekk_fixed_mul(value, decay_factor(ev, age)));
+}
+
+/**
+ * @brief Decay all components; components sharing a curve share the lookup
+ */
+static void decay_components(ekk_fixed_t *out, const ekk_fixed_t *in,
+                             ekk_time_us_t age)
+{
+    ekk_fixed_t factor[EKK_FIELD_COUNT];
+
+    for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+        const ekk_decay_eval_t *ev = &g_decay[c];
+        factor[c] = (g_decay_alias[c] == c) ? decay_factor(ev, age)
+                                            : factor[g_decay_alias[c]];
+        out[c] = decay_clamp(ev, ekk_fixed_mul(in[c], factor[c]));
+    }
+}
+
+/**
+ * @brief Recompute curve aliases and the maximum field age
+ */
+static void decay_rebuild_shared(void)
+{
+    g_max_age_us = 0;
+    g_min_tau_us = g_decay[0].tau_us;
+    g_decay_uniform = true;
+    for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+        g_decay_alias[c] = (uint8_t)c;
+        for (int j = 0; j < c; j++) {
+            if (g_decay[j].model == g_decay[c].model &&
+                g_decay[j].span_us == g_decay[c].span_us) {
+                g_decay_alias[c] = (uint8_t)j;
+                break;
+            }
+        }
+        if (g_decay[c].span_us > g_max_age_us) {
+            g_max_age_us = g_decay[c].span_us;
+        }
+        if (g_decay[c].tau_us < g_min_tau_us) {
+            g_min_tau_us = g_decay[c].tau_us;
+        }
+        if (g_decay_alias[c] != 0 ||
+            g_decay[c].min_value != INT32_MIN || g_decay[c].max_value != INT32_MAX) {
+            g_decay_uniform = false;
+        }
+    }
+}
+
+/* ============================================================================
+ * SLOT ACCESS (LAYOUT SPECIFIC)
+ * ============================================================================ */
+
+#if EKK_FIELD_LAYOUT_SOA
+#define REGION_SEQ(r, id)           ((r)->seqlocks[id].sequence)
+#define REGION_SOURCE(r, id)        ((r)->sources[id])
+#define REGION_TIMESTAMP(r, id)     ((r)->timestamps[id])
+#define REGION_COMPONENT(r, id, c)  ((r)->components[c][id])
+#else
+#define REGION_SEQ(r, id)           ((r)->fields[id].sequence)
+#define REGION_SOURCE(r, id)        ((r)->fields[id].field.source)
+#define REGION_TIMESTAMP(r, id)     ((r)->fields[id].field.timestamp)
+#define REGION_COMPONENT(r, id, c)  ((r)->fields[id].field.components[c])
+#endif
+
+/* Slots of the module-level region */
+#define SLOT_SEQ(id)            REGION_SEQ(g_field_region, id)
+#define SLOT_SOURCE(id)         REGION_SOURCE(g_field_region, id)
+#define SLOT_TIMESTAMP(id)      REGION_TIMESTAMP(g_field_region, id)
+#define SLOT_COMPONENT(id, c)   REGION_COMPONENT(g_field_region, id, c)
+
+/**
+ * @brief Copy one slot of a region under its seqlock
+ * @return true if the copy is consistent
+ */
+static bool region_read_slot(const ekk_field_region_t *r, uint32_t slot,
+                             ekk_field_t *out)
+{
+    uint32_t seq_before = REGION_SEQ(r, slot);
+    if (seq_before & 1) {
+        return false;
+    }
+
+    ekk_hal_memory_barrier();
+#if EKK_FIELD_LAYOUT_SOA
+    for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+        out->components[c] = REGION_COMPONENT(r, slot, c);
+    }
+    out->timestamp = REGION_TIMESTAMP(r, slot);
+    out->source = REGION_SOURCE(r, slot);
+    out->sequence = (uint8_t)(seq_before - 1);  /* Odd value seen during write */
+#else
+    memcpy(out, (const void *)&r->fields[slot].field, sizeof(ekk_field_t));
+#endif
+    ekk_hal_memory_barrier();
+
+    return REGION_SEQ(r, slot) == seq_before;
+}
+
+/**
+ * @brief Copy a module's field from its slot
+ *
+ * A module without a slot, or whose slot was recycled for another module
+ * during the copy, reads back as an empty field (source invalid).
+ *
+ * @return true if the copy is consistent
+ */
+static bool region_read_module(const ekk_field_region_t *r, ekk_module_id_t id,
+                               ekk_field_t *out)
+{
+    int32_t slot = ekk_field_region_slot(r, id);
+    if (slot < 0) {
+        out->source = EKK_INVALID_MODULE_ID;
+        return true;
+    }
+
+    if (!region_read_slot(r, (uint32_t)slot, out)) {
+        return false;
+    }
+    if (out->source != id) {
+        out->source = EKK_INVALID_MODULE_ID;
+    }
+    return true;
+}
+
+static inline bool read_module(ekk_module_id_t id, ekk_field_t *out)
+{
+    return region_read_module(g_field_region, id, out);
+}
+
+/**
+ * @brief Index of the lowest set bit (bits != 0)
+ */
+static inline uint32_t lowest_bit(uint32_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctz(bits);
+#else
+    uint32_t i = 0;
+    while ((bits & 1u) == 0) {
+        bits >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/**
+ * @brief Expiry wheel tick and bucket for a publish timestamp
+ */
+static inline uint32_t wheel_tick(ekk_time_us_t t)
+{
+    return (uint32_t)(t / EKK_FIELD_WHEEL_TICK_US);
+}
+
+static inline uint32_t wheel_bucket(ekk_time_us_t t)
+{
+    return wheel_tick(t) & (EKK_FIELD_WHEEL_SLOTS - 1);
+}
 
 /* ============================================================================
  * INITIALIZATION
  * ============================================================================ */
 
-ekk_error_t ekk_field_init(ekk_field_region_t *region)
+/**
+ * @brief Empty every slot of a region
+ */
+static void region_clear(ekk_field_region_t *region)
+{
+    memset(region, 0, sizeof(ekk_field_region_t));
+
+    for (int i = 0; i < EKK_MAX_MODULES; i++) {
+        REGION_SOURCE(region, i) = EKK_INVALID_MODULE_ID;
+        REGION_SEQ(region, i) = 0;
+    }
+}
+
+ekk_error_t ekk_field_init(ekk_field_region_t *region)
+{
+    if (region == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    region_clear(region);
+    return ekk_field_attach(region);
+}
+
+ekk_error_t ekk_field_attach(ekk_field_region_t *region)
+{
+    if (region == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    g_field_region = region;
+
+    /* Default decay: exponential, EKK_FIELD_DECAY_TAU_US, no clamping */
+    const ekk_field_config_t def = EKK_FIELD_CONFIG_DEFAULT;
+    for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+        g_field_config[c] = def;
+        decay_build(&g_decay[c], &def);
+    }
+    decay_rebuild_shared();
+
+    return EKK_OK;
+}
+
+ekk_error_t ekk_field_configure(ekk_field_component_t component,
+                                 const ekk_field_config_t *config)
+{
+    if (component >= EKK_FIELD_COUNT || config == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (config->decay_model > EKK_DECAY_STEP ||
+        config->min_value > config->max_value ||
+        config->decay_tau < 0) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    g_field_config[component] = *config;
+    decay_build(&g_decay[component], config);
+    decay_rebuild_shared();
+
+    return EKK_OK;
+}
+
+ekk_error_t ekk_field_get_config(ekk_field_component_t component,
+                                  ekk_field_config_t *config)
+{
+    if (component >= EKK_FIELD_COUNT || config == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    *config = g_field_config[component];
+    return EKK_OK;
+}
+
+ekk_fixed_t ekk_field_decay_factor(ekk_field_component_t component,
+                                    ekk_time_us_t elapsed_us)
+{
+    if (component >= EKK_FIELD_COUNT) {
+        return 0;
+    }
+    return decay_factor(&g_decay[component], elapsed_us);
+}
+
+/* ============================================================================
+ * FIELD PUBLISH
+ * ============================================================================ */
+
+/**
+ * @brief Write one slot of a region under its seqlock (single writer per slot)
+ */
+static void slot_store(ekk_field_region_t *r, uint32_t slot, ekk_module_id_t module_id,
+                       const ekk_field_t *field, ekk_time_us_t now)
+{
+    /* Memory barrier before write */
+    ekk_hal_memory_barrier();
+
+    /* Increment sequence to ODD (write in progress) */
+    REGION_SEQ(r, slot)++;
+
+    ekk_hal_memory_barrier();
+
+    /* Copy field data */
+    for (int i = 0; i < EKK_FIELD_COUNT; i++) {
+        REGION_COMPONENT(r, slot, i) = field->components[i];
+    }
+    REGION_TIMESTAMP(r, slot) = now;
+    REGION_SOURCE(r, slot) = module_id;
+#if !EKK_FIELD_LAYOUT_SOA
+    r->fields[slot].field.sequence = (uint8_t)REGION_SEQ(r, slot);
+#endif
+
+    /* Memory barrier after write */
+    ekk_hal_memory_barrier();
+
+    /* Increment sequence to EVEN (write complete) */
+    REGION_SEQ(r, slot)++;
+}
+
+/**
+ * @brief Change journal bucket of an epoch
+ */
+static inline uint32_t journal_bucket(uint32_t epoch)
+{
+    return (epoch / EKK_FIELD_CHANGE_SPAN) & (EKK_FIELD_CHANGE_BUCKETS - 1);
+}
+
+/**
+ * @brief Number of set bits
+ */
+static inline uint32_t bit_count(uint32_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcount(bits);
+#else
+    uint32_t n = 0;
+    while (bits != 0) {
+        bits &= bits - 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/**
+ * @brief Stamp a slot with the next change epoch
+ *
+ * Caller holds region_lock(). The stamps are stored before the
+ * epoch advances, so a reader that sees epoch E also sees every stamp
+ * up to E.
+ */
+static void slot_changed(ekk_field_region_t *r, uint32_t slot)
+{
+    uint32_t epoch = r->change_epoch + 1;
+    volatile uint32_t *bucket = r->change_journal[journal_bucket(epoch)];
+
+    if ((epoch & (EKK_FIELD_CHANGE_SPAN - 1)) == 0) {
+        /* First epoch of a span: reuse the oldest bucket */
+        for (uint32_t w = 0; w < EKK_FIELD_FLAG_WORDS; w++) {
+            bucket[w] = 0;
+        }
+    }
+    bucket[slot / 32] |= 1u << (slot % 32);
+    r->slot_epoch[slot] = epoch;
+    r->word_epoch[slot / 32] = epoch;
+    ekk_hal_memory_barrier();
+    r->change_epoch = epoch;
+}
+
+/**
+ * @brief Stamp a written slot and move it to its expiry bucket
+ *
+ * Caller holds region_lock().
+ */
+static void slot_track(ekk_field_region_t *r, uint32_t slot,
+                       ekk_time_us_t prev, ekk_time_us_t now)
+{
+    uint32_t word = slot / 32;
+    uint32_t bit = (1u << (slot % 32));
+
+    slot_changed(r, slot);
+    if (r->occupied[word] & bit) {
+        r->expiry_wheel[wheel_bucket(prev)][word] &= ~bit;
+    }
+    r->expiry_wheel[wheel_bucket(now)][word] |= bit;
+    r->occupied[word] |= bit;
+}
+
+/**
+ * @brief Lock region bookkeeping: slot allocation, change stamps, gc
+ *
+ * On POSIX the region may be mapped by several processes, so this is the
+ * HAL's region lock rather than the per-process critical section. Reads
+ * never take it.
+ */
+static inline uint32_t region_lock(void)
+{
+#ifdef EKK_PLATFORM_POSIX
+    return ekk_hal_field_lock();
+#else
+    return ekk_hal_critical_enter();
+#endif
+}
+
+static inline void region_unlock(uint32_t state)
+{
+#ifdef EKK_PLATFORM_POSIX
+    ekk_hal_field_unlock(state);
+#else
+    ekk_hal_critical_exit(state);
+#endif
+}
+
+/**
+ * @brief Write a module's field into its slot of a region
+ */
+static ekk_error_t region_write(ekk_field_region_t *r, ekk_module_id_t module_id,
+                                const ekk_field_t *field, ekk_time_us_t now)
+{
+#if EKK_MODULE_ID_BITS > 8
+    /* Slot lookup and write under one lock, so gc cannot hand the slot
+     * to another module halfway through */
+    uint32_t state = region_lock();
+    int32_t slot = ekk_idmap_insert(&r->slots, module_id);
+    if (slot < 0) {
+        region_unlock(state);
+        return EKK_ERR_NO_MEMORY;
+    }
+    ekk_time_us_t prev = REGION_TIMESTAMP(r, slot);
+    slot_store(r, (uint32_t)slot, module_id, field, now);
+    slot_track(r, (uint32_t)slot, prev, now);
+    region_unlock(state);
+#else
+    /* Store under the lock too, so gc cannot invalidate the slot
+     * halfway through the write */
+    uint32_t state = region_lock();
+    ekk_time_us_t prev = REGION_TIMESTAMP(r, module_id);
+    slot_store(r, module_id, module_id, field, now);
+    slot_track(r, module_id, prev, now);
+    region_unlock(state);
+#endif
+    return EKK_OK;
+}
+
+ekk_error_t ekk_field_publish(ekk_module_id_t module_id, const ekk_field_t *field)
+{
+    if (g_field_region == NULL) {
+        return EKK_ERR_HAL_FAILURE;
+    }
+
+    if (!EKK_MODULE_ID_VALID(module_id)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (field == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    ekk_error_t err = region_write(g_field_region, module_id, field, ekk_hal_time_us());
+    if (err != EKK_OK) {
+        return err;
+    }
+
+    /* Sync to ensure visibility */
+    ekk_hal_sync_field_region();
+
+    return EKK_OK;
+}
+
+/* ============================================================================
+ * BULK SNAPSHOT
+ * ============================================================================ */
+
+ekk_error_t ekk_field_snapshot(ekk_field_snapshot_entry_t *entries,
+                                uint32_t max_entries,
+                                uint32_t *count)
+{
+    if (g_field_region == NULL) {
+        return EKK_ERR_HAL_FAILURE;
+    }
+
+    if (entries == NULL || count == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    ekk_time_us_t now = ekk_hal_time_us();
+    uint32_t n = 0;
+    bool torn = false;
+
+    ekk_hal_memory_barrier();
+
+    for (uint32_t w = 0; w < EKK_FIELD_FLAG_WORDS; w++) {
+        uint32_t bits = g_field_region->occupied[w];
+
+        while (bits != 0) {
+            uint32_t slot = w * 32 + lowest_bit(bits);
+            bits &= bits - 1;
+
+            if (n == max_entries) {
+                *count = n;
+                return EKK_ERR_NO_MEMORY;
+            }
+
+            ekk_field_snapshot_entry_t *e = &entries[n];
+            bool ok = false;
+            for (int attempt = 0; attempt < EKK_FIELD_SNAPSHOT_RETRIES && !ok; attempt++) {
+                ok = region_read_slot(g_field_region, slot, &e->field);
+            }
+            if (!ok) {
+                torn = true;
+                continue;
+            }
+
+            if (e->field.source == EKK_INVALID_MODULE_ID) {
+                continue;
+            }
+
+            /* Published after our time read: age 0, not expired */
+            ekk_time_us_t age = (e->field.timestamp > now) ? 0 : now - e->field.timestamp;
+            if (age > g_max_age_us) {
+                continue;
+            }
+
+            e->id = e->field.source;
+            e->age_us = age;
+            n++;
+        }
+    }
+
+    *count = n;
+    return torn ? EKK_ERR_BUSY : EKK_OK;
+}
+
+/* ============================================================================
+ * SEGMENT HIERARCHY
+ * ============================================================================ */
+
+/**
+ * @brief Mean of the decayed, unexpired fields in a region
+ */
+static uint32_t region_mean(const ekk_field_region_t *r, ekk_field_t *mean)
+{
+    ekk_time_us_t now = ekk_hal_time_us();
+    int64_t sums[EKK_FIELD_COUNT] = {0};
+    uint32_t n = 0;
+
+    for (uint32_t w = 0; w < EKK_FIELD_FLAG_WORDS; w++) {
+        uint32_t bits = r->occupied[w];
+
+        while (bits != 0) {
+            uint32_t slot = w * 32 + lowest_bit(bits);
+            bits &= bits - 1;
+
+            ekk_field_t snap;
+            bool ok = false;
+            for (int attempt = 0; attempt < EKK_FIELD_SNAPSHOT_RETRIES && !ok; attempt++) {
+                ok = region_read_slot(r, slot, &snap);
+            }
+            if (!ok || snap.source == EKK_INVALID_MODULE_ID) {
+                continue;
+            }
+
+            ekk_time_us_t age = (snap.timestamp > now) ? 0 : now - snap.timestamp;
+            if (age > g_max_age_us) {
+                continue;
+            }
+
+            decay_components(snap.components, snap.components, age);
+            for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+                sums[c] += snap.components[c];
+            }
+            n++;
+        }
+    }
+
+    memset(mean, 0, sizeof(*mean));
+    if (n > 0) {
+        for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+            mean->components[c] = (ekk_fixed_t)(sums[c] / (int64_t)n);
+        }
+        mean->timestamp = now;
+    }
+    return n;
+}
+
+ekk_error_t ekk_field_parent_init(ekk_field_region_t *parent)
+{
+    if (parent == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    region_clear(parent);
+    return EKK_OK;
+}
+
+ekk_error_t ekk_field_segment_aggregate(ekk_field_t *aggregate, uint32_t *module_count)
+{
+    if (g_field_region == NULL) {
+        return EKK_ERR_HAL_FAILURE;
+    }
+
+    if (aggregate == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    uint32_t n = region_mean(g_field_region, aggregate);
+    if (module_count != NULL) {
+        *module_count = n;
+    }
+    return (n > 0) ? EKK_OK : EKK_ERR_NOT_FOUND;
+}
+
+ekk_error_t ekk_field_segment_publish(ekk_field_region_t *parent,
+                                       ekk_module_id_t segment_id,
+                                       const ekk_field_t *aggregate)
+{
+    if (parent == NULL || aggregate == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (!EKK_MODULE_ID_VALID(segment_id)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    ekk_error_t err = region_write(parent, segment_id, aggregate, ekk_hal_time_us());
+    if (err != EKK_OK) {
+        return err;
+    }
+    ekk_hal_sync_field_region();
+
+    return EKK_OK;
+}
+
+ekk_error_t ekk_field_sample_site(const ekk_field_region_t *parent,
+                                   ekk_field_t *site,
+                                   uint32_t *segment_count)
+{
+    if (parent == NULL || site == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    uint32_t n = region_mean(parent, site);
+    if (segment_count != NULL) {
+        *segment_count = n;
+    }
+    return (n > 0) ? EKK_OK : EKK_ERR_NOT_FOUND;
+}
+
+ekk_error_t ekk_field_level_publish(const ekk_field_level_t *level,
+                                     const ekk_field_t *aggregate)
+{
+    if (level == NULL || aggregate == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    ekk_field_t mean = *aggregate;
+    for (;;) {
+        ekk_error_t err = ekk_field_segment_publish(level->region, level->slot, &mean);
+        if (err != EKK_OK || level->up == NULL) {
+            return err;
+        }
+
+        /* Holds the aggregate just written, so never empty */
+        region_mean(level->region, &mean);
+        level = level->up;
+    }
+}
+
+/**
+ * @brief View of a level with the levels above blended in (count returned)
+ */
+static uint32_t level_view(const ekk_field_level_t *level, ekk_field_t *view)
+{
+    if (level == NULL) {
+        return 0;
+    }
+
+    ekk_field_t above;
+    uint32_t n_above = level_view(level->up, &above);
+    uint32_t n = region_mean(level->region, view);
+
+    if (n_above == 0) {
+        return n;
+    }
+    if (n == 0) {
+        *view = above;
+        return n_above;
+    }
+    ekk_field_lerp(view, view, &above, EKK_FIELD_SEGMENT_WEIGHT);
+    return n + n_above;
+}
+
+ekk_error_t ekk_field_sample_levels(const ekk_field_level_t *level,
+                                     ekk_field_t *view,
+                                     uint32_t *count)
 {
-    if (region == NULL) {
+    if (level == NULL || view == NULL) {
         return EKK_ERR_INVALID_ARG;
     }
 
-    /* Clear all fields */
-    memset(region, 0, sizeof(ekk_field_region_t));
-
-    /* Initialize all fields as invalid */
-    for (int i = 0; i < EKK_MAX_MODULES; i++) {
-        region->fields[i].field.source = EKK_INVALID_MODULE_ID;
-        region->fields[i].sequence = 0;
+    for (const ekk_field_level_t *l = level; l != NULL; l = l->up) {
+        if (l->region == NULL) {
+            return EKK_ERR_INVALID_ARG;
+        }
     }
 
-    g_field_region = region;
-    return EKK_OK;
+    uint32_t n = level_view(level, view);
+    if (count != NULL) {
+        *count = n;
+    }
+    return (n > 0) ? EKK_OK : EKK_ERR_NOT_FOUND;
 }
 
 /* ============================================================================
- * FIELD PUBLISH
+ * DEADBAND PUBLISHING
  * ============================================================================ */
 
-ekk_error_t ekk_field_publish(ekk_module_id_t module_id, const ekk_field_t *field)
+void ekk_field_publisher_init(ekk_field_publisher_t *pub,
+                               const ekk_field_publish_policy_t *policy)
 {
-    if (g_field_region == NULL) {
-        return EKK_ERR_HAL_FAILURE;
+    if (pub == NULL) {
+        return;
     }
 
-    if (module_id == EKK_INVALID_MODULE_ID || module_id >= EKK_MAX_MODULES) {
-        return EKK_ERR_INVALID_ARG;
+    memset(pub, 0, sizeof(*pub));
+    if (policy != NULL) {
+        pub->policy = *policy;
+    } else {
+        for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+            pub->policy.deadband[c] = EKK_FIELD_DEADBAND_DEFAULT;
+        }
+    }
+}
+
+/**
+ * @brief Forced refresh interval of a publisher
+ */
+static ekk_time_us_t publisher_max_silence(const ekk_field_publisher_t *pub)
+{
+    if (pub->policy.max_silence_us != 0) {
+        return pub->policy.max_silence_us;
     }
+    return g_min_tau_us / EKK_FIELD_SILENCE_DIVISOR;
+}
 
-    if (field == NULL) {
+/**
+ * @brief Would readers' view of the last publish still be within deadband?
+ */
+static bool publisher_within_deadband(const ekk_field_publisher_t *pub,
+                                      const ekk_field_t *field,
+                                      ekk_time_us_t now)
+{
+    if (!pub->valid || now < pub->last_time) {
+        return false;
+    }
+
+    ekk_time_us_t age = now - pub->last_time;
+    if (age >= publisher_max_silence(pub)) {
+        return false;
+    }
+
+    /* What a reader sampling the slot right now would get */
+    ekk_fixed_t predicted[EKK_FIELD_COUNT];
+    decay_components(predicted, pub->last.components, age);
+
+    for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+        int64_t err = (int64_t)decay_clamp(&g_decay[c], field->components[c]) - predicted[c];
+        if (err < 0) {
+            err = -err;
+        }
+        if (err > pub->policy.deadband[c]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ekk_error_t ekk_field_publish_delta(ekk_field_publisher_t *pub,
+                                     ekk_module_id_t module_id,
+                                     const ekk_field_t *field,
+                                     bool *sent)
+{
+    if (pub == NULL || field == NULL) {
         return EKK_ERR_INVALID_ARG;
     }
+    if (sent != NULL) {
+        *sent = false;
+    }
 
     ekk_time_us_t now = ekk_hal_time_us();
+    if (publisher_within_deadband(pub, field, now)) {
+        pub->suppressed++;
+        return EKK_OK;
+    }
 
-    /* Get target slot (using coord field with seqlock) */
-    ekk_coord_field_t *cf = &g_field_region->fields[module_id];
+    ekk_error_t err = ekk_field_publish(module_id, field);
+    if (err != EKK_OK) {
+        return err;
+    }
 
-    /* Memory barrier before write */
-    ekk_hal_memory_barrier();
+    pub->last = *field;
+    pub->last_time = now;
+    pub->valid = true;
+    pub->sent++;
+    if (sent != NULL) {
+        *sent = true;
+    }
+    return EKK_OK;
+}
 
-    /* Increment sequence to ODD (write in progress) */
-    cf->sequence++;
+ekk_time_us_t ekk_field_publisher_next_deadline(const ekk_field_publisher_t *pub)
+{
+    if (pub == NULL) {
+        return UINT64_MAX;
+    }
+    if (!pub->valid) {
+        return 0;
+    }
+    return pub->last_time + publisher_max_silence(pub);
+}
 
-    ekk_hal_memory_barrier();
+/* ============================================================================
+ * CHANGE TRACKING
+ * ============================================================================ */
 
-    /* Copy field data */
-    for (int i = 0; i < EKK_FIELD_COUNT; i++) {
-        cf->field.components[i] = field->components[i];
+uint32_t ekk_field_changes_since(ekk_field_cursor_t *cursor, uint32_t *changed)
+{
+    if (g_field_region == NULL || cursor == NULL || changed == NULL) {
+        return 0;
     }
-    cf->field.timestamp = now;
-    cf->field.source = module_id;
-    cf->field.sequence = (uint8_t)cf->sequence;
 
-    /* Memory barrier after write */
+    const ekk_field_region_t *r = g_field_region;
+
+    /* Every stamp up to this epoch is visible once it is */
+    uint32_t epoch = r->change_epoch;
     ekk_hal_memory_barrier();
 
-    /* Increment sequence to EVEN (write complete) */
-    cf->sequence++;
+    if (!cursor->synced) {
+        /* First call: report everything */
+        cursor->epoch = epoch;
+        cursor->synced = true;
+        memset(changed, 0xFF, EKK_FIELD_FLAG_WORDS * sizeof(uint32_t));
+        return EKK_MAX_MODULES;
+    }
 
-    /* Set update flag */
-    uint32_t word = module_id / 32;
-    uint32_t bit = (1u << (module_id % 32));
-    uint32_t state = ekk_hal_critical_enter();
-    g_field_region->update_flags[word] |= bit;
-    ekk_hal_critical_exit(state);
+    uint32_t seen = cursor->epoch;
+    uint32_t count = 0;
 
-    /* Sync to ensure visibility */
-    ekk_hal_sync_field_region();
+    if (epoch == seen) {
+        memset(changed, 0, EKK_FIELD_FLAG_WORDS * sizeof(uint32_t));
+        return 0;
+    }
 
-    return EKK_OK;
+    /* Journal spans from the first unseen epoch up to the current one */
+    uint32_t first = (seen + 1) / EKK_FIELD_CHANGE_SPAN;
+    uint32_t spans = epoch / EKK_FIELD_CHANGE_SPAN - first + 1;
+    if (spans < EKK_FIELD_CHANGE_BUCKETS) {
+        const volatile uint32_t *bucket =
+            r->change_journal[first & (EKK_FIELD_CHANGE_BUCKETS - 1)];
+
+        /* The first span may also hold changes already seen: keep only
+         * slots stamped later */
+        for (uint32_t w = 0; w < EKK_FIELD_FLAG_WORDS; w++) {
+            uint32_t bits = bucket[w];
+            changed[w] = 0;
+            while (bits != 0) {
+                uint32_t b = lowest_bit(bits);
+                if ((int32_t)(r->slot_epoch[w * 32 + b] - seen) > 0) {
+                    changed[w] |= 1u << b;
+                }
+                bits &= bits - 1;
+            }
+        }
+        for (uint32_t i = 1; i < spans; i++) {
+            bucket = r->change_journal[(first + i) & (EKK_FIELD_CHANGE_BUCKETS - 1)];
+            for (uint32_t w = 0; w < EKK_FIELD_FLAG_WORDS; w++) {
+                changed[w] |= bucket[w];
+            }
+        }
+
+        /* Valid unless a writer started reusing one of those buckets; the
+         * one in progress clears before its epoch shows, hence the + 1 */
+        ekk_hal_memory_barrier();
+        uint32_t next = r->change_epoch + 1;
+        if (next / EKK_FIELD_CHANGE_SPAN - first < EKK_FIELD_CHANGE_BUCKETS) {
+            for (uint32_t w = 0; w < EKK_FIELD_FLAG_WORDS; w++) {
+                count += bit_count(changed[w]);
+            }
+            cursor->epoch = epoch;
+            return count;
+        }
+    }
+
+    /* Too far behind for the journal: exact scan of the slot epochs */
+    for (uint32_t w = 0; w < EKK_FIELD_FLAG_WORDS; w++) {
+        changed[w] = 0;
+
+        /* Wrap-safe "stamped after seen" */
+        if ((int32_t)(r->word_epoch[w] - seen) <= 0) {
+            continue;
+        }
+
+        /* Plain loads after the barrier so the compare loop vectorizes;
+         * each epoch is one aligned word, a torn read cannot happen */
+        const uint32_t *slot_epoch = (const uint32_t *)&r->slot_epoch[w * 32];
+        uint32_t n = EKK_MIN(32u, (uint32_t)EKK_MAX_MODULES - w * 32);
+        uint32_t bits = 0;
+        for (uint32_t b = 0; b < n; b++) {
+            uint32_t hit = (uint32_t)((int32_t)(slot_epoch[b] - seen) > 0);
+            bits |= hit << b;
+            count += hit;
+        }
+        changed[w] = bits;
+    }
+
+    cursor->epoch = epoch;
+    return count;
 }
 
 /* ============================================================================
@@ -126,7 +1048,7 @@ ekk_error_t ekk_field_sample(ekk_module_id_t target_id, ekk_field_t *field)
         return EKK_ERR_HAL_FAILURE;
     }
 
-    if (target_id == EKK_INVALID_MODULE_ID || target_id >= EKK_MAX_MODULES) {
+    if (!EKK_MODULE_ID_VALID(target_id)) {
         return EKK_ERR_INVALID_ARG;
     }
 
@@ -136,46 +1058,80 @@ ekk_error_t ekk_field_sample(ekk_module_id_t target_id, ekk_field_t *field)
 
     ekk_time_us_t now = ekk_hal_time_us();
 
-    /* Read from coord field with seqlock consistency check */
-    const ekk_coord_field_t *cf = &g_field_region->fields[target_id];
-
     /* Memory barrier before read */
     ekk_hal_memory_barrier();
 
-    /* Read sequence before */
-    uint32_t seq_before = cf->sequence;
-    if (seq_before & 1) {
-        /* Write in progress, try later */
-        return EKK_ERR_BUSY;
+    /* Copy under seqlock; odd or changed sequence means a write raced us */
+    ekk_field_t snap;
+    if (!read_module(target_id, &snap)) {
+        return EKK_ERR_BUSY;  /* Caller should retry */
     }
 
-    ekk_hal_memory_barrier();
-
     /* Check validity */
-    if (cf->field.source == EKK_INVALID_MODULE_ID) {
+    if (snap.source == EKK_INVALID_MODULE_ID) {
         return EKK_ERR_NOT_FOUND;
     }
 
     /* Check age */
-    ekk_time_us_t age = now - cf->field.timestamp;
-    if (age > EKK_FIELD_MAX_AGE_US) {
+    ekk_time_us_t age = now - snap.timestamp;
+    if (age > g_max_age_us) {
         return EKK_ERR_FIELD_EXPIRED;
     }
 
-    /* Copy field data */
-    memcpy(field, &cf->field, sizeof(ekk_field_t));
+    memcpy(field, &snap, sizeof(ekk_field_t));
 
-    /* Memory barrier after read */
+    /* Apply decay based on age */
+    ekk_field_apply_decay(field, age);
+
+    return EKK_OK;
+}
+
+ekk_error_t ekk_field_sample_component(ekk_module_id_t target_id,
+                                        ekk_field_component_t component,
+                                        ekk_fixed_t *value)
+{
+    if (g_field_region == NULL) {
+        return EKK_ERR_HAL_FAILURE;
+    }
+
+    if (!EKK_MODULE_ID_VALID(target_id) ||
+        component >= EKK_FIELD_COUNT || value == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    ekk_time_us_t now = ekk_hal_time_us();
+
+    int32_t slot = ekk_field_region_slot(g_field_region, target_id);
+    if (slot < 0) {
+        return EKK_ERR_NOT_FOUND;
+    }
+
+    uint32_t seq_before = SLOT_SEQ(slot);
+    if (seq_before & 1) {
+        return EKK_ERR_BUSY;
+    }
+
+    ekk_hal_memory_barrier();
+    ekk_module_id_t source = SLOT_SOURCE(slot);
+    ekk_time_us_t timestamp = SLOT_TIMESTAMP(slot);
+    ekk_fixed_t raw = SLOT_COMPONENT(slot, component);
     ekk_hal_memory_barrier();
 
-    /* Check sequence after - retry if changed */
-    if (cf->sequence != seq_before) {
-        return EKK_ERR_BUSY;  /* Torn read, caller should retry */
+    if (SLOT_SEQ(slot) != seq_before) {
+        return EKK_ERR_BUSY;
     }
 
-    /* Apply decay based on age */
-    ekk_field_apply_decay(field, age);
+    /* Empty, or recycled for another module since the lookup */
+    if (source != target_id) {
+        return EKK_ERR_NOT_FOUND;
+    }
+
+    ekk_time_us_t age = now - timestamp;
+    if (age > g_max_age_us) {
+        return EKK_ERR_FIELD_EXPIRED;
+    }
 
+    *value = decay_value(&g_decay[component], raw, age);
     return EKK_OK;
 }
 
@@ -183,6 +1139,160 @@ ekk_error_t ekk_field_sample(ekk_module_id_t target_id, ekk_field_t *field)
  * NEIGHBOR AGGREGATION
  * ============================================================================ */
 
+/**
+ * Batch aggregation works in two passes over at most EKK_FIELD_BATCH slots:
+ *
+ * 1. Snapshot: copy each neighbor slot under its seqlock, using one time
+ *    read for the whole batch, apply the per-component decay tables, and
+ *    fold health and distance into a per-neighbor scale (Q16.16). With the
+ *    default config (one curve, no clamps) the decay factor goes into the
+ *    scale instead.
+ * 2. Accumulate: sums[c] += decayed[c] * scale, 64-bit, vectorized over
+ *    components. The kernel is selected at compile time.
+ *
+ * The result is sum(decayed * weight) / sum(weight), i.e. the values
+ * ekk_field_sample() would return (to rounding), averaged by
+ * health/distance weight.
+ */
+
+/** Lanes per batch row (EKK_FIELD_COUNT padded for 256-bit vectors) */
+#define EKK_FIELD_LANES         8
+
+/** Neighbors snapshotted per pass */
+#define EKK_FIELD_BATCH         EKK_K_NEIGHBORS
+
+/** Seqlock attempts per slot before the neighbor is skipped */
+#define EKK_FIELD_READ_RETRIES  3
+
+EKK_STATIC_ASSERT(EKK_FIELD_COUNT <= EKK_FIELD_LANES, "field lanes too narrow");
+
+#if EKK_FIELD_SIMD && defined(__AVX2__)
+#include <immintrin.h>
+#define EKK_FIELD_KERNEL_NAME   "avx2"
+#elif EKK_FIELD_SIMD && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define EKK_FIELD_KERNEL_NAME   "sse2"
+#elif EKK_FIELD_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define EKK_FIELD_KERNEL_NAME   "neon"
+#else
+#define EKK_FIELD_KERNEL_NAME   "scalar"
+#endif
+
+/**
+ * @brief Health/distance weight for a neighbor
+ * @return Weight (Q16.16), 0 if neighbor should be skipped
+ */
+static ekk_fixed_t neighbor_weight(const ekk_neighbor_t *neighbor)
+{
+    /* Skip dead or unknown neighbors */
+    if (neighbor->health == EKK_HEALTH_DEAD ||
+        neighbor->health == EKK_HEALTH_UNKNOWN) {
+        return 0;
+    }
+
+    /* Health factor: suspect neighbors weighted at 50% */
+    ekk_fixed_t weight = (neighbor->health == EKK_HEALTH_SUSPECT) ?
+                         EKK_FIXED_HALF : EKK_FIXED_ONE;
+
+    /* Distance factor: w = 1 / (1 + distance/256) */
+    if (neighbor->logical_distance > 0) {
+        ekk_fixed_t dist_factor = ekk_fixed_div(
+            EKK_FIXED_ONE,
+            EKK_FIXED_ONE + (neighbor->logical_distance << 8)
+        );
+        weight = ekk_fixed_mul(weight, dist_factor);
+    }
+
+    return weight;
+}
+
+/**
+ * @brief sums[c] += rows[i][c] * scale[i] for all rows
+ *
+ * Scales are non-negative Q16.16, so the products are exact Q32.32 and
+ * every kernel produces bit-identical sums.
+ */
+static void accumulate_rows(int64_t *sums,
+                            const int32_t rows[][EKK_FIELD_LANES],
+                            const ekk_fixed_t *scale,
+                            uint32_t count)
+{
+#if defined(__AVX2__) && EKK_FIELD_SIMD
+    __m256i acc_lo = _mm256_loadu_si256((const __m256i *)&sums[0]);
+    __m256i acc_hi = _mm256_loadu_si256((const __m256i *)&sums[4]);
+
+    for (uint32_t i = 0; i < count; i++) {
+        __m256i s = _mm256_set1_epi64x(scale[i]);
+        __m256i lo = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)&rows[i][0]));
+        __m256i hi = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)&rows[i][4]));
+        acc_lo = _mm256_add_epi64(acc_lo, _mm256_mul_epi32(lo, s));
+        acc_hi = _mm256_add_epi64(acc_hi, _mm256_mul_epi32(hi, s));
+    }
+
+    _mm256_storeu_si256((__m256i *)&sums[0], acc_lo);
+    _mm256_storeu_si256((__m256i *)&sums[4], acc_hi);
+
+#elif (defined(__SSE2__) || defined(_M_X64)) && EKK_FIELD_SIMD
+    /* SSE2 only has an unsigned 32x32->64 multiply. Lanes are widened
+     * to [x, 0] pairs and negative components corrected afterwards:
+     * (x + 2^32) * s - (s << 32) == x * s. */
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc[EKK_FIELD_LANES / 2];
+    for (int l = 0; l < EKK_FIELD_LANES / 2; l++) {
+        acc[l] = _mm_loadu_si128((const __m128i *)&sums[l * 2]);
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        __m128i s = _mm_set1_epi32(scale[i]);
+        for (int q = 0; q < EKK_FIELD_LANES / 4; q++) {
+            __m128i v = _mm_loadu_si128((const __m128i *)&rows[i][q * 4]);
+            __m128i pair[2] = {
+                _mm_unpacklo_epi32(v, zero),
+                _mm_unpackhi_epi32(v, zero),
+            };
+            for (int h = 0; h < 2; h++) {
+                __m128i prod = _mm_mul_epu32(pair[h], s);
+                __m128i neg = _mm_and_si128(_mm_srai_epi32(pair[h], 31), s);
+                prod = _mm_sub_epi64(prod, _mm_slli_epi64(neg, 32));
+                acc[q * 2 + h] = _mm_add_epi64(acc[q * 2 + h], prod);
+            }
+        }
+    }
+
+    for (int l = 0; l < EKK_FIELD_LANES / 2; l++) {
+        _mm_storeu_si128((__m128i *)&sums[l * 2], acc[l]);
+    }
+
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && EKK_FIELD_SIMD
+    int64x2_t acc[EKK_FIELD_LANES / 2];
+    for (int l = 0; l < EKK_FIELD_LANES / 2; l++) {
+        acc[l] = vld1q_s64(&sums[l * 2]);
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        for (int l = 0; l < EKK_FIELD_LANES / 2; l++) {
+            acc[l] = vmlal_n_s32(acc[l], vld1_s32(&rows[i][l * 2]), scale[i]);
+        }
+    }
+
+    for (int l = 0; l < EKK_FIELD_LANES / 2; l++) {
+        vst1q_s64(&sums[l * 2], acc[l]);
+    }
+
+#else
+    /* Cortex-M4/M33: each step is a single SMLAL. The DSP dual-MAC
+     * (__smlad/__smlald) works on 16-bit halves and cannot carry Q16.16
+     * operands exactly, so it is not used here. */
+    for (uint32_t i = 0; i < count; i++) {
+        const int64_t s = scale[i];
+        for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+            sums[c] += (int64_t)rows[i][c] * s;
+        }
+    }
+#endif
+}
+
 ekk_error_t ekk_field_sample_neighbors(ekk_module_id_t module_id,
                                         const ekk_neighbor_t *neighbors,
                                         uint32_t neighbor_count,
@@ -197,73 +1307,276 @@ ekk_error_t ekk_field_sample_neighbors(ekk_module_id_t module_id,
     /* Clear aggregate */
     memset(aggregate, 0, sizeof(ekk_field_t));
 
-    if (neighbor_count == 0) {
+    if (neighbor_count == 0 || g_field_region == NULL) {
         return EKK_OK;
     }
 
-    /* Accumulate weighted sum */
-    int64_t sums[EKK_FIELD_COUNT] = {0};
-    ekk_fixed_t total_weight = 0;
-    uint32_t valid_count = 0;
+    /* One time read for the whole neighborhood */
+    ekk_time_us_t now = ekk_hal_time_us();
+
+    int64_t sums[EKK_FIELD_LANES] = {0};
+    int64_t total_weight = 0;
     ekk_time_us_t max_timestamp = 0;
 
-    for (uint32_t i = 0; i < neighbor_count; i++) {
-        const ekk_neighbor_t *neighbor = &neighbors[i];
+    int32_t rows[EKK_FIELD_BATCH][EKK_FIELD_LANES];
+    ekk_fixed_t scale[EKK_FIELD_BATCH];
+
+    uint32_t next = 0;
+    while (next < neighbor_count) {
+        uint32_t batch = 0;
+
+        /* Pass 1: snapshot slots */
+        for (; next < neighbor_count && batch < EKK_FIELD_BATCH; next++) {
+            const ekk_neighbor_t *neighbor = &neighbors[next];
+
+            ekk_fixed_t weight = neighbor_weight(neighbor);
+            if (weight == 0 || !EKK_MODULE_ID_VALID(neighbor->id)) {
+                continue;
+            }
+
+            ekk_field_t snap;
+            bool consistent = false;
+            for (int r = 0; r < EKK_FIELD_READ_RETRIES && !consistent; r++) {
+                consistent = read_module(neighbor->id, &snap);
+            }
+            if (!consistent || snap.source == EKK_INVALID_MODULE_ID) {
+                continue;
+            }
+
+            /* Published after our time read: age 0, not expired */
+            ekk_time_us_t age = (snap.timestamp > now) ? 0 : now - snap.timestamp;
+            if (age > g_max_age_us) {
+                continue;
+            }
+
+            if (g_decay_uniform) {
+                /* One curve, no clamps: fold decay into the scale */
+                for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+                    rows[batch][c] = snap.components[c];
+                }
+                scale[batch] = ekk_fixed_mul(decay_factor(&g_decay[0], age), weight);
+            } else {
+                decay_components(rows[batch], snap.components, age);
+                scale[batch] = weight;
+            }
+            for (int c = EKK_FIELD_COUNT; c < EKK_FIELD_LANES; c++) {
+                rows[batch][c] = 0;
+            }
+            total_weight += weight;
+            batch++;
+
+            if (snap.timestamp > max_timestamp) {
+                max_timestamp = snap.timestamp;
+            }
+        }
 
-        /* Skip dead or unknown neighbors */
-        if (neighbor->health == EKK_HEALTH_DEAD ||
-            neighbor->health == EKK_HEALTH_UNKNOWN) {
-            continue;
+        /* Pass 2: weighted accumulate */
+        accumulate_rows(sums, (const int32_t (*)[EKK_FIELD_LANES])rows,
+                        scale, batch);
+    }
+
+    /* Weighted average: Q32.32 / Q16.16 = Q16.16 */
+    if (total_weight > 0) {
+        for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+            aggregate->components[c] = (ekk_fixed_t)(sums[c] / total_weight);
+        }
+    }
+
+    aggregate->timestamp = max_timestamp;
+    aggregate->source = EKK_INVALID_MODULE_ID;  /* Aggregate, not single source */
+    aggregate->sequence = 0;
+
+    return EKK_OK;
+}
+
+const char* ekk_field_kernel_name(void)
+{
+    return EKK_FIELD_KERNEL_NAME;
+}
+
+/* ============================================================================
+ * INCREMENTAL AGGREGATION
+ * ============================================================================ */
+
+/**
+ * @brief Latest time an unchanged neighbor may go without re-decay
+ *
+ * Exponential decay moves a value by at most |decayed|/tau per us and
+ * linear decay by |raw|/tau, so the drift stays within tolerance for
+ * tolerance*tau/|v|. Decay span ends (step edges, zero crossings) and
+ * slot expiry are hard edges.
+ */
+static ekk_time_us_t agg_next_eval(const ekk_fixed_t *raw, const ekk_fixed_t *decayed,
+                                   ekk_time_us_t timestamp, ekk_time_us_t now,
+                                   ekk_fixed_t tolerance)
+{
+    ekk_time_us_t next = timestamp + g_max_age_us + 1;
+
+    for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+        const ekk_decay_eval_t *ev = &g_decay[c];
+
+        ekk_time_us_t edge = timestamp + ev->span_us;
+        if (edge > now && edge < next) {
+            next = edge;
         }
 
-        /* Sample neighbor's field */
-        ekk_field_t nfield;
-        ekk_error_t err = ekk_field_sample(neighbor->id, &nfield);
-        if (err != EKK_OK) {
+        if (ev->model == EKK_DECAY_STEP) {
+            continue;
+        }
+        int64_t v = (ev->model == EKK_DECAY_EXPONENTIAL) ? decayed[c] : raw[c];
+        uint64_t mag = (uint64_t)((v < 0) ? -v : v);
+        if (mag == 0) {
             continue;
         }
+        ekk_time_us_t horizon = ((uint64_t)tolerance * ev->tau_us) / mag;
+        if (now + horizon < next) {
+            next = now + horizon;
+        }
+    }
+
+    return (next > now) ? next : now + 1;
+}
+
+void ekk_field_aggregator_init(ekk_field_aggregator_t *agg, ekk_fixed_t tolerance)
+{
+    if (agg == NULL) {
+        return;
+    }
+
+    memset(agg, 0, sizeof(*agg));
+    agg->tolerance = (tolerance > 0) ? tolerance : 0;
+}
+
+ekk_error_t ekk_field_aggregate_update(ekk_field_aggregator_t *agg,
+                                        const ekk_neighbor_t *neighbors,
+                                        uint32_t neighbor_count,
+                                        ekk_field_t *aggregate,
+                                        bool *changed)
+{
+    if (agg == NULL || aggregate == NULL ||
+        (neighbors == NULL && neighbor_count > 0)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    bool any_change = false;
+
+    if (g_field_region == NULL) {
+        memset(aggregate, 0, sizeof(ekk_field_t));
+        aggregate->source = EKK_INVALID_MODULE_ID;
+        if (changed != NULL) {
+            *changed = false;
+        }
+        return EKK_OK;
+    }
+
+    if (neighbor_count > EKK_K_NEIGHBORS) {
+        neighbor_count = EKK_K_NEIGHBORS;
+    }
+
+    ekk_time_us_t now = ekk_hal_time_us();
+
+    uint32_t updated[EKK_FIELD_FLAG_WORDS];
+    ekk_field_changes_since(&agg->cursor, updated);
 
-        /* Compute weight based on health and distance */
-        ekk_fixed_t weight = EKK_FIXED_ONE;
+    uint32_t slots = EKK_MAX(neighbor_count, agg->count);
+    for (uint32_t i = 0; i < slots; i++) {
+        ekk_field_agg_entry_t *e = &agg->entries[i];
+        const ekk_neighbor_t *n = (i < neighbor_count) ? &neighbors[i] : NULL;
 
-        /* Health factor: suspect neighbors weighted at 50% */
-        if (neighbor->health == EKK_HEALTH_SUSPECT) {
-            weight = EKK_FIXED_HALF;
+        ekk_module_id_t id = EKK_INVALID_MODULE_ID;
+        ekk_fixed_t weight = 0;
+        if (n != NULL && EKK_MODULE_ID_VALID(n->id)) {
+            id = n->id;
+            weight = neighbor_weight(n);
         }
 
-        /* Distance factor: closer neighbors weighted higher */
-        /* w = 1 / (1 + distance/256) approximated */
-        if (neighbor->logical_distance > 0) {
-            ekk_fixed_t dist_factor = ekk_fixed_div(
-                EKK_FIXED_ONE,
-                EKK_FIXED_ONE + (neighbor->logical_distance << 8)
-            );
-            weight = ekk_fixed_mul(weight, dist_factor);
+        bool dirty = (id != e->id) || (weight != e->weight) ||
+                     (e->present && now >= e->next_eval);
+        if (!dirty && id != EKK_INVALID_MODULE_ID) {
+            int32_t slot = ekk_field_region_slot(g_field_region, id);
+            dirty = (slot < 0) ? e->present : ((updated[slot / 32] >> (slot % 32)) & 1u);
+        }
+        if (!dirty) {
+            agg->skipped++;
+            continue;
+        }
+        agg->evaluated++;
+
+        /* Take the old contribution out */
+        bool was_present = e->present;
+        ekk_fixed_t old_decayed[EKK_FIELD_COUNT];
+        ekk_time_us_t old_timestamp = e->timestamp;
+        memcpy(old_decayed, e->decayed, sizeof(old_decayed));
+        if (e->present) {
+            for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+                agg->sums[c] -= (int64_t)e->decayed[c] * e->weight;
+            }
+            agg->total_weight -= e->weight;
+            e->present = false;
         }
 
-        /* Accumulate weighted components */
-        for (int c = 0; c < EKK_FIELD_COUNT; c++) {
-            sums[c] += (int64_t)ekk_fixed_mul(nfield.components[c], weight);
+        e->id = id;
+        e->weight = weight;
+
+        if (weight > 0) {
+            ekk_field_t snap;
+            bool consistent = false;
+            for (int r = 0; r < EKK_FIELD_READ_RETRIES && !consistent; r++) {
+                consistent = read_module(id, &snap);
+            }
+
+            if (!consistent) {
+                /* Writer busy: keep the previous snapshot, retry next call */
+                if (was_present) {
+                    snap.source = id;
+                    snap.timestamp = e->timestamp;
+                    memcpy(snap.components, e->raw, sizeof(e->raw));
+                } else {
+                    snap.source = EKK_INVALID_MODULE_ID;
+                }
+            }
+
+            /* Published after our time read: age 0, not expired */
+            ekk_time_us_t age = (snap.timestamp > now) ? 0 : now - snap.timestamp;
+            if (snap.source != EKK_INVALID_MODULE_ID && age <= g_max_age_us) {
+                memcpy(e->raw, snap.components, sizeof(e->raw));
+                e->timestamp = snap.timestamp;
+                decay_components(e->decayed, e->raw, age);
+                e->next_eval = consistent ?
+                    agg_next_eval(e->raw, e->decayed, e->timestamp, now, agg->tolerance) : now;
+                e->present = true;
+
+                for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+                    agg->sums[c] += (int64_t)e->decayed[c] * weight;
+                }
+                agg->total_weight += weight;
+            }
         }
-        total_weight += weight;
-        valid_count++;
 
-        if (nfield.timestamp > max_timestamp) {
-            max_timestamp = nfield.timestamp;
+        if (e->present != was_present ||
+            (e->present && (e->timestamp != old_timestamp ||
+                            memcmp(e->decayed, old_decayed, sizeof(old_decayed)) != 0))) {
+            any_change = true;
         }
     }
+    agg->count = neighbor_count;
 
-    /* Compute weighted average */
-    if (total_weight > 0) {
+    memset(aggregate, 0, sizeof(ekk_field_t));
+    if (agg->total_weight > 0) {
         for (int c = 0; c < EKK_FIELD_COUNT; c++) {
-            aggregate->components[c] = (ekk_fixed_t)(sums[c] / (total_weight >> 16));
+            aggregate->components[c] = (ekk_fixed_t)(agg->sums[c] / agg->total_weight);
+        }
+    }
+    for (uint32_t i = 0; i < neighbor_count; i++) {
+        if (agg->entries[i].present && agg->entries[i].timestamp > aggregate->timestamp) {
+            aggregate->timestamp = agg->entries[i].timestamp;
         }
     }
-
-    aggregate->timestamp = max_timestamp;
     aggregate->source = EKK_INVALID_MODULE_ID;  /* Aggregate, not single source */
-    aggregate->sequence = 0;
 
+    if (changed != NULL) {
+        *changed = any_change;
+    }
     return EKK_OK;
 }
 
@@ -313,13 +1626,8 @@ void ekk_field_apply_decay(ekk_field_t *field, ekk_time_us_t elapsed_us)
         return;
     }
 
-    /* Compute decay factor */
-    ekk_fixed_t decay_factor = ekk_fixed_exp_decay(elapsed_us, g_decay_tau_us);
-
-    /* Apply to all components */
-    for (int i = 0; i < EKK_FIELD_COUNT; i++) {
-        field->components[i] = ekk_fixed_mul(field->components[i], decay_factor);
-    }
+    /* Per-component model, tau and clamps */
+    decay_components(field->components, field->components, elapsed_us);
 }
 
 /* ============================================================================
@@ -332,25 +1640,72 @@ uint32_t ekk_field_gc(ekk_time_us_t max_age_us)
         return 0;
     }
 
+    ekk_field_region_t *r = g_field_region;
     ekk_time_us_t now = ekk_hal_time_us();
     uint32_t expired_count = 0;
 
-    for (int i = 0; i < EKK_MAX_MODULES; i++) {
-        ekk_coord_field_t *cf = &g_field_region->fields[i];
-
-        if (cf->field.source == EKK_INVALID_MODULE_ID) {
-            continue;
-        }
-
-        ekk_time_us_t age = now - cf->field.timestamp;
-        if (age > max_age_us) {
-            /* Mark as invalid */
-            cf->field.source = EKK_INVALID_MODULE_ID;
-            expired_count++;
+    /* Buckets up to the one holding (now - max_age) may contain expired
+     * slots. The last one is only partly due, so the cursor stops on it
+     * and it is looked at again next time. */
+    uint32_t target = (now > max_age_us) ? wheel_tick(now - max_age_us) : 0;
+    int32_t behind = (int32_t)(target - r->wheel_cursor);
+    if (behind < 0) {
+        /* Clock went back or max_age grew: nothing new is due */
+        r->wheel_cursor = target;
+        behind = 0;
+    }
+    uint32_t buckets = ((uint32_t)behind >= EKK_FIELD_WHEEL_SLOTS) ?
+                       EKK_FIELD_WHEEL_SLOTS : (uint32_t)behind + 1;
+
+    for (uint32_t n = 0; n < buckets; n++) {
+        uint32_t *bucket = r->expiry_wheel[(r->wheel_cursor + n) & (EKK_FIELD_WHEEL_SLOTS - 1)];
+
+        for (uint32_t w = 0; w < EKK_FIELD_FLAG_WORDS; w++) {
+            uint32_t bits = bucket[w];
+
+            while (bits != 0) {
+                uint32_t bit = bits & (~bits + 1);
+                uint32_t i = w * 32 + lowest_bit(bits);
+                bits &= bits - 1;
+
+                /* Hashed wheel: a bucket also holds slots from later laps.
+                 * A slot published since we read the clock is age 0. */
+                ekk_time_us_t stamp = SLOT_TIMESTAMP(i);
+                ekk_time_us_t age = (stamp > now) ? 0 : now - stamp;
+                if (age <= max_age_us) {
+                    continue;
+                }
+
+                /* Mark as invalid; report it so incremental consumers drop it */
+                uint32_t state = region_lock();
+                stamp = SLOT_TIMESTAMP(i);
+                age = (stamp > now) ? 0 : now - stamp;
+                if ((bucket[w] & bit) && age > max_age_us) {
+#if EKK_MODULE_ID_BITS > 8
+                    /* Hand the slot back; readers that looked it up
+                     * earlier see the invalid source */
+                    ekk_idmap_remove(&r->slots, SLOT_SOURCE(i));
+#endif
+                    /* Under the slot's seqlock, so readers never pair
+                     * the old field with the invalid source */
+                    ekk_hal_memory_barrier();
+                    SLOT_SEQ(i)++;
+                    ekk_hal_memory_barrier();
+                    SLOT_SOURCE(i) = EKK_INVALID_MODULE_ID;
+                    ekk_hal_memory_barrier();
+                    SLOT_SEQ(i)++;
+                    bucket[w] &= ~bit;
+                    r->occupied[w] &= ~bit;
+                    slot_changed(r, i);
+                    expired_count++;
+                }
+                region_unlock(state);
+            }
         }
     }
+    r->wheel_cursor = target;
 
-    g_field_region->last_gc = now;
+    r->last_gc = now;
     return expired_count;
 }
 
@@ -265,13 +265,12 @@ ekk_error_t ekk_gateway_process_can(ekk_gateway_t *gw, uint8_t can_idx,
 
     /* Check for gossip message */
     if (len >= 1 && data[0] == EKK_MSG_EVENT_GOSSIP) {
-        if (len >= sizeof(ekk_gossip_msg_t)) {
-            const ekk_gossip_msg_t *msg = (const ekk_gossip_msg_t *)data;
+        const ekk_gossip_msg_t *msg = (const ekk_gossip_msg_t *)data;
+        uint8_t event_count = ekk_gossip_msg_events(msg, len);
 
-            /* Process each event */
-            for (uint8_t i = 0; i < msg->event_count && i < EKK_GOSSIP_BATCH_SIZE; i++) {
-                ekk_gateway_append(gw, msg->source_module, &msg->events[i]);
-            }
+        /* Process each event */
+        for (uint8_t i = 0; i < event_count; i++) {
+            ekk_gateway_append(gw, msg->source_module, &msg->events[i]);
         }
     }
 
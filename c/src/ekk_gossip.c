@@ -219,7 +219,7 @@ ekk_error_t ekk_gossip_remove_neighbor(ekk_gossip_ctx_t *ctx, ekk_module_id_t ne
 ekk_error_t ekk_gossip_emit(ekk_gossip_ctx_t *ctx, uint8_t event_type,
                             const uint8_t *payload, uint8_t payload_len) {
     if (!ctx) return EKK_ERR_INVALID_ARG;
-    if (payload_len > 20) return EKK_ERR_INVALID_ARG;
+    if (payload_len > EKK_EVENT_V2_PAYLOAD) return EKK_ERR_INVALID_ARG;
 
     /* Check buffer space */
     if (ctx->pending_count >= 8) {
@@ -273,7 +273,12 @@ static ekk_error_t send_gossip_to_neighbor(ekk_gossip_ctx_t *ctx,
 
     msg.msg_type = EKK_MSG_EVENT_GOSSIP;
     msg.source_module = ctx->my_id;
+#if EKK_MODULE_ID_BITS == 8
     msg.event_count = event_count;
+    uint32_t msg_len = sizeof(msg);
+#else
+    uint32_t msg_len = (uint32_t)EKK_GOSSIP_MSG_LEN(event_count);
+#endif
 
     /* Build neighbor ID array for VV summary */
     ekk_module_id_t neighbor_ids[EKK_K_NEIGHBORS];
@@ -293,7 +298,7 @@ static ekk_error_t send_gossip_to_neighbor(ekk_gossip_ctx_t *ctx,
 
     /* Send via HAL callback */
     ctx->stats.events_sent += event_count;
-    return ekk_gossip_send(neighbor_id, (const uint8_t *)&msg, sizeof(msg));
+    return ekk_gossip_send(neighbor_id, (const uint8_t *)&msg, msg_len);
 }
 
 ekk_error_t ekk_gossip_tick(ekk_gossip_ctx_t *ctx, ekk_time_us_t now) {
@@ -350,14 +355,14 @@ ekk_error_t ekk_gossip_handle_msg(ekk_gossip_ctx_t *ctx, const uint8_t *data, ui
 
     switch (msg_type) {
         case EKK_MSG_EVENT_GOSSIP: {
-            if (len < sizeof(ekk_gossip_msg_t)) {
+            const ekk_gossip_msg_t *msg = (const ekk_gossip_msg_t *)data;
+            uint8_t event_count = ekk_gossip_msg_events(msg, len);
+            if (event_count == 0) {
                 return EKK_ERR_INVALID_ARG;
             }
 
-            const ekk_gossip_msg_t *msg = (const ekk_gossip_msg_t *)data;
-
             /* Process each event */
-            for (uint8_t i = 0; i < msg->event_count && i < EKK_GOSSIP_BATCH_SIZE; i++) {
+            for (uint8_t i = 0; i < event_count; i++) {
                 ekk_gossip_handle_event(ctx, &msg->events[i], msg->source_module);
             }
 
@@ -375,7 +380,7 @@ ekk_error_t ekk_gossip_handle_msg(ekk_gossip_ctx_t *ctx, const uint8_t *data, ui
         }
 
         case EKK_MSG_EVENT_ACK: {
-            if (len < sizeof(ekk_gossip_ack_t)) {
+            if (ekk_gossip_ack_count((const ekk_gossip_ack_t *)data, len) == 0) {
                 return EKK_ERR_INVALID_ARG;
             }
             /* ACKs are informational - no action needed with at-least-once delivery */
@@ -392,7 +397,8 @@ ekk_error_t ekk_gossip_handle_msg(ekk_gossip_ctx_t *ctx, const uint8_t *data, ui
             /* Only respond if we're the target origin */
             if (req->target_origin == ctx->my_id) {
                 /* Send requested events */
-                for (uint32_t seq = req->from_seq; seq <= req->to_seq; seq++) {
+                uint32_t to_seq = ekk_gossip_request_to_seq(req);
+                for (uint32_t seq = req->from_seq; seq <= to_seq; seq++) {
                     ekk_event_v2_t event;
                     if (ekk_gossip_load_event(ctx->my_id, seq, &event) == EKK_OK) {
                         send_gossip_to_neighbor(ctx, req->requester, &event, 1);
@@ -436,12 +442,11 @@ ekk_error_t ekk_gossip_handle_event(ekk_gossip_ctx_t *ctx, const ekk_event_v2_t
 
         /* Send gap fill request */
         ekk_gossip_request_t req;
+        memset(&req, 0, sizeof(req));
         req.msg_type = EKK_MSG_EVENT_REQUEST;
         req.requester = ctx->my_id;
         req.target_origin = event->origin_id;
-        req._reserved = 0;
-        req.from_seq = known_seq + 1;
-        req.to_seq = event->origin_seq - 1;
+        ekk_gossip_request_set_range(&req, known_seq + 1, event->origin_seq - 1);
 
         ekk_gossip_send(sender, (const uint8_t *)&req, sizeof(req));
 
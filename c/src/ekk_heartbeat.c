@@ -8,12 +8,289 @@
  * - Automatic neighbor health tracking
  * - State machine: Unknown → Alive → Suspect → Dead
  * - Callbacks on state transitions
+ * - Echo-probe RTT sampling (track_latency)
+ * - Phi-accrual suspicion from inter-arrival statistics (phi_accrual)
  */
 
 #include "ekk/ekk_heartbeat.h"
 #include "ekk/ekk_hal.h"
 #include <string.h>
 
+/* ============================================================================
+ * PHI ACCRUAL
+ * ============================================================================ */
+
+/*
+ * phi = -log10(P(arrival later than t)). With y = (t - mean) / std the
+ * normal tail is approximated by the logistic 1 / (1 + exp(z)),
+ * z = y * (A + B * y^2), so phi = log10(1 + exp(z))
+ *                               = max(z, 0) * log10(e) + log10(1 + exp(-|z|)).
+ */
+#define PHI_LOGISTIC_A      104700              /**< 1.5976 (Q16.16) */
+#define PHI_LOGISTIC_B      4625                /**< 0.070566 (Q16.16) */
+#define PHI_LOG10_E         28462               /**< log10(e) (Q16.16) */
+#define PHI_Y_MIN           (-8 * EKK_FIXED_ONE)
+#define PHI_Y_MAX           (64 * EKK_FIXED_ONE)
+
+/** log10(1 + exp(-w)) for w = 0, 0.5, ..., 8 (Q16.16); ~0 beyond */
+static const int32_t k_phi_tail[17] = {
+    19728, 13493, 8916, 5733, 3613, 2245, 1383, 847,
+    517, 314, 191, 116, 70, 43, 26, 16, 10,
+};
+
+/**
+ * @brief phi for a normalized delay y (Q16.16 in, Q16.16 out)
+ */
+static ekk_fixed_t phi_from_y(ekk_fixed_t y)
+{
+    int64_t yc = EKK_CLAMP((int64_t)y, (int64_t)PHI_Y_MIN, (int64_t)PHI_Y_MAX);
+    int64_t y2 = (yc * yc) >> 16;
+    int64_t z = (((int64_t)PHI_LOGISTIC_A + ((PHI_LOGISTIC_B * y2) >> 16)) * yc) >> 16;
+    int64_t w = (z < 0) ? -z : z;
+    int64_t phi = (z > 0) ? (z * PHI_LOG10_E) >> 16 : 0;
+
+    /* Table step is 0.5 (1 << 15 in Q16.16) */
+    int64_t idx = w >> 15;
+    if (idx < 16) {
+        int64_t frac = w & 0x7FFF;
+        phi += k_phi_tail[idx] + (((k_phi_tail[idx + 1] - k_phi_tail[idx]) * frac) >> 15);
+    }
+
+    return (ekk_fixed_t)EKK_MIN(phi, (int64_t)INT32_MAX);
+}
+
+/**
+ * @brief Smallest normalized delay whose phi reaches the given level
+ *
+ * Solved once at init, so classifying a neighbor is a multiply and a
+ * compare against mean + y * std rather than a per-tick division.
+ */
+static ekk_fixed_t phi_threshold_y(ekk_fixed_t phi)
+{
+    int32_t lo = PHI_Y_MIN;
+    int32_t hi = PHI_Y_MAX;
+
+    while (lo < hi) {
+        int32_t mid = (int32_t)(((int64_t)lo + hi) >> 1);
+        if (phi_from_y(mid) < phi) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief Silence after which a neighbor's phi reaches a threshold
+ */
+static ekk_time_us_t phi_deadline(const ekk_heartbeat_neighbor_t *neighbor, ekk_fixed_t y)
+{
+    int64_t t = (int64_t)neighbor->arrival_mean +
+                (((int64_t)y * neighbor->arrival_std) >> 16);
+    return (t > 0) ? (ekk_time_us_t)t : 0;
+}
+
+/**
+ * @brief Integer square root (floor)
+ */
+static uint32_t isqrt64(uint64_t n)
+{
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+/**
+ * @brief Fold one heartbeat interval into the inter-arrival statistics
+ *
+ * EWMA mean and variance with 1/8 weight: var' = 7/8 * (var + delta^2 / 8).
+ */
+static void arrival_sample(const ekk_heartbeat_t *hb,
+                           ekk_heartbeat_neighbor_t *neighbor,
+                           ekk_time_us_t interval)
+{
+    int64_t x = (int64_t)EKK_MIN(interval, (ekk_time_us_t)INT32_MAX);
+    int64_t delta = x - (int64_t)neighbor->arrival_mean;
+    neighbor->arrival_mean = (uint32_t)((int64_t)neighbor->arrival_mean + delta / 8);
+
+    uint64_t d2 = (uint64_t)(delta * delta);
+    neighbor->arrival_var = (neighbor->arrival_var + d2 / 8) / 8 * 7;
+
+    uint32_t std = isqrt64(neighbor->arrival_var);
+    neighbor->arrival_std = (uint32_t)EKK_MAX((ekk_time_us_t)std, hb->config.phi_min_std);
+}
+
+/* ============================================================================
+ * HEALTH CLASSIFICATION
+ * ============================================================================ */
+
+#define NO_DEADLINE         UINT64_MAX
+
+/**
+ * @brief Health after a silence of elapsed, and the silence at which it
+ *        would next change (NO_DEADLINE once DEAD)
+ *
+ * Every threshold returned is strictly greater than elapsed.
+ */
+static ekk_health_state_t classify(const ekk_heartbeat_t *hb,
+                                   ekk_heartbeat_neighbor_t *neighbor,
+                                   ekk_time_us_t elapsed,
+                                   ekk_time_us_t *next)
+{
+    if (hb->config.phi_accrual) {
+        ekk_time_us_t suspect_at = phi_deadline(neighbor, hb->phi_y_suspect);
+        ekk_time_us_t dead_at = phi_deadline(neighbor, hb->phi_y_dead);
+
+        if (elapsed >= dead_at) {
+            *next = NO_DEADLINE;
+            return EKK_HEALTH_DEAD;
+        }
+        if (elapsed >= suspect_at) {
+            *next = dead_at;
+            return EKK_HEALTH_SUSPECT;
+        }
+        *next = suspect_at;
+        return EKK_HEALTH_ALIVE;
+    }
+
+    ekk_time_us_t period = EKK_MAX(hb->config.period, (ekk_time_us_t)1);
+    uint32_t missed = (uint32_t)EKK_MIN(elapsed / period, (ekk_time_us_t)255);
+    if (missed > neighbor->missed_count) {
+        neighbor->missed_count = (uint8_t)missed;
+    }
+
+    if (neighbor->missed_count == 0) {
+        *next = period;
+        return EKK_HEALTH_ALIVE;
+    }
+    if (neighbor->missed_count < hb->config.timeout_count) {
+        *next = period * hb->config.timeout_count;
+        return EKK_HEALTH_SUSPECT;
+    }
+    *next = NO_DEADLINE;
+    return EKK_HEALTH_DEAD;
+}
+
+/* ============================================================================
+ * DEADLINE HEAP
+ * ============================================================================ */
+
+#define HEAP_NONE           0xFFFFu
+
+static bool deadline_before(const ekk_heartbeat_t *hb, uint32_t a, uint32_t b)
+{
+    return hb->neighbors[hb->deadline_heap[a]].deadline <
+           hb->neighbors[hb->deadline_heap[b]].deadline;
+}
+
+static void deadline_swap(ekk_heartbeat_t *hb, uint32_t a, uint32_t b)
+{
+    uint16_t tmp = hb->deadline_heap[a];
+    hb->deadline_heap[a] = hb->deadline_heap[b];
+    hb->deadline_heap[b] = tmp;
+    hb->neighbors[hb->deadline_heap[a]].heap_pos = (uint16_t)a;
+    hb->neighbors[hb->deadline_heap[b]].heap_pos = (uint16_t)b;
+}
+
+static void deadline_sift_up(ekk_heartbeat_t *hb, uint32_t pos)
+{
+    while (pos > 0) {
+        uint32_t parent = (pos - 1) / 2;
+        if (!deadline_before(hb, pos, parent)) {
+            break;
+        }
+        deadline_swap(hb, pos, parent);
+        pos = parent;
+    }
+}
+
+static void deadline_sift_down(ekk_heartbeat_t *hb, uint32_t pos)
+{
+    for (;;) {
+        uint32_t left = 2 * pos + 1;
+        uint32_t best = pos;
+        if (left < hb->deadline_count && deadline_before(hb, left, best)) {
+            best = left;
+        }
+        if (left + 1 < hb->deadline_count && deadline_before(hb, left + 1, best)) {
+            best = left + 1;
+        }
+        if (best == pos) {
+            break;
+        }
+        deadline_swap(hb, pos, best);
+        pos = best;
+    }
+}
+
+/**
+ * @brief Insert or move a neighbor's deadline
+ */
+static void deadline_schedule(ekk_heartbeat_t *hb, uint32_t idx, ekk_time_us_t when)
+{
+    ekk_heartbeat_neighbor_t *neighbor = &hb->neighbors[idx];
+    neighbor->deadline = when;
+
+    if (neighbor->heap_pos == HEAP_NONE) {
+        uint32_t pos = hb->deadline_count++;
+        hb->deadline_heap[pos] = (uint16_t)idx;
+        neighbor->heap_pos = (uint16_t)pos;
+        deadline_sift_up(hb, pos);
+    } else {
+        deadline_sift_up(hb, neighbor->heap_pos);
+        deadline_sift_down(hb, neighbor->heap_pos);
+    }
+}
+
+static void deadline_cancel(ekk_heartbeat_t *hb, uint32_t idx)
+{
+    uint32_t pos = hb->neighbors[idx].heap_pos;
+    if (pos == HEAP_NONE) {
+        return;
+    }
+
+    hb->neighbors[idx].heap_pos = HEAP_NONE;
+    uint32_t last = --hb->deadline_count;
+    if (pos != last) {
+        hb->deadline_heap[pos] = hb->deadline_heap[last];
+        hb->neighbors[hb->deadline_heap[pos]].heap_pos = (uint16_t)pos;
+        deadline_sift_up(hb, pos);
+        deadline_sift_down(hb, hb->neighbors[hb->deadline_heap[pos]].heap_pos);
+    }
+}
+
+/**
+ * @brief Schedule the next health change for a neighbor after a silence
+ *        of elapsed, and return its health now
+ */
+static ekk_health_state_t reschedule(ekk_heartbeat_t *hb, uint32_t idx, ekk_time_us_t elapsed)
+{
+    ekk_heartbeat_neighbor_t *neighbor = &hb->neighbors[idx];
+    ekk_time_us_t next;
+    ekk_health_state_t state = classify(hb, neighbor, elapsed, &next);
+
+    if (next == NO_DEADLINE) {
+        deadline_cancel(hb, idx);
+    } else {
+        deadline_schedule(hb, idx, neighbor->last_seen + next);
+    }
+    return state;
+}
+
 /* ============================================================================
  * PRIVATE HELPERS
  * ============================================================================ */
@@ -24,12 +301,38 @@
  */
 static int find_neighbor_index(const ekk_heartbeat_t *hb, ekk_module_id_t id)
 {
-    for (uint32_t i = 0; i < hb->neighbor_count; i++) {
-        if (hb->neighbors[i].id == id) {
-            return (int)i;
-        }
+#if EKK_MODULE_ID_BITS > 8
+    int32_t slot = ekk_idmap_find(&hb->index_slots, id);
+    return (slot < 0) ? -1 : (int)hb->slot_index[slot];
+#else
+    return (int)hb->index_of[id] - 1;
+#endif
+}
+
+/**
+ * @brief Point a neighbor's ID at its neighbors[] index
+ */
+static bool index_set(ekk_heartbeat_t *hb, ekk_module_id_t id, uint32_t idx)
+{
+#if EKK_MODULE_ID_BITS > 8
+    int32_t slot = ekk_idmap_insert(&hb->index_slots, id);
+    if (slot < 0) {
+        return false;
     }
-    return -1;
+    hb->slot_index[slot] = (uint16_t)idx;
+#else
+    hb->index_of[id] = (uint16_t)(idx + 1);
+#endif
+    return true;
+}
+
+static void index_clear(ekk_heartbeat_t *hb, ekk_module_id_t id)
+{
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_remove(&hb->index_slots, id);
+#else
+    hb->index_of[id] = 0;
+#endif
 }
 
 /**
@@ -45,20 +348,32 @@ static void set_neighbor_health(ekk_heartbeat_t *hb,
     }
 
     neighbor->health = new_state;
+    if (new_state == EKK_HEALTH_DEAD) {
+        neighbor->last_beat = 0;    /* Next interval would span the outage */
+    }
 
     /* Invoke callback */
     switch (new_state) {
         case EKK_HEALTH_ALIVE:
+            if (hb->inst_alive) {
+                hb->inst_alive(hb, neighbor->id);
+            }
             if (hb->on_neighbor_alive) {
                 hb->on_neighbor_alive(neighbor->id);
             }
             break;
         case EKK_HEALTH_SUSPECT:
+            if (hb->inst_suspect) {
+                hb->inst_suspect(hb, neighbor->id);
+            }
             if (hb->on_neighbor_suspect) {
                 hb->on_neighbor_suspect(neighbor->id);
             }
             break;
         case EKK_HEALTH_DEAD:
+            if (hb->inst_dead) {
+                hb->inst_dead(hb, neighbor->id);
+            }
             if (hb->on_neighbor_dead) {
                 hb->on_neighbor_dead(neighbor->id);
             }
@@ -68,6 +383,69 @@ static void set_neighbor_health(ekk_heartbeat_t *hb,
     }
 }
 
+/**
+ * @brief Send the next echo probe (round-robin over tracked modules)
+ */
+static void send_probe(ekk_heartbeat_t *hb, ekk_time_us_t now)
+{
+    hb->last_probe = now;
+    if (hb->neighbor_count == 0) {
+        return;
+    }
+
+    if (hb->probe_cursor >= hb->neighbor_count) {
+        hb->probe_cursor = 0;
+    }
+    ekk_module_id_t target = hb->neighbors[hb->probe_cursor++].id;
+
+    ekk_echo_msg_t msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_type = EKK_MSG_ECHO;
+    msg.sender_id = hb->my_id;
+    msg.target_id = target;
+    msg.token = (uint8_t)(hb->probe_token + 1);
+    msg.reply = 0;
+
+    if (ekk_heartbeat_piggyback_to(hb, target, EKK_MSG_ECHO, &msg, sizeof(msg), now) == EKK_OK) {
+        /* An unanswered earlier probe is abandoned */
+        hb->probe_token = msg.token;
+        hb->probe_target = target;
+        hb->probe_sent = now;
+    }
+}
+
+/**
+ * @brief Did every tracked neighbor get a unicast trailer this period?
+ */
+static bool period_covered(const ekk_heartbeat_t *hb)
+{
+    if (hb->neighbor_count == 0) {
+        return false;
+    }
+    for (uint32_t i = 0; i < hb->neighbor_count; i++) {
+        if (hb->neighbors[i].tx_period != hb->send_period) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Record a sign of life from a tracked neighbor
+ */
+static void mark_alive(ekk_heartbeat_t *hb, uint32_t idx, ekk_time_us_t now)
+{
+    ekk_heartbeat_neighbor_t *neighbor = &hb->neighbors[idx];
+
+    /* Update state */
+    neighbor->last_seen = now;
+    neighbor->missed_count = 0;
+    reschedule(hb, idx, 0);
+
+    /* Transition to alive (from any state) */
+    set_neighbor_health(hb, neighbor, EKK_HEALTH_ALIVE);
+}
+
 /* ============================================================================
  * INITIALIZATION
  * ============================================================================ */
@@ -82,6 +460,9 @@ ekk_error_t ekk_heartbeat_init(ekk_heartbeat_t *hb,
 
     memset(hb, 0, sizeof(ekk_heartbeat_t));
     hb->my_id = my_id;
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_init(&hb->index_slots);
+#endif
 
     /* Apply configuration */
     if (config != NULL) {
@@ -91,8 +472,15 @@ ekk_error_t ekk_heartbeat_init(ekk_heartbeat_t *hb,
         hb->config.timeout_count = EKK_HEARTBEAT_TIMEOUT_COUNT;
         hb->config.auto_broadcast = true;
         hb->config.track_latency = false;
+        hb->config.phi_accrual = EKK_HEARTBEAT_PHI_ACCRUAL;
+        hb->config.phi_suspect = EKK_HEARTBEAT_PHI_SUSPECT;
+        hb->config.phi_dead = EKK_HEARTBEAT_PHI_DEAD;
+        hb->config.phi_min_std = EKK_HEARTBEAT_PHI_MIN_STD_US;
     }
 
+    hb->phi_y_suspect = phi_threshold_y(hb->config.phi_suspect);
+    hb->phi_y_dead = phi_threshold_y(hb->config.phi_dead);
+
     return EKK_OK;
 }
 
@@ -118,13 +506,27 @@ ekk_error_t ekk_heartbeat_add_neighbor(ekk_heartbeat_t *hb,
     }
 
     /* Add neighbor */
+    if (!index_set(hb, neighbor_id, hb->neighbor_count)) {
+        return EKK_ERR_NO_MEMORY;
+    }
     ekk_heartbeat_neighbor_t *neighbor = &hb->neighbors[hb->neighbor_count];
     neighbor->id = neighbor_id;
     neighbor->health = EKK_HEALTH_UNKNOWN;
     neighbor->last_seen = 0;
     neighbor->missed_count = 0;
     neighbor->sequence = 0;
+    neighbor->last_beat = 0;
     neighbor->avg_latency = 0;
+    neighbor->deadline = 0;
+    neighbor->heap_pos = HEAP_NONE;     /* Scheduled on first heartbeat */
+    neighbor->tx_period = hb->send_period - 1;  /* Not covered yet */
+
+    /* Until intervals are observed, assume the nominal period +/- 25% */
+    ekk_time_us_t std = hb->config.period / 4;
+    neighbor->arrival_mean = (uint32_t)EKK_MIN(hb->config.period, (ekk_time_us_t)INT32_MAX);
+    neighbor->arrival_var = (uint64_t)std * std;
+    neighbor->arrival_std = (uint32_t)EKK_MIN(EKK_MAX(std, hb->config.phi_min_std),
+                                              (ekk_time_us_t)INT32_MAX);
 
     hb->neighbor_count++;
     return EKK_OK;
@@ -142,9 +544,16 @@ ekk_error_t ekk_heartbeat_remove_neighbor(ekk_heartbeat_t *hb,
         return EKK_ERR_NOT_FOUND;
     }
 
-    /* Shift remaining neighbors down */
+    deadline_cancel(hb, (uint32_t)idx);
+    index_clear(hb, neighbor_id);
+
+    /* Shift remaining neighbors down, keeping index and heap references */
     for (uint32_t i = (uint32_t)idx; i < hb->neighbor_count - 1; i++) {
         hb->neighbors[i] = hb->neighbors[i + 1];
+        index_set(hb, hb->neighbors[i].id, i);
+        if (hb->neighbors[i].heap_pos != HEAP_NONE) {
+            hb->deadline_heap[hb->neighbors[i].heap_pos] = (uint16_t)i;
+        }
     }
     hb->neighbor_count--;
 
@@ -173,21 +582,34 @@ ekk_error_t ekk_heartbeat_received(ekk_heartbeat_t *hb,
 
     ekk_heartbeat_neighbor_t *neighbor = &hb->neighbors[idx];
 
-    /* Update latency tracking if enabled */
-    if (hb->config.track_latency && neighbor->last_seen > 0) {
-        ekk_time_us_t rtt = now - neighbor->last_seen;
-        /* Simple exponential moving average: avg = 0.875*avg + 0.125*new */
-        neighbor->avg_latency = (neighbor->avg_latency * 7 + rtt) / 8;
+    /* One interval per sender period: a burst of trailers repeating the
+     * sequence would drag the mean down and make phi jumpy */
+    if (neighbor->last_beat == 0 || sequence != neighbor->sequence) {
+        /* Intervals spanning an outage or first contact say nothing about jitter */
+        if (neighbor->last_beat != 0 && now >= neighbor->last_beat &&
+            (neighbor->health == EKK_HEALTH_ALIVE || neighbor->health == EKK_HEALTH_SUSPECT)) {
+            arrival_sample(hb, neighbor, now - neighbor->last_beat);
+        }
+        neighbor->last_beat = now;
     }
 
-    /* Update state */
-    neighbor->last_seen = now;
     neighbor->sequence = sequence;
-    neighbor->missed_count = 0;
+    mark_alive(hb, (uint32_t)idx, now);
+    return EKK_OK;
+}
 
-    /* Transition to alive (from any state) */
-    set_neighbor_health(hb, neighbor, EKK_HEALTH_ALIVE);
+ekk_error_t ekk_heartbeat_seen(ekk_heartbeat_t *hb,
+                                ekk_module_id_t sender_id,
+                                ekk_time_us_t now)
+{
+    if (hb == NULL || sender_id == EKK_INVALID_MODULE_ID) {
+        return EKK_ERR_INVALID_ARG;
+    }
 
+    int idx = find_neighbor_index(hb, sender_id);
+    if (idx >= 0) {
+        mark_alive(hb, (uint32_t)idx, now);
+    }
     return EKK_OK;
 }
 
@@ -203,57 +625,81 @@ uint32_t ekk_heartbeat_tick(ekk_heartbeat_t *hb, ekk_time_us_t now)
 
     uint32_t state_changes = 0;
 
-    /* Check each neighbor for timeout */
-    for (uint32_t i = 0; i < hb->neighbor_count; i++) {
-        ekk_heartbeat_neighbor_t *neighbor = &hb->neighbors[i];
-
-        /* Skip if never seen */
-        if (neighbor->health == EKK_HEALTH_UNKNOWN) {
-            continue;
-        }
-
-        /* Calculate time since last heartbeat */
-        ekk_time_us_t elapsed = now - neighbor->last_seen;
-        uint32_t missed = (uint32_t)(elapsed / hb->config.period);
-
-        if (missed > neighbor->missed_count) {
-            neighbor->missed_count = (uint8_t)EKK_MIN(missed, 255);
-        }
-
-        /* Determine health state based on missed count */
-        ekk_health_state_t old_state = neighbor->health;
-        ekk_health_state_t new_state = old_state;
-
-        if (neighbor->missed_count == 0) {
-            new_state = EKK_HEALTH_ALIVE;
-        }
-        else if (neighbor->missed_count < hb->config.timeout_count) {
-            new_state = EKK_HEALTH_SUSPECT;
-        }
-        else {
-            new_state = EKK_HEALTH_DEAD;
+    /* Only neighbors whose next health change is due */
+    while (hb->deadline_count > 0) {
+        uint32_t idx = hb->deadline_heap[0];
+        ekk_heartbeat_neighbor_t *neighbor = &hb->neighbors[idx];
+        if (neighbor->deadline > now) {
+            break;
         }
 
-        if (new_state != old_state) {
+        /* Reschedule before the callback, which may add or remove neighbors */
+        ekk_health_state_t new_state = reschedule(hb, idx, now - neighbor->last_seen);
+        if (new_state != neighbor->health) {
             set_neighbor_health(hb, neighbor, new_state);
             state_changes++;
         }
     }
 
-    /* Send heartbeat if auto_broadcast and period elapsed */
-    if (hb->config.auto_broadcast) {
-        if (now - hb->last_send >= hb->config.period) {
-            ekk_heartbeat_send(hb);
+    /* Send heartbeat if auto_broadcast, period elapsed and not every
+     * neighbor got a trailer this period */
+    if (hb->config.auto_broadcast && now - hb->last_send >= hb->config.period) {
+        if (period_covered(hb)) {
+            hb->last_send = now;
+            hb->send_sequence++;
+            hb->send_period++;
+        } else if (ekk_heartbeat_send(hb) == EKK_OK) {
+            hb->last_send = now;    /* Same clock as the caller's deadlines */
         }
     }
 
+    /* One RTT probe per period */
+    if (hb->config.track_latency && now - hb->last_probe >= hb->config.period) {
+        send_probe(hb, now);
+    }
+
     return state_changes;
 }
 
+ekk_time_us_t ekk_heartbeat_next_deadline(const ekk_heartbeat_t *hb)
+{
+    if (hb == NULL) {
+        return NO_DEADLINE;
+    }
+
+    ekk_time_us_t next = NO_DEADLINE;
+    if (hb->deadline_count > 0) {
+        next = hb->neighbors[hb->deadline_heap[0]].deadline;
+    }
+    if (hb->config.auto_broadcast) {
+        next = EKK_MIN(next, hb->last_send + hb->config.period);
+    }
+    if (hb->config.track_latency) {
+        next = EKK_MIN(next, hb->last_probe + hb->config.period);
+    }
+    return next;
+}
+
 /* ============================================================================
  * HEARTBEAT SEND
  * ============================================================================ */
 
+/** Send through the engine's endpoint, or the HAL's own path */
+static ekk_error_t transmit(ekk_heartbeat_t *hb,
+                            ekk_module_id_t dest_id,
+                            ekk_msg_type_t msg_type,
+                            const void *data,
+                            uint32_t len)
+{
+    if (hb != NULL && hb->endpoint != NULL) {
+        return ekk_hal_endpoint_send(hb->endpoint, dest_id, msg_type, data, len);
+    }
+    if (dest_id == EKK_BROADCAST_ID) {
+        return ekk_hal_broadcast(msg_type, data, len);
+    }
+    return ekk_hal_send(dest_id, msg_type, data, len);
+}
+
 ekk_error_t ekk_heartbeat_send(ekk_heartbeat_t *hb)
 {
     if (hb == NULL) {
@@ -269,23 +715,143 @@ ekk_error_t ekk_heartbeat_send(ekk_heartbeat_t *hb)
         .neighbor_count = (uint8_t)hb->neighbor_count,
         .load_percent = 0,
         .thermal_percent = 0,
-        .flags = 0,
     };
 
     /* Broadcast */
-    ekk_error_t err = ekk_hal_broadcast(EKK_MSG_HEARTBEAT, &msg, sizeof(msg));
+    ekk_error_t err = transmit(hb, EKK_BROADCAST_ID, EKK_MSG_HEARTBEAT, &msg, sizeof(msg));
 
     if (err == EKK_OK) {
         hb->last_send = ekk_hal_time_us();
+        hb->send_period++;
+    }
+
+    return err;
+}
+
+ekk_error_t ekk_heartbeat_piggyback(ekk_heartbeat_t *hb,
+                                     ekk_msg_type_t msg_type,
+                                     const void *data,
+                                     uint32_t len,
+                                     ekk_time_us_t now)
+{
+    uint8_t frame[64];
+
+    if (hb == NULL || !EKK_HEARTBEAT_PIGGYBACK || len + EKK_HEARTBEAT_TRAILER_SIZE > sizeof(frame)) {
+        return transmit(hb, EKK_BROADCAST_ID, msg_type, data, len);
+    }
+
+    memcpy(frame, data, len);
+    frame[0] |= EKK_HEARTBEAT_TRAILER_FLAG;
+    frame[len] = hb->send_sequence;
+
+    ekk_error_t err = transmit(hb, EKK_BROADCAST_ID, msg_type, frame, len + EKK_HEARTBEAT_TRAILER_SIZE);
+    if (err == EKK_OK) {
+        hb->send_sequence++;
+        hb->last_send = now;
+        hb->send_period++;
     }
+    return err;
+}
+
+ekk_error_t ekk_heartbeat_piggyback_to(ekk_heartbeat_t *hb,
+                                        ekk_module_id_t dest_id,
+                                        ekk_msg_type_t msg_type,
+                                        const void *data,
+                                        uint32_t len,
+                                        ekk_time_us_t now)
+{
+    uint8_t frame[64];
+
+    if (dest_id == EKK_BROADCAST_ID) {
+        return ekk_heartbeat_piggyback(hb, msg_type, data, len, now);
+    }
+    if (hb == NULL || !EKK_HEARTBEAT_PIGGYBACK || len == 0 ||
+        len + EKK_HEARTBEAT_TRAILER_SIZE > sizeof(frame)) {
+        return transmit(hb, dest_id, msg_type, data, len);
+    }
+
+    memcpy(frame, data, len);
+    frame[0] |= EKK_HEARTBEAT_TRAILER_FLAG;
+    frame[len] = hb->send_sequence;
 
+    ekk_error_t err = transmit(hb, dest_id, msg_type, frame, len + EKK_HEARTBEAT_TRAILER_SIZE);
+    if (err == EKK_OK) {
+        /* The sequence advances once per period, not per frame, so a
+         * receiver folds one interval per period into its phi statistics */
+        int idx = find_neighbor_index(hb, dest_id);
+        if (idx >= 0) {
+            hb->neighbors[idx].tx_period = hb->send_period;
+        }
+    }
     return err;
 }
 
+/* ============================================================================
+ * ECHO (RTT PROBES)
+ * ============================================================================ */
+
+ekk_error_t ekk_heartbeat_on_echo(ekk_heartbeat_t *hb,
+                                   const ekk_echo_msg_t *msg,
+                                   ekk_time_us_t now)
+{
+    if (hb == NULL || msg == NULL || msg->target_id != hb->my_id) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (!msg->reply) {
+        /* Answer at once: the prober measures the round trip */
+        ekk_echo_msg_t reply = *msg;
+        reply.msg_type = EKK_MSG_ECHO;
+        reply.sender_id = hb->my_id;
+        reply.target_id = msg->sender_id;
+        reply.reply = 1;
+        return ekk_heartbeat_piggyback_to(hb, msg->sender_id, EKK_MSG_ECHO,
+                                          &reply, sizeof(reply), now);
+    }
+
+    if (msg->sender_id != hb->probe_target || msg->token != hb->probe_token) {
+        return EKK_ERR_NOT_FOUND;
+    }
+    hb->probe_target = EKK_INVALID_MODULE_ID;
+
+    int idx = find_neighbor_index(hb, msg->sender_id);
+    if (idx < 0) {
+        return EKK_ERR_NOT_FOUND;
+    }
+
+    /* EWMA with 1/8 weight, seeded by the first sample; 0 means unmeasured */
+    ekk_heartbeat_neighbor_t *neighbor = &hb->neighbors[idx];
+    ekk_time_us_t rtt = EKK_MAX(now - hb->probe_sent, (ekk_time_us_t)1);
+    if (neighbor->avg_latency == 0) {
+        neighbor->avg_latency = rtt;
+    } else {
+        neighbor->avg_latency = (neighbor->avg_latency * 7 + rtt) / 8;
+    }
+
+    if (hb->inst_latency) {
+        hb->inst_latency(hb, neighbor->id, neighbor->avg_latency);
+    }
+    if (hb->on_latency) {
+        hb->on_latency(neighbor->id, neighbor->avg_latency);
+    }
+    return EKK_OK;
+}
+
 /* ============================================================================
  * QUERIES
  * ============================================================================ */
 
+ekk_time_us_t ekk_heartbeat_get_latency(const ekk_heartbeat_t *hb,
+                                         ekk_module_id_t neighbor_id)
+{
+    if (hb == NULL || neighbor_id == EKK_INVALID_MODULE_ID) {
+        return 0;
+    }
+
+    int idx = find_neighbor_index(hb, neighbor_id);
+    return (idx < 0) ? 0 : hb->neighbors[idx].avg_latency;
+}
+
 ekk_health_state_t ekk_heartbeat_get_health(const ekk_heartbeat_t *hb,
                                              ekk_module_id_t neighbor_id)
 {
@@ -301,6 +867,28 @@ ekk_health_state_t ekk_heartbeat_get_health(const ekk_heartbeat_t *hb,
     return hb->neighbors[idx].health;
 }
 
+ekk_fixed_t ekk_heartbeat_get_phi(const ekk_heartbeat_t *hb,
+                                   ekk_module_id_t neighbor_id,
+                                   ekk_time_us_t now)
+{
+    if (hb == NULL || neighbor_id == EKK_INVALID_MODULE_ID) {
+        return 0;
+    }
+
+    int idx = find_neighbor_index(hb, neighbor_id);
+    if (idx < 0 || hb->neighbors[idx].health == EKK_HEALTH_UNKNOWN) {
+        return 0;
+    }
+
+    const ekk_heartbeat_neighbor_t *neighbor = &hb->neighbors[idx];
+    ekk_time_us_t elapsed = (now > neighbor->last_seen) ? now - neighbor->last_seen : 0;
+    int64_t delay = (int64_t)EKK_MIN(elapsed, (ekk_time_us_t)INT32_MAX) -
+                    (int64_t)neighbor->arrival_mean;
+    int64_t y = (delay * EKK_FIXED_ONE) / (int64_t)EKK_MAX(neighbor->arrival_std, 1u);
+
+    return phi_from_y((ekk_fixed_t)EKK_CLAMP(y, (int64_t)PHI_Y_MIN, (int64_t)PHI_Y_MAX));
+}
+
 ekk_time_us_t ekk_heartbeat_time_since(const ekk_heartbeat_t *hb,
                                         ekk_module_id_t neighbor_id)
 {
@@ -334,3 +922,30 @@ void ekk_heartbeat_set_callbacks(ekk_heartbeat_t *hb,
     hb->on_neighbor_suspect = on_suspect;
     hb->on_neighbor_dead = on_dead;
 }
+
+void ekk_heartbeat_set_latency_callback(ekk_heartbeat_t *hb,
+                                         void (*on_latency)(ekk_module_id_t,
+                                                            ekk_time_us_t))
+{
+    if (hb == NULL) {
+        return;
+    }
+
+    hb->on_latency = on_latency;
+}
+
+void ekk_heartbeat_set_instance_callbacks(ekk_heartbeat_t *hb,
+                                           ekk_heartbeat_cb on_alive,
+                                           ekk_heartbeat_cb on_suspect,
+                                           ekk_heartbeat_cb on_dead,
+                                           ekk_heartbeat_latency_cb on_latency)
+{
+    if (hb == NULL) {
+        return;
+    }
+
+    hb->inst_alive = on_alive;
+    hb->inst_suspect = on_suspect;
+    hb->inst_dead = on_dead;
+    hb->inst_latency = on_latency;
+}
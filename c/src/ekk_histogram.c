@@ -0,0 +1,145 @@
+/**
+ * @file ekk_histogram.c
+ * @brief EK-KOR v2 - Fixed-Memory Latency Histograms Implementation
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ *
+ * Bucket layout: values below 2^SUB_BITS get one bucket each; a value
+ * whose highest set bit is e lands in octave (e - SUB_BITS + 1), at the
+ * sub-bucket given by the SUB_BITS bits below bit e.
+ */
+
+#include "ekk/ekk_histogram.h"
+#include <string.h>
+
+EKK_STATIC_ASSERT(EKK_HIST_SUB_BITS >= 1 && EKK_HIST_SUB_BITS < EKK_HIST_MAX_BITS,
+                  "Sub-buckets must be finer than the resolved range");
+EKK_STATIC_ASSERT(EKK_HIST_MAX_BITS <= 32, "Samples are 32-bit");
+EKK_STATIC_ASSERT(sizeof(ekk_histogram_t) == EKK_HIST_SIZE, "EKK_HIST_SIZE out of step");
+
+/* ============================================================================
+ * PRIVATE HELPERS
+ * ============================================================================ */
+
+#define SUB_COUNT       (1u << EKK_HIST_SUB_BITS)
+#define SUB_MASK        (SUB_COUNT - 1u)
+
+/**
+ * @brief Index of the highest set bit (bits != 0)
+ */
+static inline uint32_t highest_bit(uint32_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 31u - (uint32_t)__builtin_clz(bits);
+#else
+    uint32_t i = 0;
+    while (bits >>= 1) {
+        i++;
+    }
+    return i;
+#endif
+}
+
+static uint32_t bucket_of(uint32_t value)
+{
+    if (value < SUB_COUNT) {
+        return value;
+    }
+
+    uint32_t e = highest_bit(value);
+    if (e >= EKK_HIST_MAX_BITS) {
+        return EKK_HIST_BUCKETS - 1;
+    }
+    uint32_t shift = e - EKK_HIST_SUB_BITS;
+    return ((e - EKK_HIST_SUB_BITS + 1) << EKK_HIST_SUB_BITS) + ((value >> shift) & SUB_MASK);
+}
+
+/**
+ * @brief Largest value that maps to a bucket
+ */
+static uint32_t bucket_upper(uint32_t idx)
+{
+    if (idx < SUB_COUNT) {
+        return idx;
+    }
+
+    uint32_t e = (idx >> EKK_HIST_SUB_BITS) + EKK_HIST_SUB_BITS - 1;
+    uint32_t shift = e - EKK_HIST_SUB_BITS;
+    uint64_t lower = (uint64_t)(SUB_COUNT | (idx & SUB_MASK)) << shift;
+    uint64_t upper = lower + ((uint64_t)1 << shift) - 1;
+    return (upper > UINT32_MAX) ? UINT32_MAX : (uint32_t)upper;
+}
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================ */
+
+void ekk_histogram_reset(ekk_histogram_t *hist)
+{
+    if (hist == NULL) {
+        return;
+    }
+
+    memset(hist, 0, sizeof(*hist));
+}
+
+void ekk_histogram_record(ekk_histogram_t *hist, uint32_t value)
+{
+    if (hist == NULL) {
+        return;
+    }
+
+    if (hist->count == 0 || value < hist->min) {
+        hist->min = value;
+    }
+    if (value > hist->max) {
+        hist->max = value;
+    }
+    hist->count++;
+    hist->buckets[bucket_of(value)]++;
+}
+
+uint32_t ekk_histogram_quantile(const ekk_histogram_t *hist, uint32_t ppm)
+{
+    if (hist == NULL || hist->count == 0) {
+        return 0;
+    }
+
+    /* Rank of the sample wanted (1-based, rounded up) */
+    uint64_t rank = ((uint64_t)hist->count * EKK_MIN(ppm, 1000000u) + 999999u) / 1000000u;
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < EKK_HIST_BUCKETS; i++) {
+        seen += hist->buckets[i];
+        if (seen >= rank) {
+            /* The last bucket also holds everything out of range */
+            if (i == EKK_HIST_BUCKETS - 1) {
+                return hist->max;
+            }
+            return EKK_CLAMP(bucket_upper(i), hist->min, hist->max);
+        }
+    }
+    return hist->max;
+}
+
+void ekk_histogram_summary(const ekk_histogram_t *hist, ekk_latency_summary_t *summary)
+{
+    if (summary == NULL) {
+        return;
+    }
+
+    memset(summary, 0, sizeof(*summary));
+    if (hist == NULL || hist->count == 0) {
+        return;
+    }
+
+    summary->count = hist->count;
+    summary->min = hist->min;
+    summary->max = hist->max;
+    summary->p50 = ekk_histogram_quantile(hist, 500000);
+    summary->p99 = ekk_histogram_quantile(hist, 990000);
+    summary->p999 = ekk_histogram_quantile(hist, 999000);
+}
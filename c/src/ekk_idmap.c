@@ -0,0 +1,162 @@
+/**
+ * @file ekk_idmap.c
+ * @brief EK-KOR v2 - Module ID to Slot Map Implementation
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ */
+
+#include "ekk/ekk_idmap.h"
+#include <string.h>
+
+EKK_STATIC_ASSERT(EKK_MAX_MODULES < 0xFFFF, "slot + 1 must fit in 16 bits");
+
+/* ============================================================================
+ * PRIVATE HELPERS
+ * ============================================================================ */
+
+#define BUCKET_ID(b)        ((ekk_module_id_t)((b) >> 16))
+#define BUCKET_SLOT(b)      ((int32_t)((b) & 0xFFFFu) - 1)
+
+static inline uint32_t idmap_hash(ekk_module_id_t id)
+{
+    /* Fibonacci hashing: consecutive IDs land far apart */
+    return ((uint32_t)id * 2654435769u >> 16) % EKK_IDMAP_BUCKETS;
+}
+
+static inline uint32_t idmap_next(uint32_t i)
+{
+    return (i + 1 == EKK_IDMAP_BUCKETS) ? 0 : i + 1;
+}
+
+static inline uint32_t idmap_prev(uint32_t i)
+{
+    return (i == 0) ? EKK_IDMAP_BUCKETS - 1 : i - 1;
+}
+
+/**
+ * @brief Bucket holding an ID
+ * @return Bucket index, or -1 if not mapped
+ */
+static int32_t idmap_locate(const ekk_idmap_t *map, ekk_module_id_t id)
+{
+    uint32_t i = idmap_hash(id);
+
+    for (uint32_t n = 0; n < EKK_IDMAP_BUCKETS; n++) {
+        uint32_t b = map->buckets[i];
+        if (b == 0) {
+            return -1;
+        }
+        if (b != EKK_IDMAP_TOMBSTONE && BUCKET_ID(b) == id) {
+            return (int32_t)i;
+        }
+        i = idmap_next(i);
+    }
+    return -1;
+}
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================ */
+
+void ekk_idmap_init(ekk_idmap_t *map)
+{
+    if (map == NULL) {
+        return;
+    }
+    memset(map, 0, sizeof(*map));
+}
+
+int32_t ekk_idmap_find(const ekk_idmap_t *map, ekk_module_id_t id)
+{
+    if (map == NULL || id == EKK_INVALID_MODULE_ID) {
+        return -1;
+    }
+
+    int32_t pos = idmap_locate(map, id);
+    return (pos < 0) ? -1 : BUCKET_SLOT(map->buckets[pos]);
+}
+
+int32_t ekk_idmap_insert(ekk_idmap_t *map, ekk_module_id_t id)
+{
+    if (map == NULL || id == EKK_INVALID_MODULE_ID || id == EKK_BROADCAST_ID) {
+        return -1;
+    }
+
+    /* Existing mapping, else the first reusable bucket on the chain */
+    uint32_t i = idmap_hash(id);
+    int32_t free_pos = -1;
+    for (uint32_t n = 0; n < EKK_IDMAP_BUCKETS; n++) {
+        uint32_t b = map->buckets[i];
+        if (b == 0) {
+            if (free_pos < 0) {
+                free_pos = (int32_t)i;
+            }
+            break;
+        }
+        if (b == EKK_IDMAP_TOMBSTONE) {
+            if (free_pos < 0) {
+                free_pos = (int32_t)i;
+            }
+        } else if (BUCKET_ID(b) == id) {
+            return BUCKET_SLOT(b);
+        }
+        i = idmap_next(i);
+    }
+
+    if (free_pos < 0 || map->count >= EKK_MAX_MODULES) {
+        return -1;
+    }
+
+    /* Lowest free slot */
+    int32_t slot = -1;
+    for (uint32_t w = 0; w < EKK_IDMAP_WORDS && slot < 0; w++) {
+        uint32_t free_bits = ~map->used[w];
+        for (uint32_t bit = 0; bit < 32 && free_bits != 0; bit++) {
+            if (free_bits & (1u << bit)) {
+                uint32_t s = w * 32 + bit;
+                if (s < EKK_MAX_MODULES) {
+                    slot = (int32_t)s;
+                }
+                break;
+            }
+        }
+    }
+    if (slot < 0) {
+        return -1;
+    }
+
+    map->used[slot / 32] |= 1u << (slot % 32);
+    map->count++;
+    map->buckets[free_pos] = ((uint32_t)id << 16) | (uint32_t)(slot + 1);
+    return slot;
+}
+
+int32_t ekk_idmap_remove(ekk_idmap_t *map, ekk_module_id_t id)
+{
+    if (map == NULL || id == EKK_INVALID_MODULE_ID) {
+        return -1;
+    }
+
+    int32_t pos = idmap_locate(map, id);
+    if (pos < 0) {
+        return -1;
+    }
+
+    int32_t slot = BUCKET_SLOT(map->buckets[pos]);
+    map->used[slot / 32] &= ~(1u << (slot % 32));
+    map->count--;
+
+    if (map->buckets[idmap_next((uint32_t)pos)] != 0) {
+        /* A chain continues past us: leave a tombstone */
+        map->buckets[pos] = EKK_IDMAP_TOMBSTONE;
+        return slot;
+    }
+
+    /* End of a chain: empty it, along with tombstones just before it */
+    uint32_t i = (uint32_t)pos;
+    map->buckets[i] = 0;
+    for (i = idmap_prev(i); map->buckets[i] == EKK_IDMAP_TOMBSTONE; i = idmap_prev(i)) {
+        map->buckets[i] = 0;
+    }
+    return slot;
+}
@@ -6,7 +6,8 @@
  *
  * Initializes the EK-KOR v2 system:
  * - HAL (platform-specific hardware)
- * - Global field region (shared memory for coordination fields)
+ * - Global field region (shared memory for coordination fields; a named
+ *   POSIX segment when ekk_hal_field_shm_open() was called first)
  */
 
 #include "ekk/ekk.h"
@@ -17,7 +18,10 @@
  * ============================================================================ */
 
 /** Global field region for coordination fields */
-static ekk_field_region_t g_field_region;
+static ekk_field_region_t g_field_region_storage;
+
+/** Region in use (static, or the HAL's shared segment) */
+static ekk_field_region_t *g_field_region = &g_field_region_storage;
 
 /** Initialization flag */
 static bool g_initialized = false;
@@ -39,7 +43,16 @@ ekk_error_t ekk_init(void)
     }
 
     /* Initialize global field region */
-    err = ekk_field_init(&g_field_region);
+#ifdef EKK_PLATFORM_POSIX
+    if (ekk_hal_field_region_shared()) {
+        /* Other processes may already be publishing: attach, don't clear */
+        g_field_region = (ekk_field_region_t *)ekk_hal_get_field_region();
+        err = ekk_field_attach(g_field_region);
+    } else
+#endif
+    {
+        err = ekk_field_init(g_field_region);
+    }
     if (err != EKK_OK) {
         return err;
     }
@@ -61,5 +74,5 @@ ekk_error_t ekk_init(void)
 
 ekk_field_region_t* ekk_get_field_region(void)
 {
-    return &g_field_region;
+    return g_field_region;
 }
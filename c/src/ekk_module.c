@@ -15,33 +15,70 @@
 #include "ekk/ekk_hal.h"
 #include <string.h>
 
-/* ============================================================================
- * PRIVATE STATE
- * ============================================================================ */
-
-/** Heartbeat engine (one per module) */
-static ekk_heartbeat_t g_heartbeat;
-
 /* ============================================================================
  * FORWARD DECLARATIONS
  * ============================================================================ */
 
-static void on_neighbor_alive_cb(ekk_module_id_t id);
-static void on_neighbor_suspect_cb(ekk_module_id_t id);
-static void on_neighbor_dead_cb(ekk_module_id_t id);
+static void on_neighbor_alive_cb(ekk_heartbeat_t *hb, ekk_module_id_t id);
+static void on_neighbor_suspect_cb(ekk_heartbeat_t *hb, ekk_module_id_t id);
+static void on_neighbor_dead_cb(ekk_heartbeat_t *hb, ekk_module_id_t id);
+static void on_latency_cb(ekk_heartbeat_t *hb, ekk_module_id_t id, ekk_time_us_t avg_rtt);
 static ekk_vote_value_t on_consensus_decide_cb(ekk_consensus_t *cons,
                                                 const ekk_ballot_t *ballot);
 static void on_consensus_complete_cb(ekk_consensus_t *cons,
                                       const ekk_ballot_t *ballot,
                                       ekk_vote_result_t result);
-
-/* Global reference to current module for callbacks */
-static ekk_module_t *g_current_module = NULL;
+static ekk_error_t handle_heartbeat(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                    const void *data, uint32_t len, ekk_time_us_t now);
+static ekk_error_t handle_echo(ekk_module_t *mod, ekk_module_id_t sender_id,
+                               const void *data, uint32_t len, ekk_time_us_t now);
+static ekk_error_t handle_discovery(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                    const void *data, uint32_t len, ekk_time_us_t now);
+static ekk_error_t handle_proposal(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                   const void *data, uint32_t len, ekk_time_us_t now);
+static ekk_error_t handle_vote(ekk_module_t *mod, ekk_module_id_t sender_id,
+                               const void *data, uint32_t len, ekk_time_us_t now);
+static ekk_error_t handle_vote_batch(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                     const void *data, uint32_t len, ekk_time_us_t now);
+static ekk_error_t handle_decision(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                   const void *data, uint32_t len, ekk_time_us_t now);
+static ekk_error_t handle_field(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                const void *data, uint32_t len, ekk_time_us_t now);
+
+/** Built-in handlers for core message types */
+static const ekk_msg_handler_t k_builtin_handlers[EKK_MSG_CORE_TYPES] = {
+    [EKK_MSG_HEARTBEAT]  = handle_heartbeat,
+    [EKK_MSG_DISCOVERY]  = handle_discovery,
+    [EKK_MSG_FIELD]      = handle_field,
+    [EKK_MSG_PROPOSAL]   = handle_proposal,
+    [EKK_MSG_VOTE]       = handle_vote,
+    [EKK_MSG_ECHO]       = handle_echo,
+    [EKK_MSG_DECISION]   = handle_decision,
+    [EKK_MSG_VOTE_BATCH] = handle_vote_batch,
+};
 
 /* ============================================================================
  * PRIVATE HELPERS
  * ============================================================================ */
 
+#if EKK_LATENCY_STATS
+/**
+ * @brief Close a tick phase: record its cycles and start the next one
+ */
+static inline void phase_end(ekk_module_t *mod, ekk_tick_phase_t phase, uint32_t *mark)
+{
+    uint32_t now = ekk_hal_cycles();
+    ekk_histogram_record(&mod->phase_latency[phase], now - *mark);
+    *mark = now;
+}
+
+#define PHASE_START(mark)           uint32_t mark = ekk_hal_cycles()
+#define PHASE_END(mod, phase, mark) phase_end((mod), (phase), &(mark))
+#else
+#define PHASE_START(mark)           ((void)0)
+#define PHASE_END(mod, phase, mark) ((void)0)
+#endif
+
 /**
  * @brief Update module state based on topology
  */
@@ -111,66 +148,115 @@ static void update_module_state(ekk_module_t *mod)
 }
 
 /**
- * @brief Process incoming messages
+ * @brief Handler table slot for a message type (-1 if none)
  */
-static void process_rx_messages(ekk_module_t *mod, ekk_time_us_t now)
+static int32_t handler_slot(ekk_msg_type_t msg_type)
 {
-    ekk_module_id_t sender_id;
-    ekk_msg_type_t msg_type;
-    uint8_t buffer[64];
-    uint32_t len;
+    uint32_t type = (uint32_t)msg_type;
 
-    /* Process all pending messages */
-    for (int i = 0; i < 16; i++) {  /* Max 16 messages per tick */
-        len = sizeof(buffer);
-        ekk_error_t err = ekk_hal_recv(&sender_id, &msg_type, buffer, &len);
+    if (type < EKK_MSG_CORE_TYPES) {
+        return (int32_t)type;
+    }
+    if (type >= EKK_MSG_USER_BASE && type - EKK_MSG_USER_BASE < EKK_MSG_USER_HANDLERS) {
+        return (int32_t)(EKK_MSG_CORE_TYPES + type - EKK_MSG_USER_BASE);
+    }
+    return -1;
+}
 
-        if (err != EKK_OK) {
-            break;  /* No more messages */
-        }
+/* Receive through the module's endpoint if it has one, else the HAL's ring */
 
-        switch (msg_type) {
-            case EKK_MSG_HEARTBEAT: {
-                const ekk_heartbeat_msg_t *hb_msg = (const ekk_heartbeat_msg_t *)buffer;
-                ekk_heartbeat_received(&g_heartbeat, hb_msg->sender_id,
-                                       hb_msg->sequence, now);
-                break;
-            }
+static ekk_error_t rx_peek(const ekk_module_t *mod, ekk_hal_rx_view_t *frame)
+{
+    return mod->endpoint != NULL ? ekk_hal_endpoint_peek(mod->endpoint, frame)
+                                 : ekk_hal_recv_peek(frame);
+}
 
-            case EKK_MSG_DISCOVERY: {
-                const ekk_discovery_msg_t *disc_msg = (const ekk_discovery_msg_t *)buffer;
-                ekk_topology_on_discovery(&mod->topology, disc_msg->sender_id,
-                                          disc_msg->position);
-                /* Also add to heartbeat tracking */
-                ekk_heartbeat_add_neighbor(&g_heartbeat, disc_msg->sender_id);
-                break;
-            }
+static void rx_release(const ekk_module_t *mod)
+{
+    if (mod->endpoint != NULL) {
+        ekk_hal_endpoint_release(mod->endpoint);
+    } else {
+        ekk_hal_recv_release();
+    }
+}
 
-            case EKK_MSG_PROPOSAL: {
-                const ekk_proposal_msg_t *prop_msg = (const ekk_proposal_msg_t *)buffer;
-                ekk_consensus_on_proposal(&mod->consensus, prop_msg->proposer_id,
-                                          prop_msg->ballot_id, prop_msg->type,
-                                          prop_msg->data, prop_msg->threshold);
-                break;
-            }
+static uint32_t rx_depth(const ekk_module_t *mod)
+{
+    return mod->endpoint != NULL ? ekk_hal_endpoint_depth(mod->endpoint)
+                                 : ekk_hal_rx_depth();
+}
 
-            case EKK_MSG_VOTE: {
-                const ekk_vote_msg_t *vote_msg = (const ekk_vote_msg_t *)buffer;
-                ekk_consensus_on_vote(&mod->consensus, vote_msg->voter_id,
-                                      vote_msg->ballot_id, vote_msg->vote);
-                break;
-            }
+/**
+ * @brief Frames to dispatch this tick
+ *
+ * EKK_RX_BUDGET normally. A deeper queue is drained whole (up to
+ * EKK_RX_BUDGET_MAX), so discovery storms and gossip bursts do not delay
+ * heartbeats into false suspicions, unless the most urgent deadline task
+ * is about to run out of slack.
+ */
+static uint32_t rx_budget(const ekk_module_t *mod, ekk_time_us_t now)
+{
+    uint32_t depth = rx_depth(mod);
+    if (depth <= EKK_RX_BUDGET) {
+        return EKK_RX_BUDGET;
+    }
 
-            case EKK_MSG_FIELD: {
-                /* Field messages - update neighbor's last field */
-                /* This is handled via shared memory in field.c */
-                break;
-            }
+    const ekk_runqueue_t *rq = &mod->runqueue;
+    if (rq->edf_count > 0 && rq->start_by[rq->edf_heap[0]] < now + EKK_RX_SLACK_US) {
+        return EKK_RX_BUDGET;
+    }
+
+    return EKK_MIN(depth, (uint32_t)EKK_RX_BUDGET_MAX);
+}
 
-            default:
-                /* Unknown message type - ignore */
-                break;
+/**
+ * @brief Dispatch received frames in place from the HAL rx ring
+ *
+ * @return true if frames were left queued for a later tick
+ */
+static bool process_rx_messages(ekk_module_t *mod, ekk_time_us_t now)
+{
+    uint32_t budget = rx_budget(mod, now);
+    uint32_t handled = 0;
+    ekk_hal_rx_view_t frame;
+
+    while (handled < budget && rx_peek(mod, &frame) == EKK_OK) {
+        ekk_error_t err = ekk_module_on_message(mod, frame.sender_id, frame.msg_type,
+                                                frame.data, frame.len, now);
+        rx_release(mod);
+        if (err != EKK_OK) {
+            mod->rx_dropped++;
         }
+        handled++;
+    }
+    mod->rx_frames += handled;
+
+    /* Budget spent: anything still waiting is deferred to the next tick */
+    if (handled < budget || rx_peek(mod, &frame) != EKK_OK) {
+        return false;
+    }
+    mod->rx_deferred += EKK_MAX(rx_depth(mod), 1u);
+    return true;
+}
+
+/**
+ * @brief Bring a task's run queue entry in line with its state
+ *
+ * Ready tasks the module can perform are queued, periodic ones on the
+ * timer until next_run; everything else is taken out.
+ */
+static void queue_task(ekk_module_t *mod, const ekk_internal_task_t *task)
+{
+    ekk_runqueue_t *rq = &mod->runqueue;
+
+    if (task->state != EKK_TASK_READY ||
+        (task->required_caps != 0 &&
+         !ekk_can_perform(mod->capabilities, task->required_caps))) {
+        ekk_runqueue_remove(rq, task->id);
+    } else if (task->period > 0 && task->next_run > 0) {
+        ekk_runqueue_release_at(rq, task->id, task->next_run);
+    } else {
+        ekk_runqueue_ready(rq, task->id);
     }
 }
 
@@ -193,11 +279,17 @@ static void run_task(ekk_module_t *mod, ekk_task_id_t task_id, ekk_time_us_t now
     mod->active_task = task_id;
 
     ekk_time_us_t start = ekk_hal_time_us();
+#if EKK_LATENCY_STATS
+    uint32_t start_cycles = ekk_hal_cycles();
+#endif
 
     if (task->function != NULL) {
         task->function(task->arg);
     }
 
+#if EKK_LATENCY_STATS
+    ekk_histogram_record(&task->latency, ekk_hal_cycles() - start_cycles);
+#endif
     ekk_time_us_t elapsed = ekk_hal_time_us() - start;
     task->total_runtime += elapsed;
     task->run_count++;
@@ -210,6 +302,26 @@ static void run_task(ekk_module_t *mod, ekk_task_id_t task_id, ekk_time_us_t now
         task->next_run = now + task->period;
         task->state = EKK_TASK_READY;
     }
+    queue_task(mod, task);
+}
+
+/**
+ * @brief Blend the segment hierarchy's view into the neighbor aggregate
+ */
+static void blend_site_aggregate(ekk_module_t *mod)
+{
+    ekk_field_t site;
+    if (ekk_field_sample_levels(&mod->segment, &site, NULL) != EKK_OK) {
+        return;
+    }
+
+    if (mod->topology.neighbor_count == 0) {
+        /* Alone in the segment: the site is the only reference */
+        mod->neighbor_aggregate = site;
+        return;
+    }
+    ekk_field_lerp(&mod->neighbor_aggregate, &mod->neighbor_aggregate, &site,
+                   EKK_FIELD_SEGMENT_WEIGHT);
 }
 
 /* ============================================================================
@@ -230,9 +342,10 @@ ekk_error_t ekk_module_init(ekk_module_t *mod,
     mod->name = name;
     mod->state = EKK_MODULE_INIT;
     mod->active_task = 0xFF;  /* No active task */
+    ekk_runqueue_init(&mod->runqueue);
     mod->tick_period = 1000;  /* 1ms default tick */
-
-    g_current_module = mod;
+    mod->poll_hal_rx = true;
+    memcpy(mod->handlers, k_builtin_handlers, sizeof(k_builtin_handlers));
 
     /* Initialize subsystems */
     ekk_error_t err;
@@ -250,16 +363,23 @@ ekk_error_t ekk_module_init(ekk_module_t *mod,
     }
 
     /* Initialize heartbeat */
-    err = ekk_heartbeat_init(&g_heartbeat, id, NULL);
+    err = ekk_heartbeat_init(&mod->heartbeat, id, NULL);
     if (err != EKK_OK) {
         return err;
     }
 
     /* Set up heartbeat callbacks */
-    ekk_heartbeat_set_callbacks(&g_heartbeat,
-                                 on_neighbor_alive_cb,
-                                 on_neighbor_suspect_cb,
-                                 on_neighbor_dead_cb);
+    ekk_heartbeat_set_instance_callbacks(&mod->heartbeat,
+                                          on_neighbor_alive_cb,
+                                          on_neighbor_suspect_cb,
+                                          on_neighbor_dead_cb,
+                                          on_latency_cb);
+
+    /* Topology and consensus send through the heartbeat engine: with
+     * EKK_HEARTBEAT_PIGGYBACK their broadcasts double as heartbeats, and
+     * either way they leave through the module's endpoint */
+    mod->topology.liveness = &mod->heartbeat;
+    mod->consensus.liveness = &mod->heartbeat;
 
     /* Set up consensus callbacks */
     ekk_consensus_set_decide_callback(&mod->consensus, on_consensus_decide_cb);
@@ -268,6 +388,8 @@ ekk_error_t ekk_module_init(ekk_module_t *mod,
     /* Initialize field */
     memset(&mod->my_field, 0, sizeof(ekk_field_t));
     mod->my_field.source = id;
+    ekk_field_aggregator_init(&mod->field_agg, EKK_FIELD_AGG_TOLERANCE);
+    ekk_field_publisher_init(&mod->field_pub, NULL);
 
     return EKK_OK;
 }
@@ -289,6 +411,11 @@ ekk_error_t ekk_module_start(ekk_module_t *mod)
     mod->state = EKK_MODULE_DISCOVERING;
     mod->last_tick = ekk_hal_time_us();
 
+    /* The latency metric ranks neighbors by echo-probe RTT */
+    if (mod->topology.config.metric == EKK_DISTANCE_LATENCY) {
+        mod->heartbeat.config.track_latency = true;
+    }
+
     return EKK_OK;
 }
 
@@ -321,64 +448,485 @@ ekk_error_t ekk_module_tick(ekk_module_t *mod, ekk_time_us_t now)
         return EKK_OK;
     }
 
-    g_current_module = mod;
     mod->ticks_total++;
+    PHASE_START(mark);
 
     /* Phase 1: Process incoming messages */
-    process_rx_messages(mod, now);
+    bool rx_backlog = false;
+    if (mod->poll_hal_rx) {
+        rx_backlog = process_rx_messages(mod, now);
+    }
+    PHASE_END(mod, EKK_PHASE_RX, mark);
 
-    /* Phase 2: Update heartbeats, detect failures */
-    uint32_t hb_changes = ekk_heartbeat_tick(&g_heartbeat, now);
-    if (hb_changes > 0) {
-        mod->topology_changes++;
+    /* Phase 2: Update heartbeats, detect failures (only once something is due) */
+    if (now >= ekk_heartbeat_next_deadline(&mod->heartbeat)) {
+        uint32_t hb_changes = ekk_heartbeat_tick(&mod->heartbeat, now);
+        if (hb_changes > 0) {
+            mod->topology_changes++;
+        }
     }
+    PHASE_END(mod, EKK_PHASE_HEARTBEAT, mark);
 
     /* Phase 3: Update topology */
     bool topo_changed = ekk_topology_tick(&mod->topology, now);
     if (topo_changed) {
         mod->topology_changes++;
     }
+    PHASE_END(mod, EKK_PHASE_TOPOLOGY, mark);
 
-    /* Phase 4: Sample neighbor fields and compute gradients */
-    ekk_error_t err = ekk_field_sample_neighbors(
-        mod->id,
+    /* Phase 4: Update neighbor aggregate (only republished/drifted neighbors)
+     * and compute gradients */
+    ekk_error_t err = ekk_field_aggregate_update(
+        &mod->field_agg,
         mod->topology.neighbors,
         mod->topology.neighbor_count,
-        &mod->neighbor_aggregate
+        &mod->neighbor_aggregate,
+        NULL
     );
 
+    if (err == EKK_OK && mod->segment.region != NULL) {
+        blend_site_aggregate(mod);
+    }
+
     if (err == EKK_OK) {
         /* Compute gradients for each component */
         ekk_field_gradient_all(&mod->my_field, &mod->neighbor_aggregate,
                                mod->gradients);
     }
+    PHASE_END(mod, EKK_PHASE_FIELD, mark);
 
     /* Phase 5: Update consensus (check timeouts) */
     uint32_t ballot_changes = ekk_consensus_tick(&mod->consensus, now);
     if (ballot_changes > 0) {
         mod->consensus_rounds++;
     }
+    PHASE_END(mod, EKK_PHASE_CONSENSUS, mark);
 
     /* Phase 6: Select and run task based on gradients */
     ekk_task_id_t task_to_run = ekk_module_select_task(mod);
     if (task_to_run < mod->task_count) {
         run_task(mod, task_to_run, now);
     }
+    PHASE_END(mod, EKK_PHASE_TASK, mark);
 
-    /* Phase 7: Publish updated field */
+    /* Phase 7: Publish updated field (skipped while readers' decay
+     * extrapolation stays within the deadband) */
     mod->my_field.timestamp = now;
-    err = ekk_field_publish(mod->id, &mod->my_field);
-    if (err == EKK_OK) {
+    bool published = false;
+    err = ekk_field_publish_delta(&mod->field_pub, mod->id, &mod->my_field, &published);
+    if (err == EKK_OK && published) {
         mod->field_updates++;
     }
 
+    /* Phase 7b: Segment gateway feeds the levels above */
+    if (mod->segment.region != NULL && (mod->capabilities & EKK_CAP_GATEWAY) &&
+        now - mod->last_segment_publish >= EKK_FIELD_SEGMENT_PERIOD_US) {
+        ekk_field_t segment;
+        if (ekk_field_segment_aggregate(&segment, NULL) == EKK_OK) {
+            ekk_field_level_publish(&mod->segment, &segment);
+            mod->last_segment_publish = now;
+        }
+    }
+    PHASE_END(mod, EKK_PHASE_PUBLISH, mark);
+
     /* Phase 8: Update module state from topology */
     update_module_state(mod);
+    PHASE_END(mod, EKK_PHASE_STATE, mark);
 
+    /* A deferred rx backlog keeps the module due */
+    mod->tick_pending = rx_backlog;
     mod->last_tick = now;
     return EKK_OK;
 }
 
+/* ============================================================================
+ * TICKLESS RUNTIME
+ * ============================================================================ */
+
+ekk_time_us_t ekk_module_next_deadline(const ekk_module_t *mod)
+{
+    if (mod == NULL || mod->state == EKK_MODULE_INIT || mod->state == EKK_MODULE_SHUTDOWN) {
+        return UINT64_MAX;
+    }
+
+    if (mod->tick_pending) {
+        return 0;
+    }
+
+    ekk_time_us_t next = ekk_heartbeat_next_deadline(&mod->heartbeat);
+    next = EKK_MIN(next, ekk_topology_next_deadline(&mod->topology));
+    next = EKK_MIN(next, ekk_consensus_next_deadline(&mod->consensus));
+    next = EKK_MIN(next, ekk_runqueue_next_deadline(&mod->runqueue));
+    next = EKK_MIN(next, ekk_field_publisher_next_deadline(&mod->field_pub));
+
+    if (mod->segment.region != NULL && (mod->capabilities & EKK_CAP_GATEWAY)) {
+        next = EKK_MIN(next, mod->last_segment_publish + EKK_FIELD_SEGMENT_PERIOD_US);
+    }
+
+    return next;
+}
+
+ekk_error_t ekk_module_wait(ekk_module_t *mod)
+{
+    if (mod == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    ekk_time_us_t now = ekk_hal_time_us();
+    ekk_time_us_t deadline = EKK_MIN(ekk_module_next_deadline(mod),
+                                     now + EKK_MODULE_MAX_SLEEP_US);
+    if (deadline <= now) {
+        return EKK_ERR_TIMEOUT;
+    }
+
+    return ekk_hal_wait_event(deadline);
+}
+
+ekk_error_t ekk_module_attach_endpoint(ekk_module_t *mod, ekk_hal_endpoint_t *ep)
+{
+    if (mod == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (mod->endpoint != NULL) {
+        ekk_hal_endpoint_close(mod->endpoint);
+        mod->endpoint = NULL;
+        mod->heartbeat.endpoint = NULL;
+    }
+
+    if (ep != NULL) {
+        ekk_error_t err = ekk_hal_endpoint_open(ep, mod->id);
+        if (err != EKK_OK) {
+            return err;
+        }
+        mod->endpoint = ep;
+        mod->heartbeat.endpoint = ep;
+    }
+
+    return EKK_OK;
+}
+
+ekk_error_t ekk_module_on_message(ekk_module_t *mod,
+                                  ekk_module_id_t sender_id,
+                                  ekk_msg_type_t msg_type,
+                                  const void *data,
+                                  uint32_t len,
+                                  ekk_time_us_t now)
+{
+    if (mod == NULL || data == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    /* Routed frames can leave state for the next tick (tickless wait) */
+    mod->tick_pending = true;
+
+    int32_t slot = handler_slot(msg_type);
+    if (slot < 0 || mod->handlers[slot] == NULL) {
+        return EKK_ERR_NOT_FOUND;
+    }
+
+    return mod->handlers[slot](mod, sender_id, data, len, now);
+}
+
+ekk_error_t ekk_module_set_handler(ekk_module_t *mod,
+                                   ekk_msg_type_t msg_type,
+                                   ekk_msg_handler_t handler)
+{
+    int32_t slot = handler_slot(msg_type);
+    if (mod == NULL || slot < 0) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (handler == NULL && slot < EKK_MSG_CORE_TYPES) {
+        handler = k_builtin_handlers[slot];
+    }
+    mod->handlers[slot] = handler;
+    return EKK_OK;
+}
+
+/* ============================================================================
+ * MESSAGE HANDLERS
+ * ============================================================================ */
+
+/**
+ * @brief Any frame from a peer proves it alive
+ *
+ * Credited to the transport-level sender, not an ID in the payload. A
+ * flagged heartbeat trailer after the body carries the peer's sequence;
+ * unflagged extra bytes are link padding.
+ */
+static void peer_heard(ekk_module_t *mod, ekk_module_id_t sender,
+                       const void *data, uint32_t len, uint32_t body_len,
+                       ekk_time_us_t now)
+{
+    uint8_t sequence;
+
+    if (sender == EKK_INVALID_MODULE_ID || sender == mod->id) {
+        return;
+    }
+
+    if (ekk_heartbeat_trailer(data, len, body_len, &sequence)) {
+        ekk_heartbeat_received(&mod->heartbeat, sender, sequence, now);
+    } else {
+        ekk_heartbeat_seen(&mod->heartbeat, sender, now);
+    }
+}
+
+static ekk_error_t handle_heartbeat(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                    const void *data, uint32_t len, ekk_time_us_t now)
+{
+    if (len < sizeof(ekk_heartbeat_msg_t)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    const ekk_heartbeat_msg_t *hb_msg = (const ekk_heartbeat_msg_t *)data;
+    ekk_heartbeat_received(&mod->heartbeat, sender_id, hb_msg->sequence, now);
+    return EKK_OK;
+}
+
+static ekk_error_t handle_echo(ekk_module_t *mod, ekk_module_id_t sender_id,
+                               const void *data, uint32_t len, ekk_time_us_t now)
+{
+    if (len < sizeof(ekk_echo_msg_t)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    const ekk_echo_msg_t *echo_msg = (const ekk_echo_msg_t *)data;
+    ekk_heartbeat_on_echo(&mod->heartbeat, echo_msg, now);
+    peer_heard(mod, sender_id, data, len, sizeof(ekk_echo_msg_t), now);
+    return EKK_OK;
+}
+
+static ekk_error_t handle_discovery(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                    const void *data, uint32_t len, ekk_time_us_t now)
+{
+    if (len < sizeof(ekk_discovery_msg_t)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    const ekk_discovery_msg_t *disc_msg = (const ekk_discovery_msg_t *)data;
+    ekk_topology_on_discovery(&mod->topology, disc_msg->sender_id,
+                              disc_msg->position);
+    /* Also add to heartbeat tracking */
+    ekk_heartbeat_add_neighbor(&mod->heartbeat, disc_msg->sender_id);
+    peer_heard(mod, sender_id, data, len, sizeof(ekk_discovery_msg_t), now);
+    return EKK_OK;
+}
+
+static ekk_error_t handle_proposal(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                   const void *data, uint32_t len, ekk_time_us_t now)
+{
+    if (len < sizeof(ekk_proposal_msg_t)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    const ekk_proposal_msg_t *prop_msg = (const ekk_proposal_msg_t *)data;
+    ekk_consensus_on_proposal(&mod->consensus, prop_msg->proposer_id,
+                              prop_msg->incarnation, prop_msg->ballot_id, prop_msg->type,
+                              prop_msg->data, prop_msg->threshold);
+    peer_heard(mod, sender_id, data, len, sizeof(ekk_proposal_msg_t), now);
+    return EKK_OK;
+}
+
+/**
+ * @brief A vote counts only for the module that sent it
+ *
+ * Ports that cannot name the transport-level sender pass
+ * EKK_INVALID_MODULE_ID and the payload is trusted as before.
+ */
+static bool voter_is_sender(ekk_module_id_t voter_id, ekk_module_id_t sender_id)
+{
+    return sender_id == EKK_INVALID_MODULE_ID || voter_id == sender_id;
+}
+
+static ekk_error_t handle_vote(ekk_module_t *mod, ekk_module_id_t sender_id,
+                               const void *data, uint32_t len, ekk_time_us_t now)
+{
+    if (len < sizeof(ekk_vote_msg_t)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    const ekk_vote_msg_t *vote_msg = (const ekk_vote_msg_t *)data;
+    if (!voter_is_sender(vote_msg->voter_id, sender_id)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    ekk_consensus_on_vote(&mod->consensus, vote_msg->voter_id,
+                          vote_msg->proposer_id, vote_msg->ballot_id,
+                          (ekk_vote_value_t)vote_msg->vote);
+    peer_heard(mod, sender_id, data, len, sizeof(ekk_vote_msg_t), now);
+    return EKK_OK;
+}
+
+static ekk_error_t handle_vote_batch(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                     const void *data, uint32_t len, ekk_time_us_t now)
+{
+    const ekk_vote_batch_msg_t *batch = (const ekk_vote_batch_msg_t *)data;
+    if (len < EKK_VOTE_BATCH_LEN(0) || batch->count > EKK_VOTE_BATCH_MAX ||
+        len < EKK_VOTE_BATCH_LEN(batch->count)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    if (!voter_is_sender(batch->voter_id, sender_id)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    for (uint32_t i = 0; i < batch->count; i++) {
+        ekk_consensus_on_vote(&mod->consensus, batch->voter_id,
+                              batch->proposer_id, batch->entries[i].ballot_id,
+                              (ekk_vote_value_t)batch->entries[i].vote);
+    }
+    peer_heard(mod, sender_id, data, len,
+               (uint32_t)EKK_VOTE_BATCH_LEN(batch->count), now);
+    return EKK_OK;
+}
+
+static ekk_error_t handle_decision(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                   const void *data, uint32_t len, ekk_time_us_t now)
+{
+    if (len < sizeof(ekk_decision_msg_t)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    const ekk_decision_msg_t *dec_msg = (const ekk_decision_msg_t *)data;
+    ekk_consensus_on_decision(&mod->consensus, dec_msg->proposer_id,
+                              dec_msg->incarnation, dec_msg->ballot_id,
+                              (ekk_vote_result_t)dec_msg->result,
+                              dec_msg->yes_count, dec_msg->vote_count);
+    peer_heard(mod, sender_id, data, len, sizeof(ekk_decision_msg_t), now);
+    return EKK_OK;
+}
+
+/**
+ * @brief Field messages: neighbor fields travel via the shared region
+ */
+static ekk_error_t handle_field(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                const void *data, uint32_t len, ekk_time_us_t now)
+{
+    EKK_UNUSED(mod);
+    EKK_UNUSED(sender_id);
+    EKK_UNUSED(data);
+    EKK_UNUSED(len);
+    EKK_UNUSED(now);
+    return EKK_OK;
+}
+
+/* ============================================================================
+ * HAL RX FALLBACKS (ports without an in-place rx ring)
+ * ============================================================================ */
+
+/**
+ * One frame staged through ekk_hal_recv() until released. It stands for
+ * the HAL's one rx ring, so it is shared exactly as that ring is: by
+ * every module without an endpoint, which the host ticks from one thread.
+ */
+static struct {
+    uint32_t data[16];          /* 64 bytes, word aligned for in-place casts */
+    ekk_hal_rx_view_t view;
+    bool held;
+} g_rx_staged;
+
+EKK_WEAK ekk_error_t ekk_hal_recv_peek(ekk_hal_rx_view_t *view)
+{
+    if (view == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (!g_rx_staged.held) {
+        uint32_t len = sizeof(g_rx_staged.data);
+        ekk_error_t err = ekk_hal_recv(&g_rx_staged.view.sender_id,
+                                       &g_rx_staged.view.msg_type,
+                                       g_rx_staged.data, &len);
+        if (err != EKK_OK) {
+            return EKK_ERR_NOT_FOUND;
+        }
+        g_rx_staged.view.data = g_rx_staged.data;
+        g_rx_staged.view.len = EKK_MIN(len, (uint32_t)sizeof(g_rx_staged.data));
+        g_rx_staged.held = true;
+    }
+
+    *view = g_rx_staged.view;
+    return EKK_OK;
+}
+
+EKK_WEAK void ekk_hal_recv_release(void)
+{
+    g_rx_staged.held = false;
+}
+
+EKK_WEAK uint32_t ekk_hal_rx_depth(void)
+{
+    return g_rx_staged.held ? 1 : 0;
+}
+
+EKK_WEAK uint32_t ekk_hal_rx_overruns(void)
+{
+    return 0;
+}
+
+/* One module per HAL: an endpoint is the HAL's own send path and rx ring.
+ * Each endpoint stages its frame in its own ring[0], not in g_rx_staged. */
+
+EKK_WEAK ekk_error_t ekk_hal_endpoint_open(ekk_hal_endpoint_t *ep, ekk_module_id_t id)
+{
+    if (ep == NULL || id == EKK_INVALID_MODULE_ID || id == EKK_BROADCAST_ID) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    ep->id = id;
+    ep->next = NULL;
+    ep->head = 0;
+    ep->tail = 0;
+    ep->overruns = 0;
+    return EKK_OK;
+}
+
+EKK_WEAK void ekk_hal_endpoint_close(ekk_hal_endpoint_t *ep)
+{
+    EKK_UNUSED(ep);
+}
+
+EKK_WEAK ekk_error_t ekk_hal_endpoint_send(ekk_hal_endpoint_t *ep,
+                                            ekk_module_id_t dest_id,
+                                            ekk_msg_type_t msg_type,
+                                            const void *data,
+                                            uint32_t len)
+{
+    EKK_UNUSED(ep);
+    if (dest_id == EKK_BROADCAST_ID) {
+        return ekk_hal_broadcast(msg_type, data, len);
+    }
+    return ekk_hal_send(dest_id, msg_type, data, len);
+}
+
+EKK_WEAK ekk_error_t ekk_hal_endpoint_peek(ekk_hal_endpoint_t *ep, ekk_hal_rx_view_t *view)
+{
+    if (ep == NULL || view == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (ep->head == ep->tail) {
+        uint32_t len = sizeof(ep->ring[0].data);
+        ekk_error_t err = ekk_hal_recv(&ep->ring[0].sender_id, &ep->ring[0].msg_type,
+                                       ep->ring[0].data, &len);
+        if (err != EKK_OK) {
+            return EKK_ERR_NOT_FOUND;
+        }
+        ep->ring[0].len = EKK_MIN(len, (uint32_t)sizeof(ep->ring[0].data));
+        ep->tail = 0;
+        ep->head = 1;
+    }
+
+    view->sender_id = ep->ring[0].sender_id;
+    view->msg_type = ep->ring[0].msg_type;
+    view->data = ep->ring[0].data;
+    view->len = ep->ring[0].len;
+    return EKK_OK;
+}
+
+EKK_WEAK void ekk_hal_endpoint_release(ekk_hal_endpoint_t *ep)
+{
+    if (ep != NULL) {
+        ep->tail = ep->head;
+    }
+}
+
+EKK_WEAK uint32_t ekk_hal_endpoint_depth(ekk_hal_endpoint_t *ep)
+{
+    /* Staged frame plus what the HAL ring still holds */
+    return ((ep != NULL) ? ep->head - ep->tail : 0) + ekk_hal_rx_depth();
+}
+
 /* ============================================================================
  * TASK MANAGEMENT
  * ============================================================================ */
@@ -410,6 +958,7 @@ ekk_error_t ekk_module_add_task(ekk_module_t *mod,
     task->next_run = 0;
     task->run_count = 0;
     task->total_runtime = 0;
+    ekk_runqueue_set_priority(&mod->runqueue, task->id, priority);
 
     if (task_id != NULL) {
         *task_id = task->id;
@@ -426,6 +975,7 @@ ekk_error_t ekk_module_task_ready(ekk_module_t *mod, ekk_task_id_t task_id)
     }
 
     mod->tasks[task_id].state = EKK_TASK_READY;
+    queue_task(mod, &mod->tasks[task_id]);
     return EKK_OK;
 }
 
@@ -436,6 +986,7 @@ ekk_error_t ekk_module_task_block(ekk_module_t *mod, ekk_task_id_t task_id)
     }
 
     mod->tasks[task_id].state = EKK_TASK_BLOCKED;
+    queue_task(mod, &mod->tasks[task_id]);
     return EKK_OK;
 }
 
@@ -455,6 +1006,7 @@ ekk_error_t ekk_module_update_field(ekk_module_t *mod,
     mod->my_field.components[EKK_FIELD_LOAD] = load;
     mod->my_field.components[EKK_FIELD_THERMAL] = thermal;
     mod->my_field.components[EKK_FIELD_POWER] = power;
+    mod->tick_pending = true;
 
     if (mod->on_field_change != NULL) {
         mod->on_field_change(mod);
@@ -532,6 +1084,7 @@ ekk_error_t ekk_module_compute_slack(ekk_module_t *mod, ekk_time_us_t now)
         /* No deadlines - maximum slack (1.0) */
         mod->my_field.components[EKK_FIELD_SLACK] = EKK_FIXED_ONE;
     }
+    mod->tick_pending = true;
 
     return EKK_OK;
 }
@@ -551,6 +1104,7 @@ ekk_error_t ekk_module_set_task_deadline(ekk_module_t *mod,
     task->deadline.duration_est = duration_est;
     task->deadline.slack = 0;
     task->deadline.critical = false;
+    ekk_runqueue_set_deadline(&mod->runqueue, task_id, true, deadline, duration_est);
 
     return EKK_OK;
 }
@@ -568,10 +1122,32 @@ ekk_error_t ekk_module_clear_task_deadline(ekk_module_t *mod,
     task->deadline.duration_est = 0;
     task->deadline.slack = 0;
     task->deadline.critical = false;
+    ekk_runqueue_set_deadline(&mod->runqueue, task_id, false, 0, 0);
 
     return EKK_OK;
 }
 
+ekk_error_t ekk_module_set_segment(ekk_module_t *mod,
+                                    ekk_field_region_t *parent,
+                                    ekk_module_id_t segment_id,
+                                    const ekk_field_level_t *up)
+{
+    if (mod == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (parent != NULL &&
+        (segment_id == EKK_INVALID_MODULE_ID || segment_id == EKK_BROADCAST_ID)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    mod->segment.region = parent;
+    mod->segment.slot = segment_id;
+    mod->segment.up = (parent != NULL) ? up : NULL;
+    mod->last_segment_publish = 0;
+    return EKK_OK;
+}
+
 /* ============================================================================
  * CAPABILITY OPERATIONS (MAPF-HET)
  * ============================================================================ */
@@ -583,6 +1159,9 @@ ekk_error_t ekk_module_set_capabilities(ekk_module_t *mod, ekk_capability_t caps
     }
 
     mod->capabilities = caps;
+    for (uint32_t i = 0; i < mod->task_count; i++) {
+        queue_task(mod, &mod->tasks[i]);
+    }
     return EKK_OK;
 }
 
@@ -604,6 +1183,7 @@ ekk_error_t ekk_module_set_task_capabilities(ekk_module_t *mod,
     }
 
     mod->tasks[task_id].required_caps = caps;
+    queue_task(mod, &mod->tasks[task_id]);
     return EKK_OK;
 }
 
@@ -651,59 +1231,12 @@ EKK_WEAK ekk_task_id_t ekk_module_select_task(ekk_module_t *mod)
         return 0xFF;
     }
 
+    /* Periodic tasks whose next run is due join the ready set */
     ekk_time_us_t now = ekk_hal_time_us();
-    ekk_task_id_t best_task = 0xFF;
-    uint8_t best_priority = 0xFF;
-    bool best_is_critical = false;
-
-    for (uint32_t i = 0; i < mod->task_count; i++) {
-        ekk_internal_task_t *task = &mod->tasks[i];
-
-        /* Skip non-ready tasks */
-        if (task->state != EKK_TASK_READY) {
-            continue;
-        }
-
-        /* Check if periodic task is due */
-        if (task->period > 0 && task->next_run > now) {
-            continue;
-        }
-
-        /* MAPF-HET: Check capability requirements */
-        if (task->required_caps != 0) {
-            if (!ekk_can_perform(mod->capabilities, task->required_caps)) {
-                continue;  /* Module lacks required capabilities */
-            }
-        }
+    ekk_runqueue_release(&mod->runqueue, now);
 
-        /* MAPF-HET: Critical deadline tasks get priority boost */
-        bool is_critical = task->has_deadline && task->deadline.critical;
-
-        /* Priority rules:
-         * 1. Critical deadline tasks always beat non-critical
-         * 2. Among critical tasks, lower priority number wins
-         * 3. Among non-critical tasks, lower priority number wins
-         */
-        bool select_this_task = false;
-
-        if (is_critical && !best_is_critical) {
-            /* Critical beats non-critical */
-            select_this_task = true;
-        } else if (is_critical == best_is_critical) {
-            /* Same criticality - compare priority */
-            if (task->priority < best_priority) {
-                select_this_task = true;
-            }
-        }
-
-        if (select_this_task) {
-            best_priority = task->priority;
-            best_task = task->id;
-            best_is_critical = is_critical;
-        }
-    }
-
-    return best_task;
+    /* MAPF-HET: critical deadline tasks (EDF) ahead of fixed priority */
+    return ekk_runqueue_pick(&mod->runqueue, now);
 }
 
 EKK_WEAK ekk_vote_value_t ekk_module_decide_vote(ekk_module_t *mod,
@@ -720,6 +1253,21 @@ EKK_WEAK ekk_vote_value_t ekk_module_decide_vote(ekk_module_t *mod,
  * STATUS
  * ============================================================================ */
 
+#if EKK_LATENCY_STATS
+/**
+ * @brief Summarize a cycle histogram in nanoseconds
+ */
+static void latency_summary_ns(const ekk_histogram_t *hist, ekk_latency_summary_t *out)
+{
+    ekk_histogram_summary(hist, out);
+    out->min = ekk_hal_cycles_to_ns(out->min);
+    out->max = ekk_hal_cycles_to_ns(out->max);
+    out->p50 = ekk_hal_cycles_to_ns(out->p50);
+    out->p99 = ekk_hal_cycles_to_ns(out->p99);
+    out->p999 = ekk_hal_cycles_to_ns(out->p999);
+}
+#endif
+
 ekk_error_t ekk_module_get_status(const ekk_module_t *mod,
                                    ekk_module_status_t *status)
 {
@@ -734,10 +1282,45 @@ ekk_error_t ekk_module_get_status(const ekk_module_t *mod,
     status->thermal_gradient = mod->gradients[EKK_FIELD_THERMAL];
     status->active_ballots = mod->consensus.active_ballot_count;
     status->ticks_total = mod->ticks_total;
+    status->field_publishes_sent = mod->field_pub.sent;
+    status->field_publishes_suppressed = mod->field_pub.suppressed;
+    status->rx_frames = mod->rx_frames;
+    status->rx_dropped = mod->rx_dropped;
+    status->rx_deferred = mod->rx_deferred;
+    status->rx_overruns = mod->endpoint != NULL ? mod->endpoint->overruns
+                                                : ekk_hal_rx_overruns();
+
+    memset(status->phase_latency, 0, sizeof(status->phase_latency));
+    memset(status->task_latency, 0, sizeof(status->task_latency));
+    status->task_count = mod->task_count;
+#if EKK_LATENCY_STATS
+    for (uint32_t i = 0; i < EKK_PHASE_COUNT; i++) {
+        latency_summary_ns(&mod->phase_latency[i], &status->phase_latency[i]);
+    }
+    for (uint32_t i = 0; i < mod->task_count; i++) {
+        latency_summary_ns(&mod->tasks[i].latency, &status->task_latency[i]);
+    }
+#endif
 
     return EKK_OK;
 }
 
+void ekk_module_reset_latency(ekk_module_t *mod)
+{
+    if (mod == NULL) {
+        return;
+    }
+
+#if EKK_LATENCY_STATS
+    for (uint32_t i = 0; i < EKK_PHASE_COUNT; i++) {
+        ekk_histogram_reset(&mod->phase_latency[i]);
+    }
+    for (uint32_t i = 0; i < mod->task_count; i++) {
+        ekk_histogram_reset(&mod->tasks[i].latency);
+    }
+#endif
+}
+
 void ekk_module_print_status(const ekk_module_t *mod)
 {
     if (mod == NULL) {
@@ -755,74 +1338,84 @@ void ekk_module_print_status(const ekk_module_t *mod)
                    mod->gradients[EKK_FIELD_LOAD],
                    mod->gradients[EKK_FIELD_THERMAL],
                    mod->gradients[EKK_FIELD_POWER]);
+
+#if EKK_LATENCY_STATS
+    static const char *const phase_names[EKK_PHASE_COUNT] = {
+        "rx", "heartbeat", "topology", "field", "consensus", "task", "publish", "state"
+    };
+    for (uint32_t i = 0; i < EKK_PHASE_COUNT; i++) {
+        ekk_latency_summary_t lat;
+        latency_summary_ns(&mod->phase_latency[i], &lat);
+        ekk_hal_printf("  %-9s ns: min=%u p50=%u p99=%u p99.9=%u max=%u\n",
+                       phase_names[i], lat.min, lat.p50, lat.p99, lat.p999, lat.max);
+    }
+#endif
 }
 
 /* ============================================================================
  * INTERNAL CALLBACKS
  * ============================================================================ */
 
-static void on_neighbor_alive_cb(ekk_module_id_t id)
+static void on_neighbor_alive_cb(ekk_heartbeat_t *hb, ekk_module_id_t id)
 {
-    if (g_current_module == NULL) {
-        return;
-    }
+    ekk_module_t *mod = EKK_CONTAINER_OF(hb, ekk_module_t, heartbeat);
 
-    /* Add to topology if new */
-    ekk_position_t pos = {0, 0, 0};  /* Position unknown from heartbeat */
-    ekk_topology_on_discovery(&g_current_module->topology, id, pos);
+    /* Add to topology if new; a discovered position must not be reset */
+    if (!ekk_topology_is_known(&mod->topology, id)) {
+        ekk_position_t pos = {0, 0, 0};  /* Position unknown from heartbeat */
+        ekk_topology_on_discovery(&mod->topology, id, pos);
+    }
 
-    if (g_current_module->on_neighbor_found != NULL) {
-        g_current_module->on_neighbor_found(g_current_module, id);
+    if (mod->on_neighbor_found != NULL) {
+        mod->on_neighbor_found(mod, id);
     }
 }
 
-static void on_neighbor_suspect_cb(ekk_module_id_t id)
+static void on_neighbor_suspect_cb(ekk_heartbeat_t *hb, ekk_module_id_t id)
 {
+    EKK_UNUSED(hb);
     EKK_UNUSED(id);
     /* Could trigger early warning */
 }
 
-static void on_neighbor_dead_cb(ekk_module_id_t id)
+static void on_neighbor_dead_cb(ekk_heartbeat_t *hb, ekk_module_id_t id)
 {
-    if (g_current_module == NULL) {
-        return;
-    }
+    ekk_module_t *mod = EKK_CONTAINER_OF(hb, ekk_module_t, heartbeat);
 
-    ekk_topology_on_neighbor_lost(&g_current_module->topology, id);
+    ekk_topology_on_neighbor_lost(&mod->topology, id);
 
-    if (g_current_module->on_neighbor_lost != NULL) {
-        g_current_module->on_neighbor_lost(g_current_module, id);
+    if (mod->on_neighbor_lost != NULL) {
+        mod->on_neighbor_lost(mod, id);
     }
 }
 
+static void on_latency_cb(ekk_heartbeat_t *hb, ekk_module_id_t id, ekk_time_us_t avg_rtt)
+{
+    ekk_module_t *mod = EKK_CONTAINER_OF(hb, ekk_module_t, heartbeat);
+
+    ekk_topology_on_latency(&mod->topology, id, avg_rtt);
+}
+
 static ekk_vote_value_t on_consensus_decide_cb(ekk_consensus_t *cons,
                                                 const ekk_ballot_t *ballot)
 {
-    EKK_UNUSED(cons);
+    ekk_module_t *mod = EKK_CONTAINER_OF(cons, ekk_module_t, consensus);
 
-    if (g_current_module == NULL) {
-        return EKK_VOTE_YES;
+    if (mod->on_vote_request != NULL) {
+        mod->on_vote_request(mod, ballot);
     }
 
-    if (g_current_module->on_vote_request != NULL) {
-        g_current_module->on_vote_request(g_current_module, ballot);
-    }
-
-    return ekk_module_decide_vote(g_current_module, ballot);
+    return ekk_module_decide_vote(mod, ballot);
 }
 
 static void on_consensus_complete_cb(ekk_consensus_t *cons,
                                       const ekk_ballot_t *ballot,
                                       ekk_vote_result_t result)
 {
-    EKK_UNUSED(cons);
+    ekk_module_t *mod = EKK_CONTAINER_OF(cons, ekk_module_t, consensus);
     EKK_UNUSED(result);
 
-    if (g_current_module == NULL) {
-        return;
-    }
-
-    if (g_current_module->on_consensus_complete != NULL) {
-        g_current_module->on_consensus_complete(g_current_module, ballot);
+    if (mod->on_consensus_complete != NULL) {
+        mod->on_consensus_complete(mod, ballot);
     }
 }
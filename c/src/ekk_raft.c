@@ -16,6 +16,7 @@
 
 #include "ekk/ekk_raft.h"
 #include "ekk/ekk_hal.h"
+#include <string.h>
 
 /* ============================================================================
  * STATE STRING CONVERSION
@@ -65,6 +66,37 @@ static void raft_reset_election_timer(ekk_raft_ctx_t *ctx, ekk_time_us_t now) {
     ctx->last_heartbeat = now;
 }
 
+/**
+ * @brief Forget every granted vote
+ */
+static void raft_clear_votes(ekk_raft_ctx_t *ctx) {
+    memset(ctx->vote_granted, 0, sizeof(ctx->vote_granted));
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_init(&ctx->voters);
+#endif
+}
+
+/**
+ * @brief Record a granted vote
+ * @return true if this voter had not been counted yet
+ */
+static bool raft_record_vote(ekk_raft_ctx_t *ctx, ekk_module_id_t voter_id) {
+#if EKK_MODULE_ID_BITS > 8
+    int32_t bit = ekk_idmap_insert(&ctx->voters, voter_id);
+    if (bit < 0) {
+        return false;
+    }
+#else
+    uint32_t bit = voter_id;
+#endif
+    uint32_t mask = 1u << (bit % 32);
+    if (ctx->vote_granted[bit / 32] & mask) {
+        return false;
+    }
+    ctx->vote_granted[bit / 32] |= mask;
+    return true;
+}
+
 /**
  * @brief Transition to follower state
  */
@@ -99,10 +131,8 @@ static void raft_become_candidate(ekk_raft_ctx_t *ctx, ekk_time_us_t now) {
 
     /* Reset vote tracking */
     ctx->votes_received = 1;  /* Already have our own vote */
-    for (int i = 0; i < EKK_MAX_MODULES; i++) {
-        ctx->vote_granted[i] = false;
-    }
-    ctx->vote_granted[ctx->my_id] = true;
+    raft_clear_votes(ctx);
+    raft_record_vote(ctx, ctx->my_id);
 
     /* Persist new term and vote */
     if (ctx->persist_term != NULL) {
@@ -156,7 +186,7 @@ static bool raft_can_start_election(ekk_raft_ctx_t *ctx) {
 
 ekk_error_t ekk_raft_init(ekk_raft_ctx_t *ctx,
                            ekk_module_id_t my_id,
-                           uint8_t total_modules,
+                           uint16_t total_modules,
                            ekk_partition_ctx_t *partition_ctx) {
     if (ctx == NULL || my_id == EKK_INVALID_MODULE_ID || total_modules == 0) {
         return EKK_ERR_INVALID_ARG;
@@ -177,12 +207,10 @@ ekk_error_t ekk_raft_init(ekk_raft_ctx_t *ctx,
     ctx->election_start = 0;
 
     ctx->votes_received = 0;
-    ctx->votes_needed = (total_modules / 2) + 1;
+    ctx->votes_needed = (uint16_t)((total_modules / 2) + 1);
     ctx->total_voters = total_modules;
 
-    for (int i = 0; i < EKK_MAX_MODULES; i++) {
-        ctx->vote_granted[i] = false;
-    }
+    raft_clear_votes(ctx);
 
     /* Callbacks */
     ctx->on_become_leader = NULL;
@@ -390,8 +418,7 @@ ekk_error_t ekk_raft_on_vote_response(ekk_raft_ctx_t *ctx,
     }
 
     /* Record vote */
-    if (vote_granted && !ctx->vote_granted[voter_id]) {
-        ctx->vote_granted[voter_id] = true;
+    if (vote_granted && raft_record_vote(ctx, voter_id)) {
         ctx->votes_received++;
 
         /* Check for majority */
@@ -0,0 +1,338 @@
+/**
+ * @file ekk_runqueue.c
+ * @brief EK-KOR v2 - Per-Module Task Run Queue Implementation
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ *
+ * Selection is two find-first-set operations on the fixed-priority
+ * bitmaps plus a look at the EDF heap head, so its cost is independent
+ * of the task count. State changes are O(1) for the bitmaps and
+ * O(log n) for the heaps.
+ */
+
+#include "ekk/ekk_runqueue.h"
+#include <string.h>
+
+EKK_STATIC_ASSERT(EKK_MAX_TASKS_PER_MODULE < EKK_RUNQUEUE_NONE,
+                  "Task IDs must fit below the idle marker");
+EKK_STATIC_ASSERT(EKK_RUNQUEUE_PRIORITIES > 0 && EKK_RUNQUEUE_PRIORITIES <= 32,
+                  "Priority levels must fit the level bitmap");
+
+/* ============================================================================
+ * PRIVATE HELPERS
+ * ============================================================================ */
+
+/**
+ * @brief Index of the lowest set bit (bits != 0)
+ */
+static inline uint32_t lowest_bit(uint32_t bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctz(bits);
+#else
+    uint32_t i = 0;
+    while ((bits & 1u) == 0) {
+        bits >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/**
+ * @brief Min-heap over task IDs with a per-task position index
+ */
+typedef struct {
+    ekk_task_id_t *heap;
+    uint8_t *pos;
+    uint32_t *count;
+    const ekk_time_us_t *key;
+} task_heap_t;
+
+static void heap_swap(task_heap_t *h, uint32_t a, uint32_t b)
+{
+    ekk_task_id_t ta = h->heap[a];
+    ekk_task_id_t tb = h->heap[b];
+    h->heap[a] = tb;
+    h->heap[b] = ta;
+    h->pos[tb] = (uint8_t)a;
+    h->pos[ta] = (uint8_t)b;
+}
+
+static void heap_up(task_heap_t *h, uint32_t i)
+{
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (h->key[h->heap[parent]] <= h->key[h->heap[i]]) {
+            break;
+        }
+        heap_swap(h, i, parent);
+        i = parent;
+    }
+}
+
+static void heap_down(task_heap_t *h, uint32_t i)
+{
+    for (;;) {
+        uint32_t left = 2 * i + 1;
+        uint32_t best = i;
+        if (left < *h->count && h->key[h->heap[left]] < h->key[h->heap[best]]) {
+            best = left;
+        }
+        if (left + 1 < *h->count && h->key[h->heap[left + 1]] < h->key[h->heap[best]]) {
+            best = left + 1;
+        }
+        if (best == i) {
+            return;
+        }
+        heap_swap(h, i, best);
+        i = best;
+    }
+}
+
+/**
+ * @brief Insert a task, or restore order after its key changed
+ */
+static void heap_update(task_heap_t *h, ekk_task_id_t id)
+{
+    uint32_t i = h->pos[id];
+    if (i == EKK_RUNQUEUE_NONE) {
+        i = (*h->count)++;
+        h->heap[i] = id;
+        h->pos[id] = (uint8_t)i;
+    }
+    heap_up(h, i);
+    heap_down(h, h->pos[id]);
+}
+
+static void heap_remove(task_heap_t *h, ekk_task_id_t id)
+{
+    uint32_t i = h->pos[id];
+    if (i == EKK_RUNQUEUE_NONE) {
+        return;
+    }
+
+    uint32_t last = --(*h->count);
+    h->pos[id] = EKK_RUNQUEUE_NONE;
+    if (i == last) {
+        return;
+    }
+
+    /* Fill the hole with the last entry and restore order around it */
+    ekk_task_id_t moved = h->heap[last];
+    h->heap[i] = moved;
+    h->pos[moved] = (uint8_t)i;
+    heap_up(h, i);
+    heap_down(h, h->pos[moved]);
+}
+
+static task_heap_t edf_heap(ekk_runqueue_t *rq)
+{
+    task_heap_t h = { rq->edf_heap, rq->edf_pos, &rq->edf_count, rq->start_by };
+    return h;
+}
+
+static task_heap_t timer_heap(ekk_runqueue_t *rq)
+{
+    task_heap_t h = { rq->timer_heap, rq->timer_pos, &rq->timer_count, rq->release_at };
+    return h;
+}
+
+/**
+ * @brief Add a task to the ready set
+ */
+static void enqueue(ekk_runqueue_t *rq, ekk_task_id_t id)
+{
+    uint8_t p = rq->priority[id];
+    rq->level[p][id / 32] |= 1u << (id % 32);
+    rq->level_map |= 1u << p;
+
+    if (rq->has_deadline[id]) {
+        task_heap_t h = edf_heap(rq);
+        heap_update(&h, id);
+    }
+}
+
+/**
+ * @brief Take a task out of the ready set
+ */
+static void dequeue(ekk_runqueue_t *rq, ekk_task_id_t id)
+{
+    uint8_t p = rq->priority[id];
+    uint32_t *words = rq->level[p];
+    words[id / 32] &= ~(1u << (id % 32));
+
+    bool empty = true;
+    for (uint32_t w = 0; w < EKK_RUNQUEUE_WORDS; w++) {
+        if (words[w] != 0) {
+            empty = false;
+            break;
+        }
+    }
+    if (empty) {
+        rq->level_map &= ~(1u << p);
+    }
+
+    task_heap_t h = edf_heap(rq);
+    heap_remove(&h, id);
+}
+
+/* ============================================================================
+ * PUBLIC API
+ * ============================================================================ */
+
+void ekk_runqueue_init(ekk_runqueue_t *rq)
+{
+    if (rq == NULL) {
+        return;
+    }
+
+    memset(rq, 0, sizeof(*rq));
+    memset(rq->edf_pos, EKK_RUNQUEUE_NONE, sizeof(rq->edf_pos));
+    memset(rq->timer_pos, EKK_RUNQUEUE_NONE, sizeof(rq->timer_pos));
+}
+
+void ekk_runqueue_set_priority(ekk_runqueue_t *rq, ekk_task_id_t id, uint8_t priority)
+{
+    if (rq == NULL || id >= EKK_MAX_TASKS_PER_MODULE) {
+        return;
+    }
+
+    uint8_t level = (uint8_t)EKK_MIN((uint32_t)priority, EKK_RUNQUEUE_PRIORITIES - 1u);
+    if (level == rq->priority[id]) {
+        return;
+    }
+
+    bool ready = ekk_runqueue_is_ready(rq, id);
+    if (ready) {
+        dequeue(rq, id);
+    }
+    rq->priority[id] = level;
+    if (ready) {
+        enqueue(rq, id);
+    }
+}
+
+void ekk_runqueue_set_deadline(ekk_runqueue_t *rq, ekk_task_id_t id, bool has_deadline,
+                               ekk_time_us_t deadline, ekk_time_us_t duration_est)
+{
+    if (rq == NULL || id >= EKK_MAX_TASKS_PER_MODULE) {
+        return;
+    }
+
+    rq->has_deadline[id] = has_deadline;
+    rq->start_by[id] = (deadline > duration_est) ? deadline - duration_est : 0;
+
+    if (ekk_runqueue_is_ready(rq, id)) {
+        task_heap_t h = edf_heap(rq);
+        if (has_deadline) {
+            heap_update(&h, id);
+        } else {
+            heap_remove(&h, id);
+        }
+    }
+}
+
+void ekk_runqueue_ready(ekk_runqueue_t *rq, ekk_task_id_t id)
+{
+    if (rq == NULL || id >= EKK_MAX_TASKS_PER_MODULE) {
+        return;
+    }
+
+    task_heap_t h = timer_heap(rq);
+    heap_remove(&h, id);
+    if (!ekk_runqueue_is_ready(rq, id)) {
+        enqueue(rq, id);
+    }
+}
+
+void ekk_runqueue_release_at(ekk_runqueue_t *rq, ekk_task_id_t id, ekk_time_us_t when)
+{
+    if (rq == NULL || id >= EKK_MAX_TASKS_PER_MODULE) {
+        return;
+    }
+
+    if (ekk_runqueue_is_ready(rq, id)) {
+        dequeue(rq, id);
+    }
+    rq->release_at[id] = when;
+    task_heap_t h = timer_heap(rq);
+    heap_update(&h, id);
+}
+
+void ekk_runqueue_remove(ekk_runqueue_t *rq, ekk_task_id_t id)
+{
+    if (rq == NULL || id >= EKK_MAX_TASKS_PER_MODULE) {
+        return;
+    }
+
+    if (ekk_runqueue_is_ready(rq, id)) {
+        dequeue(rq, id);
+    }
+    task_heap_t h = timer_heap(rq);
+    heap_remove(&h, id);
+}
+
+uint32_t ekk_runqueue_release(ekk_runqueue_t *rq, ekk_time_us_t now)
+{
+    if (rq == NULL) {
+        return 0;
+    }
+
+    task_heap_t h = timer_heap(rq);
+    uint32_t released = 0;
+
+    while (rq->timer_count > 0 && rq->release_at[rq->timer_heap[0]] <= now) {
+        ekk_task_id_t id = rq->timer_heap[0];
+        heap_remove(&h, id);
+        enqueue(rq, id);
+        released++;
+    }
+
+    return released;
+}
+
+ekk_time_us_t ekk_runqueue_next_release(const ekk_runqueue_t *rq)
+{
+    if (rq == NULL || rq->timer_count == 0) {
+        return UINT64_MAX;
+    }
+
+    return rq->release_at[rq->timer_heap[0]];
+}
+
+ekk_time_us_t ekk_runqueue_next_deadline(const ekk_runqueue_t *rq)
+{
+    if (rq != NULL && rq->level_map != 0) {
+        return 0;
+    }
+    return ekk_runqueue_next_release(rq);
+}
+
+ekk_task_id_t ekk_runqueue_pick(const ekk_runqueue_t *rq, ekk_time_us_t now)
+{
+    if (rq == NULL) {
+        return EKK_RUNQUEUE_NONE;
+    }
+
+    /* Deadline task out of slack: runs ahead of fixed priority */
+    if (rq->edf_count > 0) {
+        ekk_task_id_t head = rq->edf_heap[0];
+        if (rq->start_by[head] < now + EKK_SLACK_THRESHOLD_US) {
+            return head;
+        }
+    }
+
+    if (rq->level_map == 0) {
+        return EKK_RUNQUEUE_NONE;
+    }
+
+    const uint32_t *words = rq->level[lowest_bit(rq->level_map)];
+    for (uint32_t w = 0; w < EKK_RUNQUEUE_WORDS; w++) {
+        if (words[w] != 0) {
+            return (ekk_task_id_t)(w * 32 + lowest_bit(words[w]));
+        }
+    }
+
+    return EKK_RUNQUEUE_NONE;
+}
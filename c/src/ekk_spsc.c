@@ -27,6 +27,34 @@ static inline void *slot_ptr(const ekk_spsc_t *q, uint32_t index) {
     return (uint8_t *)q->buffer + (index * q->item_size);
 }
 
+/**
+ * @brief Free slots as the producer sees them
+ *
+ * Re-reads tail only when the cached copy cannot cover the request.
+ */
+static inline uint32_t producer_space(ekk_spsc_t *q, uint32_t head, uint32_t want) {
+    uint32_t space = (q->cached_tail - head - 1) & q->mask;
+    if (space < want) {
+        q->cached_tail = EKK_SPSC_LOAD_ACQUIRE(&q->tail);
+        space = (q->cached_tail - head - 1) & q->mask;
+    }
+    return space;
+}
+
+/**
+ * @brief Filled slots as the consumer sees them
+ *
+ * Re-reads head only when the cached copy cannot cover the request.
+ */
+static inline uint32_t consumer_count(ekk_spsc_t *q, uint32_t tail, uint32_t want) {
+    uint32_t count = (q->cached_head - tail) & q->mask;
+    if (count < want) {
+        q->cached_head = EKK_SPSC_LOAD_ACQUIRE(&q->head);
+        count = (q->cached_head - tail) & q->mask;
+    }
+    return count;
+}
+
 /* ============================================================================
  * INITIALIZATION
  * ============================================================================ */
@@ -47,6 +75,8 @@ ekk_error_t ekk_spsc_init(ekk_spsc_t *q, void *buffer,
     q->item_size = item_size;
     q->head = 0;
     q->tail = 0;
+    q->cached_tail = 0;
+    q->cached_head = 0;
 
     /* Clear buffer */
     memset(buffer, 0, capacity * item_size);
@@ -57,6 +87,8 @@ ekk_error_t ekk_spsc_init(ekk_spsc_t *q, void *buffer,
 void ekk_spsc_reset(ekk_spsc_t *q) {
     q->head = 0;
     q->tail = 0;
+    q->cached_tail = 0;
+    q->cached_head = 0;
 }
 
 /* ============================================================================
@@ -65,31 +97,26 @@ void ekk_spsc_reset(ekk_spsc_t *q) {
 
 ekk_error_t ekk_spsc_push(ekk_spsc_t *q, const void *item) {
     uint32_t head = q->head;
-    uint32_t next_head = (head + 1) & q->mask;
 
     /* Check if full */
-    if (next_head == q->tail) {
+    if (producer_space(q, head, 1) == 0) {
         return EKK_ERR_NO_MEMORY;
     }
 
     /* Copy item to slot */
     memcpy(slot_ptr(q, head), item, q->item_size);
 
-    /* Memory barrier ensures item is written before head update */
-    ekk_hal_memory_barrier();
-
-    /* Update head (makes item visible to consumer) */
-    q->head = next_head;
+    /* Release: item is written before the consumer sees the new head */
+    EKK_SPSC_STORE_RELEASE(&q->head, (head + 1) & q->mask);
 
     return EKK_OK;
 }
 
 void *ekk_spsc_push_acquire(ekk_spsc_t *q) {
     uint32_t head = q->head;
-    uint32_t next_head = (head + 1) & q->mask;
 
     /* Check if full */
-    if (next_head == q->tail) {
+    if (producer_space(q, head, 1) == 0) {
         return NULL;
     }
 
@@ -97,11 +124,40 @@ void *ekk_spsc_push_acquire(ekk_spsc_t *q) {
 }
 
 void ekk_spsc_push_commit(ekk_spsc_t *q) {
-    /* Memory barrier ensures item is written before head update */
-    ekk_hal_memory_barrier();
+    EKK_SPSC_STORE_RELEASE(&q->head, (q->head + 1) & q->mask);
+}
+
+uint32_t ekk_spsc_push_n(ekk_spsc_t *q, const void *items, uint32_t n) {
+    uint32_t head = q->head;
+    uint32_t count = EKK_MIN(n, producer_space(q, head, n));
+    if (count == 0) {
+        return 0;
+    }
 
-    /* Update head */
-    q->head = (q->head + 1) & q->mask;
+    /* At most two runs: up to the end of the buffer, then from slot 0 */
+    uint32_t first = EKK_MIN(count, q->capacity - head);
+    memcpy(slot_ptr(q, head), items, first * q->item_size);
+    if (count > first) {
+        memcpy(slot_ptr(q, 0), (const uint8_t *)items + first * q->item_size,
+               (count - first) * q->item_size);
+    }
+
+    EKK_SPSC_STORE_RELEASE(&q->head, (head + count) & q->mask);
+    return count;
+}
+
+void *ekk_spsc_push_acquire_n(ekk_spsc_t *q, uint32_t n, uint32_t *count) {
+    uint32_t head = q->head;
+    uint32_t run = EKK_MIN(EKK_MIN(n, producer_space(q, head, n)), q->capacity - head);
+
+    if (count != NULL) {
+        *count = run;
+    }
+    return (run > 0) ? slot_ptr(q, head) : NULL;
+}
+
+void ekk_spsc_push_commit_n(ekk_spsc_t *q, uint32_t n) {
+    EKK_SPSC_STORE_RELEASE(&q->head, (q->head + n) & q->mask);
 }
 
 /* ============================================================================
@@ -111,22 +167,16 @@ void ekk_spsc_push_commit(ekk_spsc_t *q) {
 ekk_error_t ekk_spsc_pop(ekk_spsc_t *q, void *item) {
     uint32_t tail = q->tail;
 
-    /* Check if empty */
-    if (tail == q->head) {
+    /* Check if empty (acquire on refresh: slot contents are visible) */
+    if (consumer_count(q, tail, 1) == 0) {
         return EKK_ERR_NOT_FOUND;
     }
 
-    /* Memory barrier ensures we see latest head */
-    ekk_hal_memory_barrier();
-
     /* Copy item from slot */
     memcpy(item, slot_ptr(q, tail), q->item_size);
 
-    /* Memory barrier ensures item is read before tail update */
-    ekk_hal_memory_barrier();
-
-    /* Update tail (frees slot for producer) */
-    q->tail = (tail + 1) & q->mask;
+    /* Release: item is read before the producer may reuse the slot */
+    EKK_SPSC_STORE_RELEASE(&q->tail, (tail + 1) & q->mask);
 
     return EKK_OK;
 }
@@ -135,20 +185,45 @@ void *ekk_spsc_pop_peek(ekk_spsc_t *q) {
     uint32_t tail = q->tail;
 
     /* Check if empty */
-    if (tail == q->head) {
+    if (consumer_count(q, tail, 1) == 0) {
         return NULL;
     }
 
-    /* Memory barrier ensures we see latest head */
-    ekk_hal_memory_barrier();
-
     return slot_ptr(q, tail);
 }
 
 void ekk_spsc_pop_release(ekk_spsc_t *q) {
-    /* Memory barrier ensures item is processed before tail update */
-    ekk_hal_memory_barrier();
+    EKK_SPSC_STORE_RELEASE(&q->tail, (q->tail + 1) & q->mask);
+}
+
+uint32_t ekk_spsc_pop_n(ekk_spsc_t *q, void *items, uint32_t n) {
+    uint32_t tail = q->tail;
+    uint32_t count = EKK_MIN(n, consumer_count(q, tail, n));
+    if (count == 0) {
+        return 0;
+    }
+
+    uint32_t first = EKK_MIN(count, q->capacity - tail);
+    memcpy(items, slot_ptr(q, tail), first * q->item_size);
+    if (count > first) {
+        memcpy((uint8_t *)items + first * q->item_size, slot_ptr(q, 0),
+               (count - first) * q->item_size);
+    }
+
+    EKK_SPSC_STORE_RELEASE(&q->tail, (tail + count) & q->mask);
+    return count;
+}
+
+void *ekk_spsc_pop_peek_n(ekk_spsc_t *q, uint32_t n, uint32_t *count) {
+    uint32_t tail = q->tail;
+    uint32_t run = EKK_MIN(EKK_MIN(n, consumer_count(q, tail, n)), q->capacity - tail);
+
+    if (count != NULL) {
+        *count = run;
+    }
+    return (run > 0) ? slot_ptr(q, tail) : NULL;
+}
 
-    /* Update tail */
-    q->tail = (q->tail + 1) & q->mask;
+void ekk_spsc_pop_release_n(ekk_spsc_t *q, uint32_t n) {
+    EKK_SPSC_STORE_RELEASE(&q->tail, (q->tail + n) & q->mask);
 }
@@ -14,35 +14,45 @@
 #include "ekk/ekk_hal.h"
 #include <string.h>
 
-/* ============================================================================
- * PRIVATE STATE
- * ============================================================================ */
-
-/** Module positions cache (for known modules) */
-static ekk_position_t g_known_positions[EKK_MAX_MODULES];
-
-/** Topology change callback */
-static ekk_topology_changed_cb g_topology_callback = NULL;
-
-/** Discovery sequence counter */
-static uint16_t g_discovery_sequence = 0;
+EKK_STATIC_ASSERT((EKK_TOPOLOGY_GRID_BUCKETS & (EKK_TOPOLOGY_GRID_BUCKETS - 1)) == 0,
+                  "Grid bucket count must be a power of 2");
+EKK_STATIC_ASSERT(EKK_TOPOLOGY_GRID_CELL > 0, "Grid cell must be positive");
 
 /* ============================================================================
  * PRIVATE HELPERS
  * ============================================================================ */
 
 /**
- * @brief Find module index in known list
- * @return Index if found, -1 otherwise
+ * @brief Index of the lowest set bit (bits != 0)
  */
-static int find_known_index(const ekk_topology_t *topo, ekk_module_id_t id)
+static inline uint32_t lowest_bit(uint32_t bits)
 {
-    for (uint32_t i = 0; i < topo->known_count; i++) {
-        if (topo->all_known[i] == id) {
-            return (int)i;
-        }
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctz(bits);
+#else
+    uint32_t i = 0;
+    while ((bits & 1u) == 0) {
+        bits >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/**
+ * @brief Slot of a known module
+ * @return Slot if known, -1 otherwise
+ */
+static int32_t known_find(const ekk_topology_t *topo, ekk_module_id_t id)
+{
+#if EKK_MODULE_ID_BITS > 8
+    return ekk_idmap_find(&topo->known_slots, id);
+#else
+    if (!EKK_MODULE_ID_VALID(id)) {
+        return -1;
     }
-    return -1;
+    return (topo->known_bits[id / 32] & (1u << (id % 32))) ? (int32_t)id : -1;
+#endif
 }
 
 /**
@@ -60,49 +70,126 @@ static int find_neighbor_index(const ekk_topology_t *topo, ekk_module_id_t id)
 }
 
 /**
- * @brief Add module to known list
- * @return Index in known list, -1 if full
+ * @brief Grid cell coordinate of a position component (floor division)
+ */
+static inline int32_t grid_coord(int16_t v)
+{
+    int32_t c = EKK_TOPOLOGY_GRID_CELL;
+    return (v >= 0) ? (int32_t)v / c : -(((int32_t)-v + c - 1) / c);
+}
+
+/**
+ * @brief Hash bucket of a grid cell
+ */
+static inline uint32_t grid_bucket(int32_t cx, int32_t cy, int32_t cz)
+{
+    uint32_t h = (uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u ^ (uint32_t)cz * 83492791u;
+    return h & (EKK_TOPOLOGY_GRID_BUCKETS - 1);
+}
+
+static inline uint32_t grid_bucket_of(ekk_position_t pos)
+{
+    return grid_bucket(grid_coord(pos.x), grid_coord(pos.y), grid_coord(pos.z));
+}
+
+/**
+ * @brief Link known slot idx into the grid at its current position
  */
-static int add_to_known(ekk_topology_t *topo, ekk_module_id_t id, ekk_position_t pos)
+static void grid_insert(ekk_topology_t *topo, uint32_t idx)
 {
-    /* Check if already known */
-    int idx = find_known_index(topo, id);
-    if (idx >= 0) {
-        /* Update position */
-        g_known_positions[idx] = pos;
-        return idx;
+    ekk_position_t pos = topo->known_positions[idx];
+    uint32_t b = grid_bucket_of(pos);
+
+    topo->grid_next[idx] = topo->grid_head[b];
+    topo->grid_head[b] = (uint16_t)(idx + 1);
+
+    /* Grow the occupied cell bounds (never shrunk until the list empties) */
+    ekk_position_t cell = {
+        .x = (int16_t)grid_coord(pos.x),
+        .y = (int16_t)grid_coord(pos.y),
+        .z = (int16_t)grid_coord(pos.z),
+    };
+    if (topo->known_count == 1) {
+        topo->grid_min = cell;
+        topo->grid_max = cell;
+    } else {
+        topo->grid_min.x = EKK_MIN(topo->grid_min.x, cell.x);
+        topo->grid_min.y = EKK_MIN(topo->grid_min.y, cell.y);
+        topo->grid_min.z = EKK_MIN(topo->grid_min.z, cell.z);
+        topo->grid_max.x = EKK_MAX(topo->grid_max.x, cell.x);
+        topo->grid_max.y = EKK_MAX(topo->grid_max.y, cell.y);
+        topo->grid_max.z = EKK_MAX(topo->grid_max.z, cell.z);
+    }
+}
+
+/**
+ * @brief Unlink known slot idx from the grid
+ */
+static void grid_remove(ekk_topology_t *topo, uint32_t idx)
+{
+    uint16_t *link = &topo->grid_head[grid_bucket_of(topo->known_positions[idx])];
+
+    while (*link != 0) {
+        if (*link == idx + 1) {
+            *link = topo->grid_next[idx];
+            return;
+        }
+        link = &topo->grid_next[*link - 1];
     }
+}
 
-    /* Check capacity */
-    if (topo->known_count >= EKK_MAX_MODULES) {
+/**
+ * @brief Add a new module to the known set
+ * @return Slot, -1 if full
+ */
+static int32_t add_to_known(ekk_topology_t *topo, ekk_module_id_t id, ekk_position_t pos)
+{
+#if EKK_MODULE_ID_BITS > 8
+    int32_t slot = ekk_idmap_insert(&topo->known_slots, id);
+#else
+    int32_t slot = EKK_MODULE_ID_VALID(id) ? (int32_t)id : -1;
+#endif
+    if (slot < 0) {
         return -1;
     }
 
-    /* Add new module */
-    idx = (int)topo->known_count;
-    topo->all_known[idx] = id;
-    g_known_positions[idx] = pos;
+    topo->all_known[slot] = id;
+    topo->known_positions[slot] = pos;
+    topo->known_latency[slot] = 0;
+    topo->known_bits[slot / 32] |= 1u << (slot % 32);
     topo->known_count++;
+    grid_insert(topo, (uint32_t)slot);
+
+    return slot;
+}
 
-    return idx;
+/**
+ * @brief Update a known module's position, moving its grid entry
+ */
+static void move_known(ekk_topology_t *topo, uint32_t slot, ekk_position_t pos)
+{
+    grid_remove(topo, slot);
+    topo->known_positions[slot] = pos;
+    grid_insert(topo, slot);
 }
 
 /**
- * @brief Remove module from known list
+ * @brief Remove module from known set
  */
 static void remove_from_known(ekk_topology_t *topo, ekk_module_id_t id)
 {
-    int idx = find_known_index(topo, id);
-    if (idx < 0) {
+    int32_t slot = known_find(topo, id);
+    if (slot < 0) {
         return;
     }
 
-    /* Shift remaining modules down */
-    for (uint32_t i = (uint32_t)idx; i < topo->known_count - 1; i++) {
-        topo->all_known[i] = topo->all_known[i + 1];
-        g_known_positions[i] = g_known_positions[i + 1];
-    }
+    grid_remove(topo, (uint32_t)slot);
+    topo->known_bits[slot / 32] &= ~(1u << (slot % 32));
+    topo->all_known[slot] = EKK_INVALID_MODULE_ID;
     topo->known_count--;
+#if EKK_MODULE_ID_BITS > 8
+    ekk_idmap_remove(&topo->known_slots, id);
+#endif
 }
 
 /**
@@ -133,20 +220,11 @@ static int32_t isqrt(int32_t n)
     return x;
 }
 
-/**
- * @brief Structure for sorting modules by distance
- */
-typedef struct {
-    ekk_module_id_t id;
-    int32_t distance;
-    ekk_position_t position;
-} distance_entry_t;
-
 /**
  * @brief Compare two distance entries (primary: distance, secondary: module ID)
  * @return true if a should come before b
  */
-static bool entry_less_than(const distance_entry_t *a, const distance_entry_t *b)
+static bool entry_less_than(const ekk_topology_candidate_t *a, const ekk_topology_candidate_t *b)
 {
     if (a->distance != b->distance) {
         return a->distance < b->distance;
@@ -156,27 +234,185 @@ static bool entry_less_than(const distance_entry_t *a, const distance_entry_t *b
 }
 
 /**
- * @brief Insertion sort for distance entries (efficient for small k)
- * Sorts by distance first, then by module ID for tie-breaking
+ * @brief Bounded max-heap of the k best candidates (root = worst kept)
  */
-static void sort_by_distance(distance_entry_t *entries, uint32_t count)
+typedef struct {
+    ekk_topology_candidate_t entries[EKK_K_NEIGHBORS + EKK_TOPOLOGY_RESERVE];
+    uint32_t count;
+    uint32_t capacity;
+} nearest_heap_t;
+
+static void heap_sift_down(ekk_topology_candidate_t *e, uint32_t count, uint32_t i)
+{
+    for (;;) {
+        uint32_t worst = i;
+        uint32_t l = 2 * i + 1;
+        uint32_t r = l + 1;
+        if (l < count && entry_less_than(&e[worst], &e[l])) worst = l;
+        if (r < count && entry_less_than(&e[worst], &e[r])) worst = r;
+        if (worst == i) {
+            return;
+        }
+        ekk_topology_candidate_t tmp = e[i];
+        e[i] = e[worst];
+        e[worst] = tmp;
+        i = worst;
+    }
+}
+
+/**
+ * @brief Offer a candidate; kept if the heap has room or it beats the worst
+ */
+static void heap_offer(nearest_heap_t *h, ekk_module_id_t id, int32_t distance)
+{
+    ekk_topology_candidate_t e = { .id = id, .distance = distance };
+
+    if (h->count < h->capacity) {
+        /* Sift up */
+        uint32_t i = h->count++;
+        while (i > 0 && entry_less_than(&h->entries[(i - 1) / 2], &e)) {
+            h->entries[i] = h->entries[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        h->entries[i] = e;
+    } else if (h->capacity > 0 && entry_less_than(&e, &h->entries[0])) {
+        h->entries[0] = e;
+        heap_sift_down(h->entries, h->count, 0);
+    }
+}
+
+/**
+ * @brief Sort the heap in place, nearest first
+ */
+static void heap_sort(nearest_heap_t *h)
 {
-    for (uint32_t i = 1; i < count; i++) {
-        distance_entry_t key = entries[i];
-        int32_t j = (int32_t)i - 1;
+    for (uint32_t n = h->count; n > 1; n--) {
+        ekk_topology_candidate_t tmp = h->entries[0];
+        h->entries[0] = h->entries[n - 1];
+        h->entries[n - 1] = tmp;
+        heap_sift_down(h->entries, n - 1, 0);
+    }
+}
 
-        while (j >= 0 && entry_less_than(&key, &entries[j])) {
-            entries[j + 1] = entries[j];
-            j--;
+/**
+ * @brief Offer every known module (any metric)
+ */
+static void select_linear(const ekk_topology_t *topo, nearest_heap_t *h)
+{
+    for (uint32_t w = 0; w < EKK_TOPOLOGY_KNOWN_WORDS; w++) {
+        for (uint32_t bits = topo->known_bits[w]; bits != 0; bits &= bits - 1) {
+            uint32_t i = w * 32 + lowest_bit(bits);
+            ekk_module_id_t id = topo->all_known[i];
+            if (id == topo->my_id) {
+                continue;
+            }
+            heap_offer(h, id, ekk_topology_distance(topo,
+                                                    topo->my_id, topo->my_position,
+                                                    id, topo->known_positions[i]));
+        }
+    }
+}
+
+/**
+ * @brief Offer known modules in one grid cell
+ * @return Entries found in the cell (self included)
+ */
+static uint32_t select_cell(const ekk_topology_t *topo, nearest_heap_t *h,
+                            int32_t cx, int32_t cy, int32_t cz)
+{
+    uint32_t found = 0;
+
+    /* Chains mix cells that share a bucket: filter by cell */
+    for (uint16_t link = topo->grid_head[grid_bucket(cx, cy, cz)]; link != 0;
+         link = topo->grid_next[link - 1]) {
+        uint32_t i = link - 1u;
+        ekk_position_t pos = topo->known_positions[i];
+        if (grid_coord(pos.x) != cx || grid_coord(pos.y) != cy || grid_coord(pos.z) != cz) {
+            continue;
+        }
+        found++;
+        if (topo->all_known[i] == topo->my_id) {
+            continue;
+        }
+
+        /* floor(sqrt(d)) > worst exactly when d >= (worst + 1)^2: skip isqrt */
+        int32_t d = position_distance_sq(topo->my_position, pos);
+        if (h->count == h->capacity) {
+            int32_t bound = h->entries[0].distance + 1;
+            if (d >= bound * bound) {
+                continue;
+            }
+        }
+        heap_offer(h, topo->all_known[i], isqrt(d));
+    }
+    return found;
+}
+
+/**
+ * @brief Ring search over the spatial grid (EKK_DISTANCE_PHYSICAL)
+ *
+ * Visits the shell of cells at Chebyshev distance r around this module's
+ * cell for r = 0, 1, ... Any module outside ring r is at least
+ * r * EKK_TOPOLOGY_GRID_CELL + 1 away, so the search stops once the heap
+ * is full and its worst entry is closer than that, or every known module
+ * has been seen. Sparse layouts where rings stay mostly empty fall back
+ * to the linear scan once probing costs more than it would.
+ */
+static void select_grid(const ekk_topology_t *topo, nearest_heap_t *h)
+{
+    int32_t cx = grid_coord(topo->my_position.x);
+    int32_t cy = grid_coord(topo->my_position.y);
+    int32_t cz = grid_coord(topo->my_position.z);
+    uint32_t seen = 0;
+    uint32_t probes = 0;
+    uint32_t budget = 2 * topo->known_count + 27;
+
+    /* Rings closer than the occupied bounds are empty: start at the bounds */
+    int32_t r_start = 0;
+    r_start = EKK_MAX(r_start, EKK_MAX((int32_t)topo->grid_min.x - cx, cx - (int32_t)topo->grid_max.x));
+    r_start = EKK_MAX(r_start, EKK_MAX((int32_t)topo->grid_min.y - cy, cy - (int32_t)topo->grid_max.y));
+    r_start = EKK_MAX(r_start, EKK_MAX((int32_t)topo->grid_min.z - cz, cz - (int32_t)topo->grid_max.z));
+
+    for (int32_t r = r_start; seen < topo->known_count; r++) {
+        /* Shell r clipped to the occupied bounds */
+        int32_t x0 = EKK_MAX(cx - r, (int32_t)topo->grid_min.x);
+        int32_t x1 = EKK_MIN(cx + r, (int32_t)topo->grid_max.x);
+        int32_t y0 = EKK_MAX(cy - r, (int32_t)topo->grid_min.y);
+        int32_t y1 = EKK_MIN(cy + r, (int32_t)topo->grid_max.y);
+        int32_t z0 = EKK_MAX(cz - r, (int32_t)topo->grid_min.z);
+        int32_t z1 = EKK_MIN(cz + r, (int32_t)topo->grid_max.z);
+
+        for (int32_t x = x0; x <= x1; x++) {
+            for (int32_t y = y0; y <= y1; y++) {
+                /* Columns inside the x/y ring only touch the shell at cz +- r */
+                bool face = (x == cx - r || x == cx + r || y == cy - r || y == cy + r);
+                int32_t step = face ? 1 : 2 * r;
+
+                for (int32_t z = face ? z0 : cz - r; z <= z1; z += step) {
+                    if (z < z0) {
+                        continue;
+                    }
+                    if (++probes > budget) {
+                        h->count = 0;
+                        select_linear(topo, h);
+                        return;
+                    }
+                    seen += select_cell(topo, h, x, y, z);
+                }
+            }
+        }
+
+        if (h->count == h->capacity &&
+            h->entries[0].distance <= r * EKK_TOPOLOGY_GRID_CELL) {
+            return;
         }
-        entries[j + 1] = key;
     }
 }
 
 /**
  * @brief Send discovery broadcast
  */
-static ekk_error_t send_discovery(const ekk_topology_t *topo)
+static ekk_error_t send_discovery(ekk_topology_t *topo, ekk_time_us_t now)
 {
     ekk_discovery_msg_t msg = {
         .msg_type = EKK_MSG_DISCOVERY,
@@ -184,10 +420,10 @@ static ekk_error_t send_discovery(const ekk_topology_t *topo)
         .position = topo->my_position,
         .neighbor_count = (uint8_t)topo->neighbor_count,
         .state = EKK_MODULE_ACTIVE,
-        .sequence = g_discovery_sequence++,
+        .sequence = topo->discovery_sequence++,
     };
 
-    return ekk_hal_broadcast(EKK_MSG_DISCOVERY, &msg, sizeof(msg));
+    return ekk_heartbeat_piggyback(topo->liveness, EKK_MSG_DISCOVERY, &msg, sizeof(msg), now);
 }
 
 /* ============================================================================
@@ -224,6 +460,136 @@ ekk_error_t ekk_topology_init(ekk_topology_t *topo,
     return EKK_OK;
 }
 
+/* ============================================================================
+ * INCREMENTAL NEIGHBOR SET
+ * ============================================================================ */
+
+/**
+ * @brief Neighbor slots in use at most (config clamped to storage)
+ */
+static inline uint32_t neighbor_capacity(const ekk_topology_t *topo)
+{
+    return EKK_MIN(topo->config.k_neighbors, (uint32_t)EKK_K_NEIGHBORS);
+}
+
+static inline ekk_topology_candidate_t neighbor_candidate(const ekk_neighbor_t *n)
+{
+    ekk_topology_candidate_t c = { .id = n->id, .distance = n->logical_distance };
+    return c;
+}
+
+/**
+ * @brief Fresh neighbor entry for a newly elected module
+ */
+static void neighbor_init(ekk_neighbor_t *n, ekk_topology_candidate_t c)
+{
+    n->id = c.id;
+    n->health = EKK_HEALTH_UNKNOWN;
+    n->last_seen = 0;
+    n->logical_distance = c.distance;
+    n->missed_heartbeats = 0;
+    memset(&n->last_field, 0, sizeof(ekk_field_t));
+}
+
+/**
+ * @brief Invoke the change callback if the neighbor IDs differ from old
+ */
+static void notify_if_changed(ekk_topology_t *topo,
+                              const ekk_neighbor_t *old_neighbors, uint32_t old_count)
+{
+    if (topo->on_changed == NULL) {
+        return;
+    }
+
+    bool changed = (old_count != topo->neighbor_count);
+    for (uint32_t i = 0; i < topo->neighbor_count && !changed; i++) {
+        if (topo->neighbors[i].id != old_neighbors[i].id) {
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        topo->on_changed(topo, old_neighbors, old_count,
+                         topo->neighbors, topo->neighbor_count);
+    }
+}
+
+/**
+ * @brief Sorted insert into the reserve (the worst entry drops off if full)
+ */
+static void reserve_insert(ekk_topology_t *topo, ekk_topology_candidate_t c)
+{
+    uint32_t n = topo->reserve_count;
+    if (n == EKK_TOPOLOGY_RESERVE) {
+        n--;
+    }
+
+    uint32_t i = n;
+    while (i > 0 && entry_less_than(&c, &topo->reserve[i - 1])) {
+        topo->reserve[i] = topo->reserve[i - 1];
+        i--;
+    }
+    topo->reserve[i] = c;
+    topo->reserve_count = n + 1;
+}
+
+/**
+ * @brief Place a newly known module (incremental mode)
+ *
+ * Invariant: neighbors[] then reserve[] are the nearest known modules in
+ * order, and any module in neither is farther than both. A newcomer that
+ * beats the k-th neighbor displaces it into the reserve; one that beats
+ * the reserve's worst (or fills a reserve with nothing behind it) joins
+ * the reserve; anything else stays unranked until the next reelection.
+ */
+static void admit_candidate(ekk_topology_t *topo, ekk_topology_candidate_t c)
+{
+    uint32_t k = neighbor_capacity(topo);
+    uint32_t n = topo->neighbor_count;
+
+    bool to_neighbors = (n < k);
+    if (!to_neighbors && k > 0) {
+        ekk_topology_candidate_t bound = neighbor_candidate(&topo->neighbors[n - 1]);
+        to_neighbors = entry_less_than(&c, &bound);
+    }
+
+    if (to_neighbors) {
+        ekk_neighbor_t old_neighbors[EKK_K_NEIGHBORS];
+        uint32_t old_count = n;
+        memcpy(old_neighbors, topo->neighbors, sizeof(old_neighbors));
+
+        if (n == k) {
+            reserve_insert(topo, neighbor_candidate(&topo->neighbors[n - 1]));
+            n--;
+        }
+
+        uint32_t i = n;
+        while (i > 0) {
+            ekk_topology_candidate_t prev = neighbor_candidate(&topo->neighbors[i - 1]);
+            if (!entry_less_than(&c, &prev)) {
+                break;
+            }
+            topo->neighbors[i] = topo->neighbors[i - 1];
+            i--;
+        }
+        neighbor_init(&topo->neighbors[i], c);
+        topo->neighbor_count = n + 1;
+
+        notify_if_changed(topo, old_neighbors, old_count);
+        return;
+    }
+
+    /* Known modules that are neither neighbors, reserve, nor the newcomer */
+    uint32_t ranked = n + topo->reserve_count + 1;
+    uint32_t unranked = (topo->known_count > ranked) ? topo->known_count - ranked : 0;
+    uint32_t r = topo->reserve_count;
+
+    if ((r > 0 && entry_less_than(&c, &topo->reserve[r - 1])) ||
+        (r < EKK_TOPOLOGY_RESERVE && unranked == 0)) {
+        reserve_insert(topo, c);
+    }
+}
+
 /* ============================================================================
  * DISCOVERY MESSAGE HANDLING
  * ============================================================================ */
@@ -232,7 +598,7 @@ ekk_error_t ekk_topology_on_discovery(ekk_topology_t *topo,
                                        ekk_module_id_t sender_id,
                                        ekk_position_t sender_position)
 {
-    if (topo == NULL || sender_id == EKK_INVALID_MODULE_ID) {
+    if (topo == NULL || !EKK_MODULE_ID_VALID(sender_id)) {
         return EKK_ERR_INVALID_ARG;
     }
 
@@ -241,16 +607,43 @@ ekk_error_t ekk_topology_on_discovery(ekk_topology_t *topo,
         return EKK_OK;
     }
 
-    /* Add to known modules */
-    int idx = add_to_known(topo, sender_id, sender_position);
-    if (idx < 0) {
-        return EKK_ERR_NO_MEMORY;
+    /* Add to known modules, or refresh its position */
+    bool added = false;
+    bool moved = false;
+    int32_t slot = known_find(topo, sender_id);
+    if (slot >= 0) {
+        ekk_position_t old = topo->known_positions[slot];
+        moved = (old.x != sender_position.x || old.y != sender_position.y ||
+                 old.z != sender_position.z);
+        if (moved) {
+            move_known(topo, (uint32_t)slot, sender_position);
+        }
+    } else {
+        slot = add_to_known(topo, sender_id, sender_position);
+        if (slot < 0) {
+            return EKK_ERR_NO_MEMORY;
+        }
+        added = true;
+    }
+
+    if (!topo->config.incremental) {
+        /* Trigger reelection if we don't have enough neighbors */
+        if (topo->neighbor_count < topo->config.k_neighbors) {
+            ekk_topology_reelect(topo);
+        }
+        return EKK_OK;
     }
 
-    /* Check if this module should be a neighbor */
-    /* Trigger reelection if we don't have enough neighbors */
-    if (topo->neighbor_count < topo->config.k_neighbors) {
+    if (moved && topo->config.metric == EKK_DISTANCE_PHYSICAL) {
+        /* Its rank may have changed anywhere in the order */
         ekk_topology_reelect(topo);
+    } else if (added) {
+        ekk_topology_candidate_t c = {
+            .id = sender_id,
+            .distance = ekk_topology_distance(topo, topo->my_id, topo->my_position,
+                                              sender_id, sender_position),
+        };
+        admit_candidate(topo, c);
     }
 
     return EKK_OK;
@@ -292,8 +685,23 @@ ekk_error_t ekk_topology_on_neighbor_lost(ekk_topology_t *topo,
         topo->neighbors[topo->neighbor_count].health = EKK_HEALTH_UNKNOWN;
     }
 
-    /* Trigger reelection to find replacement */
-    ekk_topology_reelect(topo);
+    if (topo->config.incremental && topo->reserve_count > 0) {
+        /* Promote the nearest reserve candidate (it ranks after every neighbor) */
+        ekk_neighbor_t old_neighbors[EKK_K_NEIGHBORS];
+        uint32_t old_count = topo->neighbor_count;
+        memcpy(old_neighbors, topo->neighbors, sizeof(old_neighbors));
+
+        neighbor_init(&topo->neighbors[topo->neighbor_count++], topo->reserve[0]);
+        topo->reserve_count--;
+        memmove(&topo->reserve[0], &topo->reserve[1],
+                topo->reserve_count * sizeof(topo->reserve[0]));
+
+        notify_if_changed(topo, old_neighbors, old_count);
+    } else if (!topo->config.incremental ||
+               topo->known_count > topo->neighbor_count) {
+        /* Trigger reelection to find replacement */
+        ekk_topology_reelect(topo);
+    }
 
     return EKK_OK;
 }
@@ -308,6 +716,7 @@ uint32_t ekk_topology_reelect(ekk_topology_t *topo)
         return 0;
     }
 
+    topo->reserve_count = 0;
     if (topo->known_count == 0) {
         topo->neighbor_count = 0;
         return 0;
@@ -318,33 +727,21 @@ uint32_t ekk_topology_reelect(ekk_topology_t *topo)
     uint32_t old_count = topo->neighbor_count;
     memcpy(old_neighbors, topo->neighbors, sizeof(old_neighbors));
 
-    /* Build distance entries for all known modules */
-    distance_entry_t entries[EKK_MAX_MODULES];
-    uint32_t entry_count = 0;
-
-    for (uint32_t i = 0; i < topo->known_count; i++) {
-        ekk_module_id_t id = topo->all_known[i];
-
-        /* Skip self */
-        if (id == topo->my_id) {
-            continue;
-        }
+    /* Select the k nearest (plus the reserve), without sorting the rest */
+    uint32_t k = neighbor_capacity(topo);
+    nearest_heap_t heap;
+    heap.count = 0;
+    heap.capacity = k + (topo->config.incremental ? EKK_TOPOLOGY_RESERVE : 0);
 
-        entries[entry_count].id = id;
-        entries[entry_count].position = g_known_positions[i];
-        entries[entry_count].distance = ekk_topology_distance(
-            topo,
-            topo->my_id, topo->my_position,
-            id, g_known_positions[i]
-        );
-        entry_count++;
+    if (topo->config.metric == EKK_DISTANCE_PHYSICAL) {
+        select_grid(topo, &heap);
+    } else {
+        select_linear(topo, &heap);
     }
+    heap_sort(&heap);
 
-    /* Sort by distance */
-    sort_by_distance(entries, entry_count);
-
-    /* Take k nearest as new neighbors */
-    uint32_t new_count = EKK_MIN(entry_count, topo->config.k_neighbors);
+    ekk_topology_candidate_t *entries = heap.entries;
+    uint32_t new_count = EKK_MIN(heap.count, k);
 
     for (uint32_t i = 0; i < new_count; i++) {
         /* Check if this was already a neighbor */
@@ -361,12 +758,7 @@ uint32_t ekk_topology_reelect(ekk_topology_t *topo)
             topo->neighbors[i] = old_neighbors[old_idx];
         } else {
             /* New neighbor */
-            topo->neighbors[i].id = entries[i].id;
-            topo->neighbors[i].health = EKK_HEALTH_UNKNOWN;
-            topo->neighbors[i].last_seen = 0;
-            topo->neighbors[i].logical_distance = entries[i].distance;
-            topo->neighbors[i].missed_heartbeats = 0;
-            memset(&topo->neighbors[i].last_field, 0, sizeof(ekk_field_t));
+            neighbor_init(&topo->neighbors[i], entries[i]);
         }
 
         /* Update distance (may have changed) */
@@ -379,27 +771,55 @@ uint32_t ekk_topology_reelect(ekk_topology_t *topo)
         topo->neighbors[i].health = EKK_HEALTH_UNKNOWN;
     }
 
+    /* Runners-up become the reserve */
+    topo->reserve_count = heap.count - new_count;
+    memcpy(topo->reserve, &entries[new_count],
+           topo->reserve_count * sizeof(topo->reserve[0]));
+
     topo->neighbor_count = new_count;
     topo->last_reelection = ekk_hal_time_us();
 
     /* Invoke callback if topology changed */
-    if (g_topology_callback != NULL) {
-        bool changed = (old_count != new_count);
-        if (!changed) {
-            for (uint32_t i = 0; i < new_count && !changed; i++) {
-                if (topo->neighbors[i].id != old_neighbors[i].id) {
-                    changed = true;
-                }
-            }
-        }
+    notify_if_changed(topo, old_neighbors, old_count);
+
+    return new_count;
+}
+
+/* ============================================================================
+ * MEASURED LATENCY
+ * ============================================================================ */
+
+ekk_error_t ekk_topology_on_latency(ekk_topology_t *topo,
+                                     ekk_module_id_t module_id,
+                                     ekk_time_us_t rtt_us)
+{
+    if (topo == NULL || module_id == EKK_INVALID_MODULE_ID) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    int32_t slot = known_find(topo, module_id);
+    if (slot < 0) {
+        return EKK_ERR_NOT_FOUND;
+    }
 
-        if (changed) {
-            g_topology_callback(topo, old_neighbors, old_count,
-                                topo->neighbors, new_count);
+    /* Keep measured values below the unmeasured band */
+    uint32_t rtt = (uint32_t)EKK_CLAMP(rtt_us, (ekk_time_us_t)1,
+                                       (ekk_time_us_t)(EKK_TOPOLOGY_LATENCY_UNMEASURED - 1));
+    uint32_t ranked = topo->known_latency[slot];
+
+    /* Hysteresis: ignore moves within the band around the ranked value */
+    if (ranked != 0) {
+        uint32_t delta = (rtt > ranked) ? rtt - ranked : ranked - rtt;
+        if ((uint64_t)delta * 100 <= (uint64_t)ranked * EKK_TOPOLOGY_LATENCY_HYSTERESIS_PCT) {
+            return EKK_OK;
         }
     }
+    topo->known_latency[slot] = rtt;
 
-    return new_count;
+    if (topo->config.metric == EKK_DISTANCE_LATENCY) {
+        ekk_topology_reelect(topo);
+    }
+    return EKK_OK;
 }
 
 /* ============================================================================
@@ -416,7 +836,7 @@ bool ekk_topology_tick(ekk_topology_t *topo, ekk_time_us_t now)
 
     /* Send discovery broadcast if period elapsed */
     if (now - topo->last_discovery >= topo->config.discovery_period) {
-        send_discovery(topo);
+        send_discovery(topo, now);
         topo->last_discovery = now;
     }
 
@@ -424,7 +844,7 @@ bool ekk_topology_tick(ekk_topology_t *topo, ekk_time_us_t now)
     if (topo->neighbor_count < topo->config.min_neighbors) {
         /* Trigger discovery more aggressively */
         if (now - topo->last_discovery >= topo->config.discovery_period / 4) {
-            send_discovery(topo);
+            send_discovery(topo, now);
             topo->last_discovery = now;
         }
     }
@@ -432,6 +852,19 @@ bool ekk_topology_tick(ekk_topology_t *topo, ekk_time_us_t now)
     return changed;
 }
 
+ekk_time_us_t ekk_topology_next_deadline(const ekk_topology_t *topo)
+{
+    if (topo == NULL) {
+        return UINT64_MAX;
+    }
+
+    ekk_time_us_t period = topo->config.discovery_period;
+    if (topo->neighbor_count < topo->config.min_neighbors) {
+        period /= 4;
+    }
+    return topo->last_discovery + period;
+}
+
 /* ============================================================================
  * NEIGHBOR QUERIES
  * ============================================================================ */
@@ -449,6 +882,16 @@ uint32_t ekk_topology_get_neighbors(const ekk_topology_t *topo,
     return count;
 }
 
+bool ekk_topology_is_known(const ekk_topology_t *topo,
+                            ekk_module_id_t module_id)
+{
+    if (topo == NULL) {
+        return false;
+    }
+
+    return known_find(topo, module_id) >= 0;
+}
+
 bool ekk_topology_is_neighbor(const ekk_topology_t *topo,
                                ekk_module_id_t module_id)
 {
@@ -495,10 +938,15 @@ int32_t ekk_topology_distance(const ekk_topology_t *topo,
             /* Physical distance: Euclidean */
             return isqrt(position_distance_sq(pos_a, pos_b));
 
-        case EKK_DISTANCE_LATENCY:
-            /* Latency-based: would require HAL support for RTT measurement */
-            /* Fall back to logical for now */
-            return (int32_t)(id_a > id_b ? id_a - id_b : id_b - id_a);
+        case EKK_DISTANCE_LATENCY: {
+            /* Ranked RTT of whichever module is not us */
+            int32_t slot = known_find(topo, (id_a == topo->my_id) ? id_b : id_a);
+            if (slot >= 0 && topo->known_latency[slot] != 0) {
+                return (int32_t)topo->known_latency[slot];
+            }
+            return EKK_TOPOLOGY_LATENCY_UNMEASURED +
+                   (int32_t)(id_a > id_b ? id_a - id_b : id_b - id_a);
+        }
 
         case EKK_DISTANCE_CUSTOM:
             /* Application-defined */
@@ -526,6 +974,9 @@ EKK_WEAK int32_t ekk_topology_distance_custom(ekk_module_id_t id_a,
 void ekk_topology_set_callback(ekk_topology_t *topo,
                                 ekk_topology_changed_cb callback)
 {
-    EKK_UNUSED(topo);
-    g_topology_callback = callback;
+    if (topo == NULL) {
+        return;
+    }
+
+    topo->on_changed = callback;
 }
@@ -12,14 +12,27 @@
  * STATIC ASSERTIONS
  * ============================================================================ */
 
+#if EKK_MODULE_ID_BITS > 8
+EKK_STATIC_ASSERT(EKK_MODULE_ID_BITS == 16, "module IDs are 8 or 16 bits");
+EKK_STATIC_ASSERT(sizeof(ekk_module_id_t) == 2, "module_id must be 2 bytes");
+EKK_STATIC_ASSERT(EKK_MAX_MODULES <= 32768, "max modules limited by slot map encoding");
+#else
 EKK_STATIC_ASSERT(sizeof(ekk_module_id_t) == 1, "module_id must be 1 byte");
+EKK_STATIC_ASSERT(EKK_MAX_MODULES <= 256, "max modules limited to uint8_t range");
+#endif
 EKK_STATIC_ASSERT(sizeof(ekk_ballot_id_t) == 2, "ballot_id must be 2 bytes");
 EKK_STATIC_ASSERT(sizeof(ekk_time_us_t) == 8, "time_us must be 8 bytes");
 EKK_STATIC_ASSERT(sizeof(ekk_fixed_t) == 4, "fixed must be 4 bytes");
 EKK_STATIC_ASSERT(EKK_K_NEIGHBORS >= 3, "k-neighbors must be at least 3");
 EKK_STATIC_ASSERT(EKK_K_NEIGHBORS <= 15, "k-neighbors should not exceed 15");
-EKK_STATIC_ASSERT(EKK_MAX_MODULES <= 256, "max modules limited to uint8_t range");
 EKK_STATIC_ASSERT(EKK_FIELD_COUNT == 6, "field count must be 6");
+EKK_STATIC_ASSERT((EKK_FIELD_WHEEL_SLOTS & (EKK_FIELD_WHEEL_SLOTS - 1)) == 0,
+                  "field expiry wheel slots must be a power of 2");
+EKK_STATIC_ASSERT((EKK_FIELD_CHANGE_BUCKETS & (EKK_FIELD_CHANGE_BUCKETS - 1)) == 0 &&
+                  EKK_FIELD_CHANGE_BUCKETS >= 2,
+                  "field change buckets must be a power of 2, at least 2");
+EKK_STATIC_ASSERT((EKK_FIELD_CHANGE_SPAN & (EKK_FIELD_CHANGE_SPAN - 1)) == 0,
+                  "field change span must be a power of 2");
 
 /* ============================================================================
  * FIXED-POINT ARITHMETIC
@@ -10,7 +10,9 @@
  * Features:
  * - High-resolution timing via clock_gettime/QueryPerformanceCounter
  * - Message queues using thread-safe ring buffers
+ * - Tickless waits: eventfd wakeups on Linux, clock_nanosleep elsewhere
  * - Atomic operations via compiler builtins
+ * - Field region in a named shm_open/mmap segment, shared by processes
  * - Printf for debug output
  */
 
@@ -27,6 +29,16 @@
 #include <time.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <poll.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#endif
 #endif
 
 /* ============================================================================
@@ -46,9 +58,9 @@ static struct timespec g_start_time;
 #define MSG_MAX_LEN         64
 
 typedef struct {
+    uint8_t data[MSG_MAX_LEN];      /* First: handlers cast it in place */
     ekk_module_id_t sender_id;
     ekk_msg_type_t msg_type;
-    uint8_t data[MSG_MAX_LEN];
     uint32_t len;
     bool valid;
 } hal_message_t;
@@ -56,8 +68,9 @@ typedef struct {
 static hal_message_t g_msg_queue[MSG_QUEUE_SIZE];
 static volatile uint32_t g_msg_head = 0;
 static volatile uint32_t g_msg_tail = 0;
+static volatile uint32_t g_msg_overruns = 0;
 
-/** Critical section lock */
+/** Critical section lock (this process only; see ekk_hal_field_lock()) */
 #ifdef _WIN32
 static CRITICAL_SECTION g_critical;
 #else
@@ -67,9 +80,18 @@ static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
 /** Receive callback */
 static ekk_hal_recv_cb g_recv_callback = NULL;
 
+#ifdef __linux__
+/** Signalled on send while someone sleeps in ekk_hal_wait_event() */
+static int g_rx_eventfd = -1;
+static volatile uint32_t g_rx_waiters = 0;
+#endif
+
 /** Module ID (for simulation) */
 static ekk_module_id_t g_module_id = 1;
 
+/** Open endpoints (guarded by the critical section) */
+static ekk_hal_endpoint_t *g_endpoints = NULL;
+
 /** Initialized flag */
 static bool g_hal_initialized = false;
 
@@ -136,10 +158,85 @@ void ekk_hal_delay_us(uint32_t us)
 #endif
 }
 
+uint32_t ekk_hal_cycles(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return (uint32_t)now.QuadPart;
+#else
+    /* Nanoseconds: vDSO-backed, and no TSC frequency to calibrate */
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);
+#endif
+}
+
+uint32_t ekk_hal_cycles_to_ns(uint32_t cycles)
+{
+#ifdef _WIN32
+    return (uint32_t)((uint64_t)cycles * 1000000000ULL / (uint64_t)g_freq.QuadPart);
+#else
+    return cycles;
+#endif
+}
+
 /* ============================================================================
  * MESSAGE TRANSMISSION
  * ============================================================================ */
 
+/** Wake ekk_hal_wait_event() after queueing a frame */
+static void rx_wake(void)
+{
+#ifdef __linux__
+    /* Senders skip the syscall unless someone is asleep */
+    if (g_rx_waiters != 0 && g_rx_eventfd >= 0) {
+        uint64_t one = 1;
+        ssize_t n = write(g_rx_eventfd, &one, sizeof(one));
+        EKK_UNUSED(n);
+    }
+#endif
+}
+
+/**
+ * @brief Queue a frame on every open endpoint it is addressed to
+ *
+ * Never back to the sending ID. Caller holds the critical section.
+ *
+ * @return true if any endpoint took the frame
+ */
+static bool endpoint_fanout(ekk_module_id_t sender_id,
+                            ekk_module_id_t dest_id,
+                            ekk_msg_type_t msg_type,
+                            const void *data,
+                            uint32_t len)
+{
+    bool queued = false;
+
+    for (ekk_hal_endpoint_t *ep = g_endpoints; ep != NULL; ep = ep->next) {
+        if (ep->id == sender_id || (dest_id != EKK_BROADCAST_ID && dest_id != ep->id)) {
+            continue;
+        }
+
+        uint32_t next_head = (ep->head + 1) % EKK_HAL_ENDPOINT_DEPTH;
+        if (next_head == ep->tail) {
+            ep->overruns++;
+            continue;
+        }
+
+        ep->ring[ep->head].sender_id = sender_id;
+        ep->ring[ep->head].msg_type = msg_type;
+        ep->ring[ep->head].len = len;
+        if (len > 0) {
+            memcpy(ep->ring[ep->head].data, data, len);
+        }
+        ep->head = next_head;
+        queued = true;
+    }
+
+    return queued;
+}
+
 ekk_error_t ekk_hal_send(ekk_module_id_t dest_id,
                           ekk_msg_type_t msg_type,
                           const void *data,
@@ -158,8 +255,14 @@ ekk_error_t ekk_hal_send(ekk_module_id_t dest_id,
     /* Add to queue */
     uint32_t state = ekk_hal_critical_enter();
 
+    if (g_endpoints != NULL && len <= EKK_HAL_ENDPOINT_MTU &&
+        endpoint_fanout(g_module_id, dest_id, msg_type, data, len)) {
+        rx_wake();
+    }
+
     uint32_t next_head = (g_msg_head + 1) % MSG_QUEUE_SIZE;
     if (next_head == g_msg_tail) {
+        g_msg_overruns++;
         ekk_hal_critical_exit(state);
         return EKK_ERR_NO_MEMORY;  /* Queue full */
     }
@@ -177,6 +280,8 @@ ekk_error_t ekk_hal_send(ekk_module_id_t dest_id,
 
     ekk_hal_critical_exit(state);
 
+    rx_wake();
+
     /* Call receive callback if registered (for loopback testing) */
     if (g_recv_callback != NULL && dest_id == g_module_id) {
         g_recv_callback(msg->sender_id, msg->msg_type, msg->data, msg->len);
@@ -231,11 +336,244 @@ ekk_error_t ekk_hal_recv(ekk_module_id_t *sender_id,
     return EKK_OK;
 }
 
+/*
+ * In-place receive. Senders only write the slot at head, so the slot at
+ * tail is stable until the consumer advances tail in release.
+ */
+ekk_error_t ekk_hal_recv_peek(ekk_hal_rx_view_t *view)
+{
+    if (view == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    uint32_t state = ekk_hal_critical_enter();
+
+    if (g_msg_tail == g_msg_head || !g_msg_queue[g_msg_tail].valid) {
+        ekk_hal_critical_exit(state);
+        return EKK_ERR_NOT_FOUND;
+    }
+
+    const hal_message_t *msg = &g_msg_queue[g_msg_tail];
+    view->sender_id = msg->sender_id;
+    view->msg_type = msg->msg_type;
+    view->data = msg->data;
+    view->len = msg->len;
+
+    ekk_hal_critical_exit(state);
+    return EKK_OK;
+}
+
+void ekk_hal_recv_release(void)
+{
+    uint32_t state = ekk_hal_critical_enter();
+
+    if (g_msg_tail != g_msg_head) {
+        g_msg_queue[g_msg_tail].valid = false;
+        g_msg_tail = (g_msg_tail + 1) % MSG_QUEUE_SIZE;
+    }
+
+    ekk_hal_critical_exit(state);
+}
+
+uint32_t ekk_hal_rx_depth(void)
+{
+    uint32_t state = ekk_hal_critical_enter();
+    uint32_t depth = (g_msg_head + MSG_QUEUE_SIZE - g_msg_tail) % MSG_QUEUE_SIZE;
+    ekk_hal_critical_exit(state);
+    return depth;
+}
+
+uint32_t ekk_hal_rx_overruns(void)
+{
+    return g_msg_overruns;
+}
+
 void ekk_hal_set_recv_callback(ekk_hal_recv_cb callback)
 {
     g_recv_callback = callback;
 }
 
+/* ============================================================================
+ * ENDPOINTS
+ * ============================================================================ */
+
+ekk_error_t ekk_hal_endpoint_open(ekk_hal_endpoint_t *ep, ekk_module_id_t id)
+{
+    if (ep == NULL || id == EKK_INVALID_MODULE_ID || id == EKK_BROADCAST_ID) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    memset(ep, 0, sizeof(*ep));
+    ep->id = id;
+
+    uint32_t state = ekk_hal_critical_enter();
+    ep->next = g_endpoints;
+    g_endpoints = ep;
+    ekk_hal_critical_exit(state);
+
+    return EKK_OK;
+}
+
+void ekk_hal_endpoint_close(ekk_hal_endpoint_t *ep)
+{
+    if (ep == NULL) {
+        return;
+    }
+
+    uint32_t state = ekk_hal_critical_enter();
+    for (ekk_hal_endpoint_t **link = &g_endpoints; *link != NULL; link = &(*link)->next) {
+        if (*link == ep) {
+            *link = ep->next;
+            break;
+        }
+    }
+    ep->next = NULL;
+    ep->tail = ep->head;
+    ekk_hal_critical_exit(state);
+}
+
+ekk_error_t ekk_hal_endpoint_send(ekk_hal_endpoint_t *ep,
+                                   ekk_module_id_t dest_id,
+                                   ekk_msg_type_t msg_type,
+                                   const void *data,
+                                   uint32_t len)
+{
+    if (ep == NULL || (data == NULL && len > 0) || len > EKK_HAL_ENDPOINT_MTU) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    uint32_t state = ekk_hal_critical_enter();
+    bool queued = endpoint_fanout(ep->id, dest_id, msg_type, data, len);
+    ekk_hal_critical_exit(state);
+
+    if (queued) {
+        rx_wake();
+    }
+    return EKK_OK;
+}
+
+/* As ekk_hal_recv_peek(): the slot at tail is stable until release */
+ekk_error_t ekk_hal_endpoint_peek(ekk_hal_endpoint_t *ep, ekk_hal_rx_view_t *view)
+{
+    if (ep == NULL || view == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    uint32_t state = ekk_hal_critical_enter();
+
+    if (ep->tail == ep->head) {
+        ekk_hal_critical_exit(state);
+        return EKK_ERR_NOT_FOUND;
+    }
+
+    view->sender_id = ep->ring[ep->tail].sender_id;
+    view->msg_type = ep->ring[ep->tail].msg_type;
+    view->data = ep->ring[ep->tail].data;
+    view->len = ep->ring[ep->tail].len;
+
+    ekk_hal_critical_exit(state);
+    return EKK_OK;
+}
+
+void ekk_hal_endpoint_release(ekk_hal_endpoint_t *ep)
+{
+    if (ep == NULL) {
+        return;
+    }
+
+    uint32_t state = ekk_hal_critical_enter();
+    if (ep->tail != ep->head) {
+        ep->tail = (ep->tail + 1) % EKK_HAL_ENDPOINT_DEPTH;
+    }
+    ekk_hal_critical_exit(state);
+}
+
+uint32_t ekk_hal_endpoint_depth(ekk_hal_endpoint_t *ep)
+{
+    if (ep == NULL) {
+        return 0;
+    }
+
+    uint32_t state = ekk_hal_critical_enter();
+    uint32_t depth = (ep->head + EKK_HAL_ENDPOINT_DEPTH - ep->tail) % EKK_HAL_ENDPOINT_DEPTH;
+    ekk_hal_critical_exit(state);
+    return depth;
+}
+
+/* ============================================================================
+ * EVENT WAIT
+ * ============================================================================ */
+
+static bool rx_pending(void)
+{
+    uint32_t state = ekk_hal_critical_enter();
+    bool pending = (g_msg_tail != g_msg_head);
+    for (const ekk_hal_endpoint_t *ep = g_endpoints; ep != NULL && !pending; ep = ep->next) {
+        pending = (ep->tail != ep->head);
+    }
+    ekk_hal_critical_exit(state);
+    return pending;
+}
+
+ekk_error_t ekk_hal_wait_event(ekk_time_us_t deadline)
+{
+    if (rx_pending()) {
+        return EKK_OK;
+    }
+
+    /* Simulated clock: nothing can arrive while we "sleep" */
+    if (g_mock_time_enabled) {
+        if (deadline > g_mock_time) {
+            g_mock_time = deadline;
+        }
+        return EKK_ERR_TIMEOUT;
+    }
+
+#ifdef _WIN32
+    ekk_time_us_t now = ekk_hal_time_us();
+    if (deadline > now) {
+        ekk_hal_delay_us((uint32_t)EKK_MIN(deadline - now, (ekk_time_us_t)UINT32_MAX));
+    }
+#else
+#ifdef __linux__
+    if (g_rx_eventfd >= 0) {
+        /* Announce before the re-check so a racing send signals the eventfd */
+        ekk_hal_atomic_inc(&g_rx_waiters);
+        for (;;) {
+            ekk_time_us_t now = ekk_hal_time_us();
+            if (rx_pending() || now >= deadline || deadline - now < 1000) {
+                break;
+            }
+            uint64_t ms = (deadline - now) / 1000;
+            struct pollfd pfd = { .fd = g_rx_eventfd, .events = POLLIN, .revents = 0 };
+            if (poll(&pfd, 1, (int)EKK_MIN(ms, (uint64_t)INT32_MAX)) > 0) {
+                uint64_t count;
+                ssize_t n = read(g_rx_eventfd, &count, sizeof(count));
+                EKK_UNUSED(n);
+            }
+        }
+        ekk_hal_atomic_dec(&g_rx_waiters);
+        if (rx_pending()) {
+            return EKK_OK;
+        }
+    }
+#endif
+    /* Remainder (or everything, without an eventfd) on the absolute clock */
+    struct timespec ts = g_start_time;
+    ts.tv_sec += (time_t)(deadline / 1000000);
+    ts.tv_nsec += (long)(deadline % 1000000) * 1000;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+        /* Retry */
+    }
+#endif
+
+    return rx_pending() ? EKK_OK : EKK_ERR_TIMEOUT;
+}
+
 /* ============================================================================
  * CRITICAL SECTIONS
  * ============================================================================ */
@@ -306,17 +644,319 @@ uint32_t ekk_hal_atomic_dec(volatile uint32_t *ptr)
  * ============================================================================ */
 
 /** Global field region (static allocation for POSIX) */
-static uint8_t g_field_region_storage[sizeof(ekk_field_region_t)];
+static ekk_field_region_t g_field_region_storage;
+
+/** Region in use: static storage, or the mapped segment */
+static ekk_field_region_t *g_field_region = &g_field_region_storage;
+
+#ifndef _WIN32
+
+#define SHM_MAGIC           0x464B4B45u     /* "EKKF" */
+#define SHM_VERSION         1u
+#define SHM_REGION_OFFSET   4096u           /* Region starts on its own page */
+#define SHM_ATTACH_SPINS    1000            /* x 1 ms waiting for the creator */
+
+/**
+ * @brief Header at the start of a shared field segment
+ *
+ * A process only attaches if magic, version and region geometry match,
+ * so builds with a different EKK_MAX_MODULES or layout cannot misread
+ * each other's slots.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t region_size;           /**< sizeof(ekk_field_region_t) */
+    uint32_t max_modules;           /**< EKK_MAX_MODULES */
+    uint32_t layout;                /**< EKK_FIELD_LAYOUT_SOA */
+    volatile uint32_t ready;        /**< Header fully initialized */
+    volatile uint32_t attached;     /**< Processes currently mapped */
+    volatile uint32_t notify_seq;   /**< Bumped by every field sync */
+    volatile uint32_t waiters;      /**< Processes blocked in ekk_hal_field_wait() */
+    struct timespec start_time;     /**< Common time base for timestamps */
+    pthread_mutex_t lock;           /**< Process-shared region bookkeeping lock */
+} hal_shm_header_t;
+
+EKK_STATIC_ASSERT(sizeof(hal_shm_header_t) <= SHM_REGION_OFFSET,
+                  "shm header must fit before the region");
+
+/** In-process notification state when no segment is mapped */
+static hal_shm_header_t g_local_header;
+
+static hal_shm_header_t *g_shm_header = NULL;
+static size_t g_shm_size = 0;
+static char g_shm_name[64];
+
+static hal_shm_header_t *notify_header(void)
+{
+    return g_shm_header != NULL ? g_shm_header : &g_local_header;
+}
+
+static ekk_error_t shm_init_header(hal_shm_header_t *hdr)
+{
+    pthread_mutexattr_t attr;
+
+    hdr->magic = SHM_MAGIC;
+    hdr->version = SHM_VERSION;
+    hdr->region_size = (uint32_t)sizeof(ekk_field_region_t);
+    hdr->max_modules = EKK_MAX_MODULES;
+    hdr->layout = EKK_FIELD_LAYOUT_SOA;
+    hdr->start_time = g_start_time;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+#ifdef __linux__
+    pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+#endif
+    int rc = pthread_mutex_init(&hdr->lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    if (rc != 0) {
+        return EKK_ERR_HAL_FAILURE;
+    }
+
+    /* Region bytes are zero from ftruncate: every slot empty, seq 0 */
+    ekk_hal_memory_barrier();
+    hdr->ready = 1;
+    return EKK_OK;
+}
+
+static ekk_error_t shm_check_header(const hal_shm_header_t *hdr)
+{
+    for (int i = 0; i < SHM_ATTACH_SPINS && !hdr->ready; i++) {
+        ekk_hal_delay_us(1000);
+    }
+    ekk_hal_memory_barrier();
+
+    if (!hdr->ready) {
+        return EKK_ERR_TIMEOUT;
+    }
+    if (hdr->magic != SHM_MAGIC || hdr->version != SHM_VERSION ||
+        hdr->region_size != sizeof(ekk_field_region_t) ||
+        hdr->max_modules != EKK_MAX_MODULES ||
+        hdr->layout != EKK_FIELD_LAYOUT_SOA) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    return EKK_OK;
+}
+
+ekk_error_t ekk_hal_field_shm_open(const char *name)
+{
+    if (name == NULL || name[0] != '/' || strlen(name) >= sizeof(g_shm_name)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    if (g_shm_header != NULL) {
+        return EKK_ERR_ALREADY_EXISTS;
+    }
+
+    ekk_hal_init();
+
+    size_t size = SHM_REGION_OFFSET + sizeof(ekk_field_region_t);
+    bool creator = true;
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        creator = false;
+        fd = shm_open(name, O_RDWR, 0600);
+    }
+    if (fd < 0) {
+        return EKK_ERR_HAL_FAILURE;
+    }
+
+    if (creator) {
+        if (ftruncate(fd, (off_t)size) != 0) {
+            close(fd);
+            shm_unlink(name);
+            return EKK_ERR_HAL_FAILURE;
+        }
+    } else {
+        /* Creator may not have sized the segment yet */
+        struct stat st;
+        int spins = 0;
+        while (fstat(fd, &st) == 0 && (size_t)st.st_size < size && spins++ < SHM_ATTACH_SPINS) {
+            ekk_hal_delay_us(1000);
+        }
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size != size) {
+            close(fd);
+            return EKK_ERR_INVALID_ARG;     /* Different geometry */
+        }
+    }
+
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        if (creator) {
+            shm_unlink(name);
+        }
+        return EKK_ERR_HAL_FAILURE;
+    }
+
+    hal_shm_header_t *hdr = (hal_shm_header_t *)base;
+    ekk_error_t err = creator ? shm_init_header(hdr) : shm_check_header(hdr);
+    if (err != EKK_OK) {
+        munmap(base, size);
+        if (creator) {
+            shm_unlink(name);
+        }
+        return err;
+    }
+
+    ekk_hal_atomic_inc(&hdr->attached);
+
+    /* Timestamps from every process share the creator's time base */
+    g_start_time = hdr->start_time;
+    g_shm_header = hdr;
+    g_shm_size = size;
+    strcpy(g_shm_name, name);
+    g_field_region = (ekk_field_region_t *)((uint8_t *)base + SHM_REGION_OFFSET);
+
+    return EKK_OK;
+}
+
+void ekk_hal_field_shm_close(bool unlink)
+{
+    if (g_shm_header == NULL) {
+        return;
+    }
+
+    ekk_hal_atomic_dec(&g_shm_header->attached);
+
+    g_field_region = &g_field_region_storage;
+    munmap(g_shm_header, g_shm_size);
+    g_shm_header = NULL;
+
+    if (unlink) {
+        shm_unlink(g_shm_name);
+    }
+}
+
+bool ekk_hal_field_region_shared(void)
+{
+    return g_shm_header != NULL;
+}
+
+uint32_t ekk_hal_field_notify_seq(void)
+{
+    return notify_header()->notify_seq;
+}
+
+uint32_t ekk_hal_field_wait(uint32_t seen, uint32_t timeout_us)
+{
+    hal_shm_header_t *hdr = notify_header();
+
+    uint32_t seq = hdr->notify_seq;
+    if (seq != seen || timeout_us == 0) {
+        return seq;
+    }
+
+    ekk_hal_atomic_inc(&hdr->waiters);
+#ifdef __linux__
+    struct timespec ts;
+    ts.tv_sec = timeout_us / 1000000u;
+    ts.tv_nsec = (long)(timeout_us % 1000000u) * 1000;
+    /* Shared futex (no FUTEX_PRIVATE_FLAG): wakes across processes */
+    syscall(SYS_futex, &hdr->notify_seq, FUTEX_WAIT, seen, &ts, NULL, 0);
+#else
+    for (uint32_t waited = 0; hdr->notify_seq == seen && waited < timeout_us; waited += 100) {
+        ekk_hal_delay_us(100);
+    }
+#endif
+    ekk_hal_atomic_dec(&hdr->waiters);
+
+    return hdr->notify_seq;
+}
+
+uint32_t ekk_hal_field_lock(void)
+{
+    if (g_shm_header == NULL) {
+        return ekk_hal_critical_enter();
+    }
+#ifdef __linux__
+    if (pthread_mutex_lock(&g_shm_header->lock) == EOWNERDEAD) {
+        /* Holder died inside slot allocation or gc; slot data is seqlocked */
+        pthread_mutex_consistent(&g_shm_header->lock);
+    }
+#else
+    pthread_mutex_lock(&g_shm_header->lock);
+#endif
+    return 1;
+}
+
+void ekk_hal_field_unlock(uint32_t state)
+{
+    if (state == 0) {
+        ekk_hal_critical_exit(state);
+        return;
+    }
+    pthread_mutex_unlock(&g_shm_header->lock);
+}
+
+static void field_notify(void)
+{
+    hal_shm_header_t *hdr = notify_header();
+
+    ekk_hal_atomic_inc(&hdr->notify_seq);
+#ifdef __linux__
+    /* Publishers skip the syscall unless someone is blocked */
+    if (hdr->waiters != 0) {
+        syscall(SYS_futex, &hdr->notify_seq, FUTEX_WAKE, INT32_MAX, NULL, NULL, 0);
+    }
+#endif
+}
+
+#else /* _WIN32 */
+
+ekk_error_t ekk_hal_field_shm_open(const char *name)
+{
+    EKK_UNUSED(name);
+    return EKK_ERR_NOT_SUPPORTED;
+}
+
+void ekk_hal_field_shm_close(bool unlink)
+{
+    EKK_UNUSED(unlink);
+}
+
+bool ekk_hal_field_region_shared(void)
+{
+    return false;
+}
+
+uint32_t ekk_hal_field_notify_seq(void)
+{
+    return 0;
+}
+
+uint32_t ekk_hal_field_wait(uint32_t seen, uint32_t timeout_us)
+{
+    ekk_hal_delay_us(timeout_us);
+    return seen;
+}
+
+uint32_t ekk_hal_field_lock(void)
+{
+    return ekk_hal_critical_enter();
+}
+
+void ekk_hal_field_unlock(uint32_t state)
+{
+    ekk_hal_critical_exit(state);
+}
+
+static void field_notify(void)
+{
+}
+
+#endif /* _WIN32 */
 
 void* ekk_hal_get_field_region(void)
 {
-    return g_field_region_storage;
+    return g_field_region;
 }
 
 void ekk_hal_sync_field_region(void)
 {
-    /* No-op for single-process simulation */
+    /* Seqlock writes must be visible before readers are woken */
     ekk_hal_memory_barrier();
+    field_notify();
 }
 
 /* ============================================================================
@@ -336,14 +976,20 @@ ekk_error_t ekk_hal_init(void)
 #else
     clock_gettime(CLOCK_MONOTONIC, &g_start_time);
 #endif
+#ifdef __linux__
+    if (g_rx_eventfd < 0) {
+        g_rx_eventfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    }
+#endif
 
     /* Clear message queue */
     memset(g_msg_queue, 0, sizeof(g_msg_queue));
     g_msg_head = 0;
     g_msg_tail = 0;
+    g_msg_overruns = 0;
 
     /* Clear field region */
-    memset(g_field_region_storage, 0, sizeof(g_field_region_storage));
+    memset(&g_field_region_storage, 0, sizeof(g_field_region_storage));
 
     g_hal_initialized = true;
     return EKK_OK;
@@ -51,10 +51,28 @@
 /* TIM2 (32-bit general-purpose timer) */
 #define TIM2_BASE               (APB1PERIPH_BASE + 0x0000UL)
 #define TIM2_CR1                (*(volatile uint32_t *)(TIM2_BASE + 0x00))
+#define TIM2_DIER               (*(volatile uint32_t *)(TIM2_BASE + 0x0C))
 #define TIM2_SR                 (*(volatile uint32_t *)(TIM2_BASE + 0x10))
 #define TIM2_CNT                (*(volatile uint32_t *)(TIM2_BASE + 0x24))
 #define TIM2_PSC                (*(volatile uint32_t *)(TIM2_BASE + 0x28))
 #define TIM2_ARR                (*(volatile uint32_t *)(TIM2_BASE + 0x2C))
+#define TIM2_CCR1               (*(volatile uint32_t *)(TIM2_BASE + 0x34))
+#define TIM_DIER_CC1IE          (1 << 1)
+#define TIM_SR_CC1IF            (1 << 1)
+
+/* Cortex-M4 system control (wake from WFE on pending interrupts) */
+#define SCB_SCR                 (*(volatile uint32_t *)0xE000ED10UL)
+#define SCB_SCR_SEVONPEND       (1 << 4)
+#define NVIC_ICPR0              (*(volatile uint32_t *)0xE000E280UL)
+#define TIM2_IRQN               28
+#define FDCAN1_IT0_IRQN         21
+
+/* Cortex-M4 cycle counter */
+#define COREDEBUG_DEMCR         (*(volatile uint32_t *)0xE000EDFCUL)
+#define COREDEBUG_DEMCR_TRCENA  (1 << 24)
+#define DWT_CTRL                (*(volatile uint32_t *)0xE0001000UL)
+#define DWT_CTRL_CYCCNTENA      (1 << 0)
+#define DWT_CYCCNT              (*(volatile uint32_t *)0xE0001004UL)
 
 /* USART2 (debug serial) */
 #define USART2_BASE             (APB1PERIPH_BASE + 0x4400UL)
@@ -117,6 +135,7 @@
 #define CAN_TSR_TME2            (1 << 28)  /* TX mailbox 2 empty */
 #define CAN_TSR_RQCP0           (1 << 0)   /* Request completed MB0 */
 #define CAN_RF0R_FMP0_MASK      (0x3)      /* FIFO 0 message pending */
+#define CAN_RF0R_FOVR0          (1 << 4)   /* FIFO 0 overrun (rc_w1) */
 #define CAN_RF0R_RFOM0          (1 << 5)   /* Release FIFO 0 output mailbox */
 #define CAN_TIxR_TXRQ           (1 << 0)   /* TX request */
 #define CAN_TIxR_IDE            (1 << 2)   /* Extended ID */
@@ -194,6 +213,9 @@ static volatile uint32_t g_msg_tail = 0;
 /* Receive callback */
 static ekk_hal_recv_cb g_recv_callback = NULL;
 
+/* Frames lost to a full hardware FIFO 0 (overrun events, see can_receive) */
+static volatile uint32_t g_rx_overruns = 0;
+
 /* Module ID (computed from UID) */
 static ekk_module_id_t g_module_id = 0;
 
@@ -240,6 +262,11 @@ static void timer_init(void) {
     TIM2_ARR = 0xFFFFFFFF;              /* Max count (32-bit) */
     TIM2_CNT = 0;                       /* Reset counter */
     TIM2_CR1 = 1;                       /* Enable timer */
+
+    /* DWT cycle counter for latency histograms */
+    COREDEBUG_DEMCR |= COREDEBUG_DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
 }
 
 ekk_time_us_t ekk_hal_time_us(void) {
@@ -253,6 +280,46 @@ void ekk_hal_delay_us(uint32_t us) {
     }
 }
 
+uint32_t ekk_hal_cycles(void) {
+    return DWT_CYCCNT;
+}
+
+uint32_t ekk_hal_cycles_to_ns(uint32_t cycles) {
+    return (uint32_t)((uint64_t)cycles * 1000000000ULL / SYSCLK_FREQ);
+}
+
+/**
+ * @brief Sleep until a CAN frame is pending or TIM2 reaches the deadline
+ *
+ * TIM2 channel 1 is armed as a compare at the deadline. With SEVONPEND,
+ * the compare and the FIFO 0 message-pending interrupt wake WFE by
+ * becoming pending, even though neither is enabled in the NVIC; their
+ * pending bits are cleared again before each re-check.
+ */
+ekk_error_t ekk_hal_wait_event(ekk_time_us_t deadline) {
+    uint32_t target = (uint32_t)deadline;
+
+    TIM2_CCR1 = target;
+    TIM2_SR = ~TIM_SR_CC1IF;
+    TIM2_DIER |= TIM_DIER_CC1IE;
+    SCB_SCR |= SCB_SCR_SEVONPEND;
+
+    for (;;) {
+        NVIC_ICPR0 = (1u << TIM2_IRQN) | (1u << FDCAN1_IT0_IRQN);
+        __DSB();
+        if ((CAN_RF0R & CAN_RF0R_FMP0_MASK) != 0 ||
+            (int32_t)(TIM2_CNT - target) >= 0) {
+            break;
+        }
+        __asm__ volatile("wfe");
+    }
+
+    TIM2_DIER &= ~TIM_DIER_CC1IE;
+    TIM2_SR = ~TIM_SR_CC1IF;
+
+    return ((CAN_RF0R & CAN_RF0R_FMP0_MASK) != 0) ? EKK_OK : EKK_ERR_TIMEOUT;
+}
+
 /* ============================================================================
  * SERIAL (DEBUG OUTPUT)
  * ============================================================================ */
@@ -420,6 +487,12 @@ static ekk_error_t can_receive(uint32_t *std_id, uint8_t *data, uint8_t *len) {
     /* Check if messages pending in FIFO 0 */
     uint32_t rf0r = CAN_RF0R;
     uint32_t fmp = rf0r & CAN_RF0R_FMP0_MASK;
+
+    /* The flag records that at least one frame was dropped since last cleared */
+    if (rf0r & CAN_RF0R_FOVR0) {
+        g_rx_overruns++;
+        CAN_RF0R = CAN_RF0R_FOVR0;
+    }
     if (fmp == 0) {
         return EKK_ERR_NOT_FOUND;
     }
@@ -533,48 +606,46 @@ static struct {
     bool active;
 } g_reassembly = {0};
 
+/* Frame handed out by ekk_hal_recv_peek() until ekk_hal_recv_release() */
+static struct {
+    uint32_t frame[2];          /* Single-frame payload, word aligned */
+    ekk_hal_rx_view_t view;
+    bool held;
+} g_rx_held = {0};
+
 /**
- * @brief Receive message from CAN bus
+ * @brief Pull CAN frames until a complete message is available
  *
- * Handles both single-frame and fragmented messages.
+ * Single frames are viewed in g_rx_held.frame, reassembled messages in
+ * g_reassembly.data; either stays valid until the next poll.
+ *
+ * @param[out] view Message header and payload pointer
+ * @return EKK_OK if a message is complete, EKK_ERR_NOT_FOUND if FIFO 0 ran dry
  */
-ekk_error_t ekk_hal_recv(ekk_module_id_t *sender_id,
-                          ekk_msg_type_t *msg_type,
-                          void *data,
-                          uint32_t *len) {
+static ekk_error_t can_poll(ekk_hal_rx_view_t *view) {
     uint32_t can_id;
-    uint8_t can_data[8];
+    uint8_t *can_data = (uint8_t *)g_rx_held.frame;
     uint8_t can_len;
 
-    /* Try to receive a CAN frame */
-    ekk_error_t err = can_receive(&can_id, can_data, &can_len);
-    if (err != EKK_OK) {
-        return err;
-    }
-
-    /* Decode CAN ID */
-    uint8_t rx_msg_type = CAN_ID_GET_TYPE(can_id);
-    uint8_t rx_sender = CAN_ID_GET_SENDER(can_id);
+    while (can_receive(&can_id, can_data, &can_len) == EKK_OK) {
+        /* Decode CAN ID */
+        uint8_t rx_msg_type = CAN_ID_GET_TYPE(can_id);
+        uint8_t rx_sender = CAN_ID_GET_SENDER(can_id);
 
 #if EKK_CAN_DEBUG
-    ekk_hal_printf("[CAN RX] type=%u sender=%u len=%u id=0x%03lX\n",
-                   rx_msg_type, rx_sender, can_len, (unsigned long)can_id);
+        ekk_hal_printf("[CAN RX] type=%u sender=%u len=%u id=0x%03lX\n",
+                       rx_msg_type, rx_sender, can_len, (unsigned long)can_id);
 #endif
 
-    /* Check if this is a fragmented message (first byte has fragment info) */
-    /* Heuristic: if len > 0 and first byte has high bit set or is 0x00/0x01,
-     * and message type suggests fragmentation, treat as fragment.
-     * For simplicity, only use fragmentation for DISCOVERY and PROPOSAL */
-    bool is_fragment = false;
-    if (can_len > 1 &&
-        (rx_msg_type == EKK_MSG_DISCOVERY || rx_msg_type == EKK_MSG_PROPOSAL)) {
-        uint8_t frag_info = can_data[0];
-        uint8_t frag_idx = frag_info & 0x7F;
-        bool more = (frag_info & 0x80) != 0;
-
-        /* Check if this looks like fragment header */
-        if (frag_idx < 16) {  /* Reasonable fragment index */
-            is_fragment = true;
+        /* Check if this is a fragmented message (first byte has fragment info) */
+        /* Heuristic: if len > 0 and first byte has high bit set or is 0x00/0x01,
+         * and message type suggests fragmentation, treat as fragment.
+         * For simplicity, only use fragmentation for DISCOVERY and PROPOSAL */
+        if (can_len > 1 &&
+            (rx_msg_type == EKK_MSG_DISCOVERY || rx_msg_type == EKK_MSG_PROPOSAL) &&
+            (can_data[0] & 0x7F) < 16) {    /* Reasonable fragment index */
+            uint8_t frag_idx = can_data[0] & 0x7F;
+            bool more = (can_data[0] & 0x80) != 0;
 
             if (frag_idx == 0) {
                 /* Start new reassembly */
@@ -601,39 +672,97 @@ ekk_error_t ekk_hal_recv(ekk_module_id_t *sender_id,
 
                 if (!more) {
                     /* Last fragment - deliver complete message */
-                    *sender_id = g_reassembly.sender_id;
-                    *msg_type = (ekk_msg_type_t)g_reassembly.msg_type;
-                    uint32_t copy_len = (*len < g_reassembly.len) ?
-                                        *len : g_reassembly.len;
-                    if (data) {
-                        memcpy(data, g_reassembly.data, copy_len);
-                    }
-                    *len = g_reassembly.len;
+                    view->sender_id = g_reassembly.sender_id;
+                    view->msg_type = (ekk_msg_type_t)g_reassembly.msg_type;
+                    view->data = g_reassembly.data;
+                    view->len = g_reassembly.len;
                     g_reassembly.active = false;
                     return EKK_OK;
                 }
-
-                /* More fragments coming - need to receive them */
-                return EKK_ERR_NOT_FOUND;
             }
+
+            /* More fragments coming (or out of sequence) */
+            continue;
         }
-    }
 
-    if (!is_fragment) {
         /* Single frame message */
-        *sender_id = rx_sender;
-        *msg_type = (ekk_msg_type_t)rx_msg_type;
-        uint32_t copy_len = (*len < can_len) ? *len : can_len;
-        if (data && copy_len > 0) {
-            memcpy(data, can_data, copy_len);
-        }
-        *len = can_len;
+        view->sender_id = rx_sender;
+        view->msg_type = (ekk_msg_type_t)rx_msg_type;
+        view->data = can_data;
+        view->len = can_len;
         return EKK_OK;
     }
 
     return EKK_ERR_NOT_FOUND;
 }
 
+/**
+ * @brief Look at the next complete message without a further copy
+ *
+ * CAN frames leave the hardware FIFO as they are read (reassembly needs
+ * that); the message then stays held until ekk_hal_recv_release().
+ */
+ekk_error_t ekk_hal_recv_peek(ekk_hal_rx_view_t *view) {
+    if (view == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (!g_rx_held.held) {
+        if (can_poll(&g_rx_held.view) != EKK_OK) {
+            return EKK_ERR_NOT_FOUND;
+        }
+        g_rx_held.held = true;
+    }
+
+    *view = g_rx_held.view;
+    return EKK_OK;
+}
+
+void ekk_hal_recv_release(void) {
+    g_rx_held.held = false;
+}
+
+/**
+ * @brief Frames pending in FIFO 0 (at most 3) plus a held message
+ *
+ * Fragments of one message count separately.
+ */
+uint32_t ekk_hal_rx_depth(void) {
+    return (CAN_RF0R & CAN_RF0R_FMP0_MASK) + (g_rx_held.held ? 1u : 0u);
+}
+
+uint32_t ekk_hal_rx_overruns(void) {
+    return g_rx_overruns;
+}
+
+/**
+ * @brief Receive message from CAN bus
+ *
+ * Handles both single-frame and fragmented messages.
+ */
+ekk_error_t ekk_hal_recv(ekk_module_id_t *sender_id,
+                          ekk_msg_type_t *msg_type,
+                          void *data,
+                          uint32_t *len) {
+    ekk_hal_rx_view_t view;
+
+    ekk_error_t err = ekk_hal_recv_peek(&view);
+    if (err != EKK_OK) {
+        return err;
+    }
+
+    *sender_id = view.sender_id;
+    *msg_type = view.msg_type;
+    uint32_t copy_len = (*len < view.len) ? *len : view.len;
+    if (data && copy_len > 0) {
+        memcpy(data, view.data, copy_len);
+    }
+    *len = view.len;
+
+    ekk_hal_recv_release();
+    return EKK_OK;
+}
+
 void ekk_hal_set_recv_callback(ekk_hal_recv_cb callback) {
     g_recv_callback = callback;
 }
@@ -772,6 +901,8 @@ ekk_error_t ekk_hal_init(void) {
 
     /* Initialize reassembly buffer */
     memset(&g_reassembly, 0, sizeof(g_reassembly));
+    g_rx_held.held = false;
+    g_rx_overruns = 0;
 
     /* Initialize CAN bus (bxCAN-style for Renode compatibility) */
     can_init();
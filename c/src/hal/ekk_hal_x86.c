@@ -138,6 +138,14 @@ void ekk_hal_delay_us(uint32_t us) {
     }
 }
 
+uint32_t ekk_hal_cycles(void) {
+    return (uint32_t)rdtsc();
+}
+
+uint32_t ekk_hal_cycles_to_ns(uint32_t cycles) {
+    return (uint32_t)((uint64_t)cycles * 1000ULL / g_tsc_freq_mhz);
+}
+
 /* Mock time support for testing (stub - not used on bare metal) */
 void ekk_hal_set_mock_time(ekk_time_us_t time_us) {
     (void)time_us;
@@ -156,13 +164,19 @@ typedef struct {
     volatile uint32_t valid;
 } hal_message_t;
 
-typedef struct {
+/* Head and tail on cache lines of their own (senders vs. owning core) */
+typedef struct EKK_CACHE_ALIGNED {
     hal_message_t slots[MSG_QUEUE_SIZE];
     volatile uint32_t head;
+    uint8_t _pad_head[EKK_CACHE_LINE_SIZE - sizeof(uint32_t)];
     volatile uint32_t tail;
-    uint8_t _pad[64 - 2 * sizeof(uint32_t)];  /* Cache line padding */
+    uint8_t _pad_tail[EKK_CACHE_LINE_SIZE - sizeof(uint32_t)];
 } core_queue_t;
 
+EKK_STATIC_ASSERT(EKK_CACHE_LINE_SIZE >= 64, "x86 has 64-byte cache lines");
+EKK_STATIC_ASSERT(EKK_X86_MSG_QUEUE_ADDR % EKK_CACHE_LINE_SIZE == 0,
+                  "message queues must start on a cache line");
+
 /* Message queues at fixed address */
 static core_queue_t *g_queues = (core_queue_t *)EKK_X86_MSG_QUEUE_ADDR;
 
@@ -316,6 +330,21 @@ ekk_error_t ekk_hal_recv(ekk_module_id_t *sender_id,
     return EKK_OK;
 }
 
+/**
+ * @brief Wait for a message or the deadline
+ *
+ * No timer interrupt is wired up on this port, so this spins on the
+ * TSC and this core's queue with PAUSE.
+ */
+ekk_error_t ekk_hal_wait_event(ekk_time_us_t deadline) {
+    core_queue_t *q = &g_queues[g_module_id - 1];
+
+    while (q->tail == q->head && ekk_hal_time_us() < deadline) {
+        __asm__ volatile("pause");
+    }
+    return (q->tail != q->head) ? EKK_OK : EKK_ERR_TIMEOUT;
+}
+
 void ekk_hal_set_recv_callback(ekk_hal_recv_cb callback) {
     g_recv_callback = callback;
 }
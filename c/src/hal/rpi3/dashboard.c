@@ -6,6 +6,7 @@
  * @license MIT
  */
 
+#include "ekk/ekk_types.h"
 #include "dashboard.h"
 #include "framebuffer.h"
 #include "timer.h"
@@ -35,13 +36,15 @@
  * State Variables
  * ============================================================================ */
 
-/* Core information */
-typedef struct {
+/* Core information (one cache line per core: each core bumps its own msg_count) */
+typedef struct EKK_CACHE_ALIGNED {
     core_state_t state;
     uint32_t load_pct;
     volatile uint32_t msg_count;
 } core_info_t;
 
+_Static_assert(sizeof(core_info_t) == EKK_CACHE_LINE_SIZE, "core_info_t must fill one cache line");
+
 static core_info_t g_cores[DASHBOARD_NUM_CORES];
 
 /* System statistics */
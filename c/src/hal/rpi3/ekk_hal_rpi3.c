@@ -89,6 +89,21 @@ void ekk_hal_delay_us(uint32_t us)
     timer_delay_us(us);
 }
 
+/**
+ * @brief Virtual counter (CNTVCT_EL0, 19.2 MHz), low 32 bits
+ */
+uint32_t ekk_hal_cycles(void)
+{
+    uint64_t count;
+    __asm__ volatile("isb; mrs %0, cntvct_el0" : "=r"(count) :: "memory");
+    return (uint32_t)count;
+}
+
+uint32_t ekk_hal_cycles_to_ns(uint32_t cycles)
+{
+    return (uint32_t)((uint64_t)cycles * 1000000000ULL / timer_get_frequency());
+}
+
 /**
  * @brief Set mock time for testing
  */
@@ -178,6 +193,51 @@ ekk_error_t ekk_hal_recv(ekk_module_id_t *sender_id,
     return EKK_OK;
 }
 
+/**
+ * @brief Look at the oldest received frame in place
+ */
+ekk_error_t ekk_hal_recv_peek(ekk_hal_rx_view_t *view)
+{
+    uint8_t s_id, m_type;
+
+    if (view == NULL) {
+        return EKK_ERR_INVALID_ARG;
+    }
+
+    if (msg_queue_peek(&s_id, &m_type, &view->data, &view->len) < 0) {
+        return EKK_ERR_NOT_FOUND;
+    }
+
+    view->sender_id = s_id;
+    view->msg_type = (ekk_msg_type_t)m_type;
+
+    return EKK_OK;
+}
+
+/**
+ * @brief Drop the frame returned by ekk_hal_recv_peek()
+ */
+void ekk_hal_recv_release(void)
+{
+    msg_queue_release();
+}
+
+/**
+ * @brief Frames waiting in this core's queue
+ */
+uint32_t ekk_hal_rx_depth(void)
+{
+    return msg_queue_count();
+}
+
+/**
+ * @brief Frames refused by this core's full queue
+ */
+uint32_t ekk_hal_rx_overruns(void)
+{
+    return msg_queue_overruns();
+}
+
 /**
  * @brief Register receive callback
  */
@@ -193,6 +253,32 @@ void ekk_hal_set_recv_callback(ekk_hal_recv_cb callback)
     }
 }
 
+/**
+ * @brief Sleep until a message is queued or the deadline passes
+ *
+ * Senders SEV after queueing; the generic timer event stream (see
+ * timer_init) ends each WFE within ~53 us to re-check the deadline.
+ */
+ekk_error_t ekk_hal_wait_event(ekk_time_us_t deadline)
+{
+    if (msg_queue_has_message()) {
+        return EKK_OK;
+    }
+
+    if (g_mock_time_enabled) {
+        if (deadline > g_mock_time) {
+            g_mock_time = deadline;
+        }
+        return EKK_ERR_TIMEOUT;
+    }
+
+    while (!msg_queue_has_message() && timer_get_us() < deadline) {
+        __asm__ volatile("wfe");
+    }
+
+    return msg_queue_has_message() ? EKK_OK : EKK_ERR_TIMEOUT;
+}
+
 /* ============================================================================
  * CRITICAL SECTIONS
  * ============================================================================ */
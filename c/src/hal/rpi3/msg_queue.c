@@ -16,6 +16,7 @@
  * - Messages are small (64 bytes max) to fit in cache lines
  */
 
+#include "ekk/ekk_types.h"
 #include "rpi3_hw.h"
 #include "msg_queue.h"
 #include "smp.h"
@@ -29,8 +30,8 @@
 #define MSG_MAX_LEN         64      /* Max payload size */
 #define MAX_CORES           4
 
-/* Cache line size for padding */
-#define CACHE_LINE_SIZE     64
+/* Region reserved for the queues by linker.ld */
+#define MSG_QUEUE_REGION    (256 * 1024)
 
 /* ============================================================================
  * Message Structure
@@ -51,14 +52,24 @@ _Static_assert(sizeof(msg_slot_t) <= 80, "msg_slot_t too large");
 /**
  * @brief Per-core message queue
  *
- * Aligned to cache line to avoid false sharing between cores.
+ * Head (written by senders) and tail (written by the owning core) each
+ * get a cache line of their own, and queues start on line boundaries,
+ * so neither index shares a line with the other or with a slot.
  */
-typedef struct {
+typedef struct EKK_CACHE_ALIGNED {
     msg_slot_t slots[MSG_QUEUE_SIZE];
     volatile uint32_t head;         /* Write index (producer only) */
+    volatile uint32_t overruns;     /* Sends refused because the queue was full */
+    uint8_t _pad_head[EKK_CACHE_LINE_SIZE - 2 * sizeof(uint32_t)];
     volatile uint32_t tail;         /* Read index (consumer only) */
-    uint32_t _pad[14];              /* Pad to multiple of cache line */
-} __attribute__((aligned(CACHE_LINE_SIZE))) core_queue_t;
+    uint8_t _pad_tail[EKK_CACHE_LINE_SIZE - sizeof(uint32_t)];
+} core_queue_t;
+
+_Static_assert(EKK_CACHE_LINE_SIZE >= 64, "Cortex-A53 has 64-byte cache lines");
+_Static_assert(sizeof(msg_slot_t) * MSG_QUEUE_SIZE % EKK_CACHE_LINE_SIZE == 0,
+               "head must start on its own cache line");
+_Static_assert(sizeof(core_queue_t) * MAX_CORES <= MSG_QUEUE_REGION,
+               "queues overflow the linker region");
 
 /* ============================================================================
  * External Symbols
@@ -143,6 +154,7 @@ int msg_queue_send(uint32_t dest_core, uint8_t sender_id,
 
     /* Check if queue is full */
     if (next_head == q->tail) {
+        q->overruns++;
         return -1;  /* Queue full */
     }
 
@@ -167,6 +179,9 @@ int msg_queue_send(uint32_t dest_core, uint8_t sender_id,
     /* Advance head */
     q->head = next_head;
 
+    /* Wake a receiver sleeping in WFE */
+    __asm__ volatile("dsb sy; sev" ::: "memory");
+
     return 0;
 }
 
@@ -237,6 +252,79 @@ int msg_queue_recv(uint8_t *sender_id, uint8_t *msg_type,
     return 0;
 }
 
+/**
+ * @brief Look at the oldest message in this core's queue without copying
+ *
+ * The slot stays owned by the consumer until msg_queue_release(); senders
+ * never write the slot at tail.
+ *
+ * @param[out] sender_id Sender's module ID
+ * @param[out] msg_type Message type
+ * @param[out] data Pointer to the payload in the slot
+ * @param[out] len Payload length
+ * @return 0 on success, -1 if no message
+ */
+int msg_queue_peek(uint8_t *sender_id, uint8_t *msg_type,
+                   const void **data, uint32_t *len)
+{
+    uint32_t core_id = smp_get_core_id();
+    core_queue_t *q = &g_queues[core_id];
+
+    uint32_t tail = q->tail;
+    if (tail == q->head) {
+        return -1;  /* No message */
+    }
+
+    msg_slot_t *slot = &q->slots[tail];
+
+    /* Memory barrier before reading */
+    __asm__ volatile("dmb sy" ::: "memory");
+
+    if (!slot->valid) {
+        return -1;  /* Message not ready yet */
+    }
+
+    if (sender_id) *sender_id = slot->sender_id;
+    if (msg_type) *msg_type = slot->msg_type;
+    if (data) *data = slot->data;
+    if (len) *len = slot->len;
+
+    return 0;
+}
+
+/**
+ * @brief Drop the message returned by msg_queue_peek()
+ */
+void msg_queue_release(void)
+{
+    uint32_t core_id = smp_get_core_id();
+    core_queue_t *q = &g_queues[core_id];
+
+    uint32_t tail = q->tail;
+    if (tail == q->head) {
+        return;
+    }
+
+    /* Reads of the slot complete before it is handed back */
+    __asm__ volatile("dmb sy" ::: "memory");
+
+    q->slots[tail].valid = 0;
+
+    __asm__ volatile("dmb sy" ::: "memory");
+
+    q->tail = (tail + 1) % MSG_QUEUE_SIZE;
+}
+
+/**
+ * @brief Get number of sends refused by this core's full queue
+ * @return Overrun count since msg_queue_init()
+ */
+uint32_t msg_queue_overruns(void)
+{
+    uint32_t core_id = smp_get_core_id();
+    return g_queues[core_id].overruns;
+}
+
 /**
  * @brief Check if this core's queue has messages
  * @return Non-zero if messages available
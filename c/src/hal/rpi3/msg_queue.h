@@ -52,6 +52,29 @@ int msg_queue_send(uint32_t dest_core, uint8_t sender_id,
 int msg_queue_recv(uint8_t *sender_id, uint8_t *msg_type,
                    void *data, uint32_t *len);
 
+/**
+ * @brief Look at the oldest message in this core's queue without copying
+ *
+ * @param[out] sender_id Sender's module ID
+ * @param[out] msg_type Message type
+ * @param[out] data Pointer to the payload (valid until msg_queue_release)
+ * @param[out] len Payload length
+ * @return 0 on success, -1 if no message
+ */
+int msg_queue_peek(uint8_t *sender_id, uint8_t *msg_type,
+                   const void **data, uint32_t *len);
+
+/**
+ * @brief Drop the message returned by msg_queue_peek()
+ */
+void msg_queue_release(void);
+
+/**
+ * @brief Get number of sends refused by this core's full queue
+ * @return Overrun count
+ */
+uint32_t msg_queue_overruns(void);
+
 /**
  * @brief Check if this core's queue has messages
  * @return Non-zero if messages available
@@ -46,6 +46,9 @@ void timer_init(void)
     __asm__ volatile("mrs %0, cntkctl_el1" : "=r"(cntkctl));
     cntkctl |= (1 << 0);            /* EL0PCTEN: Enable physical counter at EL0 */
     cntkctl |= (1 << 1);            /* EL0VCTEN: Enable virtual counter at EL0 */
+    /* Event stream on counter bit 9 (~53 us at 19.2 MHz): bounds every WFE */
+    cntkctl &= ~(0xFUL << 4);
+    cntkctl |= (9UL << 4) | (1 << 2);   /* EVNTI = 9, EVNTEN */
     __asm__ volatile("msr cntkctl_el1, %0" :: "r"(cntkctl));
 
     /* Read base time */
@@ -281,6 +281,13 @@ extern "C" {
 #define SCB_AIRCR_VECTKEY           (0x05FA << 16)
 #define SCB_AIRCR_SYSRESETREQ       (1UL << 2)
 
+/* DWT cycle counter */
+#define COREDEBUG_DEMCR             (*(volatile uint32_t *)0xE000EDFCUL)
+#define COREDEBUG_DEMCR_TRCENA      (1UL << 24)
+#define DWT_CTRL                    (*(volatile uint32_t *)0xE0001000UL)
+#define DWT_CTRL_CYCCNTENA          (1UL << 0)
+#define DWT_CYCCNT                  (*(volatile uint32_t *)0xE0001004UL)
+
 /* FPU (Cortex-M33) */
 #define FPU_CPACR                   (*(volatile uint32_t *)0xE000ED88UL)
 #define FPU_FPCCR                   (*(volatile uint32_t *)0xE000EF34UL)
@@ -130,6 +130,11 @@ static void timer_init(void) {
     __DSB();
 
     TIMER0_CMD = TIMER_CMD_START;
+
+    /* DWT cycle counter for latency histograms */
+    COREDEBUG_DEMCR |= COREDEBUG_DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
 }
 
 ekk_time_us_t ekk_hal_time_us(void) {
@@ -168,6 +173,15 @@ void ekk_hal_delay_us(uint32_t us) {
     }
 }
 
+uint32_t ekk_hal_cycles(void) {
+    return DWT_CYCCNT;
+}
+
+uint32_t ekk_hal_cycles_to_ns(uint32_t cycles) {
+    /* 78 MHz core clock */
+    return (uint32_t)((uint64_t)cycles * 1000ULL / 78ULL);
+}
+
 /* Mock time support for testing */
 static ekk_time_us_t g_mock_time = 0;
 static bool g_mock_time_enabled = false;
@@ -449,6 +463,21 @@ ekk_error_t ekk_hal_recv(ekk_module_id_t *sender_id,
     return EKK_ERR_NOT_FOUND;  /* Need more data */
 }
 
+/**
+ * @brief Wait for queued or incoming serial data, or the deadline
+ *
+ * Reception is polled on this port, so this spins on TIMER0 and the
+ * EUSART RX FIFO level.
+ */
+ekk_error_t ekk_hal_wait_event(ekk_time_us_t deadline) {
+    while (g_msg_head == g_msg_tail && !(EUSART0_STATUS & EUSART_STATUS_RXFL)) {
+        if (ekk_hal_time_us() >= deadline) {
+            return EKK_ERR_TIMEOUT;
+        }
+    }
+    return EKK_OK;
+}
+
 void ekk_hal_set_recv_callback(ekk_hal_recv_cb callback) {
     g_recv_callback = callback;
 }
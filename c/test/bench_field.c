@@ -0,0 +1,341 @@
+/**
+ * @file bench_field.c
+ * @brief EK-KOR v2 - Field Region Layout Benchmark
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ * @license MIT
+ *
+ * Built once per layout (bench_field_aos_N / bench_field_soa_N) from the
+ * same sources, so the numbers are directly comparable. Measures:
+ * - raw scan of one component across the region
+ * - decayed single-component sample across all modules
+ * - full field sample across all modules
+ * - bulk snapshot of the region
+ * - gc with nothing due
+ * - publish across all modules
+ * - k-neighbor aggregation, full and incremental
+ * - change tracking with many readers, one of them slow
+ */
+
+#include "ekk/ekk_field.h"
+#include "ekk/ekk_hal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/* ============================================================================
+ * Test Configuration
+ * ============================================================================ */
+
+#define ROUNDS          2000
+#define WARMUP_ROUNDS   100
+
+#if EKK_FIELD_LAYOUT_SOA
+#define LAYOUT_NAME     "SoA"
+#else
+#define LAYOUT_NAME     "AoS"
+#endif
+
+/* Module IDs are 1..SLOTS-1 (0 is invalid) */
+#define SLOTS           EKK_MAX_MODULES
+
+static ekk_field_region_t g_region;
+
+/* ============================================================================
+ * Timing Helpers
+ * ============================================================================ */
+
+static uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void report(const char *name, uint64_t elapsed_ns, uint64_t ops) {
+    printf("%-28s %8.2f ns/op  (%llu ops)\n", name,
+           (double)elapsed_ns / (double)ops, (unsigned long long)ops);
+}
+
+/* Defeat dead-code elimination */
+static volatile int64_t g_sink;
+
+/* ============================================================================
+ * Benchmark Functions
+ * ============================================================================ */
+
+static void populate(void) {
+    ekk_field_t f;
+    memset(&f, 0, sizeof(f));
+
+    for (uint32_t id = 1; id < SLOTS; id++) {
+        for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+            f.components[c] = (ekk_fixed_t)((id * 37u + (uint32_t)c * 11u) << 8);
+        }
+        ekk_field_publish((ekk_module_id_t)id, &f);
+    }
+}
+
+static void bench_raw_scan(void) {
+    int64_t acc = 0;
+
+    for (int r = 0; r < WARMUP_ROUNDS; r++) {
+        for (uint32_t id = 1; id < SLOTS; id++) {
+            acc += ekk_field_region_component(&g_region, id, EKK_FIELD_SLACK);
+        }
+    }
+
+    uint64_t t0 = get_time_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (uint32_t id = 1; id < SLOTS; id++) {
+            acc += ekk_field_region_component(&g_region, id, EKK_FIELD_SLACK);
+        }
+    }
+    uint64_t t1 = get_time_ns();
+
+    g_sink = acc;
+    report("raw component scan", t1 - t0, (uint64_t)ROUNDS * (SLOTS - 1));
+}
+
+static void bench_sample_component(void) {
+    int64_t acc = 0;
+    ekk_fixed_t v;
+
+    uint64_t t0 = get_time_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (uint32_t id = 1; id < SLOTS; id++) {
+            if (ekk_field_sample_component((ekk_module_id_t)id,
+                                           EKK_FIELD_SLACK, &v) == EKK_OK) {
+                acc += v;
+            }
+        }
+    }
+    uint64_t t1 = get_time_ns();
+
+    g_sink = acc;
+    report("sample_component(SLACK)", t1 - t0, (uint64_t)ROUNDS * (SLOTS - 1));
+}
+
+static void bench_sample_full(void) {
+    int64_t acc = 0;
+    ekk_field_t f;
+
+    uint64_t t0 = get_time_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (uint32_t id = 1; id < SLOTS; id++) {
+            if (ekk_field_sample((ekk_module_id_t)id, &f) == EKK_OK) {
+                acc += f.components[EKK_FIELD_SLACK];
+            }
+        }
+    }
+    uint64_t t1 = get_time_ns();
+
+    g_sink = acc;
+    report("sample (full field)", t1 - t0, (uint64_t)ROUNDS * (SLOTS - 1));
+}
+
+static void bench_snapshot(void) {
+    static ekk_field_snapshot_entry_t entries[SLOTS];
+    uint32_t count = 0;
+    int64_t acc = 0;
+
+    uint64_t t0 = get_time_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        ekk_field_snapshot(entries, SLOTS, &count);
+        acc += entries[count / 2].field.components[EKK_FIELD_SLACK];
+    }
+    uint64_t t1 = get_time_ns();
+
+    g_sink = acc;
+    report("snapshot (per slot)", t1 - t0, (uint64_t)ROUNDS * (SLOTS - 1));
+}
+
+static void bench_gc(void) {
+    uint32_t expired = 0;
+
+    /* Steady state: every slot fresh, so nothing is due */
+    uint64_t t0 = get_time_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        expired += ekk_field_gc(EKK_FIELD_DECAY_TAU_US * 5);
+    }
+    uint64_t t1 = get_time_ns();
+
+    g_sink = expired;
+    report("gc (nothing due)", t1 - t0, (uint64_t)ROUNDS);
+}
+
+static void bench_publish(void) {
+    ekk_field_t f;
+    memset(&f, 0, sizeof(f));
+
+    uint64_t t0 = get_time_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        f.components[EKK_FIELD_LOAD] = r;
+        for (uint32_t id = 1; id < SLOTS; id++) {
+            ekk_field_publish((ekk_module_id_t)id, &f);
+        }
+    }
+    uint64_t t1 = get_time_ns();
+
+    report("publish", t1 - t0, (uint64_t)ROUNDS * (SLOTS - 1));
+}
+
+static void bench_aggregate(void) {
+    ekk_neighbor_t neighbors[EKK_K_NEIGHBORS];
+    ekk_field_t agg;
+    int64_t acc = 0;
+
+    memset(neighbors, 0, sizeof(neighbors));
+
+    uint64_t t0 = get_time_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (uint32_t id = 1; id < SLOTS; id++) {
+            /* Neighbors spread across the region, as after reelection */
+            for (int k = 0; k < EKK_K_NEIGHBORS; k++) {
+                neighbors[k].id = (ekk_module_id_t)(1 + (id * 13u + (uint32_t)k * 31u) % (SLOTS - 1));
+                neighbors[k].health = EKK_HEALTH_ALIVE;
+            }
+            ekk_field_sample_neighbors((ekk_module_id_t)id, neighbors,
+                                       EKK_K_NEIGHBORS, &agg);
+            acc += agg.components[EKK_FIELD_LOAD];
+        }
+    }
+    uint64_t t1 = get_time_ns();
+
+    g_sink = acc;
+    report("sample_neighbors (k)", t1 - t0, (uint64_t)ROUNDS * (SLOTS - 1));
+}
+
+static void bench_incremental(void) {
+    /* One module's view: 1 ms ticks, neighbors republish every 10 ms */
+    ekk_neighbor_t neighbors[EKK_K_NEIGHBORS];
+    ekk_field_aggregator_t agg;
+    ekk_field_t f, out;
+    uint64_t full_ns = 0, inc_ns = 0;
+    int64_t acc = 0;
+    ekk_time_us_t now = 2000000;
+
+    memset(neighbors, 0, sizeof(neighbors));
+    memset(&f, 0, sizeof(f));
+    for (int k = 0; k < EKK_K_NEIGHBORS; k++) {
+        neighbors[k].id = (ekk_module_id_t)(1 + k * 3);
+        neighbors[k].health = EKK_HEALTH_ALIVE;
+    }
+    ekk_field_aggregator_init(&agg, EKK_FIELD_AGG_TOLERANCE);
+
+    for (int tick = 0; tick < ROUNDS * 10; tick++) {
+        ekk_hal_set_mock_time(now);
+        for (int k = 0; k < EKK_K_NEIGHBORS; k++) {
+            if ((tick + k) % 10 == 0) {
+                f.components[EKK_FIELD_LOAD] = (ekk_fixed_t)((tick * 7 + k * 13) % EKK_FIXED_ONE);
+                ekk_field_publish(neighbors[k].id, &f);
+            }
+        }
+
+        uint64_t t0 = get_time_ns();
+        ekk_field_sample_neighbors(1, neighbors, EKK_K_NEIGHBORS, &out);
+        uint64_t t1 = get_time_ns();
+        acc += out.components[EKK_FIELD_LOAD];
+        ekk_field_aggregate_update(&agg, neighbors, EKK_K_NEIGHBORS, &out, NULL);
+        uint64_t t2 = get_time_ns();
+        acc += out.components[EKK_FIELD_LOAD];
+
+        full_ns += t1 - t0;
+        inc_ns += t2 - t1;
+        now += 1000;
+    }
+
+    g_sink = acc;
+    report("tick: sample_neighbors", full_ns, (uint64_t)ROUNDS * 10);
+    report("tick: aggregate_update", inc_ns, (uint64_t)ROUNDS * 10);
+    printf("%-28s %8.1f %%\n", "  neighbors skipped",
+           100.0 * agg.skipped / (double)(agg.skipped + agg.evaluated));
+}
+
+static void bench_changes(uint32_t readers) {
+    /* Every reader polls each 1 ms tick, one more every SLOW_EVERY ticks;
+     * each module republishes every 10 ms */
+    enum { TICKS = 320, SLOW_EVERY = 32 };
+    static ekk_field_cursor_t cursors[SLOTS];
+    static ekk_field_cursor_t slow;
+    uint32_t changed[EKK_FIELD_FLAG_WORDS];
+    uint64_t ns = 0, calls = 0, reported = 0;
+    uint64_t slow_calls = 0, slow_reported = 0, slow_resyncs = 0;
+    ekk_field_t f;
+    char name[40];
+
+    memset(cursors, 0, sizeof(cursors));
+    memset(&slow, 0, sizeof(slow));
+    memset(&f, 0, sizeof(f));
+    for (uint32_t r = 0; r < readers; r++) {
+        ekk_field_changes_since(&cursors[r], changed);
+    }
+    ekk_field_changes_since(&slow, changed);
+
+    for (uint32_t tick = 1; tick <= TICKS; tick++) {
+        f.components[EKK_FIELD_LOAD] = (ekk_fixed_t)tick;
+        for (uint32_t id = 1 + tick % 10; id < SLOTS; id += 10) {
+            ekk_field_publish((ekk_module_id_t)id, &f);
+        }
+
+        uint64_t t0 = get_time_ns();
+        for (uint32_t r = 0; r < readers; r++) {
+            reported += ekk_field_changes_since(&cursors[r], changed);
+        }
+        ns += get_time_ns() - t0;
+        calls += readers;
+
+        if (tick % SLOW_EVERY == 0) {
+            uint32_t n = ekk_field_changes_since(&slow, changed);
+            slow_calls++;
+            slow_reported += n;
+            slow_resyncs += (n == EKK_MAX_MODULES);
+        }
+    }
+
+    snprintf(name, sizeof(name), "changes_since (%u readers)", (unsigned)readers);
+    report(name, ns, calls);
+    printf("%-28s %8.1f modules/call\n", "  reported", (double)reported / (double)calls);
+    printf("%-28s %8.1f modules/call, %llu/%llu full resyncs\n", "  slow reader",
+           (double)slow_reported / (double)slow_calls,
+           (unsigned long long)slow_resyncs, (unsigned long long)slow_calls);
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(void) {
+    printf("EK-KOR v2 Field Region Benchmark\n");
+    printf("================================\n");
+    printf("Layout: %s, modules: %d, k: %d, kernel: %s\n",
+           LAYOUT_NAME, EKK_MAX_MODULES, EKK_K_NEIGHBORS, ekk_field_kernel_name());
+    printf("Region size: %zu bytes\n\n", sizeof(ekk_field_region_t));
+
+    /* Frozen clock: nothing expires, decay cost is constant */
+    ekk_hal_set_mock_time(1000000);
+
+    if (ekk_field_init(&g_region) != EKK_OK) {
+        printf("FAIL: Could not initialize field region\n");
+        return 1;
+    }
+    populate();
+
+    ekk_hal_set_mock_time(1000000 + EKK_FIELD_DECAY_TAU_US / 2);
+
+    bench_raw_scan();
+    bench_sample_component();
+    bench_sample_full();
+    bench_snapshot();
+    bench_gc();
+    bench_publish();
+    bench_aggregate();
+    bench_incremental();
+    bench_changes(8);
+    bench_changes(SLOTS - 1);
+
+    printf("\n=== Benchmark Complete ===\n");
+    return 0;
+}
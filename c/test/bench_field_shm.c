@@ -0,0 +1,173 @@
+/**
+ * @file bench_field_shm.c
+ * @brief EK-KOR v2 - Multi-Process Shared Field Region Load Test
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ * @license MIT
+ *
+ * Forks N module processes onto one shm_open/mmap field region. Each
+ * process publishes its own slot as fast as it can and snapshots the
+ * whole region in between, checking every copied slot for torn data
+ * (a writer stores the same value in all components). Exercises the
+ * seqlock path across cores the way the SMP targets run it. Fails on
+ * any torn read, or when more than MAX_BUSY_PERMILLE of the snapshots
+ * had to skip a slot (readers starved by writers or by the region lock).
+ * The BUSY limit only applies with a CPU per process: a writer descheduled
+ * mid-publish leaves its slot odd for a whole time slice.
+ *
+ * Usage: bench_field_shm [processes] [seconds]
+ */
+
+#include "ekk/ekk.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+/* ============================================================================
+ * Test Configuration
+ * ============================================================================ */
+
+#define DEFAULT_PROCESSES   8
+#define DEFAULT_SECONDS     2
+#define MAX_BUSY_PERMILLE   10      /* Snapshots allowed to return EKK_ERR_BUSY */
+
+/** Per-process results, in an anonymous shared mapping */
+typedef struct {
+    uint64_t publishes;
+    uint64_t snapshots;
+    uint64_t slots_read;
+    uint64_t busy;
+    uint64_t torn;
+} worker_stats_t;
+
+/* ============================================================================
+ * Timing Helpers
+ * ============================================================================ */
+
+static uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* ============================================================================
+ * Worker
+ * ============================================================================ */
+
+static void run_worker(ekk_module_id_t id, uint64_t deadline_ns, worker_stats_t *stats) {
+    static ekk_field_snapshot_entry_t entries[EKK_MAX_MODULES];
+    ekk_field_t f;
+    uint32_t count;
+
+    memset(&f, 0, sizeof(f));
+
+    for (int32_t v = 1; get_time_ns() < deadline_ns; v++) {
+        for (int c = 0; c < EKK_FIELD_COUNT; c++) {
+            f.components[c] = v;
+        }
+        ekk_field_publish(id, &f);
+        stats->publishes++;
+
+        if (ekk_field_snapshot(entries, EKK_MAX_MODULES, &count) == EKK_ERR_BUSY) {
+            stats->busy++;
+        }
+        stats->snapshots++;
+        stats->slots_read += count;
+
+        for (uint32_t i = 0; i < count; i++) {
+            for (int c = 1; c < EKK_FIELD_COUNT; c++) {
+                if (entries[i].field.components[c] != entries[i].field.components[0]) {
+                    stats->torn++;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(int argc, char **argv) {
+    int processes = argc > 1 ? atoi(argv[1]) : DEFAULT_PROCESSES;
+    int seconds = argc > 2 ? atoi(argv[2]) : DEFAULT_SECONDS;
+    char name[32];
+
+    if (processes < 1 || processes >= EKK_MAX_MODULES || seconds < 1) {
+        printf("usage: %s [processes 1..%d] [seconds]\n", argv[0], EKK_MAX_MODULES - 1);
+        return 1;
+    }
+
+    printf("EK-KOR v2 Shared Field Region Load Test\n");
+    printf("=======================================\n");
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    bool busy_gate = cpus >= processes;
+    printf("Processes: %d, duration: %d s, region: %zu bytes, CPUs: %ld%s\n\n",
+           processes, seconds, sizeof(ekk_field_region_t), cpus,
+           busy_gate ? "" : " (fewer than processes, BUSY rate not checked)");
+
+    snprintf(name, sizeof(name), "/ekk-bench-%d", (int)getpid());
+    if (ekk_hal_field_shm_open(name) != EKK_OK || ekk_init() != EKK_OK) {
+        printf("FAIL: Could not map shared field region\n");
+        return 1;
+    }
+
+    worker_stats_t *stats = mmap(NULL, sizeof(worker_stats_t) * (size_t)processes,
+                                 PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (stats == MAP_FAILED) {
+        ekk_hal_field_shm_close(true);
+        return 1;
+    }
+    memset(stats, 0, sizeof(worker_stats_t) * (size_t)processes);
+
+    uint64_t deadline = get_time_ns() + (uint64_t)seconds * 1000000000ULL;
+    for (int p = 0; p < processes; p++) {
+        if (fork() == 0) {
+            run_worker((ekk_module_id_t)(p + 1), deadline, &stats[p]);
+            _exit(0);
+        }
+    }
+    for (int p = 0; p < processes; p++) {
+        wait(NULL);
+    }
+
+    worker_stats_t total;
+    memset(&total, 0, sizeof(total));
+    for (int p = 0; p < processes; p++) {
+        total.publishes += stats[p].publishes;
+        total.snapshots += stats[p].snapshots;
+        total.slots_read += stats[p].slots_read;
+        total.busy += stats[p].busy;
+        total.torn += stats[p].torn;
+    }
+
+    printf("%-28s %12.0f /s\n", "publishes", (double)total.publishes / seconds);
+    printf("%-28s %12.0f /s\n", "snapshots", (double)total.snapshots / seconds);
+    printf("%-28s %12.0f /s\n", "slots copied", (double)total.slots_read / seconds);
+    printf("%-28s %12llu (%.2f %%)\n", "snapshots with skipped slot",
+           (unsigned long long)total.busy,
+           total.snapshots ? 100.0 * (double)total.busy / (double)total.snapshots : 0.0);
+    printf("%-28s %12llu\n", "torn slots", (unsigned long long)total.torn);
+
+    munmap(stats, sizeof(worker_stats_t) * (size_t)processes);
+    ekk_hal_field_shm_close(true);
+
+    if (total.torn != 0) {
+        printf("\nFAIL: torn reads got past the seqlock\n");
+        return 1;
+    }
+    if (busy_gate && total.busy * 1000 > total.snapshots * MAX_BUSY_PERMILLE) {
+        printf("\nFAIL: more than %d.%d %% of snapshots skipped a busy slot\n",
+               MAX_BUSY_PERMILLE / 10, MAX_BUSY_PERMILLE % 10);
+        return 1;
+    }
+    printf("\n=== Load Test Complete ===\n");
+    return 0;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file bench_heartbeat.c
+ * @brief EK-KOR v2 - Heartbeat Tick Benchmark
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ * @license MIT
+ *
+ * A gateway tracking a full cluster: every peer heartbeats once per
+ * period, staggered across the period, and the engine is ticked every
+ * millisecond. Most ticks find no state change, which is the case the
+ * timeout bookkeeping has to make cheap.
+ */
+
+#include "ekk/ekk_heartbeat.h"
+#include "ekk/ekk_hal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/* ============================================================================
+ * Test Configuration
+ * ============================================================================ */
+
+#define PEERS           (EKK_MAX_MODULES - 2)
+#define TICK_US         1000
+#define PERIODS         200
+
+static ekk_heartbeat_t g_hb;
+
+/* ============================================================================
+ * Timing Helpers
+ * ============================================================================ */
+
+static uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void report(const char *name, uint64_t sum_ns, uint64_t max_ns, uint64_t ops) {
+    printf("%-28s avg %8.2f ns  max %8llu ns  (%llu ops)\n", name,
+           (double)sum_ns / (double)ops, (unsigned long long)max_ns,
+           (unsigned long long)ops);
+}
+
+/* ============================================================================
+ * Benchmark Functions
+ * ============================================================================ */
+
+static void bench_mode(const char *label, bool phi_accrual)
+{
+    ekk_heartbeat_config_t config = EKK_HEARTBEAT_CONFIG_DEFAULT;
+    config.auto_broadcast = false;
+    config.phi_accrual = phi_accrual;
+    ekk_heartbeat_init(&g_hb, 1, &config);
+
+    for (uint32_t i = 0; i < PEERS; i++) {
+        ekk_heartbeat_add_neighbor(&g_hb, (ekk_module_id_t)(i + 2));
+    }
+
+    const ekk_time_us_t period = config.period;
+    const uint32_t ticks_per_period = (uint32_t)(period / TICK_US);
+    ekk_time_us_t now = 1000000;
+    uint64_t tick_sum = 0, tick_max = 0, rx_sum = 0, rx_max = 0;
+    uint64_t ticks = 0, rx = 0;
+
+    for (uint32_t p = 0; p < PERIODS; p++) {
+        for (uint32_t t = 0; t < ticks_per_period; t++) {
+            now += TICK_US;
+
+            /* Peers whose stagger slot falls in this tick */
+            for (uint32_t i = t; i < PEERS; i += ticks_per_period) {
+                uint64_t t0 = get_time_ns();
+                ekk_heartbeat_received(&g_hb, (ekk_module_id_t)(i + 2), (uint8_t)p, now);
+                uint64_t dt = get_time_ns() - t0;
+                rx_sum += dt;
+                if (dt > rx_max) rx_max = dt;
+                rx++;
+            }
+
+            uint64_t t0 = get_time_ns();
+            ekk_heartbeat_tick(&g_hb, now);
+            uint64_t dt = get_time_ns() - t0;
+            tick_sum += dt;
+            if (dt > tick_max) tick_max = dt;
+            ticks++;
+        }
+    }
+
+    char name[64];
+    snprintf(name, sizeof(name), "%s: tick", label);
+    report(name, tick_sum, tick_max, ticks);
+    snprintf(name, sizeof(name), "%s: received", label);
+    report(name, rx_sum, rx_max, rx);
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(void)
+{
+    printf("=== Heartbeat Tick Benchmark (%d peers, %d us tick) ===\n\n",
+           PEERS, TICK_US);
+
+    bench_mode("missed-count", false);
+    bench_mode("phi-accrual", true);
+
+    printf("\n=== Benchmark Complete ===\n");
+    return 0;
+}
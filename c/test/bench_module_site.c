@@ -0,0 +1,229 @@
+/**
+ * @file bench_module_site.c
+ * @brief EK-KOR v2 - Multi-Instance Site Simulation Benchmark
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ * @license MIT
+ *
+ * Runs a rack of modules in one process, ticked from a pool of worker
+ * threads. Between rounds the host drains the loopback HAL and fans each
+ * frame out to every module (poll_hal_rx is off), the way a gateway-side
+ * digital twin routes CAN traffic. Reports module ticks per second for a
+ * single worker and for the pool, so per-instance state regressions
+ * (shared globals, false sharing) show up as lost scaling.
+ *
+ * Usage: bench_module_site [threads]
+ */
+
+#include "ekk/ekk.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/* ============================================================================
+ * Test Configuration
+ * ============================================================================ */
+
+#define MODULES         (EKK_MAX_MODULES - 2)
+#define ROUNDS          500
+#define STEP_US         1000    /* Simulated time per round */
+#define RACK_SLOTS      16
+#define MAX_THREADS     64
+#define DEFAULT_THREADS 4
+
+static ekk_module_t g_modules[MODULES];
+
+/* ============================================================================
+ * Round Gate
+ * ============================================================================ */
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t waiting;
+    uint32_t parties;
+    uint32_t generation;
+} round_gate_t;
+
+static void gate_init(round_gate_t *g, uint32_t parties)
+{
+    pthread_mutex_init(&g->lock, NULL);
+    pthread_cond_init(&g->cond, NULL);
+    g->waiting = 0;
+    g->parties = parties;
+    g->generation = 0;
+}
+
+static void gate_wait(round_gate_t *g)
+{
+    pthread_mutex_lock(&g->lock);
+    uint32_t gen = g->generation;
+    if (++g->waiting == g->parties) {
+        g->waiting = 0;
+        g->generation++;
+        pthread_cond_broadcast(&g->cond);
+    } else {
+        while (gen == g->generation) {
+            pthread_cond_wait(&g->cond, &g->lock);
+        }
+    }
+    pthread_mutex_unlock(&g->lock);
+}
+
+/* ============================================================================
+ * Workers
+ * ============================================================================ */
+
+typedef struct {
+    pthread_t thread;
+    uint32_t first;
+    uint32_t count;
+} worker_t;
+
+static round_gate_t g_start;
+static round_gate_t g_done;
+static volatile ekk_time_us_t g_now;
+static volatile bool g_stop;
+
+static void *worker_main(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+
+    for (;;) {
+        gate_wait(&g_start);
+        if (g_stop) {
+            break;
+        }
+        for (uint32_t i = w->first; i < w->first + w->count; i++) {
+            ekk_module_tick(&g_modules[i], g_now);
+        }
+        gate_wait(&g_done);
+    }
+    return NULL;
+}
+
+/* ============================================================================
+ * Timing Helpers
+ * ============================================================================ */
+
+static uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* ============================================================================
+ * Benchmark Functions
+ * ============================================================================ */
+
+static void site_init(void)
+{
+    for (uint32_t i = 0; i < MODULES; i++) {
+        ekk_position_t pos = {
+            .x = (int16_t)(i % RACK_SLOTS),
+            .y = (int16_t)(i / RACK_SLOTS),
+            .z = 0,
+        };
+        ekk_module_init(&g_modules[i], (ekk_module_id_t)(i + 1), "site", pos);
+        g_modules[i].poll_hal_rx = false;
+        ekk_module_start(&g_modules[i]);
+    }
+}
+
+/** Deliver queued frames to every module, returns frames routed */
+static uint32_t route_frames(ekk_time_us_t now)
+{
+    ekk_module_id_t sender;
+    ekk_msg_type_t type;
+    uint8_t buf[64];
+    uint32_t len = sizeof(buf);
+    uint32_t frames = 0;
+
+    while (ekk_hal_recv(&sender, &type, buf, &len) == EKK_OK) {
+        for (uint32_t i = 0; i < MODULES; i++) {
+            ekk_module_on_message(&g_modules[i], sender, type, buf, len, now);
+        }
+        frames++;
+        len = sizeof(buf);
+    }
+    return frames;
+}
+
+static double run_site(uint32_t threads)
+{
+    worker_t workers[MAX_THREADS];
+    uint32_t per = (MODULES + threads - 1) / threads;
+    uint64_t tick_ns = 0;
+    uint64_t frames = 0;
+
+    site_init();
+    gate_init(&g_start, threads + 1);
+    gate_init(&g_done, threads + 1);
+    g_stop = false;
+    g_now = ekk_hal_time_us();
+
+    for (uint32_t t = 0; t < threads; t++) {
+        workers[t].first = EKK_MIN(t * per, (uint32_t)MODULES);
+        workers[t].count = EKK_MIN(per, MODULES - workers[t].first);
+        pthread_create(&workers[t].thread, NULL, worker_main, &workers[t]);
+    }
+
+    for (uint32_t r = 0; r < ROUNDS; r++) {
+        g_now += STEP_US;
+        uint64_t t0 = get_time_ns();
+        gate_wait(&g_start);
+        gate_wait(&g_done);
+        tick_ns += get_time_ns() - t0;
+        frames += route_frames(g_now);
+    }
+
+    g_stop = true;
+    gate_wait(&g_start);
+    for (uint32_t t = 0; t < threads; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+
+    uint32_t neighbors = 0;
+    for (uint32_t i = 0; i < MODULES; i++) {
+        neighbors += g_modules[i].topology.neighbor_count;
+    }
+
+    double rate = (double)MODULES * ROUNDS / ((double)tick_ns / 1e9);
+    printf("%2u thread(s): %10.0f module ticks/s  (%llu frames routed, "
+           "%.1f neighbors/module)\n",
+           (unsigned)threads, rate, (unsigned long long)frames,
+           (double)neighbors / MODULES);
+    return rate;
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(int argc, char **argv)
+{
+    uint32_t threads = DEFAULT_THREADS;
+    if (argc > 1) {
+        threads = (uint32_t)strtoul(argv[1], NULL, 10);
+    }
+    threads = EKK_CLAMP(threads, 1u, (uint32_t)MAX_THREADS);
+
+    if (ekk_init() != EKK_OK) {
+        fprintf(stderr, "ekk_init failed\n");
+        return 1;
+    }
+
+    printf("=== Site Simulation Benchmark (%d modules, %d rounds) ===\n\n",
+           MODULES, ROUNDS);
+
+    double single = run_site(1);
+    double pool = run_site(threads);
+    printf("\nScaling: %.2fx on %u threads\n", pool / single, (unsigned)threads);
+
+    printf("\n=== Benchmark Complete ===\n");
+    return 0;
+}
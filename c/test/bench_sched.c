@@ -0,0 +1,148 @@
+/**
+ * @file bench_sched.c
+ * @brief EK-KOR v2 - Task Selection Benchmark
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ * @license MIT
+ *
+ * Selection cost against task count: the run queue pick versus the
+ * linear scan it replaced (every task checked for state, release time
+ * and criticality). Half the tasks are periodic and waiting on their
+ * period, a quarter carry deadlines, and the rest are ready at mixed
+ * priorities. Built with a large EKK_MAX_TASKS_PER_MODULE so one binary
+ * covers every count.
+ */
+
+#include "ekk/ekk_runqueue.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/* ============================================================================
+ * Test Configuration
+ * ============================================================================ */
+
+#define PICKS           200000
+#define NOW_US          1000000000ULL
+
+typedef struct {
+    bool ready;
+    uint8_t priority;
+    ekk_time_us_t next_run;
+    bool has_deadline;
+    ekk_time_us_t start_by;
+} scan_task_t;
+
+static ekk_runqueue_t g_rq;
+static scan_task_t g_tasks[EKK_MAX_TASKS_PER_MODULE];
+static volatile uint32_t g_sink;
+
+/* ============================================================================
+ * Timing Helpers
+ * ============================================================================ */
+
+static uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* ============================================================================
+ * Benchmark Functions
+ * ============================================================================ */
+
+/** Linear selection, as done before the run queue */
+static ekk_task_id_t scan_pick(uint32_t count, ekk_time_us_t now)
+{
+    ekk_task_id_t best = EKK_RUNQUEUE_NONE;
+    uint8_t best_priority = 0xFF;
+    bool best_critical = false;
+
+    for (uint32_t i = 0; i < count; i++) {
+        const scan_task_t *task = &g_tasks[i];
+        if (!task->ready || task->next_run > now) {
+            continue;
+        }
+        bool critical = task->has_deadline &&
+                        task->start_by < now + EKK_SLACK_THRESHOLD_US;
+        if ((critical && !best_critical) ||
+            (critical == best_critical && task->priority < best_priority)) {
+            best = (ekk_task_id_t)i;
+            best_priority = task->priority;
+            best_critical = critical;
+        }
+    }
+    return best;
+}
+
+static void setup(uint32_t count)
+{
+    ekk_runqueue_init(&g_rq);
+    memset(g_tasks, 0, sizeof(g_tasks));
+    srand(count);
+
+    for (uint32_t i = 0; i < count; i++) {
+        ekk_task_id_t id = (ekk_task_id_t)i;
+        scan_task_t *task = &g_tasks[i];
+        task->ready = true;
+        task->priority = (uint8_t)(rand() % 16);
+        ekk_runqueue_set_priority(&g_rq, id, task->priority);
+
+        if (i % 4 == 1) {
+            task->has_deadline = true;
+            task->start_by = NOW_US + 20000000 + (ekk_time_us_t)(rand() % 1000000);
+            ekk_runqueue_set_deadline(&g_rq, id, true, task->start_by, 0);
+        }
+
+        if (i % 2 == 0) {
+            task->next_run = NOW_US + 1000 + (ekk_time_us_t)(rand() % 100000);
+            ekk_runqueue_release_at(&g_rq, id, task->next_run);
+        } else {
+            ekk_runqueue_ready(&g_rq, id);
+        }
+    }
+}
+
+static void bench_count(uint32_t count)
+{
+    setup(count);
+
+    uint64_t t0 = get_time_ns();
+    for (uint32_t i = 0; i < PICKS; i++) {
+        ekk_runqueue_release(&g_rq, NOW_US);
+        g_sink += ekk_runqueue_pick(&g_rq, NOW_US);
+    }
+    uint64_t rq_ns = get_time_ns() - t0;
+
+    t0 = get_time_ns();
+    for (uint32_t i = 0; i < PICKS; i++) {
+        g_sink += scan_pick(count, NOW_US);
+    }
+    uint64_t scan_ns = get_time_ns() - t0;
+
+    if (ekk_runqueue_pick(&g_rq, NOW_US) != scan_pick(count, NOW_US)) {
+        printf("  mismatch at %u tasks\n", (unsigned)count);
+    }
+
+    printf("%4u tasks: run queue %7.2f ns  linear scan %7.2f ns\n",
+           (unsigned)count, (double)rq_ns / PICKS, (double)scan_ns / PICKS);
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(void)
+{
+    printf("=== Task Selection Benchmark (%d picks) ===\n\n", PICKS);
+
+    for (uint32_t count = 4; count <= EKK_MAX_TASKS_PER_MODULE; count *= 2) {
+        bench_count(count);
+    }
+
+    printf("\n=== Benchmark Complete ===\n");
+    return 0;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file bench_spsc_xcore.c
+ * @brief EK-KOR v2 - Cross-Core False Sharing Benchmark
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ * @license MIT
+ *
+ * Built once per cache line size (bench_spsc_xcore_32 / _64) from the
+ * same sources. On a 64-byte line machine the _32 build is the old
+ * layout: SPSC head and tail share a line and field slots are packed;
+ * the _64 build gives each its own line. Measures, with the two threads
+ * pinned to different CPUs:
+ * - SPSC stream, item by item and in bursts of 16
+ * - two writers updating adjacent ekk_coord_field_t slots (seqlock)
+ *
+ * Needs at least two CPUs for meaningful numbers.
+ */
+
+#define _GNU_SOURCE
+
+#include "ekk/ekk_spsc.h"
+#include "ekk/ekk_field.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* ============================================================================
+ * Test Configuration
+ * ============================================================================ */
+
+#define STREAM_ITEMS    2000000
+#define QUEUE_CAPACITY  256     /* Must be power of 2 */
+#define BURST           16
+#define FIELD_WRITES    2000000
+
+/* Test item structure (typical CAN frame size) */
+typedef struct {
+    uint32_t id;
+    uint8_t  data[8];
+    uint8_t  len;
+    uint8_t  flags;
+} test_item_t;
+
+/* ============================================================================
+ * Helpers
+ * ============================================================================ */
+
+static uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int g_ncpu = 1;
+
+/**
+ * @brief Pin the calling thread to a CPU (no-op on one CPU)
+ */
+static void pin_to_cpu(int cpu) {
+#ifdef __linux__
+    if (g_ncpu > 1) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu % g_ncpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+/** Back off while the other side catches up (lets a single CPU make progress) */
+static void spin_wait(void) {
+    if (g_ncpu == 1) {
+        sched_yield();
+    }
+}
+
+/* ============================================================================
+ * SPSC Stream
+ * ============================================================================ */
+
+static ekk_spsc_t g_queue;
+static test_item_t g_buffer[QUEUE_CAPACITY];
+static int g_batched;
+
+static void *stream_producer(void *arg) {
+    (void)arg;
+    pin_to_cpu(0);
+
+    test_item_t items[BURST];
+    memset(items, 0, sizeof(items));
+
+    uint32_t sent = 0;
+    while (sent < STREAM_ITEMS) {
+        if (g_batched) {
+            uint32_t n = EKK_MIN(BURST, STREAM_ITEMS - sent);
+            for (uint32_t i = 0; i < n; i++) {
+                items[i].id = sent + i;
+            }
+            uint32_t done = ekk_spsc_push_n(&g_queue, items, n);
+            sent += done;
+            if (done == 0) {
+                spin_wait();
+            }
+        } else {
+            items[0].id = sent;
+            if (ekk_spsc_push(&g_queue, &items[0]) == EKK_OK) {
+                sent++;
+            } else {
+                spin_wait();
+            }
+        }
+    }
+    return NULL;
+}
+
+static void *stream_consumer(void *arg) {
+    uint64_t *errors = (uint64_t *)arg;
+    pin_to_cpu(1);
+
+    test_item_t items[BURST];
+    uint32_t expect = 0;
+
+    while (expect < STREAM_ITEMS) {
+        uint32_t got;
+        if (g_batched) {
+            got = ekk_spsc_pop_n(&g_queue, items, BURST);
+        } else {
+            got = (ekk_spsc_pop(&g_queue, &items[0]) == EKK_OK) ? 1 : 0;
+        }
+        if (got == 0) {
+            spin_wait();
+            continue;
+        }
+        for (uint32_t i = 0; i < got; i++) {
+            if (items[i].id != expect) {
+                (*errors)++;
+            }
+            expect++;
+        }
+    }
+    return NULL;
+}
+
+static void bench_stream(const char *name, int batched) {
+    pthread_t prod, cons;
+    uint64_t errors = 0;
+
+    ekk_spsc_init(&g_queue, g_buffer, QUEUE_CAPACITY, sizeof(test_item_t));
+    g_batched = batched;
+
+    uint64_t start = get_time_ns();
+    pthread_create(&cons, NULL, stream_consumer, &errors);
+    pthread_create(&prod, NULL, stream_producer, NULL);
+    pthread_join(prod, NULL);
+    pthread_join(cons, NULL);
+    uint64_t elapsed = get_time_ns() - start;
+
+    printf("  %-28s %8.2f ns/item  %8.2f Mitems/s%s\n", name,
+           (double)elapsed / STREAM_ITEMS,
+           (double)STREAM_ITEMS * 1000.0 / (double)elapsed,
+           errors ? "  (ORDER ERRORS)" : "");
+}
+
+/* ============================================================================
+ * Adjacent Field Slots
+ * ============================================================================ */
+
+static ekk_coord_field_t g_slots[2];
+
+/**
+ * @brief Seqlock publish loop on one slot, as ekk_field_publish() does
+ */
+static void *slot_writer(void *arg) {
+    ekk_coord_field_t *slot = (ekk_coord_field_t *)arg;
+    pin_to_cpu(slot == &g_slots[0] ? 0 : 1);
+
+    for (uint32_t i = 0; i < FIELD_WRITES; i++) {
+        slot->sequence++;
+        ekk_hal_memory_barrier();
+        slot->field.components[EKK_FIELD_LOAD] = (ekk_fixed_t)i;
+        slot->field.timestamp = i;
+        ekk_hal_memory_barrier();
+        slot->sequence++;
+    }
+    return NULL;
+}
+
+static void bench_field_slots(void) {
+    pthread_t a, b;
+
+    memset(g_slots, 0, sizeof(g_slots));
+
+    uint64_t start = get_time_ns();
+    pthread_create(&a, NULL, slot_writer, &g_slots[0]);
+    pthread_create(&b, NULL, slot_writer, &g_slots[1]);
+    pthread_join(a, NULL);
+    pthread_join(b, NULL);
+    uint64_t elapsed = get_time_ns() - start;
+
+    unsigned long gap = (unsigned long)((uintptr_t)&g_slots[1] - (uintptr_t)&g_slots[0]);
+    printf("  %-28s %8.2f ns/write (slot stride %lu B)\n", "adjacent field slots",
+           (double)elapsed / FIELD_WRITES, gap);
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(void) {
+#ifdef _SC_NPROCESSORS_ONLN
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    g_ncpu = (n > 0) ? (int)n : 1;
+#endif
+
+    printf("=== EK-KOR v2 Cross-Core Benchmark (EKK_CACHE_LINE_SIZE=%d) ===\n\n",
+           EKK_CACHE_LINE_SIZE);
+    printf("CPUs: %d%s\n", g_ncpu, g_ncpu < 2 ? " (threads share one CPU, numbers not representative)" : "");
+    printf("ekk_spsc_t: %u B, head->tail %u B; ekk_coord_field_t: %u B\n\n",
+           (unsigned)sizeof(ekk_spsc_t),
+           (unsigned)(offsetof(ekk_spsc_t, tail) - offsetof(ekk_spsc_t, head)),
+           (unsigned)sizeof(ekk_coord_field_t));
+
+    bench_stream("SPSC stream (item by item)", 0);
+    bench_stream("SPSC stream (burst of 16)", 1);
+    bench_field_slots();
+
+    return 0;
+}
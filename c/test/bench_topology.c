@@ -0,0 +1,131 @@
+/**
+ * @file bench_topology.c
+ * @brief EK-KOR v2 - Topology Reelection Benchmark
+ *
+ * @copyright Copyright (c) 2026 Elektrokombinacija
+ * @license MIT
+ *
+ * Fills a rack one discovery at a time, once with a full reelection per
+ * discovery and once in incremental mode, then measures steady-state
+ * reelection with every slot known. Reports average and worst case per
+ * metric, since the worst case is what shows up as tick jitter.
+ */
+
+#include "ekk/ekk_topology.h"
+#include "ekk/ekk_hal.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/* ============================================================================
+ * Test Configuration
+ * ============================================================================ */
+
+#define ROUNDS          2000
+#define RACK_SLOTS      16      /* x */
+#define RACK_ROWS       8       /* y */
+
+static ekk_topology_t g_topo;
+
+/* ============================================================================
+ * Timing Helpers
+ * ============================================================================ */
+
+static uint64_t get_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void report(const char *name, uint64_t sum_ns, uint64_t max_ns, uint64_t ops) {
+    printf("%-28s avg %8.2f ns  max %8llu ns  (%llu ops)\n", name,
+           (double)sum_ns / (double)ops, (unsigned long long)max_ns,
+           (unsigned long long)ops);
+}
+
+/* ============================================================================
+ * Benchmark Functions
+ * ============================================================================ */
+
+static ekk_position_t rack_position(uint32_t i)
+{
+    ekk_position_t pos = {
+        .x = (int16_t)(i % RACK_SLOTS),
+        .y = (int16_t)((i / RACK_SLOTS) % RACK_ROWS),
+        .z = (int16_t)(i / (RACK_SLOTS * RACK_ROWS)),
+    };
+    return pos;
+}
+
+static void bench_metric(const char *label, ekk_distance_metric_t metric)
+{
+    ekk_topology_config_t config = EKK_TOPOLOGY_CONFIG_DEFAULT;
+    config.metric = metric;
+    uint32_t modules = EKK_MAX_MODULES - 2;
+    char name[64];
+
+    /* This module sits mid-rack, so neighbors fill in late */
+    config.incremental = false;
+    ekk_topology_init(&g_topo, 1, rack_position(modules / 2), &config);
+
+    /* Rack fill: one discovery and a full reelection at a time */
+    uint64_t sum = 0, max = 0;
+    for (uint32_t i = 0; i < modules; i++) {
+        uint64_t t0 = get_time_ns();
+        ekk_topology_on_discovery(&g_topo, (ekk_module_id_t)(i + 2), rack_position(i));
+        g_topo.neighbor_count = 0;   /* force the reelect path every time */
+        ekk_topology_reelect(&g_topo);
+        uint64_t dt = get_time_ns() - t0;
+        sum += dt;
+        if (dt > max) max = dt;
+    }
+    snprintf(name, sizeof(name), "%s: fill (%u)", label, (unsigned)modules);
+    report(name, sum, max, modules);
+
+    /* Same fill, incremental: each discovery is ranked against the bound */
+    config.incremental = true;
+    ekk_topology_init(&g_topo, 1, rack_position(modules / 2), &config);
+    sum = 0;
+    max = 0;
+    for (uint32_t i = 0; i < modules; i++) {
+        uint64_t t0 = get_time_ns();
+        ekk_topology_on_discovery(&g_topo, (ekk_module_id_t)(i + 2), rack_position(i));
+        uint64_t dt = get_time_ns() - t0;
+        sum += dt;
+        if (dt > max) max = dt;
+    }
+    snprintf(name, sizeof(name), "%s: fill incremental", label);
+    report(name, sum, max, modules);
+
+    /* Steady state */
+    sum = 0;
+    max = 0;
+    for (uint32_t r = 0; r < ROUNDS; r++) {
+        uint64_t t0 = get_time_ns();
+        ekk_topology_reelect(&g_topo);
+        uint64_t dt = get_time_ns() - t0;
+        sum += dt;
+        if (dt > max) max = dt;
+    }
+    snprintf(name, sizeof(name), "%s: reelect", label);
+    report(name, sum, max, ROUNDS);
+}
+
+/* ============================================================================
+ * Main
+ * ============================================================================ */
+
+int main(void)
+{
+    printf("=== Topology Reelection Benchmark (%d modules, k=%d) ===\n\n",
+           EKK_MAX_MODULES, EKK_K_NEIGHBORS);
+
+    bench_metric("logical", EKK_DISTANCE_LOGICAL);
+    bench_metric("physical", EKK_DISTANCE_PHYSICAL);
+
+    printf("\n=== Benchmark Complete ===\n");
+    return 0;
+}
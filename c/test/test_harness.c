@@ -188,14 +188,17 @@ static int test_field_publish(const cJSON *input, const cJSON *expected, cJSON *
     /* Check region state if expected */
     cJSON *region_state = cJSON_GetObjectItem(expected, "region_state");
     if (region_state && err == EKK_OK) {
-        ekk_coord_field_t *cf = &g_field_region.fields[module_id];
+        int32_t slot = ekk_field_region_slot(&g_field_region, (ekk_module_id_t)module_id);
+        uint32_t seq = (slot < 0) ? 0 : ekk_field_region_sequence(&g_field_region, (uint32_t)slot);
+        ekk_fixed_t c0 = (slot < 0) ? 0 : ekk_field_region_component(&g_field_region, (uint32_t)slot,
+                                                                     EKK_FIELD_LOAD);
 
         /* Check sequence */
         cJSON *exp_seq = cJSON_GetObjectItem(region_state, "fields[42].sequence");
         if (exp_seq && cJSON_IsNumber(exp_seq)) {
-            if (cf->sequence != (uint32_t)exp_seq->valueint) {
+            if (seq != (uint32_t)exp_seq->valueint) {
                 cJSON_AddStringToObject(result, "error", "Sequence mismatch");
-                cJSON_AddNumberToObject(result, "actual_sequence", cf->sequence);
+                cJSON_AddNumberToObject(result, "actual_sequence", seq);
                 cJSON_AddNumberToObject(result, "expected_sequence", exp_seq->valueint);
                 return 0;
             }
@@ -204,9 +207,9 @@ static int test_field_publish(const cJSON *input, const cJSON *expected, cJSON *
         /* Check components */
         cJSON *comp0 = cJSON_GetObjectItem(region_state, "fields[42].components[0]");
         if (comp0 && cJSON_IsNumber(comp0)) {
-            if (cf->field.components[0] != (ekk_fixed_t)comp0->valueint) {
+            if (c0 != (ekk_fixed_t)comp0->valueint) {
                 cJSON_AddStringToObject(result, "error", "Component[0] mismatch");
-                cJSON_AddNumberToObject(result, "actual", cf->field.components[0]);
+                cJSON_AddNumberToObject(result, "actual", c0);
                 cJSON_AddNumberToObject(result, "expected", comp0->valueint);
                 return 0;
             }
@@ -366,6 +369,73 @@ static int test_field_gradient(const cJSON *input, const cJSON *expected, cJSON
     return 1;
 }
 
+static int test_field_decay(const cJSON *input, const cJSON *expected, cJSON *result) {
+    cJSON *cases = cJSON_GetObjectItem(input, "cases");
+    cJSON *exp_factors = cJSON_GetObjectItem(expected, "factors");
+    cJSON *exp_values = cJSON_GetObjectItem(expected, "values");
+    if (!cases || !cJSON_IsArray(cases)) {
+        cJSON_AddStringToObject(result, "error", "Missing cases");
+        return 0;
+    }
+
+    cJSON *factors = cJSON_CreateArray();
+    cJSON *values = cJSON_CreateArray();
+    cJSON_AddItemToObject(result, "factors", factors);
+    cJSON_AddItemToObject(result, "values", values);
+
+    int passed = 1;
+    int i = 0;
+    cJSON *c;
+    cJSON_ArrayForEach(c, cases) {
+        ekk_field_config_t config = EKK_FIELD_CONFIG_DEFAULT;
+        const char *model = get_string(c, "model", "Exponential");
+        if (strcmp(model, "Linear") == 0) {
+            config.decay_model = EKK_DECAY_LINEAR;
+        } else if (strcmp(model, "Step") == 0) {
+            config.decay_model = EKK_DECAY_STEP;
+        }
+        config.decay_tau = (ekk_fixed_t)get_number(c, "decay_tau", 0);
+        config.min_value = (ekk_fixed_t)get_number(c, "min_value", INT32_MIN);
+        config.max_value = (ekk_fixed_t)get_number(c, "max_value", INT32_MAX);
+
+        if (ekk_field_configure(EKK_FIELD_LOAD, &config) != EKK_OK) {
+            cJSON_AddStringToObject(result, "error", "Configure failed");
+            passed = 0;
+            break;
+        }
+
+        ekk_time_us_t elapsed = (ekk_time_us_t)get_number(c, "elapsed_us", 0);
+        ekk_fixed_t factor = ekk_field_decay_factor(EKK_FIELD_LOAD, elapsed);
+
+        ekk_field_t field;
+        memset(&field, 0, sizeof(field));
+        field.components[EKK_FIELD_LOAD] = (ekk_fixed_t)get_number(c, "value", 0);
+        ekk_field_apply_decay(&field, elapsed);
+
+        cJSON_AddItemToArray(factors, cJSON_CreateNumber(factor));
+        cJSON_AddItemToArray(values, cJSON_CreateNumber(field.components[EKK_FIELD_LOAD]));
+
+        /* Bit-exact: these are shared with the Rust port */
+        cJSON *ef = exp_factors ? cJSON_GetArrayItem(exp_factors, i) : NULL;
+        cJSON *ev = exp_values ? cJSON_GetArrayItem(exp_values, i) : NULL;
+        if ((ef && (ekk_fixed_t)ef->valuedouble != factor) ||
+            (ev && (ekk_fixed_t)ev->valuedouble != field.components[EKK_FIELD_LOAD])) {
+            if (passed) {
+                cJSON_AddStringToObject(result, "error", "Decay mismatch");
+                cJSON_AddNumberToObject(result, "case", i);
+            }
+            passed = 0;
+        }
+        i++;
+    }
+
+    /* Restore default decay for the remaining vectors */
+    ekk_field_config_t def = EKK_FIELD_CONFIG_DEFAULT;
+    ekk_field_configure(EKK_FIELD_LOAD, &def);
+
+    return passed;
+}
+
 /* ============================================================================
  * SPSC MODULE TESTS
  * ============================================================================ */
@@ -932,6 +1002,7 @@ static int test_consensus_on_vote(const cJSON *input, const cJSON *expected, cJS
     }
 
     int voter_id = (int)get_number(input, "voter_id", 0);
+    int proposer_id = (int)get_number(input, "proposer_id", g_consensus.my_id);
     int ballot_id = (int)get_number(input, "ballot_id", 0);
     const char *vote_str = get_string(input, "vote", "Yes");
 
@@ -941,6 +1012,7 @@ static int test_consensus_on_vote(const cJSON *input, const cJSON *expected, cJS
     else if (strcmp(vote_str, "Inhibit") == 0) vote = EKK_VOTE_INHIBIT;
 
     ekk_error_t err = ekk_consensus_on_vote(&g_consensus, (ekk_module_id_t)voter_id,
+                                             (ekk_module_id_t)proposer_id,
                                              (ekk_ballot_id_t)ballot_id, vote);
 
     cJSON_AddStringToObject(result, "return", error_to_string(err));
@@ -1014,6 +1086,7 @@ static const test_handler_t g_handlers[] = {
     {"field", "field_publish", test_field_publish},
     {"field", "field_sample", test_field_sample},
     {"field", "field_gradient", test_field_gradient},
+    {"field", "field_decay", test_field_decay},
 
     /* Topology module */
     {"topology", "topology_on_discovery", test_topology_on_discovery},
@@ -1201,6 +1274,15 @@ static int run_single_test(const cJSON *test, cJSON *output) {
                                        (uint8_t)sequence, now);
             }
 
+            /* Handle consensus init setup (fresh engine, before any proposal) */
+            cJSON *consensus_init = cJSON_GetObjectItem(setup, "init");
+            if (consensus_init && strcmp(module, "consensus") == 0) {
+                int my_id = (int)get_number(consensus_init, "my_id", 1);
+                ekk_consensus_config_t config = EKK_CONSENSUS_CONFIG_DEFAULT;
+                ekk_consensus_init(&g_consensus, (ekk_module_id_t)my_id, &config);
+                g_consensus_initialized = true;
+            }
+
             /* Handle consensus propose setup */
             cJSON *propose = cJSON_GetObjectItem(setup, "propose");
             if (propose) {
@@ -1222,15 +1304,6 @@ static int run_single_test(const cJSON *test, cJSON *output) {
                 ekk_ballot_id_t ballot_id;
                 ekk_consensus_propose(&g_consensus, type, data, threshold_fixed, &ballot_id);
             }
-
-            /* Handle consensus init setup */
-            cJSON *consensus_init = cJSON_GetObjectItem(setup, "init");
-            if (consensus_init && !g_consensus_initialized) {
-                int my_id = (int)get_number(consensus_init, "my_id", 1);
-                ekk_consensus_config_t config = EKK_CONSENSUS_CONFIG_DEFAULT;
-                ekk_consensus_init(&g_consensus, (ekk_module_id_t)my_id, &config);
-                g_consensus_initialized = true;
-            }
         }
 
         fprintf(stderr, "    Setup complete, getting input/expected...\n");
@@ -8,10 +8,18 @@
  */
 
 #include <ekk/ekk.h>
+#include <ekk/ekk_raft.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 /* ============================================================================
  * TEST MACROS
  * ============================================================================ */
@@ -87,6 +95,12 @@ static int test_module_lifecycle(void)
         now += 1000;  /* 1ms */
     }
 
+    ekk_module_status_t status;
+    ekk_module_get_status(&mod, &status);
+    TEST_ASSERT(status.field_publishes_sent >= 1, "First tick should publish");
+    TEST_ASSERT(status.field_publishes_sent + status.field_publishes_suppressed == 10,
+                "Every tick should publish or suppress");
+
     /* Stop module */
     err = ekk_module_stop(&mod);
     TEST_ASSERT(err == EKK_OK, "Stop should succeed");
@@ -96,6 +110,518 @@ static int test_module_lifecycle(void)
     return 0;
 }
 
+/* ============================================================================
+ * TEST: Multiple Module Instances
+ * ============================================================================ */
+
+static void count_found(ekk_module_t *self, ekk_module_id_t found_id)
+{
+    EKK_UNUSED(found_id);
+    (*(uint32_t *)self->user_data)++;
+}
+
+static void count_vote_request(ekk_module_t *self, const ekk_ballot_t *ballot)
+{
+    EKK_UNUSED(ballot);
+    (*(uint32_t *)self->user_data) += 100;
+}
+
+static int test_module_multi_instance(void)
+{
+    static ekk_module_t a, b;
+    uint32_t events_a = 0, events_b = 0;
+    ekk_position_t pos_a = {0, 0, 0};
+    ekk_position_t pos_b = {5, 0, 0};
+    ekk_time_us_t now = 90000000;
+
+    ekk_module_init(&a, 10, "twin-a", pos_a);
+    ekk_module_init(&b, 11, "twin-b", pos_b);
+    a.user_data = &events_a;
+    b.user_data = &events_b;
+    a.on_neighbor_found = b.on_neighbor_found = count_found;
+    a.on_vote_request = b.on_vote_request = count_vote_request;
+
+    /* Discovery + heartbeat routed to a only */
+    ekk_discovery_msg_t disc = {
+        .msg_type = EKK_MSG_DISCOVERY,
+        .sender_id = 12,
+        .position = {1, 0, 0},
+    };
+    ekk_heartbeat_msg_t hb = {
+        .msg_type = EKK_MSG_HEARTBEAT,
+        .sender_id = 12,
+        .sequence = 1,
+    };
+    TEST_ASSERT(ekk_module_on_message(&a, 12, EKK_MSG_DISCOVERY, &disc, sizeof(disc), now) == EKK_OK,
+                "Discovery should be accepted");
+    TEST_ASSERT(ekk_module_on_message(&a, 12, EKK_MSG_HEARTBEAT, &hb, sizeof(hb), now) == EKK_OK,
+                "Heartbeat should be accepted");
+    TEST_ASSERT(events_a == 1 && events_b == 0, "Alive callback should reach only its module");
+    TEST_ASSERT(a.topology.neighbor_count == 1 && b.topology.neighbor_count == 0,
+                "Topology should be per instance");
+    TEST_ASSERT(ekk_heartbeat_get_health(&b.heartbeat, 12) == EKK_HEALTH_UNKNOWN,
+                "Heartbeat should be per instance");
+
+    /* Proposal routed to b only */
+    ekk_proposal_msg_t prop = {
+        .msg_type = EKK_MSG_PROPOSAL,
+        .proposer_id = 12,
+        .ballot_id = 7,
+        .type = EKK_PROPOSAL_MODE_CHANGE,
+        .threshold = EKK_THRESHOLD_SIMPLE_MAJORITY,
+    };
+    ekk_module_on_message(&b, 12, EKK_MSG_PROPOSAL, &prop, sizeof(prop), now);
+    TEST_ASSERT(events_a == 1 && events_b == 100, "Vote request should reach only its module");
+
+    /* Truncated frames are rejected */
+    TEST_ASSERT(ekk_module_on_message(&a, 12, EKK_MSG_VOTE, &prop, 2, now) == EKK_ERR_INVALID_ARG,
+                "Short frame should be rejected");
+
+    /* The field region is shared on purpose: each twin's tick publishes
+     * into it, and each reads the other's field without any frame */
+    now = ekk_hal_time_us();
+    ekk_module_start(&a);
+    ekk_module_start(&b);
+    a.poll_hal_rx = b.poll_hal_rx = false;
+    ekk_module_update_field(&a, EKK_FIXED_ONE / 4, 0, 0);
+    ekk_module_update_field(&b, EKK_FIXED_ONE * 3 / 4, 0, 0);
+    ekk_module_tick(&a, now);
+    ekk_module_tick(&b, now);
+    ekk_field_t seen_by_a, seen_by_b;
+    TEST_ASSERT(ekk_field_sample(11, &seen_by_a) == EKK_OK &&
+                seen_by_a.components[EKK_FIELD_LOAD] > EKK_FIXED_ONE * 3 / 4 - 64 &&
+                seen_by_a.components[EKK_FIELD_LOAD] <= EKK_FIXED_ONE * 3 / 4,
+                "a should read b's field from the shared region");
+    TEST_ASSERT(ekk_field_sample(10, &seen_by_b) == EKK_OK &&
+                seen_by_b.components[EKK_FIELD_LOAD] > EKK_FIXED_ONE / 4 - 64 &&
+                seen_by_b.components[EKK_FIELD_LOAD] <= EKK_FIXED_ONE / 4,
+                "b should read a's field from the shared region");
+
+    /* Drop what the twins broadcast */
+    ekk_module_id_t sender;
+    ekk_msg_type_t type;
+    uint8_t buf[64];
+    uint32_t len = sizeof(buf);
+    while (ekk_hal_recv(&sender, &type, buf, &len) == EKK_OK) {
+        len = sizeof(buf);
+    }
+
+    TEST_PASS("test_module_multi_instance");
+    return 0;
+}
+
+static uint32_t g_tickless_runs = 0;
+
+static void tickless_task_fn(void *arg)
+{
+    (void)arg;
+    g_tickless_runs++;
+}
+
+/** Drop everything queued on the loopback HAL */
+static void drain_hal(void)
+{
+    ekk_module_id_t sender;
+    ekk_msg_type_t type;
+    uint8_t buf[64];
+    uint32_t len = sizeof(buf);
+    while (ekk_hal_recv(&sender, &type, buf, &len) == EKK_OK) {
+        len = sizeof(buf);
+    }
+}
+
+static int test_module_tickless(void)
+{
+    ekk_module_t mod;
+    ekk_position_t pos = {0, 0, 0};
+    const ekk_time_us_t t0 = 50000000;
+
+    drain_hal();
+    ekk_hal_set_mock_time(t0);
+
+    ekk_module_init(&mod, 3, "tickless", pos);
+    mod.poll_hal_rx = false;    /* Own broadcasts are not looped back */
+    TEST_ASSERT(ekk_module_next_deadline(&mod) == UINT64_MAX, "Not running, no deadline");
+
+    ekk_task_id_t task;
+    ekk_module_add_task(&mod, "periodic", tickless_task_fn, NULL, 0, 20000, &task);
+    ekk_module_task_ready(&mod, task);
+    ekk_module_start(&mod);
+    TEST_ASSERT(ekk_module_next_deadline(&mod) <= t0, "Fresh module is due at once");
+
+    /* One idle second: wake only on deadlines (mock clock jumps to them) */
+    uint32_t ticks = 0;
+    bool on_deadline = true;
+    g_tickless_runs = 0;
+    while (ekk_hal_time_us() < t0 + 1000000) {
+        ekk_time_us_t before = ekk_hal_time_us();
+        ekk_time_us_t due = EKK_MAX(ekk_module_next_deadline(&mod), before);
+        ekk_module_wait(&mod);
+        ekk_time_us_t woke = ekk_hal_time_us();
+        if (woke != EKK_MIN(due, before + EKK_MODULE_MAX_SLEEP_US)) {
+            on_deadline = false;
+        }
+        ekk_module_tick(&mod, woke);
+        drain_hal();
+        ticks++;
+    }
+    TEST_ASSERT(on_deadline, "Each wait should end at the next deadline");
+    TEST_ASSERT(g_tickless_runs >= 45 && g_tickless_runs <= 51, "Periodic task kept its rate");
+    TEST_ASSERT(ticks < 250, "Far fewer wakeups than 1 ms ticks");
+
+    /* Work queued outside a tick is due at once */
+    ekk_module_update_field(&mod, EKK_FIXED_HALF, 0, 0);
+    TEST_ASSERT(ekk_module_next_deadline(&mod) == 0, "Field update wants a tick");
+    ekk_module_tick(&mod, ekk_hal_time_us());
+    TEST_ASSERT(ekk_module_next_deadline(&mod) > ekk_hal_time_us(), "Tick consumed it");
+
+    /* A received frame ends the wait without advancing the clock */
+    ekk_time_us_t before = ekk_hal_time_us();
+    uint8_t ping = 0;
+    ekk_hal_broadcast(EKK_MSG_HEARTBEAT, &ping, sizeof(ping));
+    TEST_ASSERT(ekk_module_wait(&mod) == EKK_OK, "Frame wakes the module");
+    TEST_ASSERT(ekk_hal_time_us() == before, "Woken before any deadline");
+    drain_hal();
+
+    ekk_hal_set_mock_time(0);
+    TEST_PASS("test_module_tickless");
+    return 0;
+}
+
+static int test_latency_histogram(void)
+{
+    static ekk_histogram_t hist;
+    ekk_latency_summary_t sum;
+
+    ekk_histogram_reset(&hist);
+    ekk_histogram_summary(&hist, &sum);
+    TEST_ASSERT(sum.count == 0 && sum.p99 == 0, "Empty histogram summarizes to zero");
+
+    for (uint32_t v = 1; v <= 1000; v++) {
+        ekk_histogram_record(&hist, v);
+    }
+    ekk_histogram_summary(&hist, &sum);
+    TEST_ASSERT(sum.count == 1000 && sum.min == 1 && sum.max == 1000, "Exact count/min/max");
+    TEST_ASSERT(sum.p50 >= 500 && sum.p50 <= 625, "p50 within one sub-bucket");
+    TEST_ASSERT(sum.p99 >= 990 && sum.p999 <= 1000, "Tail percentiles clamped to max");
+    TEST_ASSERT(ekk_histogram_quantile(&hist, 0) == 1, "p0 is the minimum");
+
+    /* Beyond the resolved range: last bucket, exact max */
+    ekk_histogram_record(&hist, 1u << 30);
+    TEST_ASSERT(hist.max == (1u << 30) && ekk_histogram_quantile(&hist, 1000000) == (1u << 30),
+                "Out-of-range sample keeps exact max");
+
+    /* Module: every tick lands in every phase, task runs in its own histogram */
+    ekk_module_t mod;
+    ekk_position_t pos = {0, 0, 0};
+    ekk_task_id_t task;
+    drain_hal();
+    ekk_module_init(&mod, 4, "latency", pos);
+    mod.poll_hal_rx = false;
+    ekk_module_add_task(&mod, "periodic", tickless_task_fn, NULL, 0, 1000, &task);
+    ekk_module_task_ready(&mod, task);
+    ekk_module_start(&mod);
+    for (uint32_t i = 0; i < 10; i++) {
+        ekk_hal_set_mock_time(60000000 + i * 1000);
+        ekk_module_tick(&mod, ekk_hal_time_us());
+        drain_hal();
+    }
+    ekk_hal_set_mock_time(0);
+
+    ekk_module_status_t status;
+    ekk_module_get_status(&mod, &status);
+#if EKK_LATENCY_STATS
+    bool all_phases = true;
+    for (uint32_t i = 0; i < EKK_PHASE_COUNT; i++) {
+        if (status.phase_latency[i].count != 10 ||
+            status.phase_latency[i].min > status.phase_latency[i].p50 ||
+            status.phase_latency[i].p50 > status.phase_latency[i].max) {
+            all_phases = false;
+        }
+    }
+    TEST_ASSERT(all_phases, "Each phase recorded once per tick, ordered summary");
+    TEST_ASSERT(status.task_count == 1 && status.task_latency[task].count == 10,
+                "Task recorded once per run");
+
+    ekk_module_reset_latency(&mod);
+    ekk_module_get_status(&mod, &status);
+    TEST_ASSERT(status.phase_latency[EKK_PHASE_TASK].count == 0 &&
+                status.task_latency[task].count == 0, "Reset clears histograms");
+#endif
+
+    TEST_PASS("test_latency_histogram");
+    return 0;
+}
+
+static uint32_t g_user_frames = 0;
+static uint32_t g_user_sum = 0;
+
+static ekk_module_id_t g_user_sender;
+
+static ekk_error_t user_frame_handler(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                      const void *data, uint32_t len, ekk_time_us_t now)
+{
+    (void)mod;
+    (void)now;
+    if (len != sizeof(uint32_t)) {
+        return EKK_ERR_INVALID_ARG;
+    }
+    g_user_sender = sender_id;
+    g_user_frames++;
+    g_user_sum += *(const uint32_t *)data;
+    return EKK_OK;
+}
+
+static int test_module_rx_dispatch(void)
+{
+    ekk_module_t mod;
+    ekk_position_t pos = {0, 0, 0};
+    ekk_module_status_t status;
+    const ekk_msg_type_t user_type = (ekk_msg_type_t)EKK_MSG_USER_BASE;
+
+    drain_hal();
+    ekk_hal_set_mock_time(70000000);
+    ekk_module_init(&mod, 5, "rx", pos);
+    TEST_ASSERT(ekk_module_set_handler(&mod, (ekk_msg_type_t)0x40, user_frame_handler) ==
+                EKK_ERR_INVALID_ARG, "Type without a slot is rejected");
+    TEST_ASSERT(ekk_module_set_handler(&mod, user_type, user_frame_handler) == EKK_OK,
+                "User handler registered");
+    ekk_module_start(&mod);
+
+    /* Burst beyond the base budget with no deadline pressure: drained in one tick */
+    g_user_frames = 0;
+    g_user_sum = 0;
+    for (uint32_t i = 1; i <= 40; i++) {
+        ekk_hal_broadcast(user_type, &i, sizeof(i));
+    }
+    ekk_module_tick(&mod, ekk_hal_time_us());
+    TEST_ASSERT(g_user_frames == 40 && g_user_sum == 820, "Whole backlog dispatched in place");
+    TEST_ASSERT(g_user_sender == ekk_hal_get_module_id(), "Handler sees the transport sender");
+    ekk_module_get_status(&mod, &status);
+    TEST_ASSERT(status.rx_frames == 40 && status.rx_dropped == 0 && status.rx_deferred == 0,
+                "Counters after drain");
+    drain_hal();
+
+    /* Unknown types and short frames count as dropped */
+    uint32_t one = 1;
+    ekk_hal_broadcast((ekk_msg_type_t)(EKK_MSG_USER_BASE + 1), &one, sizeof(one));
+    ekk_hal_broadcast(EKK_MSG_HEARTBEAT, &one, 1);
+    ekk_module_tick(&mod, ekk_hal_time_us());
+    ekk_module_get_status(&mod, &status);
+    TEST_ASSERT(status.rx_dropped == 2, "Unhandled and truncated frames dropped");
+    drain_hal();
+
+    /* Votes cast in another module's name are dropped */
+    ekk_module_id_t me = ekk_hal_get_module_id();
+    ekk_vote_msg_t vote = {.msg_type = EKK_MSG_VOTE, .voter_id = me, .proposer_id = 9,
+                           .ballot_id = 3, .vote = EKK_VOTE_YES};
+    ekk_hal_broadcast(EKK_MSG_VOTE, &vote, sizeof(vote));
+    vote.voter_id = (ekk_module_id_t)(me + 1);
+    ekk_hal_broadcast(EKK_MSG_VOTE, &vote, sizeof(vote));
+    ekk_vote_batch_msg_t batch;
+    memset(&batch, 0, sizeof(batch));
+    batch.msg_type = EKK_MSG_VOTE_BATCH;
+    batch.voter_id = (ekk_module_id_t)(me + 1);
+    batch.proposer_id = 9;
+    batch.count = 1;
+    batch.entries[0].ballot_id = 3;
+    batch.entries[0].vote = EKK_VOTE_YES;
+    ekk_hal_broadcast(EKK_MSG_VOTE_BATCH, &batch, EKK_VOTE_BATCH_LEN(1));
+    ekk_module_tick(&mod, ekk_hal_time_us());
+    ekk_module_get_status(&mod, &status);
+    TEST_ASSERT(status.rx_dropped == 4, "Votes not from their voter dropped");
+    drain_hal();
+
+    /* Deadline task short of slack: base budget, rest deferred and due at once */
+    ekk_task_id_t task;
+    ekk_module_add_task(&mod, "urgent", tickless_task_fn, NULL, 0, 0, &task);
+    ekk_module_set_task_deadline(&mod, task, ekk_hal_time_us() + 200, 0);
+    ekk_module_task_ready(&mod, task);
+    g_user_frames = 0;
+    for (uint32_t i = 0; i < 40; i++) {
+        ekk_hal_broadcast(user_type, &i, sizeof(i));
+    }
+    ekk_module_tick(&mod, ekk_hal_time_us());
+    TEST_ASSERT(g_user_frames == EKK_RX_BUDGET, "Budget held back under deadline pressure");
+    ekk_module_get_status(&mod, &status);
+    TEST_ASSERT(status.rx_deferred >= 40 - EKK_RX_BUDGET, "Backlog counted as deferred");
+    TEST_ASSERT(ekk_module_next_deadline(&mod) == 0, "Backlog keeps the module due");
+    ekk_module_tick(&mod, ekk_hal_time_us());
+    TEST_ASSERT(g_user_frames == 40, "Backlog drained once slack returns");
+    drain_hal();
+
+    /* Full ring: the HAL counts overruns */
+    uint32_t before = ekk_hal_rx_overruns();
+    for (uint32_t i = 0; i < 80; i++) {
+        ekk_hal_broadcast(user_type, &i, sizeof(i));
+    }
+    ekk_module_get_status(&mod, &status);
+    TEST_ASSERT(status.rx_overruns > before, "Ring overruns reported");
+    drain_hal();
+
+    ekk_hal_set_mock_time(0);
+    TEST_PASS("test_module_rx_dispatch");
+    return 0;
+}
+
+/* ============================================================================
+ * TEST: Per-Module Endpoints (modules ticked from several threads)
+ * ============================================================================ */
+
+#define ENDPOINT_MODULES    6
+#define ENDPOINT_THREADS    3
+#define ENDPOINT_ROUNDS     200
+#define ENDPOINT_FIRST_ID   40
+
+typedef struct {
+    uint32_t from;
+    uint32_t seq;
+} endpoint_frame_t;
+
+typedef struct {
+    uint32_t next_seq[ENDPOINT_MODULES];    /* Per sender: next expected sequence */
+    bool ok;                                /* Every frame in order, from its stamped sender */
+} endpoint_rx_t;
+
+static ekk_module_t g_ep_modules[ENDPOINT_MODULES];
+static ekk_hal_endpoint_t g_ep_endpoints[ENDPOINT_MODULES];
+static endpoint_rx_t g_ep_rx[ENDPOINT_MODULES];
+static pthread_barrier_t g_ep_round;
+
+static ekk_error_t endpoint_frame_handler(ekk_module_t *mod, ekk_module_id_t sender_id,
+                                          const void *data, uint32_t len, ekk_time_us_t now)
+{
+    EKK_UNUSED(now);
+    endpoint_rx_t *rx = (endpoint_rx_t *)mod->user_data;
+    endpoint_frame_t frame;
+    if (len != sizeof(frame)) {
+        rx->ok = false;
+        return EKK_ERR_INVALID_ARG;
+    }
+    memcpy(&frame, data, sizeof(frame));
+
+    uint32_t from = frame.from - ENDPOINT_FIRST_ID;
+    if (frame.from != sender_id || sender_id == mod->id || from >= ENDPOINT_MODULES ||
+        frame.seq != rx->next_seq[from]) {
+        rx->ok = false;
+        return EKK_OK;
+    }
+    rx->next_seq[from]++;
+    return EKK_OK;
+}
+
+/* Each worker owns every ENDPOINT_THREADS-th module: send one frame, tick */
+static void *endpoint_worker(void *arg)
+{
+    uint32_t first = (uint32_t)(uintptr_t)arg;
+
+    for (uint32_t round = 0; round < ENDPOINT_ROUNDS; round++) {
+        for (uint32_t i = first; i < ENDPOINT_MODULES; i += ENDPOINT_THREADS) {
+            endpoint_frame_t frame = { g_ep_modules[i].id, round };
+            ekk_hal_endpoint_send(&g_ep_endpoints[i], EKK_BROADCAST_ID,
+                                  (ekk_msg_type_t)EKK_MSG_USER_BASE, &frame, sizeof(frame));
+            ekk_module_tick(&g_ep_modules[i], ekk_hal_time_us());
+        }
+        pthread_barrier_wait(&g_ep_round);
+    }
+    return NULL;
+}
+
+static int test_module_endpoints(void)
+{
+    ekk_position_t pos = {0, 0, 0};
+    ekk_hal_rx_view_t view;
+    static ekk_hal_endpoint_t probe;
+
+    drain_hal();
+    for (uint32_t i = 0; i < ENDPOINT_MODULES; i++) {
+        ekk_module_t *mod = &g_ep_modules[i];
+        pos.x = (int16_t)i;
+        ekk_module_init(mod, (ekk_module_id_t)(ENDPOINT_FIRST_ID + i), "endpoint", pos);
+        TEST_ASSERT(ekk_module_attach_endpoint(mod, &g_ep_endpoints[i]) == EKK_OK,
+                    "Endpoint attached");
+        memset(&g_ep_rx[i], 0, sizeof(g_ep_rx[i]));
+        g_ep_rx[i].ok = true;
+        mod->user_data = &g_ep_rx[i];
+        ekk_module_set_handler(mod, (ekk_msg_type_t)EKK_MSG_USER_BASE, endpoint_frame_handler);
+    }
+
+    /* Sender IDs are per endpoint; legacy sends reach endpoints too */
+    TEST_ASSERT(ekk_hal_endpoint_open(&probe, 60) == EKK_OK, "Probe opened");
+    uint32_t word = 7;
+    ekk_hal_endpoint_send(&g_ep_endpoints[1], 60, EKK_MSG_HEARTBEAT, &word, sizeof(word));
+    bool stamped = ekk_hal_endpoint_peek(&probe, &view) == EKK_OK &&
+                   view.sender_id == ENDPOINT_FIRST_ID + 1 && view.len == sizeof(word);
+    ekk_hal_endpoint_release(&probe);
+    bool addressed = ekk_hal_endpoint_depth(&g_ep_endpoints[0]) == 0;
+    ekk_hal_broadcast(EKK_MSG_HEARTBEAT, &word, sizeof(word));
+    bool legacy = ekk_hal_endpoint_peek(&probe, &view) == EKK_OK &&
+                  view.sender_id == ekk_hal_get_module_id();
+    ekk_hal_endpoint_close(&probe);
+    for (uint32_t i = 0; i < ENDPOINT_MODULES; i++) {
+        ekk_hal_endpoint_release(&g_ep_endpoints[i]);
+    }
+    drain_hal();
+
+    bool in_order = true, complete = true, no_overruns = true, peers_alive = true;
+#ifndef _WIN32
+    for (uint32_t i = 0; i < ENDPOINT_MODULES; i++) {
+        ekk_module_start(&g_ep_modules[i]);
+    }
+
+    pthread_t workers[ENDPOINT_THREADS];
+    pthread_barrier_init(&g_ep_round, NULL, ENDPOINT_THREADS);
+    for (uint32_t t = 0; t < ENDPOINT_THREADS; t++) {
+        pthread_create(&workers[t], NULL, endpoint_worker, (void *)(uintptr_t)t);
+    }
+    for (uint32_t t = 0; t < ENDPOINT_THREADS; t++) {
+        pthread_join(workers[t], NULL);
+    }
+    pthread_barrier_destroy(&g_ep_round);
+
+    /* Last round's frames */
+    for (uint32_t i = 0; i < ENDPOINT_MODULES; i++) {
+        ekk_module_tick(&g_ep_modules[i], ekk_hal_time_us());
+    }
+
+    for (uint32_t i = 0; i < ENDPOINT_MODULES; i++) {
+        ekk_module_status_t status;
+        ekk_module_get_status(&g_ep_modules[i], &status);
+        in_order = in_order && g_ep_rx[i].ok;
+        no_overruns = no_overruns && status.rx_overruns == 0;
+        for (uint32_t j = 0; j < ENDPOINT_MODULES; j++) {
+            if (j == i) {
+                complete = complete && g_ep_rx[i].next_seq[j] == 0;
+                continue;
+            }
+            complete = complete && g_ep_rx[i].next_seq[j] == ENDPOINT_ROUNDS;
+            peers_alive = peers_alive &&
+                ekk_heartbeat_get_health(&g_ep_modules[i].heartbeat, g_ep_modules[j].id) ==
+                EKK_HEALTH_ALIVE;
+        }
+    }
+#endif
+
+    /* Detach before asserting: the rings must not outlive the test */
+    for (uint32_t i = 0; i < ENDPOINT_MODULES; i++) {
+        ekk_module_attach_endpoint(&g_ep_modules[i], NULL);
+    }
+    drain_hal();
+
+    TEST_ASSERT(stamped, "Unicast carries the sending endpoint's ID");
+    TEST_ASSERT(addressed, "Unicast reached only its target");
+    TEST_ASSERT(legacy, "HAL broadcast reaches endpoints");
+    TEST_ASSERT(in_order, "Frames arrive in order, stamped with their endpoint's ID");
+    TEST_ASSERT(complete, "Each module got every peer frame once and none of its own");
+    TEST_ASSERT(no_overruns, "No endpoint ring overran");
+    TEST_ASSERT(peers_alive, "Every module sees the others' heartbeats");
+    TEST_ASSERT(g_ep_modules[0].endpoint == NULL && g_ep_modules[0].heartbeat.endpoint == NULL,
+                "Detached back to the HAL");
+
+    TEST_PASS("test_module_endpoints");
+    return 0;
+}
+
 /* ============================================================================
  * TEST: Fixed-Point Math
  * ============================================================================ */
@@ -154,6 +680,707 @@ static int test_field_operations(void)
     return 0;
 }
 
+/* ============================================================================
+ * TEST: Per-Component Decay
+ * ============================================================================ */
+
+static int test_field_decay(void)
+{
+    /* Default: exponential, tau = EKK_FIELD_DECAY_TAU_US */
+    TEST_ASSERT(ekk_field_decay_factor(EKK_FIELD_LOAD, 0) == EKK_FIXED_ONE,
+                "No decay at age 0");
+    TEST_ASSERT(ekk_field_decay_factor(EKK_FIELD_LOAD, EKK_FIELD_DECAY_TAU_US) == 24121,
+                "exp(-1) table value");
+
+    /* Thermal: slow linear decay, clamped to [0, 1] */
+    ekk_field_config_t thermal = EKK_FIELD_CONFIG_DEFAULT;
+    thermal.decay_tau = 10 * EKK_FIXED_ONE;         /* 10 s */
+    thermal.decay_model = EKK_DECAY_LINEAR;
+    thermal.min_value = 0;
+    thermal.max_value = EKK_FIXED_ONE;
+    ekk_error_t err = ekk_field_configure(EKK_FIELD_THERMAL, &thermal);
+    TEST_ASSERT(err == EKK_OK, "Configure should succeed");
+
+    ekk_field_config_t bad = thermal;
+    bad.min_value = EKK_FIXED_ONE;
+    bad.max_value = 0;
+    err = ekk_field_configure(EKK_FIELD_THERMAL, &bad);
+    TEST_ASSERT(err == EKK_ERR_INVALID_ARG, "min > max should be rejected");
+
+    ekk_hal_set_mock_time(9000000);
+    ekk_field_t f;
+    memset(&f, 0, sizeof(f));
+    f.components[EKK_FIELD_LOAD] = EKK_FIXED_ONE;
+    f.components[EKK_FIELD_THERMAL] = 2 * EKK_FIXED_ONE;
+    ekk_field_publish(30, &f);
+
+    /* 1 s later: load (5*tau = 500 ms) has fully decayed, thermal has not */
+    ekk_hal_set_mock_time(10000000);
+    ekk_field_t sampled;
+    err = ekk_field_sample(30, &sampled);
+    TEST_ASSERT(err == EKK_OK, "Long thermal tau should keep the field alive");
+    TEST_ASSERT(sampled.components[EKK_FIELD_LOAD] == 0, "Load should be fully decayed");
+    TEST_ASSERT(sampled.components[EKK_FIELD_THERMAL] == EKK_FIXED_ONE,
+                "Thermal should be clamped to max");
+
+    /* Restore defaults */
+    ekk_field_config_t def = EKK_FIELD_CONFIG_DEFAULT;
+    ekk_field_configure(EKK_FIELD_THERMAL, &def);
+    ekk_field_get_config(EKK_FIELD_THERMAL, &thermal);
+    TEST_ASSERT(thermal.decay_model == EKK_DECAY_EXPONENTIAL, "Config should be restored");
+
+    err = ekk_field_sample(30, &sampled);
+    TEST_ASSERT(err == EKK_ERR_FIELD_EXPIRED, "Default max age should apply again");
+
+    ekk_hal_set_mock_time(0);
+
+    TEST_PASS("test_field_decay");
+    return 0;
+}
+
+/* ============================================================================
+ * TEST: Single Component Sample
+ * ============================================================================ */
+
+static int test_field_component(void)
+{
+    ekk_hal_set_mock_time(7000000);
+
+    ekk_field_t f;
+    memset(&f, 0, sizeof(f));
+    f.components[EKK_FIELD_SLACK] = 3 * EKK_FIXED_ONE;
+    ekk_error_t err = ekk_field_publish(20, &f);
+    TEST_ASSERT(err == EKK_OK, "Publish should succeed");
+
+    ekk_hal_set_mock_time(7000000 + EKK_FIELD_DECAY_TAU_US / 2);
+
+    ekk_fixed_t value;
+    ekk_field_t sampled;
+    err = ekk_field_sample_component(20, EKK_FIELD_SLACK, &value);
+    TEST_ASSERT(err == EKK_OK, "Component sample should succeed");
+    err = ekk_field_sample(20, &sampled);
+    TEST_ASSERT(err == EKK_OK, "Sample should succeed");
+    TEST_ASSERT(value == sampled.components[EKK_FIELD_SLACK],
+                "Component sample should match full sample");
+
+    ekk_field_region_t *region = ekk_get_field_region();
+    int32_t slot = ekk_field_region_slot(region, 20);
+    TEST_ASSERT(slot >= 0, "Published module should have a slot");
+    TEST_ASSERT(ekk_field_region_component(region, (uint32_t)slot, EKK_FIELD_SLACK) == 3 * EKK_FIXED_ONE,
+                "Region should hold the undecayed value");
+    TEST_ASSERT((ekk_field_region_sequence(region, (uint32_t)slot) & 1) == 0,
+                "Sequence should be even after publish");
+
+    err = ekk_field_sample_component(21, EKK_FIELD_SLACK, &value);
+    TEST_ASSERT(err == EKK_ERR_NOT_FOUND, "Unpublished slot should not be found");
+
+    ekk_hal_set_mock_time(0);
+
+    TEST_PASS("test_field_component");
+    return 0;
+}
+
+/* ============================================================================
+ * TEST: Neighbor Field Aggregation
+ * ============================================================================ */
+
+static int test_field_aggregate(void)
+{
+    ekk_time_us_t t0 = 5000000;
+    ekk_hal_set_mock_time(t0);
+
+    ekk_field_t f;
+    memset(&f, 0, sizeof(f));
+    f.components[EKK_FIELD_LOAD] = EKK_FIXED_ONE;
+    f.components[EKK_FIELD_SLACK] = -EKK_FIXED_HALF;
+    ekk_field_publish(10, &f);
+    f.components[EKK_FIELD_LOAD] = EKK_FIXED_HALF;
+    f.components[EKK_FIELD_SLACK] = -EKK_FIXED_ONE;
+    ekk_field_publish(11, &f);
+
+    ekk_neighbor_t neighbors[3];
+    memset(neighbors, 0, sizeof(neighbors));
+    neighbors[0].id = 10;
+    neighbors[0].health = EKK_HEALTH_ALIVE;
+    neighbors[1].id = 11;
+    neighbors[1].health = EKK_HEALTH_ALIVE;
+    neighbors[2].id = 12;                       /* never published */
+    neighbors[2].health = EKK_HEALTH_ALIVE;
+
+    /* Equal weights: plain average */
+    ekk_field_t agg;
+    ekk_error_t err = ekk_field_sample_neighbors(1, neighbors, 3, &agg);
+    TEST_ASSERT(err == EKK_OK, "Aggregate should succeed");
+    TEST_ASSERT(agg.components[EKK_FIELD_LOAD] == EKK_FIXED_ONE * 3 / 4,
+                "Load aggregate should be 0.75");
+    TEST_ASSERT(agg.components[EKK_FIELD_SLACK] == -EKK_FIXED_ONE * 3 / 4,
+                "Negative components should aggregate exactly");
+    TEST_ASSERT(agg.timestamp == t0, "Aggregate timestamp should be newest");
+
+    /* A single distant, suspect neighbor: weight cancels out */
+    neighbors[1].health = EKK_HEALTH_SUSPECT;
+    neighbors[1].logical_distance = 4;
+    err = ekk_field_sample_neighbors(1, &neighbors[1], 1, &agg);
+    TEST_ASSERT(err == EKK_OK, "Single-neighbor aggregate should succeed");
+    TEST_ASSERT(agg.components[EKK_FIELD_LOAD] == EKK_FIXED_HALF,
+                "Single neighbor aggregate should equal its value");
+
+    /* Decay is applied against the batch time read */
+    ekk_hal_set_mock_time(t0 + EKK_FIELD_DECAY_TAU_US);
+    ekk_field_t sampled;
+    err = ekk_field_sample(11, &sampled);
+    TEST_ASSERT(err == EKK_OK, "Sample should succeed");
+    err = ekk_field_sample_neighbors(1, &neighbors[1], 1, &agg);
+    TEST_ASSERT(err == EKK_OK, "Decayed aggregate should succeed");
+    int32_t diff = agg.components[EKK_FIELD_LOAD] - sampled.components[EKK_FIELD_LOAD];
+    if (diff < 0) diff = -diff;
+    TEST_ASSERT(diff < 4, "Aggregate should match ekk_field_sample decay");
+    TEST_ASSERT(agg.components[EKK_FIELD_LOAD] < EKK_FIXED_HALF,
+                "Aggregate should be decayed");
+
+    /* Published after the batch time read (another process): age 0, kept */
+    ekk_hal_set_mock_time(t0 + 2 * EKK_FIELD_DECAY_TAU_US);
+    ekk_field_publish(11, &f);
+    ekk_hal_set_mock_time(t0 + EKK_FIELD_DECAY_TAU_US);
+    err = ekk_field_sample_neighbors(1, &neighbors[1], 1, &agg);
+    TEST_ASSERT(err == EKK_OK, "Future-stamped aggregate should succeed");
+    TEST_ASSERT(agg.components[EKK_FIELD_LOAD] == EKK_FIXED_HALF,
+                "Slot newer than the batch clock is undecayed, not expired");
+
+    ekk_hal_set_mock_time(0);
+
+    printf("  (kernel: %s)\n", ekk_field_kernel_name());
+    TEST_PASS("test_field_aggregate");
+    return 0;
+}
+
+/* ============================================================================
+ * TEST: Change Tracking and Incremental Aggregate
+ * ============================================================================ */
+
+static int test_field_incremental(void)
+{
+    ekk_time_us_t t = 20000000;
+    ekk_hal_set_mock_time(t);
+
+    uint32_t changed[EKK_FIELD_FLAG_WORDS];
+    ekk_field_cursor_t a = {0}, b = {0};
+
+    /* First call is a full resync */
+    TEST_ASSERT(ekk_field_changes_since(&a, changed) == EKK_MAX_MODULES,
+                "First call should report all modules");
+    ekk_field_changes_since(&b, changed);
+    TEST_ASSERT(ekk_field_changes_since(&a, changed) == 0, "No publishes, no changes");
+
+    ekk_field_t f;
+    memset(&f, 0, sizeof(f));
+    f.components[EKK_FIELD_LOAD] = EKK_FIXED_HALF;
+    ekk_field_publish(40, &f);
+    ekk_field_publish(41, &f);
+
+    TEST_ASSERT(ekk_field_changes_since(&a, changed) == 2, "Two modules changed");
+    int32_t slot40 = ekk_field_region_slot(ekk_get_field_region(), 40);
+    TEST_ASSERT(slot40 >= 0 && (changed[slot40 / 32] & (1u << (slot40 % 32))),
+                "Module 40 should be flagged");
+
+    /* Second consumer still sees the same generation */
+    ekk_field_publish(42, &f);
+    TEST_ASSERT(ekk_field_changes_since(&b, changed) == 3, "Other cursor sees all three");
+    TEST_ASSERT(ekk_field_changes_since(&a, changed) == 1, "First cursor sees only 42");
+
+    /* A cursor left behind past the change journal still gets the exact set,
+     * while one that keeps up sees each change once */
+    uint32_t busy_total = 0;
+    for (uint32_t i = 0; i < 2u * EKK_FIELD_CHANGE_BUCKETS * EKK_FIELD_CHANGE_SPAN; i++) {
+        ekk_field_publish((ekk_module_id_t)(43 + i % 2), &f);
+        busy_total += ekk_field_changes_since(&a, changed);
+    }
+    TEST_ASSERT(busy_total == 2u * EKK_FIELD_CHANGE_BUCKETS * EKK_FIELD_CHANGE_SPAN,
+                "Cursor keeping up sees every change once");
+    TEST_ASSERT(ekk_field_changes_since(&b, changed) == 2,
+                "Lagging cursor sees exactly 43 and 44, no full resync");
+    int32_t slot43 = ekk_field_region_slot(ekk_get_field_region(), 43);
+    TEST_ASSERT(slot43 >= 0 && (changed[slot43 / 32] & (1u << (slot43 % 32))),
+                "Module 43 should be flagged");
+
+    /* Incremental aggregate tracks the full one */
+    ekk_neighbor_t neighbors[3];
+    memset(neighbors, 0, sizeof(neighbors));
+    for (int i = 0; i < 3; i++) {
+        neighbors[i].id = (ekk_module_id_t)(40 + i);
+        neighbors[i].health = EKK_HEALTH_ALIVE;
+        neighbors[i].logical_distance = i;
+    }
+
+    ekk_field_aggregator_t agg;
+    ekk_field_aggregator_init(&agg, EKK_FIELD_AGG_TOLERANCE);
+
+    ekk_field_t inc, full;
+    bool agg_changed = false;
+    for (int tick = 0; tick < 50; tick++) {
+        if (tick % 10 == 0) {
+            f.components[EKK_FIELD_LOAD] = EKK_FIXED_ONE * (tick / 10 + 1) / 8;
+            ekk_field_publish(41, &f);
+        }
+
+        ekk_error_t err = ekk_field_aggregate_update(&agg, neighbors, 3, &inc, &agg_changed);
+        TEST_ASSERT(err == EKK_OK, "Incremental update should succeed");
+        ekk_field_sample_neighbors(1, neighbors, 3, &full);
+
+        int32_t diff = inc.components[EKK_FIELD_LOAD] - full.components[EKK_FIELD_LOAD];
+        if (diff < 0) diff = -diff;
+        TEST_ASSERT(diff <= EKK_FIELD_AGG_TOLERANCE + 4,
+                    "Incremental aggregate should stay within tolerance");
+
+        t += 1000;  /* 1 ms tick */
+        ekk_hal_set_mock_time(t);
+    }
+    TEST_ASSERT(agg.skipped > agg.evaluated, "Most neighbor evaluations should be skipped");
+
+    /* A dead neighbor leaves the sums */
+    neighbors[1].health = EKK_HEALTH_DEAD;
+    ekk_field_aggregate_update(&agg, neighbors, 3, &inc, &agg_changed);
+    ekk_field_sample_neighbors(1, neighbors, 3, &full);
+    TEST_ASSERT(agg_changed, "Losing a neighbor should change the aggregate");
+    int32_t diff = inc.components[EKK_FIELD_LOAD] - full.components[EKK_FIELD_LOAD];
+    if (diff < 0) diff = -diff;
+    TEST_ASSERT(diff <= EKK_FIELD_AGG_TOLERANCE + 4,
+                "Aggregate without the dead neighbor should match");
+
+    /* Published after the update read its clock (another process): age 0, kept */
+    ekk_hal_set_mock_time(t + 5000);
+    f.components[EKK_FIELD_LOAD] = EKK_FIXED_ONE;
+    ekk_field_publish(40, &f);
+    ekk_hal_set_mock_time(t);
+    ekk_field_aggregator_init(&agg, EKK_FIELD_AGG_TOLERANCE);
+    ekk_field_aggregate_update(&agg, neighbors, 1, &inc, &agg_changed);
+    TEST_ASSERT(agg_changed && inc.components[EKK_FIELD_LOAD] == EKK_FIXED_ONE,
+                "Slot newer than the update clock is undecayed, not expired");
+
+    ekk_hal_set_mock_time(0);
+
+    TEST_PASS("test_field_incremental");
+    return 0;
+}
+
+static int test_field_deadband(void)
+{
+    ekk_time_us_t t = 30000000;
+    ekk_hal_set_mock_time(t);
+
+    ekk_field_publisher_t pub;
+    ekk_field_publisher_init(&pub, NULL);
+
+    ekk_field_t f, seen;
+    memset(&f, 0, sizeof(f));
+    f.components[EKK_FIELD_LOAD] = EKK_FIXED_HALF;
+
+    bool sent = false;
+    TEST_ASSERT(ekk_field_publish_delta(&pub, 50, &f, &sent) == EKK_OK, "Publish should succeed");
+    TEST_ASSERT(sent, "First publish is always sent");
+
+    /* Steady value: readers' decayed view stays within the deadband */
+    t += 1000;
+    ekk_hal_set_mock_time(t);
+    ekk_field_publish_delta(&pub, 50, &f, &sent);
+    TEST_ASSERT(!sent, "Steady value should be suppressed");
+    ekk_field_sample(50, &seen);
+    int32_t err = seen.components[EKK_FIELD_LOAD] - f.components[EKK_FIELD_LOAD];
+    if (err < 0) err = -err;
+    TEST_ASSERT(err <= EKK_FIELD_DEADBAND_DEFAULT, "Reader should be within deadband");
+
+    /* Step change goes out immediately */
+    f.components[EKK_FIELD_LOAD] = EKK_FIXED_HALF + EKK_FIXED_ONE / 10;
+    ekk_field_publish_delta(&pub, 50, &f, &sent);
+    TEST_ASSERT(sent, "Change beyond deadband should be sent");
+
+    /* Decay drift eventually forces a refresh */
+    int ticks = 0;
+    do {
+        t += 1000;
+        ekk_hal_set_mock_time(t);
+        ekk_field_publish_delta(&pub, 50, &f, &sent);
+        ticks++;
+    } while (!sent && ticks < 100);
+    TEST_ASSERT(sent && ticks > 1, "Drift should trigger a refresh after a few ticks");
+
+    /* All-zero field never drifts: max silence (tau / divisor) refreshes it */
+    memset(&f, 0, sizeof(f));
+    ekk_field_publish_delta(&pub, 51, &f, &sent);
+    ticks = 0;
+    do {
+        t += 1000;
+        ekk_hal_set_mock_time(t);
+        ekk_field_publish_delta(&pub, 51, &f, &sent);
+        ticks++;
+    } while (!sent && ticks < 1000);
+    TEST_ASSERT(ticks * 1000 == EKK_FIELD_DECAY_TAU_US / EKK_FIELD_SILENCE_DIVISOR,
+                "Silent field should refresh at max silence");
+    TEST_ASSERT(pub.suppressed > pub.sent, "Most publishes should be suppressed");
+
+    ekk_hal_set_mock_time(0);
+
+    TEST_PASS("test_field_deadband");
+    return 0;
+}
+
+static int test_field_snapshot(void)
+{
+    ekk_time_us_t t = 40000000;
+    ekk_hal_set_mock_time(t);
+
+    /* Expire everything earlier tests published; gc empties the bitmap */
+    ekk_field_gc(0);
+
+    ekk_field_snapshot_entry_t entries[8];
+    uint32_t count = 99;
+    TEST_ASSERT(ekk_field_snapshot(entries, 8, &count) == EKK_OK, "Empty snapshot should succeed");
+    TEST_ASSERT(count == 0, "Empty region should have no entries");
+
+    ekk_field_t f;
+    memset(&f, 0, sizeof(f));
+    f.components[EKK_FIELD_THERMAL] = EKK_FIXED_HALF;
+    ekk_field_publish(200, &f);
+    ekk_field_publish(60, &f);
+
+    t += 2000;
+    ekk_hal_set_mock_time(t);
+    ekk_field_publish(61, &f);
+
+    ekk_field_region_t *region = ekk_get_field_region();
+    int32_t slot200 = ekk_field_region_slot(region, 200);
+
+    TEST_ASSERT(ekk_field_snapshot(entries, 8, &count) == EKK_OK, "Snapshot should succeed");
+    TEST_ASSERT(count == 3, "Snapshot should hold the three published slots");
+    for (uint32_t i = 1; i < count; i++) {
+        TEST_ASSERT(ekk_field_region_slot(region, entries[i - 1].id) <
+                    ekk_field_region_slot(region, entries[i].id),
+                    "Entries should be in slot order");
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        TEST_ASSERT(entries[i].age_us == (entries[i].id == 61 ? 0u : 2000u),
+                    "Ages share one time base");
+        TEST_ASSERT(entries[i].field.components[EKK_FIELD_THERMAL] == EKK_FIXED_HALF,
+                    "Snapshot values are undecayed");
+    }
+
+    /* Buffer too small: partial result */
+    TEST_ASSERT(ekk_field_snapshot(entries, 2, &count) == EKK_ERR_NO_MEMORY,
+                "Short buffer should report NO_MEMORY");
+    TEST_ASSERT(count == 2, "Short buffer should be filled");
+
+    /* Expired slots are left out, and gc drops them from the bitmap */
+    t += EKK_FIELD_DECAY_TAU_US * 5;
+    ekk_hal_set_mock_time(t);
+    ekk_field_publish(61, &f);
+    ekk_field_snapshot(entries, 8, &count);
+    TEST_ASSERT(count == 1 && entries[0].id == 61, "Only the fresh slot should remain");
+    TEST_ASSERT(ekk_field_gc(EKK_FIELD_DECAY_TAU_US * 5) == 2, "gc should expire two slots");
+    TEST_ASSERT((region->occupied[slot200 / 32] & (1u << (slot200 % 32))) == 0,
+                "gc should clear occupancy");
+
+    ekk_hal_set_mock_time(0);
+
+    TEST_PASS("test_field_snapshot");
+    return 0;
+}
+
+static int test_field_gc_wheel(void)
+{
+    ekk_time_us_t t = 50000000;
+    ekk_hal_set_mock_time(t);
+    ekk_field_gc(0);
+
+    ekk_field_t f;
+    memset(&f, 0, sizeof(f));
+    ekk_field_publish(80, &f);
+    ekk_field_publish(82, &f);
+    int32_t slot80 = ekk_field_region_slot(ekk_get_field_region(), 80);
+
+    ekk_hal_set_mock_time(t + 100000);
+    ekk_field_publish(81, &f);
+
+    /* Republishing moves a slot to a later bucket */
+    ekk_hal_set_mock_time(t + 300000);
+    ekk_field_publish(82, &f);
+
+    ekk_hal_set_mock_time(t + 450000);
+    TEST_ASSERT(ekk_field_gc(500000) == 0, "Nothing is due yet");
+
+    ekk_hal_set_mock_time(t + 501000);
+    TEST_ASSERT(ekk_field_gc(500000) == 1, "Only module 80 is due");
+    TEST_ASSERT(ekk_field_sample(80, &f) == EKK_ERR_NOT_FOUND, "Expired slot should be empty");
+    TEST_ASSERT((ekk_get_field_region()->occupied[slot80 / 32] & (1u << (slot80 % 32))) == 0,
+                "Expired slot should leave the occupancy bitmap");
+
+    ekk_hal_set_mock_time(t + 601000);
+    TEST_ASSERT(ekk_field_gc(500000) == 1, "Module 81 is due next");
+    ekk_hal_set_mock_time(t + 801000);
+    TEST_ASSERT(ekk_field_gc(500000) == 1, "Republished module 82 expires last");
+
+    /* Max age beyond the wheel span: slot survives several laps */
+    t += 1000000;
+    ekk_hal_set_mock_time(t);
+    ekk_field_publish(83, &f);
+    uint32_t expired = 0;
+    ekk_time_us_t expired_at = 0;
+    for (ekk_time_us_t dt = 0; dt <= 3000000 && expired == 0; dt += 50000) {
+        ekk_hal_set_mock_time(t + dt);
+        expired = ekk_field_gc(2000000);
+        expired_at = dt;
+    }
+    TEST_ASSERT(expired == 1 && expired_at == 2050000, "Long max age should expire on time");
+
+    /* Published after gc read its clock (another process): age 0, kept */
+    t += 5000000;
+    ekk_hal_set_mock_time(t);
+    ekk_field_gc(0);
+    ekk_hal_set_mock_time(t + 5000);
+    ekk_field_publish(84, &f);
+    ekk_hal_set_mock_time(t + 1000);
+    TEST_ASSERT(ekk_field_gc(0) == 0, "Slot newer than the gc clock is not expired");
+    int32_t slot84 = ekk_field_region_slot(ekk_get_field_region(), 84);
+    TEST_ASSERT(slot84 >= 0 &&
+                (ekk_get_field_region()->occupied[slot84 / 32] & (1u << (slot84 % 32))),
+                "Newer slot stays occupied");
+
+    ekk_hal_set_mock_time(0);
+
+    TEST_PASS("test_field_gc_wheel");
+    return 0;
+}
+
+static int test_field_segments(void)
+{
+    static ekk_field_region_t parent;
+    ekk_time_us_t t = 60000000;
+    ekk_hal_set_mock_time(t);
+    ekk_field_gc(0);
+
+    TEST_ASSERT(ekk_field_parent_init(&parent) == EKK_OK, "Parent init should succeed");
+
+    ekk_field_t f, agg, site;
+    uint32_t n = 0;
+    TEST_ASSERT(ekk_field_segment_aggregate(&agg, &n) == EKK_ERR_NOT_FOUND,
+                "Empty segment has no aggregate");
+
+    /* This segment: two modules at 0.2 and 0.4 load */
+    memset(&f, 0, sizeof(f));
+    f.components[EKK_FIELD_LOAD] = EKK_FIXED_ONE / 5;
+    ekk_field_publish(90, &f);
+    f.components[EKK_FIELD_LOAD] = EKK_FIXED_ONE * 2 / 5;
+    ekk_field_publish(91, &f);
+
+    TEST_ASSERT(ekk_field_segment_aggregate(&agg, &n) == EKK_OK && n == 2,
+                "Segment aggregate should cover both modules");
+    int32_t diff = agg.components[EKK_FIELD_LOAD] - EKK_FIXED_ONE * 3 / 10;
+    TEST_ASSERT(diff >= -2 && diff <= 2, "Segment aggregate should be the mean");
+
+    /* Another rack reports 0.9 through its own gateway */
+    TEST_ASSERT(ekk_field_segment_publish(&parent, 1, &agg) == EKK_OK, "Segment publish");
+    f.components[EKK_FIELD_LOAD] = EKK_FIXED_ONE * 9 / 10;
+    ekk_field_segment_publish(&parent, 2, &f);
+    TEST_ASSERT(ekk_field_segment_publish(&parent, 0, &f) == EKK_ERR_INVALID_ARG,
+                "Segment 0 is invalid");
+
+    TEST_ASSERT(ekk_field_sample_site(&parent, &site, &n) == EKK_OK && n == 2,
+                "Site aggregate should cover both segments");
+    diff = site.components[EKK_FIELD_LOAD] - EKK_FIXED_ONE * 6 / 10;
+    TEST_ASSERT(diff >= -2 && diff <= 2, "Site aggregate should be the segment mean");
+
+    /* A gateway module sees the site and feeds its segment upward */
+    ekk_module_t mod;
+    ekk_position_t pos = {0, 0, 0};
+    ekk_module_init(&mod, 92, "gateway", pos);
+    TEST_ASSERT(ekk_module_set_segment(&mod, &parent, 1, NULL) == EKK_OK, "Set segment");
+    ekk_module_set_capabilities(&mod, EKK_CAP_GATEWAY);
+    ekk_module_start(&mod);
+    ekk_module_tick(&mod, t);
+
+    TEST_ASSERT(mod.neighbor_aggregate.components[EKK_FIELD_LOAD] > EKK_FIXED_HALF,
+                "Isolated module should take the site aggregate");
+    TEST_ASSERT(ekk_module_get_gradient(&mod, EKK_FIELD_LOAD) > 0,
+                "Idle module in a loaded site should see a positive gradient");
+
+    /* Gateway republished segment 1 including itself (0.2 + 0.4 + 0) / 3 */
+    diff = ekk_field_region_component(&parent, (uint32_t)ekk_field_region_slot(&parent, 1),
+                                      EKK_FIELD_LOAD) - EKK_FIXED_ONE / 5;
+    TEST_ASSERT(diff >= -2 && diff <= 2, "Gateway should publish its segment aggregate");
+
+    /* Third level: the parent is row 1 of a hall; row 2 reports 0.0 */
+    static ekk_field_region_t hall;
+    ekk_field_parent_init(&hall);
+    const ekk_field_level_t hall_level = { &hall, 1, NULL };
+    const ekk_field_level_t row_level = { &parent, 1, &hall_level };
+    memset(&f, 0, sizeof(f));
+    ekk_field_segment_publish(&hall, 2, &f);
+
+    /* Row mean (0.2 + 0.9) / 2, blended a quarter of the way to the hall's 0.0 */
+    TEST_ASSERT(ekk_field_sample_levels(&row_level, &site, &n) == EKK_OK && n == 3,
+                "View should cover both rows' segments and the other row");
+    diff = site.components[EKK_FIELD_LOAD] - EKK_FIXED_ONE * 55 * 3 / 400;
+    TEST_ASSERT(diff >= -4 && diff <= 4, "Hall level should be blended in");
+
+    /* The gateway carries its row's mean up into the hall */
+    TEST_ASSERT(ekk_module_set_segment(&mod, &parent, 1, &hall_level) == EKK_OK,
+                "Set segment with a level above");
+    ekk_module_tick(&mod, t + EKK_FIELD_SEGMENT_PERIOD_US);
+    diff = ekk_field_region_component(&hall, (uint32_t)ekk_field_region_slot(&hall, 1),
+                                      EKK_FIELD_LOAD) - EKK_FIXED_ONE * 55 / 100;
+    TEST_ASSERT(diff >= -4 && diff <= 4, "Row aggregate should reach the hall");
+    TEST_ASSERT(mod.neighbor_aggregate.components[EKK_FIELD_LOAD] < EKK_FIXED_ONE * 55 / 100,
+                "Idle hall should pull the module's view down");
+
+    ekk_hal_set_mock_time(0);
+
+    TEST_PASS("test_field_segments");
+    return 0;
+}
+
+static int test_field_shm(void)
+{
+#ifndef _WIN32
+    char name[32];
+    snprintf(name, sizeof(name), "/ekk-test-%d", (int)getpid());
+
+    TEST_ASSERT(ekk_hal_field_shm_open("no-slash") == EKK_ERR_INVALID_ARG,
+                "Segment name needs a leading slash");
+    TEST_ASSERT(ekk_hal_field_shm_open(name) == EKK_OK, "Segment should be created");
+    TEST_ASSERT(ekk_hal_field_region_shared(), "Region should be shared");
+
+    ekk_field_region_t *shared = (ekk_field_region_t *)ekk_hal_get_field_region();
+    TEST_ASSERT(shared != ekk_get_field_region(), "HAL should hand out the mapped region");
+    ekk_field_attach(shared);
+
+    uint32_t seen = ekk_hal_field_notify_seq();
+    pid_t pid = fork();
+    TEST_ASSERT(pid >= 0, "fork should succeed");
+    if (pid == 0) {
+        /* Another process publishing into the same segment */
+        ekk_field_t f;
+        memset(&f, 0, sizeof(f));
+        f.components[EKK_FIELD_POWER] = EKK_FIXED_HALF;
+        ekk_field_publish(70, &f);
+        _exit(0);
+    }
+
+    uint32_t now_seq = seen;
+    for (int i = 0; i < 10 && now_seq == seen; i++) {
+        now_seq = ekk_hal_field_wait(seen, 100000);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    TEST_ASSERT(now_seq != seen, "Publish in the child should wake the parent");
+
+    ekk_field_t f;
+    TEST_ASSERT(ekk_field_sample(70, &f) == EKK_OK, "Parent should see the child's slot");
+    TEST_ASSERT(f.components[EKK_FIELD_POWER] > EKK_FIXED_HALF - EKK_FIXED_ONE / 64,
+                "Shared value should match");
+
+    /* Only region bookkeeping is shared: a process holding the region lock
+     * holds up neither our critical sections nor seqlock reads, and dying
+     * with it held does not wedge publishers */
+    int lock_held[2], release[2];
+    TEST_ASSERT(pipe(lock_held) == 0 && pipe(release) == 0, "pipe should succeed");
+    pid = fork();
+    TEST_ASSERT(pid >= 0, "fork should succeed");
+    if (pid == 0) {
+        char c = 0;
+        ekk_hal_field_lock();
+        if (write(lock_held[1], &c, 1) != 1 || read(release[0], &c, 1) != 1) {
+            _exit(1);
+        }
+        _exit(0);   /* Still holding the lock */
+    }
+    char c = 0;
+    TEST_ASSERT(read(lock_held[0], &c, 1) == 1, "Child should take the region lock");
+    uint32_t state = ekk_hal_critical_enter();
+    ekk_hal_critical_exit(state);
+    TEST_ASSERT(ekk_field_sample(70, &f) == EKK_OK, "Reads should not need the region lock");
+    TEST_ASSERT(write(release[1], &c, 1) == 1, "Child should be released");
+    waitpid(pid, &status, 0);
+    close(lock_held[0]);
+    close(lock_held[1]);
+    close(release[0]);
+    close(release[1]);
+    TEST_ASSERT(ekk_field_publish(71, &f) == EKK_OK,
+                "Publish should recover the lock from a dead holder");
+
+    /* A second attach checks the header instead of clearing the region */
+    ekk_hal_field_shm_close(false);
+    TEST_ASSERT(ekk_hal_field_shm_open(name) == EKK_OK, "Reattach should succeed");
+    shared = (ekk_field_region_t *)ekk_hal_get_field_region();
+    int32_t slot70 = ekk_field_region_slot(shared, 70);
+    TEST_ASSERT(slot70 >= 0 && (shared->occupied[slot70 / 32] & (1u << (slot70 % 32))),
+                "Slot should survive reattach");
+
+    ekk_hal_field_shm_close(true);
+    ekk_field_attach(ekk_get_field_region());
+#endif
+
+    TEST_PASS("test_field_shm");
+    return 0;
+}
+
+/* ============================================================================
+ * TEST: Module ID Slot Map
+ * ============================================================================ */
+
+static int test_idmap(void)
+{
+    static ekk_idmap_t map;
+    ekk_idmap_init(&map);
+
+    TEST_ASSERT(ekk_idmap_find(&map, 5) == -1, "Empty map has no slots");
+    TEST_ASSERT(ekk_idmap_insert(&map, 5) == 0, "First ID gets slot 0");
+    TEST_ASSERT(ekk_idmap_insert(&map, 9) == 1, "Second ID gets slot 1");
+    TEST_ASSERT(ekk_idmap_insert(&map, 5) == 0, "Insert is idempotent");
+    TEST_ASSERT(ekk_idmap_insert(&map, EKK_INVALID_MODULE_ID) == -1, "Invalid ID rejected");
+    TEST_ASSERT(ekk_idmap_insert(&map, EKK_BROADCAST_ID) == -1, "Broadcast ID rejected");
+
+    /* Freed slots are reused lowest-first */
+    TEST_ASSERT(ekk_idmap_remove(&map, 5) == 0, "Remove returns the freed slot");
+    TEST_ASSERT(ekk_idmap_find(&map, 5) == -1, "Removed ID is gone");
+    TEST_ASSERT(ekk_idmap_find(&map, 9) == 1, "Other IDs keep their slot");
+    TEST_ASSERT(ekk_idmap_insert(&map, 7) == 0, "Freed slot is reused");
+
+    /* Fill to capacity (8-bit IDs cannot name every slot of a 256-entry map) */
+#if EKK_MODULE_ID_BITS > 8 || EKK_MAX_MODULES < 254
+    ekk_idmap_init(&map);
+    for (uint32_t i = 0; i < EKK_MAX_MODULES; i++) {
+        TEST_ASSERT(ekk_idmap_insert(&map, (ekk_module_id_t)(i + 1)) == (int32_t)i,
+                    "Slots are dense");
+    }
+    TEST_ASSERT(ekk_idmap_insert(&map, (ekk_module_id_t)(EKK_MAX_MODULES + 1)) == -1,
+                "Full map rejects new IDs");
+    TEST_ASSERT(ekk_idmap_remove(&map, 3) == 2, "Remove frees a slot");
+    TEST_ASSERT(ekk_idmap_insert(&map, (ekk_module_id_t)(EKK_MAX_MODULES + 1)) == 2,
+                "New ID takes the freed slot");
+    for (uint32_t i = 0; i < EKK_MAX_MODULES; i++) {
+        if (i != 2) {
+            TEST_ASSERT(ekk_idmap_find(&map, (ekk_module_id_t)(i + 1)) == (int32_t)i,
+                        "Lookups survive tombstones");
+        }
+    }
+#endif
+
+#if EKK_MODULE_ID_BITS > 8
+    /* IDs past the table size map into the field region */
+    ekk_hal_set_mock_time(60000000);
+    ekk_field_t f, out;
+    memset(&f, 0, sizeof(f));
+    f.components[EKK_FIELD_LOAD] = EKK_FIXED_HALF;
+    TEST_ASSERT(ekk_field_publish(40000, &f) == EKK_OK, "High ID should publish");
+    TEST_ASSERT(ekk_field_sample(40000, &out) == EKK_OK, "High ID should sample");
+    TEST_ASSERT(out.source == 40000, "Source keeps the full ID");
+    TEST_ASSERT(ekk_field_region_slot(ekk_get_field_region(), 40000) >= 0,
+                "High ID should own a slot");
+#endif
+
+    TEST_PASS("test_idmap");
+    return 0;
+}
+
 /* ============================================================================
  * TEST: Topology
  * ============================================================================ */
@@ -186,6 +1413,155 @@ static int test_topology(void)
     return 0;
 }
 
+/* ============================================================================
+ * TEST: Topology Reelection (k-nearest selection)
+ * ============================================================================ */
+
+/** Brute-force k-nearest by (floor distance, ID), for checking reelection */
+static uint32_t nearest_reference(const ekk_topology_t *topo, ekk_module_id_t *out)
+{
+    ekk_module_id_t ids[EKK_MAX_MODULES];
+    int32_t dist[EKK_MAX_MODULES];
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; i < EKK_MAX_MODULES; i++) {
+        if (topo->known_bits[i / 32] & (1u << (i % 32))) {
+            ids[n] = topo->all_known[i];
+            dist[n] = ekk_topology_distance(topo, topo->my_id, topo->my_position,
+                                            ids[n], topo->known_positions[i]);
+            n++;
+        }
+    }
+
+    uint32_t k = EKK_MIN(n, topo->config.k_neighbors);
+    for (uint32_t i = 0; i < k; i++) {
+        uint32_t best = i;
+        for (uint32_t j = i + 1; j < n; j++) {
+            if (dist[j] < dist[best] || (dist[j] == dist[best] && ids[j] < ids[best])) {
+                best = j;
+            }
+        }
+        ekk_module_id_t tid = ids[i]; ids[i] = ids[best]; ids[best] = tid;
+        int32_t td = dist[i]; dist[i] = dist[best]; dist[best] = td;
+        out[i] = ids[i];
+    }
+    return k;
+}
+
+static int check_neighbors(const ekk_topology_t *topo)
+{
+    ekk_module_id_t expected[EKK_K_NEIGHBORS];
+    uint32_t k = nearest_reference(topo, expected);
+
+    TEST_ASSERT(topo->neighbor_count == k, "Should hold k neighbors");
+    for (uint32_t i = 0; i < k; i++) {
+        TEST_ASSERT(topo->neighbors[i].id == expected[i], "Neighbors should match brute force");
+    }
+    return 0;
+}
+
+static int check_reelect(ekk_topology_t *topo)
+{
+    ekk_topology_reelect(topo);
+    return check_neighbors(topo);
+}
+
+static int test_topology_reelect(void)
+{
+    static ekk_topology_t topo;
+    ekk_topology_config_t config = EKK_TOPOLOGY_CONFIG_DEFAULT;
+    config.metric = EKK_DISTANCE_PHYSICAL;
+
+    /* A rack of 8 slots x 6 rows x 4 columns with this module above it */
+    ekk_position_t me = {3, 2, 5};
+    TEST_ASSERT(ekk_topology_init(&topo, 1, me, &config) == EKK_OK, "Init should succeed");
+    uint32_t id = 2;
+    for (int16_t z = 0; z < 4; z++) {
+        for (int16_t y = 0; y < 6; y++) {
+            for (int16_t x = 0; x < 8 && id < 180; x++) {
+                ekk_position_t pos = {x, y, z};
+                ekk_topology_on_discovery(&topo, (ekk_module_id_t)id++, pos);
+            }
+        }
+    }
+    if (check_reelect(&topo)) return 1;
+
+    /* Position updates and losses keep the grid consistent */
+    ekk_position_t moved = {-40, 7, 1};
+    ekk_topology_on_discovery(&topo, 100, moved);
+    ekk_position_t close = {3, 2, 4};
+    ekk_topology_on_discovery(&topo, 150, close);
+    if (check_reelect(&topo)) return 1;
+    TEST_ASSERT(topo.neighbors[0].id == 150, "Moved module should be nearest");
+
+    TEST_ASSERT(ekk_topology_on_neighbor_lost(&topo, 150) == EKK_OK, "Loss should succeed");
+    TEST_ASSERT(!ekk_topology_is_neighbor(&topo, 150), "Lost module should be gone");
+    if (check_reelect(&topo)) return 1;
+
+    /* Far from everyone: outer rings first, or the linear fallback */
+    topo.my_position.x = 2000;
+    topo.my_position.y = -900;
+    if (check_reelect(&topo)) return 1;
+
+    /* Other metrics use the bounded heap directly */
+    topo.config.metric = EKK_DISTANCE_LOGICAL;
+    if (check_reelect(&topo)) return 1;
+    TEST_ASSERT(topo.neighbors[0].id == 2, "Logical nearest to 1 is 2");
+
+    TEST_PASS("test_topology_reelect");
+    return 0;
+}
+
+static int test_topology_incremental(void)
+{
+    static ekk_topology_t topo;
+    ekk_topology_config_t config = EKK_TOPOLOGY_CONFIG_DEFAULT;
+    ekk_position_t origin = {0, 0, 0};
+
+    /* Cold start of 200 modules in scrambled ID order, this module mid-range */
+    ekk_hal_set_mock_time(70000000);
+    TEST_ASSERT(ekk_topology_init(&topo, 100, origin, &config) == EKK_OK, "Init should succeed");
+    for (uint32_t i = 0; i < 200; i++) {
+        ekk_module_id_t id = (ekk_module_id_t)(1 + (i * 37) % 200);
+        if (id == 100) {
+            continue;
+        }
+        TEST_ASSERT(ekk_topology_on_discovery(&topo, id, origin) == EKK_OK,
+                    "Discovery should succeed");
+        if (check_neighbors(&topo)) return 1;
+
+        /* Repeat discoveries are no-ops */
+        ekk_topology_on_discovery(&topo, id, origin);
+    }
+    TEST_ASSERT(topo.known_count == 199, "All modules should be known");
+    TEST_ASSERT(topo.last_reelection == 0, "Cold start should not need a full reelection");
+
+    /* Losses promote from the reserve, then fall back to reelection */
+    for (uint32_t i = 0; i < 3 * EKK_TOPOLOGY_RESERVE; i++) {
+        TEST_ASSERT(ekk_topology_on_neighbor_lost(&topo, topo.neighbors[0].id) == EKK_OK,
+                    "Loss should succeed");
+        if (check_neighbors(&topo)) return 1;
+        if (i < EKK_TOPOLOGY_RESERVE) {
+            TEST_ASSERT(topo.last_reelection == 0, "Reserve should cover early losses");
+        }
+    }
+    TEST_ASSERT(topo.last_reelection != 0, "Exhausted reserve should reelect");
+    TEST_ASSERT(topo.known_count == 199 - 3 * EKK_TOPOLOGY_RESERVE, "Lost modules are forgotten");
+
+    /* A closer newcomer displaces the k-th neighbor */
+    ekk_module_id_t far = topo.neighbors[topo.neighbor_count - 1].id;
+    for (uint32_t i = 0; i < topo.neighbor_count; i++) {
+        TEST_ASSERT(topo.neighbors[i].id != 101, "101 was lost above");
+    }
+    TEST_ASSERT(ekk_topology_on_discovery(&topo, 101, origin) == EKK_OK, "Rediscovery should succeed");
+    TEST_ASSERT(topo.neighbors[0].id == 101, "Returning module should rank first");
+    TEST_ASSERT(!ekk_topology_is_neighbor(&topo, far), "Farthest neighbor should be displaced");
+    if (check_neighbors(&topo)) return 1;
+
+    TEST_PASS("test_topology_incremental");
+    return 0;
+}
+
 /* ============================================================================
  * TEST: Consensus
  * ============================================================================ */
@@ -245,6 +1621,827 @@ static int test_heartbeat(void)
     return 0;
 }
 
+static int test_heartbeat_phi(void)
+{
+    static ekk_heartbeat_t hb;
+    ekk_heartbeat_config_t config = EKK_HEARTBEAT_CONFIG_DEFAULT;
+    config.auto_broadcast = false;
+    config.phi_accrual = true;
+    const ekk_time_us_t period = config.period;
+    const ekk_time_us_t t_end = 70000000;
+
+    ekk_heartbeat_init(&hb, 1, &config);
+    ekk_heartbeat_add_neighbor(&hb, 2);     /* quiet bus: exactly on period */
+    ekk_heartbeat_add_neighbor(&hb, 3);     /* bursty: 0.2 / 1.8 periods */
+
+    /* 40 periods of history, both ending at t_end */
+    ekk_time_us_t t3 = t_end - 40 * period;
+    for (uint32_t i = 0; i <= 40; i++) {
+        ekk_heartbeat_received(&hb, 2, (uint8_t)i, t_end - (40 - i) * period);
+        ekk_heartbeat_received(&hb, 3, (uint8_t)i, t3);
+        t3 += (i & 1) ? period * 18 / 10 : period * 2 / 10;
+    }
+    TEST_ASSERT(hb.neighbors[0].arrival_mean == period, "Regular mean should be the period");
+    TEST_ASSERT(hb.neighbors[1].arrival_std > hb.neighbors[0].arrival_std * 4,
+                "Bursty arrivals should widen the spread");
+
+    /* Slightly late: nobody suspected, phi grows with silence */
+    ekk_heartbeat_tick(&hb, t_end + period * 12 / 10);
+    TEST_ASSERT(ekk_heartbeat_get_health(&hb, 2) == EKK_HEALTH_ALIVE, "Slight delay is ALIVE");
+    ekk_fixed_t phi_a = ekk_heartbeat_get_phi(&hb, 2, t_end + period * 12 / 10);
+    ekk_fixed_t phi_b = ekk_heartbeat_get_phi(&hb, 2, t_end + period * 14 / 10);
+    TEST_ASSERT(phi_a > 0 && phi_b > phi_a, "phi should grow with silence");
+    TEST_ASSERT(phi_a < config.phi_suspect, "Slight delay should stay below suspect");
+
+    /* Two periods of silence: the quiet neighbor is dead well before the
+     * fixed timeout_count; the bursty one is routinely this late */
+    ekk_heartbeat_tick(&hb, t_end + 2 * period);
+    TEST_ASSERT(ekk_heartbeat_get_health(&hb, 2) == EKK_HEALTH_DEAD, "Quiet neighbor should be DEAD");
+    TEST_ASSERT(ekk_heartbeat_get_health(&hb, 3) == EKK_HEALTH_ALIVE, "Bursty neighbor should stay ALIVE");
+
+    /* Recovery: the outage is not folded into the statistics */
+    ekk_heartbeat_received(&hb, 2, 41, t_end + 5 * period);
+    TEST_ASSERT(ekk_heartbeat_get_health(&hb, 2) == EKK_HEALTH_ALIVE, "Heartbeat should revive");
+    TEST_ASSERT(hb.neighbors[0].arrival_mean == period, "Outage should not skew the mean");
+
+    /* Steady again, then a burst of votes right after a heartbeat: half
+     * repeat the trailer's sequence, half carry none. Neither shortens
+     * the mean, so the usual silence afterwards is not a failure */
+    ekk_time_us_t t = t_end + 5 * period;
+    for (uint32_t i = 42; i <= 60; i++) {
+        t += period;
+        ekk_heartbeat_received(&hb, 2, (uint8_t)i, t);
+    }
+    for (uint32_t i = 1; i <= 40; i++) {
+        if (i & 1) {
+            ekk_heartbeat_received(&hb, 2, 60, t + i * period / 160);
+        } else {
+            ekk_heartbeat_seen(&hb, 2, t + i * period / 160);
+        }
+    }
+    TEST_ASSERT(hb.neighbors[0].arrival_mean == period, "Burst should not skew the mean");
+    t += period / 4;
+    ekk_heartbeat_tick(&hb, t + period * 11 / 10);
+    TEST_ASSERT(ekk_heartbeat_get_health(&hb, 2) == EKK_HEALTH_ALIVE,
+                "Silence after a burst should stay ALIVE");
+
+    TEST_PASS("test_heartbeat_phi");
+    return 0;
+}
+
+static int test_heartbeat_deadlines(void)
+{
+    static ekk_heartbeat_t hb;
+    static ekk_time_us_t last[64];
+    ekk_heartbeat_config_t config = EKK_HEARTBEAT_CONFIG_DEFAULT;
+    config.auto_broadcast = false;
+    const ekk_time_us_t period = config.period;
+    ekk_time_us_t t = 60000000;
+
+    ekk_heartbeat_init(&hb, 1, &config);
+    ekk_heartbeat_add_neighbor(&hb, 2);
+    ekk_heartbeat_add_neighbor(&hb, 3);
+    ekk_heartbeat_add_neighbor(&hb, 4);
+    TEST_ASSERT(ekk_heartbeat_next_deadline(&hb) == UINT64_MAX, "Unseen neighbors have no deadline");
+
+    ekk_heartbeat_received(&hb, 2, 0, t);
+    ekk_heartbeat_received(&hb, 3, 0, t + 3000);
+    ekk_heartbeat_received(&hb, 4, 0, t + 6000);
+    TEST_ASSERT(ekk_heartbeat_next_deadline(&hb) == t + period, "Earliest deadline first");
+    TEST_ASSERT(ekk_heartbeat_tick(&hb, t + period - 1) == 0, "Nothing due yet");
+    TEST_ASSERT(ekk_heartbeat_tick(&hb, t + period) == 1, "One neighbor due");
+    TEST_ASSERT(ekk_heartbeat_get_health(&hb, 2) == EKK_HEALTH_SUSPECT, "Missed period is SUSPECT");
+    TEST_ASSERT(ekk_heartbeat_next_deadline(&hb) == t + 3000 + period, "Next sender's deadline");
+
+    /* Removing from the middle keeps index and heap consistent */
+    ekk_heartbeat_remove_neighbor(&hb, 3);
+    TEST_ASSERT(ekk_heartbeat_get_health(&hb, 3) == EKK_HEALTH_UNKNOWN, "Removed neighbor untracked");
+    TEST_ASSERT(ekk_heartbeat_next_deadline(&hb) == t + 6000 + period, "Removed deadline dropped");
+    TEST_ASSERT(ekk_heartbeat_get_health(&hb, 4) == EKK_HEALTH_ALIVE, "Shifted neighbor found");
+
+    /* Randomized against the full-scan rule: missed = silence / period */
+    ekk_heartbeat_init(&hb, 1, &config);
+    for (uint32_t i = 0; i < 64; i++) {
+        ekk_heartbeat_add_neighbor(&hb, (ekk_module_id_t)(i + 2));
+        last[i] = 0;
+    }
+    uint32_t rng = 12345;
+    for (uint32_t step = 0; step < 400; step++) {
+        t += 1000;
+        for (uint32_t i = 0; i < 64; i++) {
+            rng = rng * 1103515245u + 12345u;
+            if (((rng >> 16) % 100) < (i % 4 == 0 ? 2u : 15u)) {
+                ekk_heartbeat_received(&hb, (ekk_module_id_t)(i + 2), 0, t);
+                last[i] = t;
+            }
+        }
+        ekk_heartbeat_tick(&hb, t);
+
+        for (uint32_t i = 0; i < 64; i++) {
+            ekk_health_state_t expect = EKK_HEALTH_UNKNOWN;
+            if (last[i] != 0) {
+                ekk_time_us_t missed = (t - last[i]) / period;
+                expect = (missed == 0) ? EKK_HEALTH_ALIVE :
+                         (missed < config.timeout_count) ? EKK_HEALTH_SUSPECT : EKK_HEALTH_DEAD;
+            }
+            TEST_ASSERT(ekk_heartbeat_get_health(&hb, (ekk_module_id_t)(i + 2)) == expect,
+                        "Deadline tick should match the full scan");
+        }
+    }
+
+    TEST_PASS("test_heartbeat_deadlines");
+    return 0;
+}
+
+/* ============================================================================
+ * TEST: Measured Latency (echo RTT + EKK_DISTANCE_LATENCY)
+ * ============================================================================ */
+
+static ekk_module_id_t g_latency_id;
+static ekk_time_us_t g_latency_rtt;
+
+static void record_latency(ekk_module_id_t id, ekk_time_us_t rtt)
+{
+    g_latency_id = id;
+    g_latency_rtt = rtt;
+}
+
+/** Next queued HAL message of one type (loopback), false if none */
+static bool recv_type(ekk_msg_type_t want, void *buf, uint32_t size)
+{
+    ekk_module_id_t sender;
+    ekk_msg_type_t type;
+    uint32_t len = size;
+    while (ekk_hal_recv(&sender, &type, buf, &len) == EKK_OK) {
+        if (type == want) {
+            return true;
+        }
+        len = size;
+    }
+    return false;
+}
+
+static int test_latency(void)
+{
+    static ekk_heartbeat_t prober, peer;
+    ekk_heartbeat_config_t config = EKK_HEARTBEAT_CONFIG_DEFAULT;
+    config.auto_broadcast = false;
+    config.track_latency = true;
+    uint8_t buf[64];
+
+    /* Drop anything earlier tests left on the loopback queue */
+    ekk_module_id_t sender;
+    ekk_msg_type_t type;
+    uint32_t len = sizeof(buf);
+    while (ekk_hal_recv(&sender, &type, buf, &len) == EKK_OK) {
+        len = sizeof(buf);
+    }
+
+    ekk_heartbeat_init(&prober, 1, &config);
+    ekk_heartbeat_init(&peer, 2, NULL);
+    ekk_heartbeat_add_neighbor(&prober, 2);
+    ekk_heartbeat_set_latency_callback(&prober, record_latency);
+
+    /* Probe -> reply -> sample */
+    ekk_time_us_t t = 80000000;
+    ekk_heartbeat_tick(&prober, t);
+    TEST_ASSERT(recv_type(EKK_MSG_ECHO, buf, sizeof(buf)), "Tick should send a probe");
+    ekk_echo_msg_t probe;
+    memcpy(&probe, buf, sizeof(probe));
+    TEST_ASSERT(probe.target_id == 2 && probe.reply == 0, "Probe should target the neighbor");
+
+    TEST_ASSERT(ekk_heartbeat_on_echo(&peer, &probe, t + 100) == EKK_OK, "Peer should reply");
+    TEST_ASSERT(recv_type(EKK_MSG_ECHO, buf, sizeof(buf)), "Reply should be sent");
+    ekk_echo_msg_t reply;
+    memcpy(&reply, buf, sizeof(reply));
+    TEST_ASSERT(reply.reply == 1 && reply.token == probe.token, "Reply echoes the token");
+
+    TEST_ASSERT(ekk_heartbeat_on_echo(&prober, &reply, t + 400) == EKK_OK, "Reply should match");
+    TEST_ASSERT(g_latency_id == 2 && g_latency_rtt == 400, "First sample seeds the RTT");
+    TEST_ASSERT(ekk_heartbeat_on_echo(&prober, &reply, t + 500) == EKK_ERR_NOT_FOUND,
+                "Duplicate reply should be ignored");
+
+    /* Second sample is smoothed */
+    ekk_heartbeat_tick(&prober, t + config.period);
+    recv_type(EKK_MSG_ECHO, buf, sizeof(buf));
+    memcpy(&probe, buf, sizeof(probe));
+    reply = probe;
+    reply.sender_id = 2;
+    reply.target_id = 1;
+    reply.reply = 1;
+    ekk_heartbeat_on_echo(&prober, &reply, t + config.period + 1200);
+    TEST_ASSERT(ekk_heartbeat_get_latency(&prober, 2) == (400 * 7 + 1200) / 8, "EWMA 1/8");
+
+    /* Topology ranks by RTT, unmeasured modules last by logical distance */
+    static ekk_topology_t topo;
+    ekk_topology_config_t tcfg = EKK_TOPOLOGY_CONFIG_DEFAULT;
+    tcfg.metric = EKK_DISTANCE_LATENCY;
+    tcfg.k_neighbors = 3;
+    ekk_position_t origin = {0, 0, 0};
+    ekk_topology_init(&topo, 10, origin, &tcfg);
+    for (ekk_module_id_t id = 11; id <= 16; id++) {
+        ekk_topology_on_discovery(&topo, id, origin);
+    }
+    TEST_ASSERT(topo.neighbors[0].id == 11 && topo.neighbors[2].id == 13,
+                "Unmeasured modules rank by ID proximity");
+
+    ekk_topology_on_latency(&topo, 16, 100);
+    ekk_topology_on_latency(&topo, 15, 110);
+    TEST_ASSERT(topo.neighbors[0].id == 16 && topo.neighbors[1].id == 15 &&
+                topo.neighbors[2].id == 11, "Measured modules should rank first");
+
+    /* Inside the hysteresis band: no change */
+    ekk_topology_on_latency(&topo, 16, 120);
+    TEST_ASSERT(topo.neighbors[0].id == 16, "Jitter should not reorder neighbors");
+
+    /* Beyond it: 16 falls behind 15 */
+    ekk_topology_on_latency(&topo, 16, 140);
+    TEST_ASSERT(topo.neighbors[0].id == 15 && topo.neighbors[1].id == 16,
+                "A real slowdown should reorder neighbors");
+
+    TEST_PASS("test_latency");
+    return 0;
+}
+
+static int test_heartbeat_piggyback(void)
+{
+    static ekk_heartbeat_t hb;
+    static ekk_module_t mod;
+    ekk_heartbeat_config_t config = EKK_HEARTBEAT_CONFIG_DEFAULT;
+    const ekk_time_us_t period = config.period;
+    ekk_time_us_t t = 50000000;
+    uint8_t buf[64];
+
+    drain_hal();
+
+    /* A discovery broadcast carries the sequence and replaces the heartbeat */
+    ekk_heartbeat_init(&hb, 1, &config);
+    ekk_discovery_msg_t disc = {.msg_type = EKK_MSG_DISCOVERY, .sender_id = 1};
+    TEST_ASSERT(ekk_heartbeat_piggyback(&hb, EKK_MSG_DISCOVERY, &disc, sizeof(disc), t) == EKK_OK,
+                "Piggyback broadcast should succeed");
+    ekk_module_id_t sender;
+    ekk_msg_type_t type;
+    uint32_t len = sizeof(buf);
+    TEST_ASSERT(ekk_hal_recv(&sender, &type, buf, &len) == EKK_OK, "Frame should be queued");
+    TEST_ASSERT(len == sizeof(disc) + EKK_HEARTBEAT_TRAILER_SIZE && buf[sizeof(disc)] == 0 &&
+                buf[0] == (EKK_MSG_DISCOVERY | EKK_HEARTBEAT_TRAILER_FLAG),
+                "Frame should carry the flagged heartbeat trailer");
+    ekk_heartbeat_tick(&hb, t + period / 2);
+    TEST_ASSERT(!recv_type(EKK_MSG_HEARTBEAT, buf, sizeof(buf)), "No explicit heartbeat needed");
+    ekk_heartbeat_tick(&hb, t + period);
+    TEST_ASSERT(recv_type(EKK_MSG_HEARTBEAT, buf, sizeof(buf)), "Quiet period sends a heartbeat");
+
+    /* Receive side: trailer sequence, then a plain frame, both count */
+    ekk_position_t pos = {0, 0, 0};
+    ekk_module_init(&mod, 30, "piggyback", pos);
+    mod.topology.config.metric = EKK_DISTANCE_PHYSICAL;
+    memset(buf, 0, sizeof(buf));
+    ekk_discovery_msg_t peer = {
+        .msg_type = EKK_MSG_DISCOVERY,
+        .sender_id = 31,
+        .position = {3, 0, 0},
+    };
+    memcpy(buf, &peer, sizeof(peer));
+    buf[0] |= EKK_HEARTBEAT_TRAILER_FLAG;
+    buf[sizeof(peer)] = 7;
+    ekk_module_on_message(&mod, 31, EKK_MSG_DISCOVERY, buf, sizeof(peer) + 1, t);
+    TEST_ASSERT(ekk_heartbeat_get_health(&mod.heartbeat, 31) == EKK_HEALTH_ALIVE,
+                "Discovery should prove liveness");
+    TEST_ASSERT(mod.heartbeat.neighbors[0].sequence == 7, "Trailer sequence should be recorded");
+
+    ekk_vote_msg_t vote = {.msg_type = EKK_MSG_VOTE, .voter_id = 31, .ballot_id = 99};
+    ekk_module_on_message(&mod, 31, EKK_MSG_VOTE, &vote, sizeof(vote), t + period);
+    TEST_ASSERT(mod.heartbeat.neighbors[0].last_seen == t + period, "Any frame should refresh liveness");
+
+    /* DLC padding after an unflagged body is not a trailer */
+    memset(buf, 0, sizeof(buf));
+    memcpy(buf, &vote, sizeof(vote));
+    buf[sizeof(vote)] = 9;
+    ekk_module_on_message(&mod, 31, EKK_MSG_VOTE, buf, sizeof(vote) + 4, t + 2 * period);
+    TEST_ASSERT(mod.heartbeat.neighbors[0].sequence == 7 &&
+                mod.heartbeat.neighbors[0].last_seen == t + 2 * period,
+                "Padding should count as a plain frame, not a sequence");
+
+    /* Liveness goes to the transport sender, not the ID in the payload;
+     * a vote in another module's name is dropped and credits nobody */
+    ekk_heartbeat_add_neighbor(&mod.heartbeat, 32);
+    ekk_module_on_message(&mod, 32, EKK_MSG_VOTE, &vote, sizeof(vote), t + 3 * period);
+    TEST_ASSERT(mod.heartbeat.neighbors[0].last_seen == t + 2 * period &&
+                mod.heartbeat.neighbors[1].last_seen == 0,
+                "Forged vote must not be credited");
+    memcpy(buf, &peer, sizeof(peer));
+    ekk_module_on_message(&mod, 32, EKK_MSG_DISCOVERY, buf, sizeof(peer), t + 4 * period);
+    TEST_ASSERT(mod.heartbeat.neighbors[0].last_seen == t + 2 * period,
+                "Payload sender ID must not be credited");
+    TEST_ASSERT(mod.heartbeat.neighbors[1].last_seen == t + 4 * period,
+                "Transport sender should be credited");
+
+    drain_hal();
+
+    TEST_PASS("test_heartbeat_piggyback");
+    return 0;
+}
+
+/**
+ * @brief Raft majority over more than 255 voters
+ */
+static int test_raft_large_cluster(void)
+{
+    static ekk_raft_ctx_t raft;
+    const uint16_t voters = 300;
+    ekk_time_us_t t = 80000000;
+#if EKK_MODULE_ID_BITS > 8
+    const ekk_module_id_t base = 1000;     /* Voter IDs beyond 8 bits too */
+#else
+    const ekk_module_id_t base = 1;
+#endif
+
+    drain_hal();
+    TEST_ASSERT(ekk_raft_init(&raft, base, voters, NULL) == EKK_OK, "Raft init should succeed");
+    TEST_ASSERT(raft.total_voters == voters && raft.votes_needed == 151,
+                "Majority should be computed over all voters");
+
+    ekk_raft_tick(&raft, t);
+    t += raft.election_timeout;
+    ekk_raft_tick(&raft, t);
+    TEST_ASSERT(ekk_raft_get_state(&raft) == EKK_RAFT_CANDIDATE, "Timeout should start an election");
+    uint32_t term = ekk_raft_get_term(&raft);
+
+    /* Own vote plus 149 others: one short */
+    for (ekk_module_id_t i = 1; i < 150; i++) {
+        ekk_raft_on_vote_response(&raft, (ekk_module_id_t)(base + i), term, true, t);
+    }
+    ekk_raft_on_vote_response(&raft, (ekk_module_id_t)(base + 1), term, true, t);
+    TEST_ASSERT(raft.votes_received == 150 && ekk_raft_get_state(&raft) == EKK_RAFT_CANDIDATE,
+                "150 of 300 votes is no majority; repeats must not count");
+
+    ekk_raft_on_vote_response(&raft, (ekk_module_id_t)(base + 150), term, true, t);
+    TEST_ASSERT(ekk_raft_get_state(&raft) == EKK_RAFT_LEADER, "151 of 300 votes should elect");
+
+    drain_hal();
+
+    TEST_PASS("test_raft_large_cluster");
+    return 0;
+}
+
+/**
+ * @brief A neighbor coming (back) alive keeps its discovered position
+ */
+static int test_module_alive_keeps_position(void)
+{
+    static ekk_module_t mod;
+    ekk_position_t pos = {0, 0, 0};
+    ekk_time_us_t t = 70000000;
+
+    drain_hal();
+    ekk_module_init(&mod, 40, "alive", pos);
+    mod.topology.config.metric = EKK_DISTANCE_PHYSICAL;
+
+    ekk_discovery_msg_t peer = {
+        .msg_type = EKK_MSG_DISCOVERY,
+        .sender_id = 41,
+        .position = {3, 0, 0},
+    };
+    ekk_module_on_message(&mod, 41, EKK_MSG_DISCOVERY, &peer, sizeof(peer), t);
+    TEST_ASSERT(ekk_heartbeat_get_health(&mod.heartbeat, 41) == EKK_HEALTH_ALIVE,
+                "First contact should mark the neighbor alive");
+    TEST_ASSERT(ekk_topology_get_neighbor(&mod.topology, 41)->logical_distance == 3,
+                "First contact must not reset the discovered position");
+
+    /* Suspect, then heard again: the alive callback fires once more */
+    ekk_time_us_t quiet = mod.heartbeat.config.period * 4;
+    ekk_heartbeat_tick(&mod.heartbeat, t + quiet);
+    TEST_ASSERT(ekk_heartbeat_get_health(&mod.heartbeat, 41) == EKK_HEALTH_SUSPECT,
+                "Quiet neighbor should become suspect");
+    ekk_heartbeat_received(&mod.heartbeat, 41, 1, t + quiet + 1);
+    TEST_ASSERT(ekk_heartbeat_get_health(&mod.heartbeat, 41) == EKK_HEALTH_ALIVE,
+                "Heartbeat should revive the neighbor");
+    TEST_ASSERT(ekk_topology_get_neighbor(&mod.topology, 41)->logical_distance == 3,
+                "Revival must not reset the discovered position");
+
+    drain_hal();
+
+    TEST_PASS("test_module_alive_keeps_position");
+    return 0;
+}
+
+/**
+ * @brief Count explicit heartbeats while unicast traffic carries trailers
+ */
+static int test_heartbeat_trailer_coverage(void)
+{
+    static ekk_heartbeat_t hb;
+    ekk_heartbeat_config_t config = EKK_HEARTBEAT_CONFIG_DEFAULT;
+    const ekk_time_us_t period = config.period;
+    ekk_time_us_t t = 60000000;
+    uint8_t buf[64];
+    uint32_t explicit_hb;
+
+    drain_hal();
+    ekk_heartbeat_init(&hb, 1, &config);
+    ekk_heartbeat_add_neighbor(&hb, 2);
+    ekk_heartbeat_add_neighbor(&hb, 3);
+    ekk_heartbeat_tick(&hb, t);
+    drain_hal();
+
+    /* Steady traffic: a vote to every neighbor each period */
+    explicit_hb = 0;
+    for (uint32_t i = 1; i <= 20; i++) {
+        ekk_vote_msg_t vote = {.msg_type = EKK_MSG_VOTE, .voter_id = 1, .ballot_id = 5};
+        TEST_ASSERT(ekk_heartbeat_piggyback_to(&hb, 2, EKK_MSG_VOTE, &vote, sizeof(vote),
+                                               t + (i - 1) * period + 10) == EKK_OK &&
+                    ekk_heartbeat_piggyback_to(&hb, 3, EKK_MSG_VOTE, &vote, sizeof(vote),
+                                               t + (i - 1) * period + 20) == EKK_OK,
+                    "Unicast piggyback should succeed");
+        ekk_heartbeat_tick(&hb, t + i * period);
+        while (recv_type(EKK_MSG_HEARTBEAT, buf, sizeof(buf))) {
+            explicit_hb++;
+        }
+    }
+    TEST_ASSERT(explicit_hb == 0, "Covered periods should need no explicit heartbeat");
+    t += 20 * period;
+
+    /* Traffic to one neighbor only: the other still needs heartbeats */
+    explicit_hb = 0;
+    for (uint32_t i = 1; i <= 5; i++) {
+        ekk_vote_msg_t vote = {.msg_type = EKK_MSG_VOTE, .voter_id = 1, .ballot_id = 6};
+        ekk_heartbeat_piggyback_to(&hb, 2, EKK_MSG_VOTE, &vote, sizeof(vote),
+                                   t + (i - 1) * period + 10);
+        ekk_heartbeat_tick(&hb, t + i * period);
+        while (recv_type(EKK_MSG_HEARTBEAT, buf, sizeof(buf))) {
+            explicit_hb++;
+        }
+    }
+    TEST_ASSERT(explicit_hb == 5, "Uncovered neighbor should get a heartbeat every period");
+    t += 5 * period;
+
+    /* Echo frames carry the trailer too */
+    ekk_echo_msg_t echo = {.msg_type = EKK_MSG_ECHO, .sender_id = 2, .target_id = 1, .token = 4};
+    TEST_ASSERT(ekk_heartbeat_on_echo(&hb, &echo, t) == EKK_OK, "Echo should be answered");
+    uint32_t len = sizeof(buf);
+    ekk_module_id_t sender;
+    ekk_msg_type_t type;
+    TEST_ASSERT(ekk_hal_recv(&sender, &type, buf, &len) == EKK_OK && type == EKK_MSG_ECHO &&
+                len == sizeof(echo) + EKK_HEARTBEAT_TRAILER_SIZE &&
+                (buf[0] & EKK_HEARTBEAT_TRAILER_FLAG) != 0,
+                "Echo reply should carry the trailer");
+
+    drain_hal();
+
+    TEST_PASS("test_heartbeat_trailer_coverage");
+    return 0;
+}
+
+static int test_consensus_pipeline(void)
+{
+    static ekk_consensus_t a, b;
+    ekk_ballot_id_t ids[EKK_MAX_BALLOTS];
+    ekk_ballot_id_t id;
+
+    drain_hal();
+    ekk_consensus_init(&a, 2, NULL);
+    ekk_consensus_init(&b, 3, NULL);
+
+    /* Proposers allocate from disjoint ID ranges */
+    TEST_ASSERT(ekk_consensus_propose(&a, EKK_PROPOSAL_MODE_CHANGE, 1,
+                                      EKK_THRESHOLD_SUPERMAJORITY, &ids[0]) == EKK_OK,
+                "First proposal should succeed");
+    TEST_ASSERT(ekk_consensus_propose(&b, EKK_PROPOSAL_MODE_CHANGE, 2,
+                                      EKK_THRESHOLD_SUPERMAJORITY, &id) == EKK_OK,
+                "Peer proposal should succeed");
+    TEST_ASSERT(id != ids[0], "Ballot IDs from different proposers must not collide");
+    TEST_ASSERT(ekk_consensus_on_proposal(&b, 2, a.incarnation, ids[0],
+                                          EKK_PROPOSAL_MODE_CHANGE, 1,
+                                          EKK_THRESHOLD_SUPERMAJORITY) == EKK_OK,
+                "Remote proposal should be tracked next to our own");
+    TEST_ASSERT(b.active_ballot_count == 2, "Both ballots should be active");
+    TEST_ASSERT(ekk_consensus_on_vote(&b, 5, 2, ids[0], EKK_VOTE_YES) == EKK_ERR_INVALID_ARG,
+                "Votes for a remote ballot belong to its proposer");
+    drain_hal();
+
+    /* Pipeline: every slot can hold an in-flight proposal */
+    for (uint32_t i = 1; i < EKK_MAX_BALLOTS; i++) {
+        TEST_ASSERT(ekk_consensus_propose(&a, EKK_PROPOSAL_POWER_LIMIT, i,
+                                          EKK_THRESHOLD_SUPERMAJORITY, &ids[i]) == EKK_OK,
+                    "Pipelined proposal should succeed");
+        TEST_ASSERT(ids[i] != ids[i - 1], "Pipelined IDs should be unique");
+        drain_hal();
+    }
+    TEST_ASSERT(ekk_consensus_propose(&a, EKK_PROPOSAL_SHUTDOWN, 0,
+                                      EKK_THRESHOLD_SUPERMAJORITY, &id) == EKK_ERR_BUSY,
+                "Table full of pending ballots should refuse");
+    for (uint32_t i = 0; i < EKK_MAX_BALLOTS; i++) {
+        TEST_ASSERT(ekk_consensus_get_result(&a, ids[i]) == EKK_VOTE_PENDING,
+                    "Every ballot should be found by ID");
+    }
+
+    /* A completed ballot frees its slot without waiting for a tick */
+    ekk_consensus_inhibit(&a, ids[3]);
+    drain_hal();
+    TEST_ASSERT(ekk_consensus_propose(&a, EKK_PROPOSAL_SHUTDOWN, 0,
+                                      EKK_THRESHOLD_SUPERMAJORITY, &id) == EKK_OK,
+                "Completed ballot should be reclaimed for a new proposal");
+    drain_hal();
+    for (uint32_t i = 0; i < EKK_MAX_BALLOTS; i++) {
+        ekk_vote_result_t r = ekk_consensus_get_result(&a, ids[i]);
+        TEST_ASSERT(r == ((i == 3) ? EKK_VOTE_CANCELLED : EKK_VOTE_PENDING),
+                    "Index should survive slot reuse");
+    }
+
+    /* History ring answers queries and late voters after cleanup */
+    TEST_ASSERT(ekk_consensus_on_vote(&a, 5, 2, ids[3], EKK_VOTE_YES) == EKK_OK,
+                "Late vote should be ignored, not rejected");
+    TEST_ASSERT(ekk_consensus_vote(&a, ids[3], EKK_VOTE_YES) == EKK_ERR_BUSY,
+                "Completed ballot should not accept votes");
+    ekk_consensus_tick(&a, ekk_hal_time_us() + EKK_VOTE_TIMEOUT_US + 1);
+    drain_hal();
+    TEST_ASSERT(a.active_ballot_count == 0, "Tick should retire timed-out ballots");
+    TEST_ASSERT(ekk_consensus_get_result(&a, id) != EKK_VOTE_PENDING,
+                "Outcome at the deadline should be remembered");
+    TEST_ASSERT(EKK_BALLOT_HISTORY > EKK_MAX_BALLOTS ||
+                ekk_consensus_get_result(&a, ids[3]) == EKK_VOTE_PENDING,
+                "Oldest outcome should age out of the ring");
+    TEST_ASSERT(ekk_consensus_on_proposal(&b, 2, a.incarnation, ids[0],
+                                          EKK_PROPOSAL_MODE_CHANGE, 1,
+                                          EKK_THRESHOLD_SUPERMAJORITY) == EKK_OK &&
+                b.active_ballot_count == 2,
+                "Re-broadcast proposal should not be tracked twice");
+    drain_hal();
+
+    TEST_PASS("test_consensus_pipeline");
+    return 0;
+}
+
+static int test_consensus_decision(void)
+{
+    static ekk_consensus_t a, b;
+    ekk_ballot_id_t ids[3];
+    uint8_t buf[64];
+
+    drain_hal();
+    ekk_consensus_init(&a, 2, NULL);
+    ekk_consensus_init(&b, 3, NULL);
+    ekk_time_us_t t = ekk_hal_time_us();
+
+    for (uint32_t i = 0; i < 3; i++) {
+        ekk_consensus_propose(&a, EKK_PROPOSAL_POWER_LIMIT, i,
+                              EKK_THRESHOLD_SIMPLE_MAJORITY, &ids[i]);
+        ekk_consensus_on_proposal(&b, 2, a.incarnation, ids[i], EKK_PROPOSAL_POWER_LIMIT,
+                                  i, EKK_THRESHOLD_SIMPLE_MAJORITY);
+    }
+    drain_hal();
+
+    /* Votes for one proposer leave in a single frame */
+    ekk_consensus_tick(&b, t);
+    TEST_ASSERT(recv_type(EKK_MSG_VOTE_BATCH, buf, sizeof(buf)), "Votes should be batched");
+    ekk_vote_batch_msg_t batch;
+    memcpy(&batch, buf, sizeof(batch));
+    TEST_ASSERT(batch.voter_id == 3 && batch.proposer_id == 2 && batch.count == 3 &&
+                batch.entries[2].ballot_id == ids[2] && batch.entries[2].vote == EKK_VOTE_YES,
+                "Batch should carry every queued vote");
+    TEST_ASSERT(!recv_type(EKK_MSG_VOTE, buf, sizeof(buf)), "No per-ballot vote frames");
+
+    /* Proposer certifies as soon as the threshold is crossed */
+    for (uint32_t i = 0; i < batch.count; i++) {
+        ekk_consensus_on_vote(&a, batch.voter_id, batch.proposer_id, batch.entries[i].ballot_id,
+                              (ekk_vote_value_t)batch.entries[i].vote);
+    }
+    ekk_consensus_on_vote(&a, 4, 2, ids[0], EKK_VOTE_YES);
+    TEST_ASSERT(!recv_type(EKK_MSG_DECISION, buf, sizeof(buf)), "Below threshold: no certificate");
+    ekk_consensus_on_vote(&a, 5, 2, ids[0], EKK_VOTE_YES);
+    TEST_ASSERT(ekk_consensus_get_result(&a, ids[0]) == EKK_VOTE_APPROVED, "4 of 7 should approve");
+    TEST_ASSERT(recv_type(EKK_MSG_DECISION, buf, sizeof(buf)), "Approval should be broadcast");
+    ekk_decision_msg_t dec;
+    memcpy(&dec, buf, sizeof(dec));
+    TEST_ASSERT(dec.proposer_id == 2 && dec.incarnation == a.incarnation &&
+                dec.ballot_id == ids[0] &&
+                dec.result == EKK_VOTE_APPROVED && dec.yes_count == 4,
+                "Certificate should carry the outcome");
+
+    /* Voter finishes on the certificate, long before its deadline */
+    TEST_ASSERT(ekk_consensus_on_decision(&b, 9, a.incarnation, ids[0],
+                                          EKK_VOTE_APPROVED, 7, 7) == EKK_ERR_INVALID_ARG &&
+                ekk_consensus_get_result(&b, ids[0]) == EKK_VOTE_PENDING,
+                "Only the proposer can decide its ballot");
+    TEST_ASSERT(ekk_consensus_on_decision(&b, 2, a.incarnation, ids[0],
+                                          EKK_VOTE_APPROVED, 3, 7) == EKK_ERR_INVALID_ARG &&
+                ekk_consensus_on_decision(&b, 2, a.incarnation, ids[0],
+                                          EKK_VOTE_APPROVED, 5, 4) == EKK_ERR_INVALID_ARG &&
+                ekk_consensus_on_decision(&b, 2, a.incarnation, ids[0],
+                                          EKK_VOTE_REJECTED, 6, 7) == EKK_ERR_INVALID_ARG &&
+                ekk_consensus_get_result(&b, ids[0]) == EKK_VOTE_PENDING,
+                "Counts short of the threshold should not decide");
+    ekk_consensus_on_decision(&b, dec.proposer_id, dec.incarnation, dec.ballot_id,
+                              (ekk_vote_result_t)dec.result, dec.yes_count, dec.vote_count);
+    TEST_ASSERT(ekk_consensus_get_result(&b, ids[0]) == EKK_VOTE_APPROVED,
+                "Certificate should decide the voter's copy");
+
+    /* A certificate for a missed proposal is held until the proposal shows the threshold */
+    ekk_ballot_id_t missed = (ekk_ballot_id_t)(ids[2] + 1);
+    ekk_consensus_on_decision(&b, 2, a.incarnation, missed, EKK_VOTE_REJECTED, 1, 5);
+    TEST_ASSERT(ekk_consensus_get_result(&b, missed) == EKK_VOTE_PENDING,
+                "Unverified certificate should not answer queries");
+    ekk_consensus_on_proposal(&b, 2, a.incarnation, missed, EKK_PROPOSAL_POWER_LIMIT,
+                              9, EKK_THRESHOLD_SIMPLE_MAJORITY);
+    TEST_ASSERT(ekk_consensus_get_result(&b, missed) == EKK_VOTE_REJECTED,
+                "Late proposal should not reopen a decided ballot");
+
+    /* A forged early certificate does not suppress the real proposal */
+    ekk_ballot_id_t forged = (ekk_ballot_id_t)(missed + 1);
+    ekk_consensus_on_decision(&b, 2, a.incarnation, forged, EKK_VOTE_APPROVED, 1, 7);
+    ekk_consensus_on_proposal(&b, 2, a.incarnation, forged, EKK_PROPOSAL_POWER_LIMIT,
+                              9, EKK_THRESHOLD_SIMPLE_MAJORITY);
+    TEST_ASSERT(ekk_consensus_get_result(&b, forged) == EKK_VOTE_PENDING,
+                "Invalid held certificate should let the ballot open");
+
+    /* Certificates and vote batches need a MAC like proposals and votes */
+    TEST_ASSERT(ekk_auth_is_required(EKK_MSG_DECISION) == (EKK_AUTH_REQUIRED_PROPOSAL != 0) &&
+                ekk_auth_is_required(EKK_MSG_VOTE_BATCH) == (EKK_AUTH_REQUIRED_VOTE != 0) &&
+                ekk_auth_is_required(EKK_MSG_DECISION) && ekk_auth_is_required(EKK_MSG_VOTE_BATCH),
+                "DECISION and VOTE_BATCH should require authentication");
+
+    /* Without a certificate the voter cannot know the outcome */
+    ekk_consensus_tick(&b, t + EKK_VOTE_TIMEOUT_US * 2);
+    TEST_ASSERT(ekk_consensus_get_result(&b, ids[1]) == EKK_VOTE_TIMEOUT,
+                "Uncertified remote ballot should time out");
+    drain_hal();
+
+    TEST_PASS("test_consensus_decision");
+    return 0;
+}
+
+static int test_consensus_restart(void)
+{
+    static ekk_consensus_t a, b;
+    ekk_ballot_id_t first, second, id;
+
+    drain_hal();
+    ekk_consensus_init(&a, 2, NULL);
+    ekk_consensus_init(&b, 3, NULL);
+    ekk_consensus_set_incarnation(&a, 1);
+    ekk_time_us_t t = ekk_hal_time_us();
+
+    /* b holds an outcome and an inhibition for a's first two ballots */
+    ekk_consensus_propose(&a, EKK_PROPOSAL_MODE_CHANGE, 1, EKK_THRESHOLD_SIMPLE_MAJORITY, &first);
+    ekk_consensus_propose(&a, EKK_PROPOSAL_MODE_CHANGE, 2, EKK_THRESHOLD_SIMPLE_MAJORITY, &second);
+    ekk_consensus_on_proposal(&b, 2, a.incarnation, first, EKK_PROPOSAL_MODE_CHANGE, 1,
+                              EKK_THRESHOLD_SIMPLE_MAJORITY);
+    ekk_consensus_on_proposal(&b, 2, a.incarnation, second, EKK_PROPOSAL_MODE_CHANGE, 2,
+                              EKK_THRESHOLD_SIMPLE_MAJORITY);
+    ekk_consensus_on_decision(&b, 2, a.incarnation, first, EKK_VOTE_APPROVED, 4, 4);
+    ekk_consensus_on_vote(&b, 4, 2, second, EKK_VOTE_INHIBIT);
+    ekk_consensus_tick(&b, t);
+    drain_hal();
+    TEST_ASSERT(ekk_consensus_get_result(&b, first) == EKK_VOTE_APPROVED &&
+                b.active_ballot_count == 0, "First ballot should be decided and retired");
+
+    /* a restarts and numbers its ballots from the start of its range again */
+    ekk_consensus_init(&a, 2, NULL);
+    ekk_consensus_set_incarnation(&a, 2);
+    ekk_consensus_propose(&a, EKK_PROPOSAL_POWER_LIMIT, 3, EKK_THRESHOLD_SIMPLE_MAJORITY, &id);
+    TEST_ASSERT(id == first, "Restarted proposer should reuse its first ID");
+    TEST_ASSERT(ekk_consensus_on_proposal(&b, 2, a.incarnation, id, EKK_PROPOSAL_POWER_LIMIT, 3,
+                                          EKK_THRESHOLD_SIMPLE_MAJORITY) == EKK_OK &&
+                ekk_consensus_get_result(&b, id) == EKK_VOTE_PENDING &&
+                b.active_ballot_count == 1,
+                "New incarnation's ballot should open, not match the old outcome");
+    ekk_consensus_propose(&a, EKK_PROPOSAL_POWER_LIMIT, 4, EKK_THRESHOLD_SIMPLE_MAJORITY, &id);
+    TEST_ASSERT(id == second &&
+                ekk_consensus_on_proposal(&b, 2, a.incarnation, id, EKK_PROPOSAL_POWER_LIMIT, 4,
+                                          EKK_THRESHOLD_SIMPLE_MAJORITY) == EKK_OK,
+                "Old incarnation's inhibition should not block the new ballot");
+    TEST_ASSERT(ekk_consensus_on_proposal(&b, 2, a.incarnation, id, EKK_PROPOSAL_POWER_LIMIT, 4,
+                                          EKK_THRESHOLD_SIMPLE_MAJORITY) == EKK_OK &&
+                b.active_ballot_count == 2,
+                "Same incarnation should still be deduplicated");
+    drain_hal();
+
+#if EKK_MODULE_ID_BITS > 8
+    /* Module 2 + 2^(16 - SEQ_BITS) shares module 2's range */
+    static ekk_consensus_t c;
+    ekk_module_id_t twin = (ekk_module_id_t)(2u + (1u << (16 - EKK_BALLOT_SEQ_BITS)));
+    ekk_consensus_init(&c, twin, NULL);
+    ekk_consensus_propose(&c, EKK_PROPOSAL_SHUTDOWN, 0, EKK_THRESHOLD_SIMPLE_MAJORITY, &id);
+    TEST_ASSERT(id == first, "Aliased proposers should allocate the same ID");
+
+    ekk_consensus_on_vote(&b, 4, 2, first, EKK_VOTE_INHIBIT);
+    TEST_ASSERT(ekk_consensus_on_proposal(&b, twin, c.incarnation, id, EKK_PROPOSAL_SHUTDOWN, 0,
+                                          EKK_THRESHOLD_SIMPLE_MAJORITY) == EKK_OK,
+                "Inhibiting one proposer should not block its alias");
+    TEST_ASSERT(ekk_consensus_on_proposal(&b, 2, a.incarnation, first, EKK_PROPOSAL_POWER_LIMIT, 3,
+                                          EKK_THRESHOLD_SIMPLE_MAJORITY) == EKK_ERR_INHIBITED,
+                "The inhibited proposer should stay inhibited");
+    ekk_consensus_on_decision(&b, twin, c.incarnation, id, EKK_VOTE_APPROVED, 4, 4);
+    ekk_consensus_tick(&b, t);
+    TEST_ASSERT(ekk_consensus_on_proposal(&b, twin, c.incarnation, id, EKK_PROPOSAL_SHUTDOWN, 0,
+                                          EKK_THRESHOLD_SIMPLE_MAJORITY) == EKK_OK &&
+                b.active_ballot_count == 1,
+                "Alias's outcome should be remembered under its own proposer");
+    drain_hal();
+#endif
+
+    TEST_PASS("test_consensus_restart");
+    return 0;
+}
+
+/* ============================================================================
+ * TEST: SPSC Batching (cached indices, push_n/pop_n, multi-slot acquire)
+ * ============================================================================ */
+
+#ifndef _WIN32
+#define SPSC_STRESS_ITEMS   200000
+
+static void *spsc_stress_producer(void *arg)
+{
+    ekk_spsc_t *q = (ekk_spsc_t *)arg;
+    uint32_t batch[12];
+    uint32_t next = 0;
+
+    while (next < SPSC_STRESS_ITEMS) {
+        uint32_t n = EKK_MIN(1u + next % 12u, SPSC_STRESS_ITEMS - next);
+        for (uint32_t i = 0; i < n; i++) {
+            batch[i] = next + i;
+        }
+        uint32_t pushed = ekk_spsc_push_n(q, batch, n);
+        if (pushed == 0) {
+            sched_yield();      /* Full: let the consumer run on a single core */
+        }
+        next += pushed;
+    }
+    return NULL;
+}
+#endif
+
+static int test_spsc_batch(void)
+{
+    uint32_t buffer[8];
+    uint32_t items[10];
+    uint32_t out[10];
+    ekk_spsc_t q;
+
+    for (uint32_t i = 0; i < 10; i++) {
+        items[i] = 100 + i;
+    }
+
+    ekk_spsc_init(&q, buffer, 8, sizeof(uint32_t));
+    TEST_ASSERT(ekk_spsc_push_n(&q, items, 5) == 5, "Batch pushed");
+    TEST_ASSERT(ekk_spsc_push_n(&q, items + 5, 5) == 2, "Batch clipped at capacity - 1");
+    TEST_ASSERT(ekk_spsc_pop_n(&q, out, 3) == 3 && out[0] == 100 && out[2] == 102,
+                "Batch popped in order");
+
+    /* Wrapping batch after the producer's cached tail went stale */
+    TEST_ASSERT(ekk_spsc_push_n(&q, items, 3) == 3, "Wrapping batch pushed");
+    TEST_ASSERT(ekk_spsc_pop_n(&q, out, 10) == 7, "Everything popped");
+    TEST_ASSERT(out[0] == 103 && out[3] == 106 && out[4] == 100 && out[6] == 102,
+                "Wrapped batch kept order");
+    TEST_ASSERT(ekk_spsc_pop_n(&q, out, 1) == 0 && ekk_spsc_is_empty(&q), "Empty");
+
+    /* Multi-slot acquire stops at the buffer end; one commit publishes the run */
+    uint32_t granted = 0;
+    uint32_t *slots = ekk_spsc_push_acquire_n(&q, 10, &granted);
+    TEST_ASSERT(slots != NULL && granted == 6, "Contiguous run up to the buffer end");
+    for (uint32_t i = 0; i < granted; i++) {
+        slots[i] = 200 + i;
+    }
+    TEST_ASSERT(ekk_spsc_len(&q) == 0, "Nothing visible before commit");
+    ekk_spsc_push_commit_n(&q, granted);
+    TEST_ASSERT(ekk_spsc_len(&q) == 6, "Run visible after one commit");
+
+    uint32_t avail = 0;
+    const uint32_t *run = ekk_spsc_pop_peek_n(&q, 4, &avail);
+    TEST_ASSERT(run != NULL && avail == 4 && run[0] == 200 && run[3] == 203, "Batch peeked in place");
+    ekk_spsc_pop_release_n(&q, avail);
+    TEST_ASSERT(ekk_spsc_len(&q) == 2 && ekk_spsc_pop(&q, out) == EKK_OK && out[0] == 204,
+                "Release freed the peeked run");
+
+#ifndef _WIN32
+    /* Cross-thread: ordered, nothing lost or duplicated */
+    static uint32_t stress_buffer[64];
+    ekk_spsc_init(&q, stress_buffer, 64, sizeof(uint32_t));
+    pthread_t producer;
+    pthread_create(&producer, NULL, spsc_stress_producer, &q);
+
+    uint32_t expect = 0;
+    bool ordered = true;
+    while (expect < SPSC_STRESS_ITEMS) {
+        uint32_t n = ekk_spsc_pop_n(&q, out, 10);
+        if (n == 0) {
+            sched_yield();
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            if (out[i] != expect++) {
+                ordered = false;
+            }
+        }
+    }
+    pthread_join(producer, NULL);
+    TEST_ASSERT(ordered && ekk_spsc_is_empty(&q), "Cross-thread batches arrive in order");
+#endif
+
+    TEST_PASS("test_spsc_batch");
+    return 0;
+}
+
 /* ============================================================================
  * TEST: Task Management
  * ============================================================================ */
@@ -288,6 +2485,90 @@ static int test_task_management(void)
     return 0;
 }
 
+static int test_task_scheduler(void)
+{
+    ekk_runqueue_t rq;
+    ekk_runqueue_init(&rq);
+    TEST_ASSERT(ekk_runqueue_pick(&rq, 0) == EKK_RUNQUEUE_NONE, "Empty queue is idle");
+
+    /* Fixed priority: lowest number wins, lowest ID on ties */
+    const ekk_task_id_t last = EKK_MAX_TASKS_PER_MODULE - 1;
+    ekk_runqueue_set_priority(&rq, 0, 5);
+    ekk_runqueue_set_priority(&rq, 1, 2);
+    ekk_runqueue_set_priority(&rq, 2, 2);
+    ekk_runqueue_set_priority(&rq, last, 200);
+    ekk_runqueue_ready(&rq, last);
+    ekk_runqueue_ready(&rq, 2);
+    ekk_runqueue_ready(&rq, 0);
+    ekk_runqueue_ready(&rq, 1);
+    TEST_ASSERT(ekk_runqueue_pick(&rq, 0) == 1, "Highest priority, lowest ID");
+    ekk_runqueue_remove(&rq, 1);
+    TEST_ASSERT(ekk_runqueue_pick(&rq, 0) == 2, "Same level after removal");
+    ekk_runqueue_set_priority(&rq, 0, 1);
+    TEST_ASSERT(ekk_runqueue_pick(&rq, 0) == 0, "Priority change requeues");
+    ekk_runqueue_remove(&rq, 0);
+    ekk_runqueue_remove(&rq, 2);
+    TEST_ASSERT(ekk_runqueue_pick(&rq, 0) == last, "Out-of-range priority shares last level");
+
+    /* Deadlines: EDF on latest start time once inside the slack threshold */
+    const ekk_time_us_t t = 100000000;
+    ekk_runqueue_ready(&rq, 0);
+    ekk_runqueue_set_priority(&rq, 3, 9);
+    ekk_runqueue_set_priority(&rq, 4, 9);
+    ekk_runqueue_set_deadline(&rq, 3, true, t + 30000000, 5000000);
+    ekk_runqueue_set_deadline(&rq, 4, true, t + 29000000, 1000000);
+    ekk_runqueue_ready(&rq, 3);
+    ekk_runqueue_ready(&rq, 4);
+    TEST_ASSERT(ekk_runqueue_pick(&rq, t) == 0, "Ample slack keeps fixed priority");
+    TEST_ASSERT(ekk_runqueue_pick(&rq, t + 16000000) == 3, "Earliest start-by goes first");
+    ekk_runqueue_remove(&rq, 3);
+    TEST_ASSERT(ekk_runqueue_pick(&rq, t + 16000000) == 0, "Next deadline still has slack");
+    TEST_ASSERT(ekk_runqueue_pick(&rq, t + 19000000) == 4, "Next deadline becomes critical");
+    ekk_runqueue_set_deadline(&rq, 4, false, 0, 0);
+    TEST_ASSERT(ekk_runqueue_pick(&rq, t + 19000000) == 0, "Cleared deadline loses boost");
+    ekk_runqueue_remove(&rq, 4);
+
+    /* Timer queue: periodic releases in time order */
+    ekk_runqueue_remove(&rq, 0);
+    ekk_runqueue_release_at(&rq, 0, 3000);
+    ekk_runqueue_release_at(&rq, 2, 1000);
+    TEST_ASSERT(ekk_runqueue_next_release(&rq) == 1000, "Earliest release first");
+    TEST_ASSERT(ekk_runqueue_release(&rq, 999) == 0, "Nothing due yet");
+    TEST_ASSERT(ekk_runqueue_release(&rq, 1000) == 1, "Due task released");
+    TEST_ASSERT(ekk_runqueue_is_ready(&rq, 2), "Released task is ready");
+    TEST_ASSERT(ekk_runqueue_next_release(&rq) == 3000, "Next release");
+    ekk_runqueue_ready(&rq, 0);
+    TEST_ASSERT(ekk_runqueue_next_release(&rq) == UINT64_MAX, "Ready cancels release");
+
+    /* Module: capability-gated and periodic tasks */
+    ekk_module_t mod;
+    ekk_position_t pos = {0, 0, 0};
+    ekk_module_init(&mod, 1, "sched-test", pos);
+
+    ekk_task_id_t gated, periodic;
+    ekk_module_add_task(&mod, "gated", test_task_fn, NULL, 0, 0, &gated);
+    ekk_module_add_task(&mod, "periodic", test_task_fn, NULL, 3, 1000000, &periodic);
+    ekk_module_set_task_capabilities(&mod, gated, EKK_CAP_GATEWAY);
+    ekk_module_task_ready(&mod, gated);
+    ekk_module_task_ready(&mod, periodic);
+    TEST_ASSERT(ekk_module_select_task(&mod) == periodic, "Gated task skipped");
+
+    ekk_module_set_capabilities(&mod, EKK_CAP_GATEWAY);
+    TEST_ASSERT(ekk_module_select_task(&mod) == gated, "Capability unblocks task");
+    ekk_module_task_block(&mod, gated);
+
+    ekk_module_start(&mod);
+    g_task_run_count = 0;
+    ekk_module_tick(&mod, ekk_hal_time_us());
+    TEST_ASSERT(g_task_run_count == 1, "Periodic task ran");
+    TEST_ASSERT(ekk_module_select_task(&mod) == EKK_RUNQUEUE_NONE, "Waits for its period");
+    TEST_ASSERT(ekk_runqueue_next_release(&mod.runqueue) == mod.tasks[periodic].next_run,
+                "Re-armed on the timer queue");
+
+    TEST_PASS("test_task_scheduler");
+    return 0;
+}
+
 /* ============================================================================
  * MAIN
  * ============================================================================ */
@@ -305,12 +2586,41 @@ int main(int argc, char **argv)
     failures += test_init();
     failures += test_fixed_point();
     failures += test_field_operations();
+    failures += test_field_decay();
+    failures += test_field_component();
+    failures += test_field_aggregate();
+    failures += test_field_incremental();
+    failures += test_field_deadband();
+    failures += test_field_snapshot();
+    failures += test_field_gc_wheel();
+    failures += test_field_segments();
+    failures += test_field_shm();
+    failures += test_idmap();
     failures += test_topology();
+    failures += test_topology_reelect();
+    failures += test_topology_incremental();
     failures += test_consensus();
     failures += test_heartbeat();
+    failures += test_heartbeat_phi();
+    failures += test_heartbeat_deadlines();
+    failures += test_latency();
+    failures += test_heartbeat_piggyback();
+    failures += test_heartbeat_trailer_coverage();
+    failures += test_module_alive_keeps_position();
+    failures += test_raft_large_cluster();
+    failures += test_consensus_pipeline();
+    failures += test_consensus_decision();
+    failures += test_consensus_restart();
     failures += test_module_create();
     failures += test_module_lifecycle();
+    failures += test_module_multi_instance();
+    failures += test_module_endpoints();
+    failures += test_module_tickless();
+    failures += test_latency_histogram();
+    failures += test_module_rx_dispatch();
     failures += test_task_management();
+    failures += test_task_scheduler();
+    failures += test_spsc_batch();
 
     printf("\n====================\n");
     if (failures == 0) {
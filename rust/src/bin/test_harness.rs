@@ -4,12 +4,12 @@
 //! JSON results for cross-validation with the C implementation.
 
 use ekk::{
-    field::{FieldEngine, FieldRegion},
+    field::{DecayModel, FieldConfig, FieldEngine, FieldRegion},
     topology::{Topology, TopologyConfig, DistanceMetric},
     consensus::{Consensus, ProposalType},
     heartbeat::Heartbeat,
     types::{
-        Field, Fixed, ModuleId, BallotId, TimeUs, Position,
+        Field, FieldComponent, Fixed, ModuleId, BallotId, TimeUs, Position,
         HealthState, VoteValue, threshold, K_NEIGHBORS,
     },
 };
@@ -253,6 +253,7 @@ fn dispatch_test(vector: &TestVector, state: &mut TestState) -> TestResult {
         ("field", "field_publish") => test_field_publish(vector, state),
         ("field", "field_sample") => test_field_sample(vector, state),
         ("field", "field_gradient") => test_field_gradient(vector, state),
+        ("field", "field_decay") => test_field_decay(vector, state),
 
         // Topology module
         ("topology", "topology_on_discovery") => test_topology_on_discovery(vector, state),
@@ -342,6 +343,10 @@ fn test_field_publish(vector: &TestVector, state: &mut TestState) -> Result<Valu
     match result {
         Ok(()) => {
             let stored = state.field_region.get(module_id).ok_or("Field not stored")?;
+            // Outer seqlock counter (even = stable), as the C harness reports
+            let sequence = state.field_region.get_coord(module_id)
+                .ok_or("Field not stored")?
+                .sequence.load(std::sync::atomic::Ordering::SeqCst);
             Ok(json!({
                 "return": "OK",
                 "region_state": {
@@ -350,7 +355,7 @@ fn test_field_publish(vector: &TestVector, state: &mut TestState) -> Result<Valu
                     format!("fields[{}].components[0]", module_id): stored.components[0].to_bits(),
                     format!("fields[{}].components[1]", module_id): stored.components[1].to_bits(),
                     format!("fields[{}].components[2]", module_id): stored.components[2].to_bits(),
-                    format!("fields[{}].sequence", module_id): stored.sequence,
+                    format!("fields[{}].sequence", module_id): sequence,
                 }
             }))
         }
@@ -429,17 +434,21 @@ fn test_field_gradient(vector: &TestVector, state: &mut TestState) -> Result<Val
         .or_else(|| input.get("neighbor_aggregate"))
         .ok_or("Missing neighbor_field or neighbor_aggregate")?;
 
-    let my = Field::with_values(
+    let mut my = Field::with_values(
         Fixed::from_num(my_field.get("load").and_then(|v| v.as_f64()).unwrap_or(0.0)),
         Fixed::from_num(my_field.get("thermal").and_then(|v| v.as_f64()).unwrap_or(0.0)),
         Fixed::from_num(my_field.get("power").and_then(|v| v.as_f64()).unwrap_or(0.0)),
     );
+    my.set(FieldComponent::Slack,
+        Fixed::from_num(my_field.get("slack").and_then(|v| v.as_f64()).unwrap_or(0.0)));
 
-    let neighbor = Field::with_values(
+    let mut neighbor = Field::with_values(
         Fixed::from_num(neighbor_field.get("load").and_then(|v| v.as_f64()).unwrap_or(0.0)),
         Fixed::from_num(neighbor_field.get("thermal").and_then(|v| v.as_f64()).unwrap_or(0.0)),
         Fixed::from_num(neighbor_field.get("power").and_then(|v| v.as_f64()).unwrap_or(0.0)),
     );
+    neighbor.set(FieldComponent::Slack,
+        Fixed::from_num(neighbor_field.get("slack").and_then(|v| v.as_f64()).unwrap_or(0.0)));
 
     let gradients = state.field_engine.gradient_all(&my, &neighbor);
 
@@ -452,6 +461,7 @@ fn test_field_gradient(vector: &TestVector, state: &mut TestState) -> Result<Val
         "Load" | "load" => gradients[0].to_num::<f64>(),
         "Thermal" | "thermal" => gradients[1].to_num::<f64>(),
         "Power" | "power" => gradients[2].to_num::<f64>(),
+        "Slack" | "slack" => gradients[FieldComponent::Slack as usize].to_num::<f64>(),
         _ => gradients[0].to_num::<f64>(),
     };
 
@@ -461,6 +471,50 @@ fn test_field_gradient(vector: &TestVector, state: &mut TestState) -> Result<Val
     }))
 }
 
+fn test_field_decay(vector: &TestVector, state: &mut TestState) -> Result<Value> {
+    let cases = vector.input.get("cases")
+        .and_then(|v| v.as_array())
+        .ok_or("Missing cases")?;
+
+    let mut factors = Vec::with_capacity(cases.len());
+    let mut values = Vec::with_capacity(cases.len());
+
+    for case in cases {
+        let decay_model = match case.get("model").and_then(|v| v.as_str()).unwrap_or("Exponential") {
+            "Linear" => DecayModel::Linear,
+            "Step" => DecayModel::Step,
+            _ => DecayModel::Exponential,
+        };
+        let raw = |key: &str, def: i64| case.get(key).and_then(|v| v.as_i64()).unwrap_or(def) as i32;
+
+        let config = FieldConfig {
+            decay_tau: Fixed::from_bits(raw("decay_tau", 0)),
+            decay_model,
+            min_value: Fixed::from_bits(raw("min_value", i32::MIN as i64)),
+            max_value: Fixed::from_bits(raw("max_value", i32::MAX as i64)),
+            ..FieldConfig::default()
+        };
+        state.field_engine.set_config(FieldComponent::Load, config);
+
+        let elapsed = case.get("elapsed_us").and_then(|v| v.as_u64()).unwrap_or(0);
+        let mut field = Field::new();
+        field.components[0] = Fixed::from_bits(raw("value", 0));
+        state.field_engine.apply_decay(&mut field, elapsed);
+
+        factors.push(state.field_engine.decay_factor(FieldComponent::Load, elapsed).to_bits());
+        values.push(field.components[0].to_bits());
+    }
+
+    // Restore default decay for the remaining vectors
+    state.field_engine.set_config(FieldComponent::Load, FieldConfig::default());
+
+    Ok(json!({
+        "return": "OK",
+        "factors": factors,
+        "values": values,
+    }))
+}
+
 // ============================================================================
 // Topology Tests
 // ============================================================================
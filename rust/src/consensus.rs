@@ -202,10 +202,27 @@ impl Ballot {
 
 #[derive(Debug, Clone, Copy, Default)]
 struct Inhibition {
+    proposer: ModuleId,
     ballot_id: BallotId,
     until: TimeUs,
 }
 
+// ============================================================================
+// Ballot ID Ranges
+// ============================================================================
+
+const BALLOT_SEQ_MASK: u32 = (1 << BALLOT_SEQ_BITS) - 1;
+
+/// First ballot ID of a proposer's range
+fn ballot_range(proposer: ModuleId) -> BallotId {
+    (((proposer as u32).wrapping_sub(1) << BALLOT_SEQ_BITS) & 0xFFFF) as BallotId
+}
+
+/// Lowest module ID whose range holds a ballot ID
+fn range_owner(id: BallotId) -> ModuleId {
+    ((id as u32 >> BALLOT_SEQ_BITS) + 1) as ModuleId
+}
+
 // ============================================================================
 // Consensus Engine
 // ============================================================================
@@ -216,9 +233,9 @@ pub struct Consensus {
     my_id: ModuleId,
     /// Active ballots
     ballots: Vec<Ballot, MAX_BALLOTS>,
-    /// Inhibited ballot IDs
+    /// Inhibited (proposer, ballot ID) pairs
     inhibited: Vec<Inhibition, MAX_BALLOTS>,
-    /// Next ballot ID to use
+    /// Next ballot ID to use (own range)
     next_ballot_id: BallotId,
     /// Configuration
     config: ConsensusConfig,
@@ -236,7 +253,7 @@ impl Consensus {
             my_id,
             ballots: Vec::new(),
             inhibited: Vec::new(),
-            next_ballot_id: 1,
+            next_ballot_id: ballot_range(my_id) | 1, // Sequence 0 is never used
             config: config.unwrap_or_default(),
             on_decide: None,
             on_complete: None,
@@ -257,11 +274,7 @@ impl Consensus {
             return Err(Error::Busy);
         }
 
-        let ballot_id = self.next_ballot_id;
-        self.next_ballot_id = self.next_ballot_id.wrapping_add(1);
-        if self.next_ballot_id == INVALID_BALLOT_ID {
-            self.next_ballot_id = 1;
-        }
+        let ballot_id = self.allocate_ballot_id();
 
         let deadline = now + self.config.vote_timeout;
         let ballot = Ballot::new(ballot_id, proposal_type, self.my_id, data, threshold, deadline);
@@ -271,40 +284,78 @@ impl Consensus {
         Ok(ballot_id)
     }
 
+    /// Next free ID from this module's range
+    ///
+    /// The sequence wraps within the range, skipping 0 and any ID still in
+    /// the table (the range is larger than the table, so one is always free).
+    fn allocate_ballot_id(&mut self) -> BallotId {
+        loop {
+            let id = self.next_ballot_id;
+            let mut seq = (id as u32 & BALLOT_SEQ_MASK) + 1;
+            if seq > BALLOT_SEQ_MASK {
+                seq = 1;
+            }
+            self.next_ballot_id = ((id as u32 & !BALLOT_SEQ_MASK) | seq) as BallotId;
+            if self.find_ballot(self.my_id, id).is_none() {
+                return id;
+            }
+        }
+    }
+
+    /// Find a ballot by proposer and ID
+    fn find_ballot(&self, proposer: ModuleId, id: BallotId) -> Option<usize> {
+        self.ballots.iter().position(|b| b.proposer == proposer && b.id == id)
+    }
+
+    /// Find a ballot by ID alone, our own first
+    fn find_local_ballot(&self, id: BallotId) -> Option<usize> {
+        self.find_ballot(self.my_id, id)
+            .or_else(|| self.ballots.iter().position(|b| b.id == id))
+    }
+
     /// Cast vote in response to neighbor's proposal
     pub fn vote(&mut self, ballot_id: BallotId, vote: VoteValue) -> Result<()> {
+        let idx = self.find_local_ballot(ballot_id).ok_or(Error::NotFound)?;
+
         // Check if inhibited
-        if self.is_inhibited(ballot_id) {
+        if self.is_inhibited(self.ballots[idx].proposer, ballot_id) {
             return Err(Error::Inhibited);
         }
 
-        // Find and update ballot
-        for ballot in self.ballots.iter_mut() {
-            if ballot.id == ballot_id && !ballot.completed {
-                ballot.record_vote(vote);
-                return Ok(());
-            }
+        let ballot = &mut self.ballots[idx];
+        if ballot.completed {
+            return Err(Error::NotFound);
         }
-
-        Err(Error::NotFound)
+        ballot.record_vote(vote);
+        Ok(())
     }
 
     /// Inhibit a competing proposal
+    ///
+    /// Applies to the proposer of the open ballot with this ID, or to the
+    /// owner of the ID range if no such ballot is open.
     pub fn inhibit(&mut self, ballot_id: BallotId, now: TimeUs) -> Result<()> {
-        let inhibition = Inhibition {
-            ballot_id,
-            until: now + self.config.inhibit_duration,
+        let idx = self.find_local_ballot(ballot_id);
+        let proposer = match idx {
+            Some(i) => self.ballots[i].proposer,
+            None => range_owner(ballot_id),
         };
 
-        self.inhibited.push(inhibition).map_err(|_| Error::NoMemory)?;
+        let until = now + self.config.inhibit_duration;
+        if let Some(entry) = self.inhibited.iter_mut()
+            .find(|i| i.proposer == proposer && i.ballot_id == ballot_id)
+        {
+            entry.until = until;
+        } else {
+            let inhibition = Inhibition { proposer, ballot_id, until };
+            self.inhibited.push(inhibition).map_err(|_| Error::NoMemory)?;
+        }
 
         // Mark ballot as cancelled if we have it
-        for ballot in self.ballots.iter_mut() {
-            if ballot.id == ballot_id {
-                ballot.result = VoteResult::Cancelled;
-                ballot.completed = true;
-                break;
-            }
+        if let Some(i) = idx {
+            let ballot = &mut self.ballots[i];
+            ballot.result = VoteResult::Cancelled;
+            ballot.completed = true;
         }
 
         Ok(())
@@ -321,8 +372,10 @@ impl Consensus {
         vote: VoteValue,
         total_voters: u8,
     ) -> Result<()> {
+        // Votes are addressed to the proposer
+        let my_id = self.my_id;
         for ballot in self.ballots.iter_mut() {
-            if ballot.id == ballot_id {
+            if ballot.proposer == my_id && ballot.id == ballot_id {
                 // Use record_vote_from for proper deduplication
                 if !ballot.record_vote_from(voter_id, vote) {
                     // Duplicate vote - ignore but don't error
@@ -353,7 +406,7 @@ impl Consensus {
         now: TimeUs,
     ) -> Result<VoteValue> {
         // Check if inhibited
-        if self.is_inhibited(ballot_id) {
+        if self.is_inhibited(proposer_id, ballot_id) {
             return Err(Error::Inhibited);
         }
 
@@ -372,14 +425,12 @@ impl Consensus {
         }
     }
 
-    /// Get result of a ballot
+    /// Get result of a ballot (our own first if a remote one shares the ID)
     pub fn get_result(&self, ballot_id: BallotId) -> VoteResult {
-        for ballot in self.ballots.iter() {
-            if ballot.id == ballot_id {
-                return ballot.result;
-            }
+        match self.find_local_ballot(ballot_id) {
+            Some(i) => self.ballots[i].result,
+            None => VoteResult::Pending,
         }
-        VoteResult::Pending
     }
 
     /// Periodic tick - check timeouts
@@ -414,9 +465,9 @@ impl Consensus {
         completed
     }
 
-    /// Check if ballot is inhibited
-    fn is_inhibited(&self, ballot_id: BallotId) -> bool {
-        self.inhibited.iter().any(|i| i.ballot_id == ballot_id)
+    /// Check if a proposer's ballot is inhibited
+    fn is_inhibited(&self, proposer: ModuleId, ballot_id: BallotId) -> bool {
+        self.inhibited.iter().any(|i| i.proposer == proposer && i.ballot_id == ballot_id)
     }
 
     /// Set decision callback
@@ -439,6 +490,7 @@ impl Consensus {
 #[repr(C, packed)]
 pub struct VoteMessage {
     pub voter_id: ModuleId,
+    pub proposer_id: ModuleId,
     pub ballot_id: BallotId,
     pub vote: VoteValue,
     pub timestamp: u32,
@@ -449,6 +501,7 @@ pub struct VoteMessage {
 #[repr(C, packed)]
 pub struct ProposalMessage {
     pub proposer_id: ModuleId,
+    pub incarnation: u8,
     pub ballot_id: BallotId,
     pub proposal_type: ProposalType,
     pub data: u32,
@@ -499,4 +552,60 @@ mod tests {
 
         assert_eq!(cons.get_result(ballot_id), VoteResult::Cancelled);
     }
+
+    #[test]
+    fn test_consensus_id_ranges() {
+        let mut a = Consensus::new(3, None);
+        let mut b = Consensus::new(4, None);
+
+        let id_a = a
+            .propose(ProposalType::ModeChange, 1, threshold::SIMPLE_MAJORITY, 1000)
+            .unwrap();
+        let id_b = b
+            .propose(ProposalType::ModeChange, 2, threshold::SIMPLE_MAJORITY, 1000)
+            .unwrap();
+
+        assert_eq!(id_a, (2 << BALLOT_SEQ_BITS) | 1);
+        assert_eq!(id_b, (3 << BALLOT_SEQ_BITS) | 1);
+        assert_eq!(range_owner(id_a), 3);
+    }
+
+    #[test]
+    fn test_consensus_id_wraps_within_range() {
+        let mut cons = Consensus::new(2, None);
+
+        let last = (0..BALLOT_SEQ_MASK)
+            .map(|_| {
+                let id = cons
+                    .propose(ProposalType::ModeChange, 0, threshold::SIMPLE_MAJORITY, 1000)
+                    .unwrap();
+                cons.tick(1000 + VOTE_TIMEOUT_US);
+                id
+            })
+            .last()
+            .unwrap();
+        assert_eq!(last, ballot_range(2) | BALLOT_SEQ_MASK as BallotId);
+
+        let next = cons
+            .propose(ProposalType::ModeChange, 0, threshold::SIMPLE_MAJORITY, 1000)
+            .unwrap();
+        assert_eq!(next, ballot_range(2) | 1);
+    }
+
+    #[test]
+    fn test_consensus_inhibit_keyed_on_proposer() {
+        let mut cons = Consensus::new(1, None);
+        let id = ballot_range(2) | 1;
+
+        cons.on_proposal(2, id, ProposalType::ModeChange, 0, threshold::SIMPLE_MAJORITY, 1000)
+            .unwrap();
+        cons.inhibit(id, 1000).unwrap();
+
+        assert!(cons.is_inhibited(2, id));
+        assert!(!cons.is_inhibited(3, id));
+        assert_eq!(
+            cons.on_proposal(2, id, ProposalType::ModeChange, 0, threshold::SIMPLE_MAJORITY, 1000),
+            Err(Error::Inhibited)
+        );
+    }
 }
@@ -37,7 +37,7 @@ pub enum DecayModel {
 /// Field configuration per component
 #[derive(Debug, Clone, Copy)]
 pub struct FieldConfig {
-    /// Decay time constant (seconds as Q16.16)
+    /// Decay time constant (seconds as Q16.16, zero = `FIELD_DECAY_TAU_US`)
     pub decay_tau: Fixed,
     /// Decay function
     pub decay_model: DecayModel,
@@ -52,15 +52,104 @@ pub struct FieldConfig {
 impl Default for FieldConfig {
     fn default() -> Self {
         Self {
-            decay_tau: Fixed::from_num(0.1), // 100ms
+            decay_tau: Fixed::ZERO, // FIELD_DECAY_TAU_US (100ms)
             decay_model: DecayModel::Exponential,
-            min_value: Fixed::ZERO,
-            max_value: Fixed::ONE,
+            min_value: Fixed::MIN,
+            max_value: Fixed::MAX,
             default_value: Fixed::ZERO,
         }
     }
 }
 
+// ============================================================================
+// Decay Tables
+// ============================================================================
+
+/// Segments in the exponential decay table (covers 0..5 tau)
+const DECAY_SEGMENTS: u64 = 64;
+
+/// exp(-5i/64) in Q16.16, i = 0..64, rounded to nearest.
+/// Must match `g_decay_exp_table` in c/src/ekk_field.c bit for bit.
+const DECAY_EXP_TABLE: [i32; DECAY_SEGMENTS as usize + 1] = [
+    65536, 60611, 56056, 51843, 47947, 44344, 41011, 37929,
+    35079, 32443, 30005, 27750, 25664, 23736, 21952, 20302,
+    18776, 17365, 16060, 14853, 13737, 12705, 11750, 10867,
+    10050,  9295,  8596,  7950,  7353,  6800,  6289,  5817,
+     5380,  4975,  4601,  4256,  3936,  3640,  3366,  3113,
+     2879,  2663,  2463,  2278,  2107,  1948,  1802,  1666,
+     1541,  1425,  1318,  1219,  1128,  1043,   964,   892,
+      825,   763,   706,   653,   604,   558,   516,   477,
+      442,
+];
+
+/// Decay evaluator for one component, built from its `FieldConfig`
+///
+/// All divisions happen at build time. Evaluation is a 64-bit multiply by
+/// the precomputed reciprocal, one table lookup and an interpolation, in
+/// pure integer arithmetic so results match the C implementation exactly.
+#[derive(Debug, Clone, Copy)]
+struct DecayEval {
+    model: DecayModel,
+    /// Age at which the factor reaches 0
+    span_us: TimeUs,
+    /// 2^32 * (Q16 table position per us)
+    recip: u64,
+    min_value: Fixed,
+    max_value: Fixed,
+}
+
+impl DecayEval {
+    fn build(config: &FieldConfig) -> Self {
+        let bits = config.decay_tau.to_bits();
+        let tau = if bits <= 0 {
+            FIELD_DECAY_TAU_US
+        } else {
+            ((bits as u64 * 1_000_000) >> 16).max(1)
+        };
+
+        let (span_us, recip) = match config.decay_model {
+            DecayModel::Exponential => (tau * 5, (DECAY_SEGMENTS << 48) / (tau * 5)),
+            DecayModel::Linear => (tau, (1u64 << 48) / tau),
+            DecayModel::Step => (tau, 0),
+        };
+
+        Self {
+            model: config.decay_model,
+            span_us,
+            recip,
+            min_value: config.min_value,
+            max_value: config.max_value,
+        }
+    }
+
+    /// Decay factor in Q16.16 raw bits, [0, 65536]
+    fn factor(&self, age: TimeUs) -> i32 {
+        if age >= self.span_us {
+            return 0;
+        }
+
+        match self.model {
+            DecayModel::Exponential => {
+                // age < span keeps the product below 2^54
+                let pos = ((age * self.recip) >> 32) as u32;
+                let idx = (pos >> 16) as usize;
+                let frac = (pos & 0xFFFF) as i64;
+                let a = DECAY_EXP_TABLE[idx];
+                let b = DECAY_EXP_TABLE[idx + 1];
+                a + (((b - a) as i64 * frac) >> 16) as i32
+            }
+            DecayModel::Linear => 65536 - ((age * self.recip) >> 32) as i32,
+            DecayModel::Step => 65536,
+        }
+    }
+
+    /// Decay and clamp a value, matching `ekk_fixed_mul` truncation
+    fn apply(&self, value: Fixed, age: TimeUs) -> Fixed {
+        let raw = (value.to_bits() as i64 * self.factor(age) as i64) >> 16;
+        Fixed::from_bits(raw as i32).max(self.min_value).min(self.max_value)
+    }
+}
+
 // ============================================================================
 // Field Region (Shared Memory)
 // ============================================================================
@@ -176,13 +265,21 @@ impl Default for FieldRegion {
 pub struct FieldEngine {
     /// Configuration per component
     config: [FieldConfig; FIELD_COUNT],
+    /// Decay evaluators built from `config`
+    decay: [DecayEval; FIELD_COUNT],
+    /// Longest decay span over all components
+    max_age_us: TimeUs,
 }
 
 impl FieldEngine {
     /// Create a new field engine with default config
     pub fn new() -> Self {
+        let config = FieldConfig::default();
+        let eval = DecayEval::build(&config);
         Self {
-            config: [FieldConfig::default(); FIELD_COUNT],
+            config: [config; FIELD_COUNT],
+            decay: [eval; FIELD_COUNT],
+            max_age_us: eval.span_us,
         }
     }
 
@@ -255,9 +352,8 @@ impl FieldEngine {
         }
 
         let elapsed = now.saturating_sub(field.timestamp);
-        let max_age = FIELD_DECAY_TAU_US * 5; // 5 tau = ~99% decay
 
-        if elapsed > max_age {
+        if elapsed > self.max_age_us {
             return Err(Error::FieldExpired);
         }
 
@@ -389,69 +485,23 @@ impl FieldEngine {
     /// Apply decay to a field based on elapsed time and configuration
     ///
     /// Uses the configured decay model for each component:
-    /// - Exponential: f(t) = f0 * exp(-t/tau)
+    /// - Exponential: f(t) = f0 * exp(-t/tau), table over 0..5 tau
     /// - Linear: f(t) = f0 * (1 - t/tau), clamped to 0
     /// - Step: f(t) = f0 if t < tau, else 0
     ///
-    /// Also applies min/max clamping from config.
+    /// Also applies min/max clamping from config. Bit-exact with the C
+    /// implementation (see spec/test-vectors/field_009_decay_models.json).
     pub fn apply_decay(&self, field: &mut Field, elapsed_us: TimeUs) {
         for i in 0..FIELD_COUNT {
-            let config = &self.config[i];
-            let tau_us = (config.decay_tau.to_num::<f32>() * 1_000_000.0) as u64;
-            let tau = if tau_us > 0 { tau_us } else { FIELD_DECAY_TAU_US };
-
-            let t = elapsed_us as f32;
-            let tau_f = tau as f32;
-
-            let decay_factor = match config.decay_model {
-                DecayModel::Exponential => {
-                    // Piecewise approximation of exp(-t/tau) for embedded
-                    // More accurate than simple linear approximation
-                    if t < tau_f {
-                        Fixed::from_num(1.0 - t / tau_f * 0.632) // exp(-1) ≈ 0.368
-                    } else if t < tau_f * 2.0 {
-                        Fixed::from_num(0.368 - (t - tau_f) / tau_f * 0.233) // exp(-2) ≈ 0.135
-                    } else if t < tau_f * 3.0 {
-                        Fixed::from_num(0.135 - (t - tau_f * 2.0) / tau_f * 0.086) // exp(-3) ≈ 0.049
-                    } else if t < tau_f * 5.0 {
-                        Fixed::from_num(0.049 * (1.0 - (t - tau_f * 3.0) / (tau_f * 2.0)))
-                    } else {
-                        Fixed::ZERO
-                    }
-                }
-                DecayModel::Linear => {
-                    // f(t) = f0 * (1 - t/tau), clamped to 0
-                    if t < tau_f {
-                        Fixed::from_num(1.0 - t / tau_f)
-                    } else {
-                        Fixed::ZERO
-                    }
-                }
-                DecayModel::Step => {
-                    // f(t) = f0 if t < tau, else 0
-                    if t < tau_f {
-                        Fixed::ONE
-                    } else {
-                        Fixed::ZERO
-                    }
-                }
-            };
-
-            let decay_factor = decay_factor.max(Fixed::ZERO);
-
-            // Apply decay
-            field.components[i] *= decay_factor;
-
-            // Apply min/max clamping from config
-            if field.components[i] < config.min_value {
-                field.components[i] = config.min_value;
-            }
-            if field.components[i] > config.max_value {
-                field.components[i] = config.max_value;
-            }
+            field.components[i] = self.decay[i].apply(field.components[i], elapsed_us);
         }
     }
 
+    /// Decay factor for a component after `elapsed_us` (Q16.16, [0, 1])
+    pub fn decay_factor(&self, component: FieldComponent, elapsed_us: TimeUs) -> Fixed {
+        Fixed::from_bits(self.decay[component as usize].factor(elapsed_us))
+    }
+
     /// Garbage collect expired fields
     pub fn gc(&self, region: &mut FieldRegion, now: TimeUs, max_age_us: TimeUs) -> u32 {
         let mut expired = 0u32;
@@ -475,6 +525,8 @@ impl FieldEngine {
         let idx = component as usize;
         if idx < FIELD_COUNT {
             self.config[idx] = config;
+            self.decay[idx] = DecayEval::build(&config);
+            self.max_age_us = self.decay.iter().map(|d| d.span_us).max().unwrap_or(0);
         }
     }
 
@@ -568,4 +620,33 @@ mod tests {
         let gradient = engine.gradient(&my_field, &neighbor_field, FieldComponent::Load);
         assert!(gradient > Fixed::ZERO); // Neighbors have higher load
     }
+
+    #[test]
+    fn test_decay_models() {
+        let mut engine = FieldEngine::new();
+
+        // Values shared with spec/test-vectors/field_009_decay_models.json
+        assert_eq!(engine.decay_factor(FieldComponent::Load, 0).to_bits(), 65536);
+        assert_eq!(engine.decay_factor(FieldComponent::Load, 100_000).to_bits(), 24121);
+        assert_eq!(engine.decay_factor(FieldComponent::Load, 500_000).to_bits(), 0);
+
+        engine.set_config(FieldComponent::Thermal, FieldConfig {
+            decay_tau: Fixed::ONE,
+            decay_model: DecayModel::Linear,
+            ..FieldConfig::default()
+        });
+        assert_eq!(engine.decay_factor(FieldComponent::Thermal, 250_000).to_bits(), 49153);
+
+        // Long thermal tau keeps fields alive past the default 5*tau
+        engine.set_config(FieldComponent::Thermal, FieldConfig {
+            decay_tau: Fixed::from_num(10),
+            ..FieldConfig::default()
+        });
+        let mut region = FieldRegion::new();
+        let field = Field::with_values(Fixed::ONE, Fixed::ONE, Fixed::ZERO);
+        engine.publish(&mut region, 1, &field, 1000).unwrap();
+        let sampled = engine.sample(&region, 1, 1000 + 1_000_000).unwrap();
+        assert_eq!(sampled.get(FieldComponent::Load), Fixed::ZERO);
+        assert_eq!(sampled.get(FieldComponent::Thermal).to_bits(), 59335);
+    }
 }
@@ -356,6 +356,8 @@ impl Module {
             next_run: 0,
             run_count: 0,
             total_runtime: 0,
+            deadline: None,
+            required_caps: 0,
         };
 
         self.tasks.push(task).map_err(|_| Error::NoMemory)?;
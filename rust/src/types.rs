@@ -35,6 +35,9 @@ pub const VOTE_TIMEOUT_US: u64 = 50_000;
 /// Maximum concurrent ballots
 pub const MAX_BALLOTS: usize = 4;
 
+/// Ballot sequence bits: module N proposes IDs ((N - 1) << BALLOT_SEQ_BITS) + 1 onward
+pub const BALLOT_SEQ_BITS: u32 = 8;
+
 /// Maximum field components (6 with MAPF-HET slack integration)
 pub const FIELD_COUNT: usize = 6;
 